@@ -0,0 +1,219 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <typeinfo>
+
+#include "sparrow_ipc/config/config.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief Concept for stream-like types that support read operations.
+     *
+     * A type satisfies this concept if it has a read method that accepts a pointer
+     * to a character buffer and a maximum number of bytes to read.
+     *
+     * Two flavours of read are supported:
+     * - std::istream-like types, where the number of bytes read is given by `gcount()`
+     * - POSIX-like types, where `read` returns the number of bytes read, 0 at the end
+     *   of the stream and a negative value on error
+     */
+    template <typename T>
+    concept readable_stream = requires(T& t, char* s, std::streamsize count) {
+        { t.read(s, count) };
+    };
+
+    /**
+     * @brief Type-erased wrapper for any readable stream-like object.
+     *
+     * This class is the input counterpart of any_output_stream: it uses the same
+     * concept-based type erasure pattern to wrap any stream-like object polymorphically.
+     *
+     * Usage:
+     * @code
+     * std::ifstream file("data.arrows", std::ios::binary);
+     * any_input_stream stream1(file);
+     *
+     * // Or any custom type with a read method
+     * my_socket_stream socket;
+     * any_input_stream stream2(socket);
+     * @endcode
+     */
+    class SPARROW_IPC_API any_input_stream
+    {
+    public:
+
+        /**
+         * @brief Constructs a type-erased stream from any readable stream-like object.
+         *
+         * @tparam TStream The concrete stream type (must satisfy readable_stream concept)
+         * @param stream The stream object to wrap
+         *
+         * The stream is stored by reference, so the caller must ensure the stream
+         * lifetime exceeds that of the any_input_stream object.
+         */
+        template <readable_stream TStream>
+        any_input_stream(TStream& stream);
+
+        ~any_input_stream() = default;
+
+        any_input_stream(any_input_stream&&) noexcept = default;
+        any_input_stream& operator=(any_input_stream&&) noexcept = default;
+
+        any_input_stream(const any_input_stream&) = delete;
+        any_input_stream& operator=(const any_input_stream&) = delete;
+
+        /**
+         * @brief Reads bytes from the underlying stream until the span is full or the stream ends.
+         *
+         * @param span The destination of the bytes
+         * @return The number of bytes read, smaller than the span size only if the end of the stream
+         *         was reached
+         * @throws std::runtime_error if the read operation fails
+         */
+        [[nodiscard]] size_t read(std::span<std::uint8_t> span);
+
+        /**
+         * @brief Gets the number of bytes read so far.
+         *
+         * @return The current position in the stream
+         */
+        [[nodiscard]] size_t position() const;
+
+        /**
+         * @brief Gets a reference to the underlying stream cast to the specified type.
+         *
+         * @tparam TStream The expected concrete type of the underlying stream
+         * @return Reference to the underlying stream as TStream
+         * @throws std::bad_cast if the underlying stream is not of type TStream
+         */
+        template <typename TStream>
+        TStream& get();
+
+    private:
+
+        /**
+         * @brief Abstract interface for type-erased streams.
+         */
+        struct stream_concept
+        {
+            virtual ~stream_concept() = default;
+            [[nodiscard]] virtual size_t read(std::span<std::uint8_t> span) = 0;
+            [[nodiscard]] virtual size_t position() const = 0;
+        };
+
+        /**
+         * @brief Concrete model that adapts a specific stream type to the interface.
+         *
+         * @tparam TStream The concrete stream type
+         */
+        template <typename TStream>
+        class stream_model : public stream_concept
+        {
+        public:
+
+            stream_model(TStream& stream);
+
+            [[nodiscard]] size_t read(std::span<std::uint8_t> span) final;
+
+            [[nodiscard]] size_t position() const final;
+
+            TStream& get_stream();
+
+        private:
+
+            TStream* m_stream;
+            size_t m_position = 0;
+        };
+
+        std::unique_ptr<stream_concept> m_impl;
+    };
+
+    // Implementation
+
+    template <readable_stream TStream>
+    any_input_stream::any_input_stream(TStream& stream)
+        : m_impl(std::make_unique<stream_model<TStream>>(stream))
+    {
+    }
+
+    template <typename TStream>
+    TStream& any_input_stream::get()
+    {
+        auto* model = dynamic_cast<stream_model<TStream>*>(m_impl.get());
+        if (!model)
+        {
+            throw std::bad_cast();
+        }
+        return model->get_stream();
+    }
+
+    // stream_model implementation
+
+    template <typename TStream>
+    any_input_stream::stream_model<TStream>::stream_model(TStream& stream)
+        : m_stream(&stream)
+    {
+    }
+
+    template <typename TStream>
+    size_t any_input_stream::stream_model<TStream>::read(std::span<std::uint8_t> span)
+    {
+        size_t total = 0;
+        while (total < span.size())
+        {
+            char* destination = reinterpret_cast<char*>(span.data() + total);
+            const auto count = static_cast<std::streamsize>(span.size() - total);
+            std::streamsize read_count = 0;
+            if constexpr (requires(TStream& t) {
+                              { t.gcount() } -> std::convertible_to<std::streamsize>;
+                          })
+            {
+                m_stream->read(destination, count);
+                if constexpr (requires(const TStream& t) {
+                                  { t.bad() } -> std::convertible_to<bool>;
+                              })
+                {
+                    if (m_stream->bad())
+                    {
+                        throw std::runtime_error("Failed to read from the input stream.");
+                    }
+                }
+                read_count = m_stream->gcount();
+            }
+            else
+            {
+                read_count = static_cast<std::streamsize>(m_stream->read(destination, count));
+                if (read_count < 0)
+                {
+                    throw std::runtime_error("Failed to read from the input stream.");
+                }
+            }
+            if (read_count == 0)
+            {
+                break;
+            }
+            total += static_cast<size_t>(read_count);
+        }
+        m_position += total;
+        return total;
+    }
+
+    template <typename TStream>
+    size_t any_input_stream::stream_model<TStream>::position() const
+    {
+        return m_position;
+    }
+
+    template <typename TStream>
+    TStream& any_input_stream::stream_model<TStream>::get_stream()
+    {
+        return *m_stream;
+    }
+}  // namespace sparrow_ipc
@@ -1,6 +1,7 @@
 #pragma once
 #include <concepts>
 #include <cstdint>
+#include <memory>
 #include <span>
 #include <variant>
 #include <vector>
@@ -27,9 +28,17 @@ namespace sparrow_ipc
         [[nodiscard]] SPARROW_IPC_API const void** buffers_ptrs() noexcept;
         [[nodiscard]] SPARROW_IPC_API std::size_t n_buffers() const noexcept;
 
+        /**
+         * @brief Keeps alive the memory the non-owned buffers point into.
+         *
+         * @param owner The object owning the memory referenced by the span buffers
+         */
+        SPARROW_IPC_API void set_owner(std::shared_ptr<const void> owner) noexcept;
+
     private:
 
         std::vector<optionally_owned_buffer> m_buffers;
         std::vector<const void*> m_buffer_pointers;
+        std::shared_ptr<const void> m_owner;
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <unordered_set>
 
@@ -68,4 +69,25 @@ namespace sparrow_ipc
         fill_non_owning_arrow_schema(schema, format, name, metadata, flags, children_count, children, dictionary);
         return schema;
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief Creates an ArrowSchema borrowing its strings from an immutable, shared object.
+     *
+     * Contrary to make_non_owning_arrow_schema, neither the format nor the metadata is copied,
+     * and no flag set is built: schemas describing the same field in many arrays can be created
+     * at the cost of a single allocation.
+     *
+     * @param format The format string, pointing into `owner`
+     * @param name The name, pointing into `owner`, or nullptr
+     * @param metadata The serialized metadata, pointing into `owner`, or nullptr
+     * @param flags The ArrowSchema flags
+     * @param owner The object owning the strings, kept alive until the schema is released
+     */
+    [[nodiscard]] SPARROW_IPC_API ArrowSchema make_shared_arrow_schema(
+        const char* format,
+        const char* name,
+        const char* metadata,
+        int64_t flags,
+        std::shared_ptr<const void> owner
+    );
+}
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -19,6 +20,30 @@ namespace sparrow_ipc
             std::optional<std::string> metadata
         );
 
+        /**
+         * @brief Borrows all the strings of the schema from an immutable object.
+         *
+         * Nothing is copied: the strings are shared by all the schemas created from the
+         * same object, which stays alive until the last of them is released.
+         *
+         * @param format The format string, pointing into `owner`
+         * @param name The name, pointing into `owner`, or nullptr
+         * @param metadata The serialized metadata, pointing into `owner`, or nullptr
+         * @param owner The object owning the strings
+         */
+        SPARROW_IPC_API non_owning_arrow_schema_private_data(
+            const char* format,
+            const char* name,
+            const char* metadata,
+            std::shared_ptr<const void> owner
+        );
+
+        // The string pointers may point into the object itself: it can be neither copied nor moved
+        non_owning_arrow_schema_private_data(const non_owning_arrow_schema_private_data&) = delete;
+        non_owning_arrow_schema_private_data& operator=(const non_owning_arrow_schema_private_data&) = delete;
+        non_owning_arrow_schema_private_data(non_owning_arrow_schema_private_data&&) = delete;
+        non_owning_arrow_schema_private_data& operator=(non_owning_arrow_schema_private_data&&) = delete;
+
         [[nodiscard]] SPARROW_IPC_API const char* format_ptr() const noexcept;
         [[nodiscard]] SPARROW_IPC_API const char* name_ptr() const noexcept;
         [[nodiscard]] SPARROW_IPC_API const char* metadata_ptr() const noexcept;
@@ -26,7 +51,10 @@ namespace sparrow_ipc
     private:
 
         std::string m_format;
+        const char* m_format_ptr;
         const char* m_name;
         std::optional<std::string> m_metadata;
+        const char* m_metadata_ptr;
+        std::shared_ptr<const void> m_owner;
     };
 }
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "sparrow_ipc/config/config.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief Recycling pool of memory blocks, sorted in power-of-two size classes.
+     *
+     * The buffers of the decompressed arrays and of the messages read from a stream are
+     * allocated from a pool. When a decoded record batch is released, its buffers go back
+     * to the pool instead of the system allocator, so that decoding a stream of batches of
+     * the same shape stops allocating after the first batches.
+     *
+     * A request is rounded up to the next power of two, from 64 bytes to 64 MiB; larger
+     * requests bypass the pool. The blocks are aligned on 64 bytes. The pool keeps at most
+     * `max_cached_bytes()` bytes of idle blocks and frees the blocks released beyond.
+     *
+     * The pool is thread-safe.
+     */
+    class SPARROW_IPC_API buffer_pool
+    {
+    public:
+
+        static constexpr size_t alignment = 64;
+        static constexpr size_t min_block_size = 64;
+        static constexpr size_t max_block_size = size_t{1} << 26;
+        static constexpr size_t default_max_cached_bytes = size_t{256} << 20;
+
+        /**
+         * @brief Counters of the activity of a pool.
+         */
+        struct statistics
+        {
+            // Number of blocks allocated from the system
+            size_t allocated_blocks = 0;
+            // Number of requests served with an idle block of the pool
+            size_t reused_blocks = 0;
+            // Total size of the idle blocks kept by the pool
+            size_t cached_bytes = 0;
+        };
+
+        explicit buffer_pool(size_t limit = default_max_cached_bytes);
+        ~buffer_pool();
+
+        buffer_pool(const buffer_pool&) = delete;
+        buffer_pool& operator=(const buffer_pool&) = delete;
+
+        /**
+         * @brief Gets the pool used by the compression and deserialization paths.
+         */
+        [[nodiscard]] static const std::shared_ptr<buffer_pool>& default_pool();
+
+        /**
+         * @brief Allocates a block of at least `size` bytes, reusing an idle block if possible.
+         *
+         * @throws std::bad_alloc If the memory cannot be allocated
+         */
+        [[nodiscard]] void* allocate(size_t size);
+
+        /**
+         * @brief Returns a block to the pool.
+         *
+         * @param pointer A block allocated by this pool
+         * @param size The size given to allocate
+         */
+        void deallocate(void* pointer, size_t size) noexcept;
+
+        /**
+         * @brief Frees all the idle blocks.
+         */
+        void release_cached() noexcept;
+
+        [[nodiscard]] size_t max_cached_bytes() const noexcept;
+
+        /**
+         * @brief Sets the maximum size of the idle blocks kept, freeing the blocks beyond it.
+         */
+        void set_max_cached_bytes(size_t limit) noexcept;
+
+        [[nodiscard]] statistics stats() const noexcept;
+
+    private:
+
+        static constexpr size_t size_class_count = 21;
+
+        void trim(size_t limit) noexcept;
+
+        mutable std::mutex m_mutex;
+        std::array<std::vector<void*>, size_class_count> m_idle_blocks;
+        size_t m_max_cached_bytes;
+        statistics m_stats;
+    };
+
+    /**
+     * @brief Standard allocator drawing its memory from a buffer_pool.
+     *
+     * Used to allocate `sparrow::buffer` and `std::vector` storage from the pool. The allocator
+     * shares the ownership of its pool, so that the buffers can outlive any other reference to it.
+     */
+    template <class T>
+    class pool_allocator
+    {
+    public:
+
+        using value_type = T;
+
+        pool_allocator()
+            : m_pool(buffer_pool::default_pool())
+        {
+        }
+
+        explicit pool_allocator(std::shared_ptr<buffer_pool> source) noexcept
+            : m_pool(std::move(source))
+        {
+        }
+
+        template <class U>
+        pool_allocator(const pool_allocator<U>& other) noexcept
+            : m_pool(other.pool())
+        {
+        }
+
+        [[nodiscard]] T* allocate(size_t n)
+        {
+            if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T*>(m_pool->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* pointer, size_t n) noexcept
+        {
+            m_pool->deallocate(pointer, n * sizeof(T));
+        }
+
+        [[nodiscard]] const std::shared_ptr<buffer_pool>& pool() const noexcept
+        {
+            return m_pool;
+        }
+
+        template <class U>
+        [[nodiscard]] bool operator==(const pool_allocator<U>& other) const noexcept
+        {
+            return m_pool == other.pool();
+        }
+
+    private:
+
+        std::shared_ptr<buffer_pool> m_pool;
+    };
+
+    /**
+     * @brief Byte vector allocated from the default buffer pool.
+     */
+    using pooled_byte_vector = std::vector<uint8_t, pool_allocator<uint8_t>>;
+}
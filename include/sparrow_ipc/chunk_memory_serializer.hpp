@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bit>
 #include <numeric>
 #include <optional>
 #include <ranges>
@@ -12,6 +13,7 @@
 #include "sparrow_ipc/chunk_memory_output_stream.hpp"
 #include "sparrow_ipc/compression.hpp"
 #include "sparrow_ipc/config/config.hpp"
+#include "sparrow_ipc/dictionary_tracker.hpp"
 #include "sparrow_ipc/memory_output_stream.hpp"
 #include "sparrow_ipc/serialize.hpp"
 #include "sparrow_ipc/serialize_utils.hpp"
@@ -30,6 +32,8 @@ namespace sparrow_ipc
      * - The schema is written once as the first chunk when the first record batch is processed
      * - All subsequent record batches must have the same schema
      * - Each record batch is serialized into its own independent memory chunk
+     * - The DictionaryBatch messages a record batch needs are written before it, each in its own
+     *   chunk; a dictionary extending the previous one is written as a delta
      *
      * @note Once end() is called, no further record batches can be written to this serializer.
      */
@@ -42,8 +46,14 @@ namespace sparrow_ipc
          *
          * @param stream Reference to a chunked memory output stream that will receive the serialized chunks
          * @param compression Optional: The compression type to use for record batch bodies.
+         * @param byte_order The byte order of the buffers written in the chunks. Buffers are converted
+         *                   when it is not the native one.
          */
-        chunk_serializer(chunked_memory_output_stream<std::vector<std::vector<uint8_t>>>& stream, std::optional<CompressionType> compression = std::nullopt);
+        chunk_serializer(
+            chunked_memory_output_stream<std::vector<std::vector<uint8_t>>>& stream,
+            std::optional<CompressionType> compression = std::nullopt,
+            std::endian byte_order = std::endian::native
+        );
 
         /**
          * @brief Writes a single record batch to the chunked stream.
@@ -127,9 +137,11 @@ namespace sparrow_ipc
 
         bool m_schema_received{false};
         std::vector<sparrow::data_type> m_dtypes;
+        dictionary_tracker m_dictionaries;
         chunked_memory_output_stream<std::vector<std::vector<uint8_t>>>* m_pstream;
         bool m_ended{false};
         std::optional<CompressionType> m_compression;
+        std::endian m_byte_order;
     };
 
     // Implementation
@@ -152,7 +164,7 @@ namespace sparrow_ipc
             std::vector<uint8_t> schema_buffer;
             memory_output_stream stream(schema_buffer);
             any_output_stream astream(stream);
-            serialize_schema_message(*record_batches.begin(), astream);
+            serialize_schema_message(*record_batches.begin(), astream, m_byte_order);
             m_pstream->write(std::move(schema_buffer));
         }
 
@@ -162,11 +174,19 @@ namespace sparrow_ipc
             {
                 throw std::invalid_argument("Record batch schema does not match serializer schema");
             }
+            for (const auto& dictionary : m_dictionaries.update(rb))
+            {
+                std::vector<uint8_t> dictionary_buffer;
+                memory_output_stream dictionary_stream(dictionary_buffer);
+                any_output_stream dictionary_astream(dictionary_stream);
+                serialize_dictionary_batch(dictionary, dictionary_astream, m_compression, m_byte_order);
+                m_pstream->write(std::move(dictionary_buffer));
+            }
             std::vector<uint8_t> buffer;
             memory_output_stream stream(buffer);
             any_output_stream astream(stream);
             CompressionCache compressed_buffers_cache;
-            serialize_record_batch(rb, astream, m_compression, compressed_buffers_cache);
+            serialize_record_batch(rb, astream, m_compression, compressed_buffers_cache, m_byte_order);
             m_pstream->write(std::move(buffer));
         }
     }
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "sparrow_ipc/any_output_stream.hpp"
+#include "sparrow_ipc/config/config.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief Options of the concatenation of IPC streams and files.
+     */
+    struct concatenate_options
+    {
+        /**
+         * Record batches with fewer rows are merged with the following ones into a single
+         * RecordBatch message, until the merged batch has at least this number of rows.
+         * 0 disables the merging: all the messages are copied as is.
+         *
+         * Only the record batches of schemas whose fields are all primitive, boolean, binary or
+         * string ones, neither nested nor dictionary-encoded, and in the byte order of the host are
+         * merged; the record batches of other schemas are always copied. A merged batch is
+         * compressed with the codec of its first batch.
+         */
+        int64_t min_batch_rows = 0;
+
+        /**
+         * Whether the FlatBuffer metadata of each message is verified, which is required for
+         * untrusted input.
+         */
+        bool verify = true;
+    };
+
+    /**
+     * @brief Concatenates IPC streams or files with the same schema into a single stream.
+     *
+     * The messages of the inputs are indexed from their metadata, and their schemas are checked
+     * once against the one of the first input. The Schema message of the first input is then
+     * written, followed by the dictionary and record batches of every input, copied byte for byte
+     * without being decoded, and by the end-of-stream marker. Only the record batches merged as
+     * requested by `options.min_batch_rows` are rewritten.
+     *
+     * @param inputs The inputs, each an IPC stream or an IPC file
+     * @param output The output stream the concatenated stream is written to
+     * @param options The concatenation options
+     *
+     * @throws std::invalid_argument If there is no input, or if the schema of an input differs
+     *         from the one of the first input
+     * @throws std::runtime_error If an input is invalid or truncated, or holds other messages than
+     *         dictionary and record batches after its schema
+     */
+    SPARROW_IPC_API void concatenate_streams(
+        std::span<const std::span<const uint8_t>> inputs,
+        any_output_stream& output,
+        const concatenate_options& options = {}
+    );
+
+    /**
+     * @brief Concatenates IPC streams or files with the same schema into a single file.
+     *
+     * The messages are written as by concatenate_streams, between the leading magic bytes and a
+     * fresh footer whose blocks are computed while the messages are written. Since the file format
+     * does not allow replacing a dictionary, the dictionary batches of the inputs after the first
+     * one must be identical to the ones of the first input: they are then skipped.
+     *
+     * @param inputs The inputs, each an IPC stream or an IPC file
+     * @param output The output stream the file is written to, from its start
+     * @param options The concatenation options
+     *
+     * @throws std::invalid_argument If there is no input, if the schema of an input differs from
+     *         the one of the first input, or if its dictionaries differ from the ones of the first
+     *         input
+     * @throws std::runtime_error If an input is invalid or truncated, or holds other messages than
+     *         dictionary and record batches after its schema
+     */
+    SPARROW_IPC_API void concatenate_files(
+        std::span<const std::span<const uint8_t>> inputs,
+        any_output_stream& output,
+        const concatenate_options& options = {}
+    );
+}
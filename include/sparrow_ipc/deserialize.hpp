@@ -1,21 +1,129 @@
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <span>
+#include <string>
 #include <vector>
 
 #include <sparrow/record_batch.hpp>
+#include <sparrow/utils/metadata.hpp>
 
+#include "Message_generated.h"
 #include "sparrow_ipc/config/config.hpp"
+#include "sparrow_ipc/encapsulated_message.hpp"
+#include "sparrow_ipc/read_options.hpp"
 
 namespace sparrow_ipc
 {
+    namespace details
+    {
+        struct decoder_plan;
+        struct dictionary_set;
+    }
+
+    /**
+     * @brief Field information extracted once from a Schema message.
+     *
+     * A decoded_schema is built when a Schema message is encountered and reused to decode
+     * every subsequent RecordBatch message of the same stream. It describes the decoded
+     * fields only: when a projection is requested, `field_names` and `fields_metadata`
+     * hold the selected fields, in the requested order.
+     *
+     * The type dispatch of the decoded fields is resolved once, into a decoder plan that
+     * each RecordBatch message then executes. The dictionaries of the dictionary-encoded
+     * fields are updated by decode_dictionary_batch as the DictionaryBatch messages of the
+     * stream are read.
+     *
+     * @note `schema` points into the Schema message, which must outlive this object.
+     */
+    struct decoded_schema
+    {
+        const org::apache::arrow::flatbuf::Schema* schema = nullptr;
+        std::vector<std::string> field_names;
+        std::vector<std::optional<std::vector<sparrow::metadata_pair>>> fields_metadata;
+        // Index in `schema` of each decoded field
+        std::vector<size_t> field_indices;
+        // Checks applied to the RecordBatch messages decoded with this schema
+        validation_level validation = validation_level::metadata;
+        // Number of threads decompressing the buffers of a RecordBatch, see read_options
+        size_t decompression_threads = 1;
+        // Whether the run-end encoded fields are expanded, see read_options
+        bool expand_run_end_encoded = false;
+        std::shared_ptr<const details::decoder_plan> plan;
+        // Dictionaries read so far, shared with the arrays decoded with them
+        std::shared_ptr<const details::dictionary_set> dictionaries;
+    };
+
+    /**
+     * @brief Extracts the field names and metadata of a Schema message.
+     *
+     * @param schema The FlatBuffer Schema of the stream
+     * @param options The read options; the field projection, the validation level and the
+     *                number of decompression threads are used
+     * @return decoded_schema The information needed to decode the RecordBatch messages of the stream
+     *
+     * @throws std::invalid_argument If the projection refers to an unknown field, selects a field
+     *         twice, or sets both `field_indices` and `field_names`
+     */
+    [[nodiscard]] SPARROW_IPC_API decoded_schema
+    decode_schema(const org::apache::arrow::flatbuf::Schema& schema, const read_options& options = {});
+
+    /**
+     * @brief Reads a DictionaryBatch message into the dictionaries of a schema.
+     *
+     * The values of the batch replace the dictionary of their id or, for a delta batch, are
+     * appended to it. The record batches decoded before keep the dictionaries they were decoded
+     * with: their arrays share the ownership of them. Batches of dictionaries that no decoded
+     * field uses are skipped.
+     *
+     * @param message The encapsulated DictionaryBatch message
+     * @param schema The schema decoded from the Schema message of the stream, whose dictionaries
+     *               are updated
+     * @param body_owner Optional: an object keeping the memory of `message` alive. When given, the
+     *                   dictionary holds a reference to it. When empty, the dictionary borrows the
+     *                   message memory.
+     *
+     * @throws std::runtime_error If the message is not a DictionaryBatch message, does not match
+     *         the type of its dictionary, fails the checks of the validation level of `schema`, or
+     *         is a delta for a dictionary that has not been read or whose values are nested
+     */
+    SPARROW_IPC_API void decode_dictionary_batch(
+        const encapsulated_message& message,
+        decoded_schema& schema,
+        std::shared_ptr<const void> body_owner = nullptr
+    );
+
+    /**
+     * @brief Decodes a RecordBatch message into a record batch.
+     *
+     * @param message The encapsulated RecordBatch message
+     * @param schema The schema decoded from the Schema message of the stream
+     * @param body_owner Optional: an object keeping the memory of `message` alive. When given, the
+     *                   decoded arrays hold a reference to it, so that the record batch can outlive
+     *                   the caller's buffer. When empty, the record batch borrows the message memory.
+     *
+     * @return sparrow::record_batch The decoded record batch
+     *
+     * @throws std::runtime_error If the message is not a RecordBatch message, contains unsupported types,
+     *         fails the checks of the validation level of `schema`, or uses a dictionary that has not
+     *         been read
+     *
+     * @note The FlatBuffer metadata of `message` is expected to have been verified by the caller,
+     *       when the validation level requires it, before its header type was read.
+     */
+    [[nodiscard]] SPARROW_IPC_API sparrow::record_batch decode_record_batch(
+        const encapsulated_message& message,
+        const decoded_schema& schema,
+        std::shared_ptr<const void> body_owner = nullptr
+    );
+
     /**
      * @brief Deserializes an Arrow IPC stream from binary data into a vector of record batches.
      *
      * This function processes an Arrow IPC stream format, extracting schema information
      * and record batch data. It handles encapsulated messages sequentially, first expecting
-     * a Schema message followed by one or more RecordBatch messages.
+     * a Schema message followed by DictionaryBatch and RecordBatch messages.
      *
      * @param data A span of bytes containing the serialized Arrow IPC stream data
      *
@@ -24,11 +132,72 @@ namespace sparrow_ipc
      * @throws std::runtime_error If:
      *         - A RecordBatch message is encountered before a Schema message
      *         - A RecordBatch message header is missing or invalid
-     *         - Unsupported message types are encountered (Tensor, DictionaryBatch, SparseTensor)
+     *         - Unsupported message types are encountered (Tensor, SparseTensor)
+     *         - A DictionaryBatch message is invalid, or a RecordBatch uses a dictionary not read before it
      *         - An unknown message header type is encountered
      *
      * @note The function processes messages until an end-of-stream marker is detected
      */
     [[nodiscard]] SPARROW_IPC_API std::vector<sparrow::record_batch>
     deserialize_stream(std::span<const uint8_t> data);
+
+    /**
+     * @brief Deserializes an Arrow IPC stream with the given read options.
+     *
+     * When `options.num_threads` is not 1, the message boundaries of the stream are indexed first
+     * by reading the message headers only, then the record batches are decoded concurrently.
+     * When a projection is set, only the selected fields are decoded. Unless the validation level
+     * is `none`, the metadata of every message is verified before it is read.
+     *
+     * @param data A span of bytes containing the serialized Arrow IPC stream data
+     * @param options The options controlling the decoding
+     *
+     * @return std::vector<sparrow::record_batch> The deserialized record batches, in stream order
+     *
+     * @throws std::runtime_error In the same cases as deserialize_stream(std::span<const uint8_t>)
+     * @throws std::invalid_argument If the projection does not match the schema
+     */
+    [[nodiscard]] SPARROW_IPC_API std::vector<sparrow::record_batch>
+    deserialize_stream(std::span<const uint8_t> data, const read_options& options);
+
+    /**
+     * @brief Deserializes an Arrow IPC stream whose memory is kept alive by an owner.
+     *
+     * The uncompressed buffers of the record batches point into `data` without being copied,
+     * and the decoded arrays share the ownership of `owner`: the record batches remain valid
+     * after the caller releases its own references to the input.
+     *
+     * @param data A span of bytes containing the serialized Arrow IPC stream data
+     * @param owner An object keeping `data` alive, for instance a std::shared_ptr to the buffer
+     *              holding it or to a memory_mapped_file
+     * @param options The options controlling the decoding. It has no default, so that
+     *                `deserialize_stream(data, {})` selects the overload without owner.
+     *
+     * @return std::vector<sparrow::record_batch> The deserialized record batches, in stream order
+     *
+     * @throws std::runtime_error In the same cases as deserialize_stream(std::span<const uint8_t>)
+     * @throws std::invalid_argument If the projection does not match the schema
+     */
+    [[nodiscard]] SPARROW_IPC_API std::vector<sparrow::record_batch> deserialize_stream(
+        std::span<const uint8_t> data,
+        std::shared_ptr<const void> owner,
+        const read_options& options
+    );
+
+    /**
+     * @brief Deserializes an Arrow IPC stream, taking the ownership of its memory.
+     *
+     * The buffer is moved into a shared owner held by the decoded arrays, so that the record
+     * batches reference it without any copy and can outlive the caller's scope.
+     *
+     * @param data The serialized Arrow IPC stream data
+     * @param options The options controlling the decoding
+     *
+     * @return std::vector<sparrow::record_batch> The deserialized record batches, in stream order
+     *
+     * @throws std::runtime_error In the same cases as deserialize_stream(std::span<const uint8_t>)
+     * @throws std::invalid_argument If the projection does not match the schema
+     */
+    [[nodiscard]] SPARROW_IPC_API std::vector<sparrow::record_batch>
+    deserialize_stream(std::vector<uint8_t>&& data, const read_options& options = {});
 }
@@ -4,6 +4,7 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 
@@ -16,6 +17,90 @@
 
 namespace sparrow_ipc::detail
 {
+    /**
+     * @brief Deserializes the buffers of an array with simple layout, described by an existing schema.
+     *
+     * @tparam ArrayType The array type template (e.g., sparrow::primitive_array)
+     * @tparam T The element type
+     *
+     * @param record_batch The FlatBuffer RecordBatch containing metadata
+     * @param body The raw buffer data
+     * @param schema The schema of the array, whose ownership is transferred to the returned array
+     * @param buffer_index The current buffer index (incremented by this function)
+     * @param node Optional: the FieldNode of the array, giving its length and null count
+     * @param validation The checks applied to the buffers
+     *
+     * @return The deserialized array of type ArrayType<T>
+     */
+    template <template<typename...> class ArrayType, typename T>
+    [[nodiscard]] ArrayType<T> deserialize_non_owning_simple_array(
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        ArrowSchema&& schema,
+        size_t& buffer_index,
+        const org::apache::arrow::flatbuf::FieldNode* node = nullptr,
+        validation_level validation = validation_level::full
+    )
+    {
+        const auto compression = record_batch.compression();
+        const int64_t length = utils::get_length(record_batch, node);
+        std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+
+        auto validity_buffer_span = utils::get_buffer(record_batch, body, buffer_index);
+        auto data_buffer_span = utils::get_buffer(record_batch, body, buffer_index);
+
+        if (compression)
+        {
+            buffers.push_back(utils::get_decompressed_buffer(validity_buffer_span, compression));
+            buffers.push_back(utils::get_decompressed_buffer(data_buffer_span, compression));
+        }
+        else
+        {
+            buffers.emplace_back(validity_buffer_span);
+            buffers.emplace_back(data_buffer_span);
+        }
+
+        if (validation != validation_level::none)
+        {
+            // The size of the values is only known for arithmetic types
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                utils::check_buffer_size(
+                    utils::buffer_view(buffers[1]),
+                    (static_cast<size_t>(length) + 7) / 8,
+                    "values"
+                );
+            }
+            else if constexpr (std::is_arithmetic_v<T>)
+            {
+                utils::check_buffer_size(
+                    utils::buffer_view(buffers[1]),
+                    static_cast<size_t>(length) * sizeof(T),
+                    "values"
+                );
+            }
+        }
+        const int64_t null_count = utils::get_null_count(
+            utils::buffer_view(buffers[0]),
+            length,
+            node,
+            validation
+        );
+
+        ArrowArray array = make_arrow_array<arrow_array_private_data>(
+            length,
+            null_count,
+            0,
+            0,
+            nullptr,
+            nullptr,
+            std::move(buffers)
+        );
+
+        sparrow::arrow_proxy ap{std::move(array), std::move(schema)};
+        return ArrayType<T>{std::move(ap)};
+    }
+
     /**
      * @brief Generic implementation for deserializing non-owning arrays with simple layout.
      *
@@ -31,6 +116,7 @@ namespace sparrow_ipc::detail
      * @param metadata Optional metadata pairs
      * @param nullable Whether the array is nullable
      * @param buffer_index The current buffer index (incremented by this function)
+     * @param format_override Optional: the format of the array, when it depends on type parameters
      *
      * @return The deserialized array of type ArrayType<T>
      */
@@ -42,7 +128,7 @@ namespace sparrow_ipc::detail
         const std::optional<std::vector<sparrow::metadata_pair>>& metadata,
         bool nullable,
         size_t& buffer_index,
-        std::optional<std::string> format_override = std::nullopt
+        std::optional<std::string_view> format_override = std::nullopt
     )
     {
         const std::string_view format = format_override.has_value()
@@ -66,37 +152,6 @@ namespace sparrow_ipc::detail
             nullptr
         );
 
-        const auto compression = record_batch.compression();
-        std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
-
-        auto validity_buffer_span = utils::get_buffer(record_batch, body, buffer_index);
-        auto data_buffer_span = utils::get_buffer(record_batch, body, buffer_index);
-
-        if (compression)
-        {
-            buffers.push_back(utils::get_decompressed_buffer(validity_buffer_span, compression));
-            buffers.push_back(utils::get_decompressed_buffer(data_buffer_span, compression));
-        }
-        else
-        {
-            buffers.emplace_back(validity_buffer_span);
-            buffers.emplace_back(data_buffer_span);
-        }
-
-        // TODO bitmap_ptr is not used anymore... Leave it for now, and remove later if no need confirmed
-        const auto [bitmap_ptr, null_count] = utils::get_bitmap_pointer_and_null_count(validity_buffer_span, record_batch.length());
-
-        ArrowArray array = make_arrow_array<arrow_array_private_data>(
-            record_batch.length(),
-            null_count,
-            0,
-            0,
-            nullptr,
-            nullptr,
-            std::move(buffers)
-        );
-
-        sparrow::arrow_proxy ap{std::move(array), std::move(schema)};
-        return ArrayType<T>{std::move(ap)};
+        return deserialize_non_owning_simple_array<ArrayType, T>(record_batch, body, std::move(schema), buffer_index);
     }
 }
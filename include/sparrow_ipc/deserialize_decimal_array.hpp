@@ -9,48 +9,31 @@
 #include "Message_generated.h"
 #include "sparrow_ipc/arrow_interface/arrow_array.hpp"
 #include "sparrow_ipc/arrow_interface/arrow_schema.hpp"
+#include "sparrow_ipc/buffer_pool.hpp"
 #include "sparrow_ipc/deserialize_utils.hpp"
 
 namespace sparrow_ipc
 {
+    /**
+     * @brief Deserializes the buffers of a decimal array, described by an existing schema.
+     *
+     * @param schema The schema of the array, whose format gives the precision and scale. Its
+     *               ownership is transferred to the returned array.
+     * @param node Optional: the FieldNode of the array, giving its length and null count
+     * @param validation The checks applied to the buffers
+     */
     template <sparrow::decimal_type T>
     [[nodiscard]] sparrow::decimal_array<T> deserialize_non_owning_decimal(
         const org::apache::arrow::flatbuf::RecordBatch& record_batch,
         std::span<const uint8_t> body,
-        std::string_view name,
-        const std::optional<std::vector<sparrow::metadata_pair>>& metadata,
-        bool nullable,
+        ArrowSchema&& schema,
         size_t& buffer_index,
-        int32_t scale,
-        int32_t precision
+        const org::apache::arrow::flatbuf::FieldNode* node = nullptr,
+        validation_level validation = validation_level::full
     )
     {
-        constexpr std::size_t sizeof_decimal = sizeof(typename T::integer_type);
-        std::string format_str = "d:" + std::to_string(precision) + "," + std::to_string(scale);
-        if constexpr (sizeof_decimal != 16)  // We don't need to specify the size for 128-bit
-                                             // decimals
-        {
-            format_str += "," + std::to_string(sizeof_decimal * 8);
-        }
-
-        // Set up flags based on nullable
-        std::optional<std::unordered_set<sparrow::ArrowFlag>> flags;
-        if (nullable)
-        {
-            flags = std::unordered_set<sparrow::ArrowFlag>{sparrow::ArrowFlag::NULLABLE};
-        }
-
-        ArrowSchema schema = make_non_owning_arrow_schema(
-            format_str,
-            name.data(),
-            metadata,
-            flags,
-            0,
-            nullptr,
-            nullptr
-        );
-
         const auto compression = record_batch.compression();
+        const int64_t length = utils::get_length(record_batch, node);
         std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
 
         auto validity_buffer_span = utils::get_buffer(record_batch, body, buffer_index);
@@ -74,7 +57,7 @@ namespace sparrow_ipc
                 else
                 {
                     // It's a span, copy to ensure alignment
-                    sparrow::buffer<std::uint8_t> aligned_buffer(arg.begin(), arg.end(), sparrow::buffer<std::uint8_t>::default_allocator());
+                    sparrow::buffer<std::uint8_t> aligned_buffer(arg.begin(), arg.end(), pool_allocator<std::uint8_t>());
                     buffers.emplace_back(std::move(aligned_buffer));
                 }
             }, std::move(decompressed_data));
@@ -82,17 +65,27 @@ namespace sparrow_ipc
         else
         {
             buffers.emplace_back(validity_buffer_span);
-            sparrow::buffer<std::uint8_t> data_buffer_copy(data_buffer_span.begin(), data_buffer_span.end(), sparrow::buffer<std::uint8_t>::default_allocator());
+            sparrow::buffer<std::uint8_t> data_buffer_copy(data_buffer_span.begin(), data_buffer_span.end(), pool_allocator<std::uint8_t>());
             buffers.emplace_back(std::move(data_buffer_copy));
         }
 
-        const auto [bitmap_ptr, null_count] = utils::get_bitmap_pointer_and_null_count(
-            validity_buffer_span,
-            record_batch.length()
+        if (validation != validation_level::none)
+        {
+            utils::check_buffer_size(
+                utils::buffer_view(buffers[1]),
+                static_cast<size_t>(length) * sizeof(typename T::integer_type),
+                "values"
+            );
+        }
+        const int64_t null_count = utils::get_null_count(
+            utils::buffer_view(buffers[0]),
+            length,
+            node,
+            validation
         );
 
         ArrowArray array = make_arrow_array<arrow_array_private_data>(
-            record_batch.length(),
+            length,
             null_count,
             0,
             0,
@@ -103,4 +96,44 @@ namespace sparrow_ipc
         sparrow::arrow_proxy ap{std::move(array), std::move(schema)};
         return sparrow::decimal_array<T>(std::move(ap));
     }
+
+    template <sparrow::decimal_type T>
+    [[nodiscard]] sparrow::decimal_array<T> deserialize_non_owning_decimal(
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        std::string_view name,
+        const std::optional<std::vector<sparrow::metadata_pair>>& metadata,
+        bool nullable,
+        size_t& buffer_index,
+        int32_t scale,
+        int32_t precision
+    )
+    {
+        constexpr std::size_t sizeof_decimal = sizeof(typename T::integer_type);
+        std::string format_str = "d:" + std::to_string(precision) + "," + std::to_string(scale);
+        if constexpr (sizeof_decimal != 16)  // We don't need to specify the size for 128-bit
+                                             // decimals
+        {
+            format_str += "," + std::to_string(sizeof_decimal * 8);
+        }
+
+        // Set up flags based on nullable
+        std::optional<std::unordered_set<sparrow::ArrowFlag>> flags;
+        if (nullable)
+        {
+            flags = std::unordered_set<sparrow::ArrowFlag>{sparrow::ArrowFlag::NULLABLE};
+        }
+
+        ArrowSchema schema = make_non_owning_arrow_schema(
+            format_str,
+            name.data(),
+            metadata,
+            flags,
+            0,
+            nullptr,
+            nullptr
+        );
+
+        return deserialize_non_owning_decimal<T>(record_batch, body, std::move(schema), buffer_index);
+    }
 }
\ No newline at end of file
@@ -10,6 +10,23 @@
 
 namespace sparrow_ipc
 {
+    /**
+     * @brief Deserializes the buffers of a fixed-width binary array, described by an existing schema.
+     *
+     * @param schema The schema of the array, whose format gives the byte width. Its ownership
+     *               is transferred to the returned array.
+     * @param node Optional: the FieldNode of the array, giving its length and null count
+     * @param validation The checks applied to the buffers
+     */
+    [[nodiscard]] sparrow::fixed_width_binary_array deserialize_non_owning_fixedwidthbinary(
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        ArrowSchema&& schema,
+        size_t& buffer_index,
+        const org::apache::arrow::flatbuf::FieldNode* node = nullptr,
+        validation_level validation = validation_level::full
+    );
+
     [[nodiscard]] sparrow::fixed_width_binary_array deserialize_non_owning_fixedwidthbinary(
         const org::apache::arrow::flatbuf::RecordBatch& record_batch,
         std::span<const uint8_t> body,
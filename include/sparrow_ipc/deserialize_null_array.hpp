@@ -12,4 +12,16 @@ namespace sparrow_ipc
         bool nullable,
         size_t& buffer_index
     );
+
+    /**
+     * @brief Builds a null array described by an existing schema. A null array has no buffer.
+     *
+     * @param schema The schema of the array, whose ownership is transferred to the returned array
+     * @param node Optional: the FieldNode of the array, giving its length
+     */
+    [[nodiscard]] sparrow::null_array deserialize_non_owning_null(
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        ArrowSchema&& schema,
+        const org::apache::arrow::flatbuf::FieldNode* node = nullptr
+    );
 }
\ No newline at end of file
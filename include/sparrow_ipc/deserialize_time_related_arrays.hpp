@@ -49,7 +49,7 @@ namespace sparrow_ipc
         const std::string& timezone
     )
     {
-        std::string format = std::string(data_type_to_format(
+        const std::string format = std::string(data_type_to_format(
             sparrow::detail::get_data_type_from_array<sparrow::timestamp_array<T>>::get()
         )) + timezone;
 
@@ -60,7 +60,7 @@ namespace sparrow_ipc
             metadata,
             nullable,
             buffer_index,
-            std::move(format)
+            format
         );
     }
 
@@ -1,12 +1,20 @@
 #pragma once
 
+#include <concepts>
+#include <cstdint>
 #include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <utility>
+#include <variant>
 
 #include <sparrow/buffer/buffer.hpp>
 #include <sparrow/buffer/dynamic_bitset/dynamic_bitset_view.hpp>
 
 #include "Message_generated.h"
+#include "Schema_generated.h"
+#include "sparrow_ipc/read_options.hpp"
 
 namespace sparrow_ipc::utils
 {
@@ -28,6 +36,116 @@ namespace sparrow_ipc::utils
     [[nodiscard]] std::pair<std::uint8_t*, int64_t>
     get_bitmap_pointer_and_null_count(std::span<const uint8_t> validity_buffer_span, const int64_t length);
 
+    /**
+     * @brief Gets the length of an array.
+     *
+     * The arrays nested in another one have their own length, only given by their FieldNode.
+     *
+     * @param record_batch The RecordBatch holding the array.
+     * @param node The FieldNode of the array, or nullptr for a top-level array.
+     *
+     * @return The length of the FieldNode when given, the length of the RecordBatch otherwise.
+     */
+    [[nodiscard]] inline int64_t get_length(
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        const org::apache::arrow::flatbuf::FieldNode* node
+    )
+    {
+        return node != nullptr ? node->length() : record_batch.length();
+    }
+
+    /**
+     * @brief Counts the null values of a validity bitmap.
+     *
+     * The bitmap is read 64 bits at a time, each word being counted with a single popcount.
+     *
+     * @param validity_bitmap The decompressed validity bitmap. An empty bitmap means that all
+     *                        the values are valid.
+     * @param length The number of values of the array.
+     *
+     * @return The number of unset bits among the first `length` bits of the bitmap.
+     * @throws std::runtime_error if the bitmap holds less than `length` bits.
+     */
+    [[nodiscard]] int64_t count_nulls(std::span<const uint8_t> validity_bitmap, int64_t length);
+
+    /**
+     * @brief Gets the null count of an array, as required by the validation level.
+     *
+     * With `none` and `metadata`, the null count of the FieldNode is used as is. With `full`,
+     * the validity bitmap is counted and must match the FieldNode. When no FieldNode is given,
+     * the bitmap is always counted.
+     *
+     * @param validity_bitmap The decompressed validity bitmap of the array.
+     * @param length The number of values of the array.
+     * @param node The FieldNode of the array, or nullptr.
+     * @param validation The validation level of the read.
+     *
+     * @return The null count of the array.
+     * @throws std::runtime_error if the bitmap is too small, or if its null count does not match
+     *         the FieldNode.
+     */
+    [[nodiscard]] int64_t get_null_count(
+        std::span<const uint8_t> validity_bitmap,
+        int64_t length,
+        const org::apache::arrow::flatbuf::FieldNode* node,
+        validation_level validation
+    );
+
+    /**
+     * @brief Checks that a buffer holds at least the given number of bytes.
+     *
+     * @param buffer The decompressed buffer.
+     * @param required_size The size the layout of the array requires.
+     * @param buffer_name The name of the buffer, for the error message.
+     *
+     * @throws std::runtime_error if the buffer is too small.
+     */
+    void check_buffer_size(std::span<const uint8_t> buffer, size_t required_size, std::string_view buffer_name);
+
+    /**
+     * @brief Checks the offsets of a variable-size layout.
+     *
+     * The offsets must be non-negative, increasing, and the last one must not exceed the size
+     * of the data buffer. The comparisons of adjacent offsets are accumulated without branches,
+     * so that the loop is vectorized by the compiler.
+     *
+     * @tparam OffsetType The offset type of the layout (int32_t or int64_t).
+     * @param offsets_buffer The decompressed offsets buffer, holding `length + 1` offsets.
+     * @param length The number of values of the array.
+     * @param data_size The size of the decompressed data buffer.
+     *
+     * @throws std::runtime_error if the offsets are invalid.
+     */
+    template <std::signed_integral OffsetType>
+    void check_offsets(std::span<const uint8_t> offsets_buffer, int64_t length, size_t data_size)
+    {
+        if (length == 0)
+        {
+            return;
+        }
+        const size_t count = static_cast<size_t>(length) + 1;
+        check_buffer_size(offsets_buffer, count * sizeof(OffsetType), "offsets");
+        const auto* offsets = reinterpret_cast<const OffsetType*>(offsets_buffer.data());
+        unsigned decreasing = 0;
+        for (size_t i = 1; i < count; ++i)
+        {
+            decreasing |= static_cast<unsigned>(offsets[i] < offsets[i - 1]);
+        }
+        if (offsets[0] < 0 || decreasing != 0 || static_cast<uint64_t>(offsets[count - 1]) > data_size)
+        {
+            throw std::runtime_error(
+                "Invalid offsets: they must be increasing and within the data buffer of "
+                + std::to_string(data_size) + " bytes"
+            );
+        }
+    }
+
+    /**
+     * @brief Views the bytes of a buffer returned by get_decompressed_buffer.
+     */
+    [[nodiscard]] std::span<const uint8_t>
+    buffer_view(const std::variant<sparrow::buffer<std::uint8_t>, std::span<const std::uint8_t>>& buffer);
+
     /**
      * @brief Extracts a buffer from a RecordBatch's body.
      *
@@ -67,4 +185,77 @@ namespace sparrow_ipc::utils
         std::span<const uint8_t> buffer_span,
         const org::apache::arrow::flatbuf::BodyCompression* compression
     );
+
+    /**
+     * @brief Counts the buffers a field occupies in the body of a RecordBatch message.
+     *
+     * The count includes the buffers of the children of nested fields, in the depth-first
+     * order in which they are serialized. It is used to skip a field without touching its data.
+     * The variadic data buffers of the binary and string views are not counted: their number is
+     * given by each RecordBatch, see count_field_variadic_buffer_counts.
+     *
+     * @param field The FlatBuffer Field of the schema.
+     *
+     * @return The number of entries of `RecordBatch::buffers` describing the field.
+     * @throws std::runtime_error if the field type is not supported.
+     */
+    [[nodiscard]] size_t count_field_buffers(const org::apache::arrow::flatbuf::Field& field);
+
+    /**
+     * @brief Counts the buffers of the values of a field, ignoring its dictionary encoding.
+     *
+     * For a dictionary-encoded field, this is the number of buffers of the dictionary in the
+     * RecordBatch of a DictionaryBatch message. Otherwise, it is count_field_buffers(field).
+     *
+     * @param field The FlatBuffer Field of the schema.
+     *
+     * @return The number of entries of `RecordBatch::buffers` describing the values.
+     * @throws std::runtime_error if the field type is not supported.
+     */
+    [[nodiscard]] size_t count_value_buffers(const org::apache::arrow::flatbuf::Field& field);
+
+    /**
+     * @brief Counts the FieldNodes a field occupies in a RecordBatch message.
+     *
+     * A field has one FieldNode, followed by the FieldNodes of its children in depth-first
+     * order. Dictionary-encoded fields have a single FieldNode, the one of their indices.
+     *
+     * @param field The FlatBuffer Field of the schema.
+     *
+     * @return The number of entries of `RecordBatch::nodes` describing the field.
+     */
+    [[nodiscard]] size_t count_field_nodes(const org::apache::arrow::flatbuf::Field& field);
+
+    /**
+     * @brief Counts the FieldNodes of the values of a field, ignoring its dictionary encoding.
+     *
+     * @param field The FlatBuffer Field of the schema.
+     *
+     * @return The number of entries of `RecordBatch::nodes` describing the values: the ones of
+     *         the dictionary of a dictionary-encoded field.
+     */
+    [[nodiscard]] size_t count_value_nodes(const org::apache::arrow::flatbuf::Field& field);
+
+    /**
+     * @brief Counts the entries of `RecordBatch::variadicBufferCounts` describing a field.
+     *
+     * Each binary and string view field has one entry, the number of its variadic data buffers,
+     * in the depth-first order of the fields. Dictionary-encoded fields have none.
+     *
+     * @param field The FlatBuffer Field of the schema.
+     *
+     * @return The number of binary and string view fields among the field and its descendants.
+     */
+    [[nodiscard]] size_t count_field_variadic_buffer_counts(const org::apache::arrow::flatbuf::Field& field);
+
+    /**
+     * @brief Counts the entries of `RecordBatch::variadicBufferCounts` describing the values of a
+     *        field, ignoring its dictionary encoding.
+     *
+     * @param field The FlatBuffer Field of the schema.
+     *
+     * @return The number of entries describing the values: the ones of the dictionary of a
+     *         dictionary-encoded field.
+     */
+    [[nodiscard]] size_t count_value_variadic_buffer_counts(const org::apache::arrow::flatbuf::Field& field);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <span>
+#include <type_traits>
 #include <unordered_set>
 
 #include <sparrow/arrow_interface/arrow_array_schema_proxy.hpp>
@@ -13,36 +14,26 @@
 
 namespace sparrow_ipc
 {
+    /**
+     * @brief Deserializes the validity, offsets and data buffers of a variable-size binary array,
+     *        described by an existing schema.
+     *
+     * @param schema The schema of the array, whose ownership is transferred to the returned array
+     * @param node Optional: the FieldNode of the array, giving its length and null count
+     * @param validation The checks applied to the buffers; `full` checks the offsets
+     */
     template <typename T>
     [[nodiscard]] T deserialize_non_owning_variable_size_binary(
         const org::apache::arrow::flatbuf::RecordBatch& record_batch,
         std::span<const uint8_t> body,
-        std::string_view name,
-        const std::optional<std::vector<sparrow::metadata_pair>>& metadata,
-        bool nullable,
-        size_t& buffer_index
+        ArrowSchema&& schema,
+        size_t& buffer_index,
+        const org::apache::arrow::flatbuf::FieldNode* node = nullptr,
+        validation_level validation = validation_level::full
     )
     {
-        const std::string_view format = data_type_to_format(sparrow::detail::get_data_type_from_array<T>::get());
-        
-        // Set up flags based on nullable
-        std::optional<std::unordered_set<sparrow::ArrowFlag>> flags;
-        if (nullable)
-        {
-            flags = std::unordered_set<sparrow::ArrowFlag>{sparrow::ArrowFlag::NULLABLE};
-        }
-        
-        ArrowSchema schema = make_non_owning_arrow_schema(
-            format,
-            name.data(),
-            metadata,
-            flags,
-            0,
-            nullptr,
-            nullptr
-        );
-
         const auto compression = record_batch.compression();
+        const int64_t length = utils::get_length(record_batch, node);
         std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
 
         auto validity_buffer_span = utils::get_buffer(record_batch, body, buffer_index);
@@ -62,11 +53,35 @@ namespace sparrow_ipc
             buffers.push_back(data_buffer_span);
         }
 
-        // TODO bitmap_ptr is not used anymore... Leave it for now, and remove later if no need confirmed
-        const auto [bitmap_ptr, null_count] = utils::get_bitmap_pointer_and_null_count(validity_buffer_span, record_batch.length());
+        using offset_type = std::conditional_t<
+            std::is_same_v<T, sparrow::big_string_array> || std::is_same_v<T, sparrow::big_binary_array>,
+            int64_t,
+            int32_t>;
+        if (validation == validation_level::full)
+        {
+            utils::check_offsets<offset_type>(
+                utils::buffer_view(buffers[1]),
+                length,
+                utils::buffer_view(buffers[2]).size()
+            );
+        }
+        else if (validation == validation_level::metadata && length > 0)
+        {
+            utils::check_buffer_size(
+                utils::buffer_view(buffers[1]),
+                (static_cast<size_t>(length) + 1) * sizeof(offset_type),
+                "offsets"
+            );
+        }
+        const int64_t null_count = utils::get_null_count(
+            utils::buffer_view(buffers[0]),
+            length,
+            node,
+            validation
+        );
 
         ArrowArray array = make_arrow_array<arrow_array_private_data>(
-            record_batch.length(),
+            length,
             null_count,
             0,
             0,
@@ -78,4 +93,36 @@ namespace sparrow_ipc
         sparrow::arrow_proxy ap{std::move(array), std::move(schema)};
         return T{std::move(ap)};
     }
+
+    template <typename T>
+    [[nodiscard]] T deserialize_non_owning_variable_size_binary(
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        std::string_view name,
+        const std::optional<std::vector<sparrow::metadata_pair>>& metadata,
+        bool nullable,
+        size_t& buffer_index
+    )
+    {
+        const std::string_view format = data_type_to_format(sparrow::detail::get_data_type_from_array<T>::get());
+        
+        // Set up flags based on nullable
+        std::optional<std::unordered_set<sparrow::ArrowFlag>> flags;
+        if (nullable)
+        {
+            flags = std::unordered_set<sparrow::ArrowFlag>{sparrow::ArrowFlag::NULLABLE};
+        }
+        
+        ArrowSchema schema = make_non_owning_arrow_schema(
+            format,
+            name.data(),
+            metadata,
+            flags,
+            0,
+            nullptr,
+            nullptr
+        );
+
+        return deserialize_non_owning_variable_size_binary<T>(record_batch, body, std::move(schema), buffer_index);
+    }
 }
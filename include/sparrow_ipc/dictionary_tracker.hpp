@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <sparrow/array.hpp>
+#include <sparrow/record_batch.hpp>
+
+#include "sparrow_ipc/config/config.hpp"
+
+namespace sparrow_ipc
+{
+    namespace details
+    {
+        class dictionary;
+    }
+
+    /**
+     * @brief A DictionaryBatch message to write before a record batch.
+     */
+    struct dictionary_batch
+    {
+        int64_t id = 0;
+        // The values of the dictionary, or only the ones appended to it when `is_delta` is true
+        sparrow::array values;
+        bool is_delta = false;
+    };
+
+    /**
+     * @brief Tracks the dictionaries written to a stream, so that each value is written once.
+     *
+     * The dictionaries of the dictionary-encoded columns are numbered from 0 in depth-first order
+     * of the schema, like the ids written in the Schema message by create_field. For each record
+     * batch, a dictionary is written when it has not been written yet or has changed. A dictionary
+     * whose previous values are a prefix of the new ones is written as a delta holding only the
+     * appended values; any other change replaces the dictionary.
+     *
+     * The tracker keeps a copy of the written values to compare the next dictionaries with. The
+     * values appended by deltas are added to it in amortized constant time per value.
+     */
+    class SPARROW_IPC_API dictionary_tracker
+    {
+    public:
+
+        /**
+         * @brief Constructs a tracker of a stream to which no dictionary has been written.
+         *
+         * @param allow_replacement Whether a dictionary can be replaced by a different one. The
+         *                          Arrow IPC file format only allows delta dictionaries.
+         */
+        explicit dictionary_tracker(bool allow_replacement = true);
+
+        /**
+         * @brief Gets the DictionaryBatch messages to write before a record batch, and records
+         *        them as written.
+         *
+         * The dictionaries nested in the values of a dictionary come before it.
+         *
+         * @param record_batch The record batch about to be written
+         * @return The messages to write, in order; empty when the dictionaries are unchanged
+         *
+         * @throws std::invalid_argument If a dictionary-encoded column has no dictionary, or if a
+         *         dictionary is replaced when replacement is not allowed
+         */
+        [[nodiscard]] std::vector<dictionary_batch> update(const sparrow::record_batch& record_batch);
+
+    private:
+
+        std::map<int64_t, std::shared_ptr<const details::dictionary>> m_dictionaries;
+        bool m_allow_replacement;
+    };
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 #include <variant>
 #include <span>
 
@@ -29,6 +30,12 @@ namespace sparrow_ipc
         [[nodiscard]] const ::flatbuffers::Vector<::flatbuffers::Offset<org::apache::arrow::flatbuf::KeyValue>>*
         custom_metadata() const;
 
+        /**
+         * @brief Gets the length of the body of the message, as given by its metadata.
+         *
+         * @throws std::runtime_error If the body length is negative, or if the message would not
+         *         fit in a size_t
+         */
         [[nodiscard]] size_t body_length() const;
 
         [[nodiscard]] std::span<const uint8_t> body() const;
@@ -37,11 +44,52 @@ namespace sparrow_ipc
 
         [[nodiscard]] std::span<const uint8_t> as_span() const;
 
+        /**
+         * @brief Verifies the FlatBuffer metadata of the message.
+         *
+         * The other accessors trust the metadata; this check makes them safe to call on
+         * untrusted input.
+         *
+         * @throws std::runtime_error If the metadata exceeds the message, is not a valid
+         *         FlatBuffer Message or has an invalid body length
+         */
+        void verify() const;
+
     private:
 
         std::span<const uint8_t> m_data;
     };
 
+    /**
+     * @brief Splits the first encapsulated message from a buffer.
+     *
+     * @param buf_ptr The buffer, starting with an encapsulated message
+     * @param verify Whether the FlatBuffer metadata of the message is verified before its
+     *               body length is read
+     * @return The message, and the rest of the buffer
+     * @throws std::runtime_error If the message is invalid or exceeds the buffer
+     */
     [[nodiscard]] std::pair<encapsulated_message, std::span<const uint8_t>>
-    extract_encapsulated_message(std::span<const uint8_t> buf_ptr);
+    extract_encapsulated_message(std::span<const uint8_t> buf_ptr, bool verify = false);
+
+    // Size of the continuation bytes followed by the metadata length
+    inline constexpr std::size_t encapsulated_message_prefix_size = 8;
+
+    /**
+     * @brief Parses the prefix (continuation bytes and metadata length) of an encapsulated message.
+     *
+     * @param prefix The first `encapsulated_message_prefix_size` bytes of the message
+     * @return The metadata length, or std::nullopt if the prefix is an end-of-stream marker
+     * @throws std::runtime_error If the prefix does not start with the continuation bytes or
+     *         if the metadata length is negative
+     */
+    [[nodiscard]] std::optional<size_t> parse_message_prefix(std::span<const uint8_t> prefix);
+
+    /**
+     * @brief Computes the size of the prefix, metadata and padding of an encapsulated message.
+     *
+     * @param metadata_length The metadata length read from the message prefix
+     * @return The offset of the message body
+     */
+    [[nodiscard]] size_t encapsulated_message_header_size(size_t metadata_length);
 }
\ No newline at end of file
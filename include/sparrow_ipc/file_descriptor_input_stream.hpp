@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <ios>
+
+#include "sparrow_ipc/config/config.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief Input stream reading from a raw file descriptor (file, pipe or socket).
+     *
+     * The file descriptor is not owned: the caller is responsible for closing it
+     * once the stream is no longer used.
+     *
+     * Usage:
+     * @code
+     * file_descriptor_input_stream input(STDIN_FILENO);
+     * stream_reader reader(input);
+     * @endcode
+     */
+    class SPARROW_IPC_API file_descriptor_input_stream
+    {
+    public:
+
+        explicit file_descriptor_input_stream(int fd) noexcept;
+
+        /**
+         * @brief Reads at most `count` bytes from the file descriptor.
+         *
+         * Interrupted system calls are transparently retried.
+         *
+         * @param s The destination buffer
+         * @param count The maximum number of bytes to read
+         * @return The number of bytes read, 0 at the end of the stream, or a negative value on error
+         */
+        [[nodiscard]] std::streamsize read(char* s, std::streamsize count);
+
+        [[nodiscard]] int fd() const noexcept;
+
+    private:
+
+        int m_fd;
+    };
+}
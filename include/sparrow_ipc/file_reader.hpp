@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sparrow/record_batch.hpp>
+
+#include "File_generated.h"
+#include "sparrow_ipc/config/config.hpp"
+#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/encapsulated_message.hpp"
+#include "sparrow_ipc/lazy_record_batch.hpp"
+#include "sparrow_ipc/read_options.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief Random-access reader of an Arrow IPC file.
+     *
+     * The reader parses the footer of the file once, then reads any record batch
+     * directly from the offset given by its footer block, without going through the
+     * preceding ones. Uncompressed buffers of the decoded record batches point into
+     * the file data, no copy is made. The dictionaries listed in the footer are read
+     * when the reader is constructed, and shared by all the record batches.
+     *
+     * When opened from a path, the file is memory-mapped: only the pages holding the
+     * footer and the requested record batches are loaded. The decoded record batches
+     * share the ownership of the mapping, so they remain valid after the reader is
+     * destroyed.
+     *
+     * Usage:
+     * @code
+     * file_reader reader("data.arrow");
+     * const auto last = reader.read_record_batch(reader.num_record_batches() - 1);
+     * @endcode
+     */
+    class SPARROW_IPC_API file_reader
+    {
+    public:
+
+        /**
+         * @brief Opens and memory-maps an Arrow IPC file.
+         *
+         * @param path The path of the file
+         * @param options The read options; the field projection, if any, is applied to every
+         *                record batch read. The pages of the skipped fields are never loaded.
+         *                The validation level applies to the footer and to every record batch read.
+         * @throws std::runtime_error If the file cannot be mapped or is not a valid Arrow file
+         * @throws std::invalid_argument If the projection does not match the schema
+         */
+        explicit file_reader(const std::filesystem::path& path, const read_options& options = {});
+
+        /**
+         * @brief Reads an Arrow IPC file already in memory.
+         *
+         * @param data The content of the file
+         * @param owner Optional: an object keeping `data` alive. When given, the decoded record
+         *              batches share its ownership. When empty, the caller must keep `data` alive
+         *              as long as the reader and the decoded record batches are used.
+         * @param options The read options; the field projection, if any, is applied to every
+         *                record batch read. The validation level applies to the footer and to
+         *                every record batch read.
+         * @throws std::runtime_error If `data` is not a valid Arrow file
+         * @throws std::invalid_argument If the projection does not match the schema
+         */
+        explicit file_reader(
+            std::span<const uint8_t> data,
+            std::shared_ptr<const void> owner = nullptr,
+            const read_options& options = {}
+        );
+
+        /**
+         * @brief Reads an Arrow IPC file, taking the ownership of its content.
+         *
+         * The content is moved into a shared owner: the decoded record batches reference it
+         * without any copy and remain valid after the reader is destroyed.
+         *
+         * @param data The content of the file
+         * @param options The read options, see file_reader(std::span<const uint8_t>, ...)
+         * @throws std::runtime_error If `data` is not a valid Arrow file
+         * @throws std::invalid_argument If the projection does not match the schema
+         */
+        explicit file_reader(std::vector<uint8_t>&& data, const read_options& options = {});
+
+        /**
+         * @brief Gets the number of record batches listed in the footer.
+         */
+        [[nodiscard]] size_t num_record_batches() const noexcept;
+
+        /**
+         * @brief Gets the schema stored in the footer, restricted to the projection if one was given.
+         */
+        [[nodiscard]] const decoded_schema& schema() const noexcept;
+
+        /**
+         * @brief Gets the names of the decoded fields of the schema.
+         */
+        [[nodiscard]] const std::vector<std::string>& names() const noexcept;
+
+        /**
+         * @brief Reads the record batch at the given index.
+         *
+         * @param index The index of the record batch, in [0, num_record_batches())
+         * @return The decoded record batch
+         * @throws std::out_of_range If `index` is out of range
+         * @throws std::runtime_error If the block of the record batch is invalid
+         */
+        [[nodiscard]] sparrow::record_batch read_record_batch(size_t index) const;
+
+        /**
+         * @brief Reads the record batch at the given index, deferring the decoding of its columns.
+         *
+         * Each column is decompressed and decoded when it is first accessed.
+         *
+         * @param index The index of the record batch, in [0, num_record_batches())
+         * @return The lazy record batch
+         * @throws std::out_of_range If `index` is out of range
+         * @throws std::runtime_error If the block of the record batch is invalid
+         */
+        [[nodiscard]] lazy_record_batch read_lazy_record_batch(size_t index) const;
+
+        /**
+         * @brief Reads all the record batches of the file, in order.
+         *
+         * Only the number of threads and the projection are taken from `options`. The decoding
+         * flags, that is the validation level, the decompression threads and the expansion of
+         * the run-end encoded fields, are always the ones given at construction, with or without
+         * a projection: their values in `options` are ignored.
+         *
+         * @param options The options controlling the decoding. With several threads, the
+         *                record batches are decoded concurrently, each from its footer block.
+         *                A projection set in `options` replaces the one given at construction.
+         * @throws std::invalid_argument If the projection does not match the schema
+         */
+        [[nodiscard]] std::vector<sparrow::record_batch> read_all(const read_options& options = {}) const;
+
+    private:
+
+        void parse_footer(const read_options& options);
+
+        [[nodiscard]] sparrow::record_batch read_record_batch(size_t index, const decoded_schema& schema) const;
+
+        [[nodiscard]] encapsulated_message record_batch_message(size_t index, const decoded_schema& schema) const;
+
+        // Reads the DictionaryBatch messages listed in the footer, in order, into the dictionaries of `schema`
+        void read_dictionaries(decoded_schema& schema) const;
+
+        // Checks that a footer block lies within the file, and verifies its message
+        [[nodiscard]] encapsulated_message block_message(
+            const org::apache::arrow::flatbuf::Block& block,
+            size_t index,
+            std::string_view kind,
+            validation_level validation
+        ) const;
+
+        std::shared_ptr<const void> m_owner;
+        std::span<const uint8_t> m_data;
+        size_t m_footer_offset = 0;
+        const org::apache::arrow::flatbuf::Footer* m_footer = nullptr;
+        decoded_schema m_schema;
+    };
+}
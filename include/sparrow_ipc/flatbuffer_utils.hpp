@@ -1,4 +1,6 @@
 #pragma once
+#include <bit>
+
 #include <flatbuffers/flatbuffers.h>
 #include <Message_generated.h>
 
@@ -7,6 +9,8 @@
 
 #include "File_generated.h"
 #include "sparrow_ipc/compression.hpp"
+#include "sparrow_ipc/dictionary_tracker.hpp"
+#include "sparrow_ipc/tensor.hpp"
 #include "sparrow_ipc/utils.hpp"
 
 namespace sparrow_ipc
@@ -22,8 +26,9 @@ namespace sparrow_ipc
 
     // Creates a Flatbuffers type from a format string
     // This function maps a sparrow data type to the corresponding Flatbuffers type
+    // The flags of the ArrowSchema give the properties of the type not held by the format (sorted map keys)
     [[nodiscard]] std::pair<org::apache::arrow::flatbuf::Type, flatbuffers::Offset<void>>
-    get_flatbuffer_type(flatbuffers::FlatBufferBuilder& builder, std::string_view format_str);
+    get_flatbuffer_type(flatbuffers::FlatBufferBuilder& builder, std::string_view format_str, int64_t flags = 0);
 
     /**
      * @brief Creates a FlatBuffers vector of KeyValue pairs from ArrowSchema metadata.
@@ -60,7 +65,8 @@ namespace sparrow_ipc
      * @return A FlatBuffer offset to the created Field object that can be used in further
      *         FlatBuffer construction operations
      *
-     * @note Dictionary encoding is not currently supported (TODO item)
+     * @note A dictionary-encoded field has the type of its dictionary values, and the index type
+     *       given by its own format. The dictionaries are numbered from 0 in depth-first order.
      * @note The function checks the NULLABLE flag from the ArrowSchema flags to determine nullability
      * @note The name_override parameter is useful when serializing record batches where column
      *       names are stored separately from the array schemas
@@ -71,6 +77,38 @@ namespace sparrow_ipc
         std::optional<std::string_view> name_override = std::nullopt
     );
 
+    /**
+     * @brief Creates a FlatBuffer Field object from an ArrowSchema, numbering its dictionaries.
+     *
+     * @param builder Reference to the FlatBufferBuilder used for creating FlatBuffer objects
+     * @param arrow_schema The ArrowSchema structure containing the field definition to convert
+     * @param name_override Optional field name to use instead of the name from arrow_schema
+     * @param next_dictionary_id The id of the next dictionary-encoded field, in depth-first order
+     *                           of the schema; incremented for each one found in the field
+     * @return A FlatBuffer offset to the created Field object
+     *
+     * @throws std::invalid_argument If the index type of a dictionary-encoded field is not an integer
+     */
+    [[nodiscard]] ::flatbuffers::Offset<org::apache::arrow::flatbuf::Field> create_field(
+        flatbuffers::FlatBufferBuilder& builder,
+        const ArrowSchema& arrow_schema,
+        std::optional<std::string_view> name_override,
+        int64_t& next_dictionary_id
+    );
+
+    /**
+     * @brief Creates a FlatBuffers DictionaryEncoding from the schema of a dictionary-encoded field.
+     *
+     * @param builder Reference to the FlatBufferBuilder used for creating FlatBuffer objects
+     * @param arrow_schema The schema of the field, whose format is the one of the indices
+     * @param id The id of the dictionary
+     * @return A FlatBuffer offset to the created DictionaryEncoding
+     *
+     * @throws std::invalid_argument If the format of the indices is not an integer one
+     */
+    [[nodiscard]] ::flatbuffers::Offset<org::apache::arrow::flatbuf::DictionaryEncoding>
+    create_dictionary_encoding(flatbuffers::FlatBufferBuilder& builder, const ArrowSchema& arrow_schema, int64_t id);
+
     /**
      * @brief Creates a FlatBuffers vector of Field objects from a record batch.
      *
@@ -117,24 +155,51 @@ namespace sparrow_ipc
         ::flatbuffers::Vector<::flatbuffers::Offset<org::apache::arrow::flatbuf::Field>>>
     create_children(flatbuffers::FlatBufferBuilder& builder, const ArrowSchema& arrow_schema);
 
+    /**
+     * @brief Creates a FlatBuffers vector of Field objects from an ArrowSchema's children,
+     *        numbering their dictionaries.
+     *
+     * @param builder Reference to the FlatBufferBuilder used for creating FlatBuffers objects
+     * @param arrow_schema The ArrowSchema containing the children to convert
+     * @param next_dictionary_id The id of the next dictionary-encoded field, in depth-first order
+     *                           of the schema; incremented for each one found in the children
+     * @return A FlatBuffers offset to a vector of Field objects, or 0 if no children exist
+     *
+     * @throws std::invalid_argument If any child pointer in the ArrowSchema is null
+     */
+    [[nodiscard]] ::flatbuffers::Offset<
+        ::flatbuffers::Vector<::flatbuffers::Offset<org::apache::arrow::flatbuf::Field>>>
+    create_children(
+        flatbuffers::FlatBufferBuilder& builder,
+        const ArrowSchema& arrow_schema,
+        int64_t& next_dictionary_id
+    );
+
     /**
      * @brief Creates a FlatBuffer builder containing a serialized Arrow schema message.
      *
      * This function constructs an Arrow IPC schema message from a record batch by:
      * 1. Creating field definitions from the record batch columns
-     * 2. Building a Schema flatbuffer with little-endian byte order
+     * 2. Building a Schema flatbuffer with the given byte order
      * 3. Wrapping the schema in a Message with metadata version V5
      * 4. Finalizing the buffer for serialization
      *
      * @param record_batch The source record batch containing column definitions
+     * @param byte_order The byte order of the buffers of the record batches written after the schema
      * @return flatbuffers::FlatBufferBuilder A completed FlatBuffer containing the schema message,
      *         ready for Arrow IPC serialization
      *
      * @note The schema message has zero body length as it contains only metadata
-     * @note Currently uses little-endian byte order (marked as TODO for configurability)
      */
-    [[nodiscard]] flatbuffers::FlatBufferBuilder
-    get_schema_message_builder(const sparrow::record_batch& record_batch);
+    [[nodiscard]] flatbuffers::FlatBufferBuilder get_schema_message_builder(
+        const sparrow::record_batch& record_batch,
+        std::endian byte_order = std::endian::native
+    );
+
+    /**
+     * @brief Converts a byte order to its FlatBuffer Endianness.
+     */
+    [[nodiscard]] SPARROW_IPC_API org::apache::arrow::flatbuf::Endianness to_fb_endianness(std::endian byte_order);
 
     /**
      * @brief Recursively fills a vector of FieldNode objects from an arrow_proxy and its children.
@@ -171,8 +236,61 @@ namespace sparrow_ipc
     [[nodiscard]] std::vector<org::apache::arrow::flatbuf::FieldNode>
     create_fieldnodes(const sparrow::record_batch& record_batch);
 
+    /**
+     * @brief Recursively appends the number of variadic data buffers of each binary and string view
+     *        array of an Arrow proxy and of its children, in depth-first order.
+     *
+     * @param arrow_proxy The arrow proxy object
+     * @param counts Reference to the vector of counts, the `variadicBufferCounts` of a RecordBatch
+     */
+    void fill_variadic_buffer_counts(const sparrow::arrow_proxy& arrow_proxy, std::vector<int64_t>& counts);
+
+    /**
+     * @brief Creates the `variadicBufferCounts` of the RecordBatch message of a record batch.
+     *
+     * @param record_batch The sparrow record batch
+     * @return One count per binary and string view array of the columns, children included; empty
+     *         when there is no such array
+     */
+    [[nodiscard]] std::vector<int64_t> create_variadic_buffer_counts(const sparrow::record_batch& record_batch);
+
     namespace details
     {
+        /**
+         * @brief Calls `func` with each buffer of an array written in the body of a message.
+         *
+         * These are the buffers of the C data interface, except for the binary and string views:
+         * their last buffer, holding the sizes of their variadic data buffers, is not written. The
+         * number of data buffers is given by `RecordBatch::variadicBufferCounts` instead.
+         */
+        template <typename Func>
+        void for_each_body_buffer(const sparrow::arrow_proxy& arrow_proxy, Func&& func)
+        {
+            const auto data_type = arrow_proxy.data_type();
+            if (data_type != sparrow::data_type::STRING_VIEW && data_type != sparrow::data_type::BINARY_VIEW)
+            {
+                for (const auto& buffer : arrow_proxy.buffers())
+                {
+                    func(std::span<const uint8_t>(buffer.data(), buffer.size()));
+                }
+                return;
+            }
+            // Validity, views of 16 bytes, then the data buffers whose sizes are in the last buffer
+            const ArrowArray& array = arrow_proxy.array();
+            const auto slots = static_cast<size_t>(array.offset + array.length);
+            const auto* validity = static_cast<const uint8_t*>(array.buffers[0]);
+            func(std::span<const uint8_t>(validity, validity == nullptr ? 0 : (slots + 7) / 8));
+            func(std::span<const uint8_t>(static_cast<const uint8_t*>(array.buffers[1]), slots * 16));
+            const auto* sizes = static_cast<const int64_t*>(array.buffers[array.n_buffers - 1]);
+            for (int64_t i = 2; i + 1 < array.n_buffers; ++i)
+            {
+                func(std::span<const uint8_t>(
+                    static_cast<const uint8_t*>(array.buffers[i]),
+                    static_cast<size_t>(sizes[i - 2])
+                ));
+            }
+        }
+
         template <typename Func>
         void fill_buffers_impl(
             const sparrow::arrow_proxy& arrow_proxy,
@@ -181,13 +299,15 @@ namespace sparrow_ipc
             Func&& get_buffer_size
         )
         {
-            const auto& buffers = arrow_proxy.buffers();
-            for (const auto& buffer : buffers)
-            {
-                int64_t size = get_buffer_size(buffer);
-                flatbuf_buffers.emplace_back(offset, size);
-                offset += utils::align_to_8(size);
-            }
+            for_each_body_buffer(
+                arrow_proxy,
+                [&](std::span<const uint8_t> buffer)
+                {
+                    int64_t size = get_buffer_size(buffer);
+                    flatbuf_buffers.emplace_back(offset, size);
+                    offset += utils::align_to_8(size);
+                }
+            );
             for (const auto& child : arrow_proxy.children())
             {
                 fill_buffers_impl(child, flatbuf_buffers, offset, get_buffer_size);
@@ -207,6 +327,19 @@ namespace sparrow_ipc
             }
             return buffers;
         }
+
+        /**
+         * @brief Gets the buffers of a sparse tensor in the order they are written in the body of
+         *        its message: the indptr of a CSR or CSC tensor, then its indices and its data.
+         */
+        inline std::vector<std::span<const uint8_t>> sparse_tensor_body_buffers(const sparse_tensor_view& tensor)
+        {
+            if (tensor.index == sparse_tensor_index::coo)
+            {
+                return {tensor.indices, tensor.data};
+            }
+            return {tensor.indptr, tensor.indices, tensor.data};
+        }
     }  // namespace details
 
     /**
@@ -347,7 +480,7 @@ namespace sparrow_ipc
      * @throws std::invalid_argument if compression is given but not cache.
      *
      * @note The returned message uses Arrow IPC format version V5.
-     * @note Variadic buffer counts is not currently implemented (set to 0).
+     * @note The variadic buffer counts are only written when a column holds binary or string views.
      */
     [[nodiscard]] flatbuffers::FlatBufferBuilder get_record_batch_message_builder(
         const sparrow::record_batch& record_batch,
@@ -355,6 +488,47 @@ namespace sparrow_ipc
         std::optional<std::reference_wrapper<CompressionCache>> cache = std::nullopt
     );
 
+    /**
+     * @brief Creates a FlatBuffer message containing a serialized Apache Arrow DictionaryBatch.
+     *
+     * The values of the dictionary are described as the single column of the RecordBatch of the
+     * message, like get_record_batch_message_builder does for the columns of a record batch.
+     *
+     * @param dictionary The dictionary values to serialize, with their id and delta flag
+     * @param compression Optional: The compression algorithm to be used for the message body.
+     * @param cache Optional: A cache for compressed buffers to avoid recompression if compression is enabled.
+     * If compression is given, cache should be set as well.
+     * @return A finished FlatBufferBuilder containing the complete serialized message
+     * @throws std::invalid_argument if compression is given but not cache.
+     */
+    [[nodiscard]] flatbuffers::FlatBufferBuilder get_dictionary_batch_message_builder(
+        const dictionary_batch& dictionary,
+        std::optional<CompressionType> compression = std::nullopt,
+        std::optional<std::reference_wrapper<CompressionCache>> cache = std::nullopt
+    );
+
+    /**
+     * @brief Creates a FlatBuffer message describing a dense tensor.
+     *
+     * The body of the message holds the data of the tensor only, at offset 0.
+     *
+     * @param tensor The tensor to describe, checked with check_tensor beforehand
+     * @return A finished FlatBufferBuilder containing the complete serialized message
+     */
+    [[nodiscard]] flatbuffers::FlatBufferBuilder get_tensor_message_builder(const tensor_view& tensor);
+
+    /**
+     * @brief Creates a FlatBuffer message describing a sparse tensor in COO, CSR or CSC layout.
+     *
+     * The buffers of the body are the ones of details::sparse_tensor_body_buffers, each aligned
+     * to 8 bytes.
+     *
+     * @param tensor The sparse tensor to describe, checked with check_sparse_tensor beforehand
+     * @return A finished FlatBufferBuilder containing the complete serialized message
+     */
+    [[nodiscard]] flatbuffers::FlatBufferBuilder
+    get_sparse_tensor_message_builder(const sparse_tensor_view& tensor);
+
     // Helper function to extract and parse the footer from Arrow IPC file data
     [[nodiscard]] SPARROW_IPC_API const org::apache::arrow::flatbuf::Footer* get_footer_from_file_data(std::span<const uint8_t> file_data);
 }
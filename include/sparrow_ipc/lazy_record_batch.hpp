@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sparrow/array.hpp>
+#include <sparrow/record_batch.hpp>
+
+#include "Message_generated.h"
+#include "sparrow_ipc/config/config.hpp"
+#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/encapsulated_message.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief Record batch whose columns are decoded on first access.
+     *
+     * Constructing a lazy_record_batch only checks the RecordBatch message against its schema.
+     * The buffers of a column are decompressed, and its array built, the first time the column
+     * is accessed; the columns that are never accessed cost nothing. This suits queries that
+     * filter on a few columns and only project the remaining ones for the matching batches.
+     *
+     * The columns can be accessed concurrently from several threads: each column is decoded
+     * exactly once.
+     *
+     * Usage:
+     * @code
+     * file_reader reader("data.arrow");
+     * for (size_t i = 0; i < reader.num_record_batches(); ++i)
+     * {
+     *     const lazy_record_batch batch = reader.read_lazy_record_batch(i);
+     *     if (matches(batch.get_column("key")))
+     *     {
+     *         process(batch.get_column("value"));
+     *     }
+     * }
+     * @endcode
+     */
+    class SPARROW_IPC_API lazy_record_batch
+    {
+    public:
+
+        /**
+         * @brief Prepares the lazy decoding of a RecordBatch message.
+         *
+         * @param message The encapsulated RecordBatch message
+         * @param schema The schema decoded from the Schema message of the stream
+         * @param body_owner Optional: an object keeping the memory of `message` alive. When given,
+         *                   the lazy batch and the arrays it decodes share its ownership. When empty,
+         *                   the caller must keep the memory of `message` alive as long as the lazy
+         *                   batch and its arrays are used.
+         *
+         * @throws std::runtime_error If the message is not a RecordBatch message or does not match
+         *         the schema
+         */
+        lazy_record_batch(
+            const encapsulated_message& message,
+            const decoded_schema& schema,
+            std::shared_ptr<const void> body_owner = nullptr
+        );
+
+        ~lazy_record_batch();
+
+        lazy_record_batch(const lazy_record_batch&) = delete;
+        lazy_record_batch& operator=(const lazy_record_batch&) = delete;
+        lazy_record_batch(lazy_record_batch&&) noexcept;
+        lazy_record_batch& operator=(lazy_record_batch&&) noexcept;
+
+        /**
+         * @brief Gets the number of columns, without decoding them.
+         */
+        [[nodiscard]] size_t nb_columns() const noexcept;
+
+        /**
+         * @brief Gets the number of rows, without decoding the columns.
+         */
+        [[nodiscard]] size_t nb_rows() const noexcept;
+
+        /**
+         * @brief Gets the names of the columns, without decoding them.
+         */
+        [[nodiscard]] const std::vector<std::string>& names() const noexcept;
+
+        /**
+         * @brief Gets a column, decoding it on first access.
+         *
+         * @param index The index of the column, in [0, nb_columns())
+         * @return The decoded column, valid as long as the lazy batch
+         *
+         * @throws std::out_of_range If `index` is out of range
+         * @throws std::runtime_error If the column cannot be decoded. The next access tries again.
+         */
+        [[nodiscard]] const sparrow::array& get_column(size_t index) const;
+
+        /**
+         * @brief Gets a column by name, decoding it on first access.
+         *
+         * @throws std::out_of_range If there is no column named `name`
+         * @throws std::runtime_error If the column cannot be decoded
+         */
+        [[nodiscard]] const sparrow::array& get_column(std::string_view name) const;
+
+        /**
+         * @brief Tells whether a column has already been decoded.
+         *
+         * @throws std::out_of_range If `index` is out of range
+         */
+        [[nodiscard]] bool is_materialized(size_t index) const;
+
+        /**
+         * @brief Decodes the remaining columns and moves all of them into a record batch.
+         *
+         * The lazy batch is left empty. This function must not be called concurrently with
+         * any other member function.
+         *
+         * @throws std::runtime_error If a column cannot be decoded
+         */
+        [[nodiscard]] sparrow::record_batch extract_record_batch();
+
+    private:
+
+        struct column;
+
+        std::shared_ptr<const details::decoder_plan> m_plan;
+        std::shared_ptr<const details::dictionary_set> m_dictionaries;
+        std::vector<std::string> m_names;
+        const org::apache::arrow::flatbuf::RecordBatch* m_record_batch = nullptr;
+        std::span<const uint8_t> m_body;
+        std::shared_ptr<const void> m_owner;
+        std::unique_ptr<column[]> m_columns;
+    };
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "sparrow_ipc/config/config.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief Read-only memory mapping of a whole file.
+     *
+     * The pages of the file are only loaded when they are accessed, which makes
+     * it possible to read a few record batches of a large file without reading
+     * the rest of it.
+     */
+    class SPARROW_IPC_API memory_mapped_file
+    {
+    public:
+
+        /**
+         * @brief Maps the given file in memory.
+         *
+         * @param path The path of the file to map
+         * @throws std::runtime_error If the file cannot be opened or mapped
+         */
+        explicit memory_mapped_file(const std::filesystem::path& path);
+
+        ~memory_mapped_file();
+
+        memory_mapped_file(memory_mapped_file&& other) noexcept;
+        memory_mapped_file& operator=(memory_mapped_file&& other) noexcept;
+
+        memory_mapped_file(const memory_mapped_file&) = delete;
+        memory_mapped_file& operator=(const memory_mapped_file&) = delete;
+
+        /**
+         * @brief Gets the content of the file.
+         */
+        [[nodiscard]] std::span<const uint8_t> data() const noexcept;
+
+        /**
+         * @brief Gets the size of the file in bytes.
+         */
+        [[nodiscard]] size_t size() const noexcept;
+
+    private:
+
+        void unmap() noexcept;
+
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+    };
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Message_generated.h"
+#include "sparrow_ipc/compression.hpp"
+#include "sparrow_ipc/config/config.hpp"
+#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/read_options.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief Location and metadata of an encapsulated message of an IPC stream.
+     */
+    struct message_info
+    {
+        // Offset of the continuation bytes of the message from the start of the scanned data
+        size_t offset = 0;
+        org::apache::arrow::flatbuf::MessageHeader type = org::apache::arrow::flatbuf::MessageHeader::NONE;
+        // Size of the prefix, FlatBuffer metadata and padding, as in a Block of the file footer
+        int32_t metadata_length = 0;
+        int64_t body_length = 0;
+        // Number of rows of a RecordBatch, or of values of a DictionaryBatch; 0 for other messages
+        int64_t num_rows = 0;
+        // Codec of the body of a RecordBatch or DictionaryBatch, empty when uncompressed
+        std::optional<CompressionType> compression;
+        // Id of the dictionary of a DictionaryBatch, and whether it is a delta
+        int64_t dictionary_id = 0;
+        bool is_delta = false;
+    };
+
+    /**
+     * @brief Index of the messages of an IPC stream, built from their metadata only.
+     */
+    struct message_index
+    {
+        // Messages in stream order, the Schema message first
+        std::vector<message_info> messages;
+        // Offset of the end of the last message, where the end-of-stream marker is when present
+        size_t end_offset = 0;
+        bool has_end_of_stream = false;
+    };
+
+    /**
+     * @brief Indexes the messages of an IPC stream without reading their bodies.
+     *
+     * Only the prefix and the FlatBuffer metadata of each message are read: the bodies are
+     * skipped, so that a memory-mapped stream is indexed without loading their pages. The
+     * scan stops at the end-of-stream marker, or at the end of `data` when there is none.
+     *
+     * `data` may also be an IPC file: its leading magic bytes are skipped, and the messages of
+     * its stream portion are indexed with their offset from the start of the file.
+     *
+     * @param data The stream
+     * @param verify Whether the FlatBuffer metadata of each message is verified, which is
+     *               required for untrusted input
+     * @return The index of the messages
+     *
+     * @throws std::runtime_error If a message is invalid or truncated
+     */
+    [[nodiscard]] SPARROW_IPC_API message_index scan_stream(std::span<const uint8_t> data, bool verify = true);
+
+    /**
+     * @brief Counts the rows of the record batches of an IPC stream without reading their bodies.
+     *
+     * @param data The stream, or an IPC file
+     * @param verify Whether the FlatBuffer metadata of each message is verified
+     * @return The sum of the lengths of the RecordBatch messages
+     *
+     * @throws std::runtime_error If a message is invalid or truncated
+     */
+    [[nodiscard]] SPARROW_IPC_API int64_t count_rows(std::span<const uint8_t> data, bool verify = true);
+
+    /**
+     * @brief Reads the schema of an IPC stream, its first message, without scanning the others.
+     *
+     * @param data The stream, or an IPC file
+     * @param options The read options giving the fields to decode, as for deserialize_stream
+     * @return The decoded schema. It points into `data`, which must outlive it.
+     *
+     * @throws std::runtime_error If the stream does not start with a valid Schema message
+     * @throws std::invalid_argument If the projection of `options` does not match the schema
+     */
+    [[nodiscard]] SPARROW_IPC_API decoded_schema
+    read_schema(std::span<const uint8_t> data, const read_options& options = {});
+}
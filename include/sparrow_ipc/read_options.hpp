@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief How much of their input the readers check before decoding it.
+     */
+    enum class validation_level
+    {
+        /**
+         * The input is trusted: the FlatBuffer metadata is not verified and the null counts
+         * are read from the FieldNodes. No buffer is scanned.
+         */
+        none,
+        /**
+         * The FlatBuffer metadata of every message is verified, and the buffers are checked
+         * to be large enough for the length of their array. The data is not scanned.
+         */
+        metadata,
+        /**
+         * In addition to the metadata checks, the offsets of variable-size layouts are checked
+         * to be increasing and within their data buffer, and the null counts are recounted from
+         * the validity bitmaps and checked against the FieldNodes.
+         */
+        full
+    };
+
+    /**
+     * @brief Options controlling how record batches are decoded by the readers.
+     */
+    struct read_options
+    {
+        /**
+         * Number of threads used to decode independent record batches.
+         * 1 decodes everything on the calling thread, 0 uses the hardware concurrency.
+         * The record batches are always returned in stream order.
+         */
+        size_t num_threads = 1;
+
+        /**
+         * Indices, in the schema, of the fields to decode. The columns of the decoded record
+         * batches follow the order of this list. The buffers of the other fields are skipped:
+         * they are neither read nor decompressed.
+         * When neither `field_indices` nor `field_names` is set, all the fields are decoded.
+         */
+        std::optional<std::vector<size_t>> field_indices;
+
+        /**
+         * Names of the fields to decode, as an alternative to `field_indices`.
+         * Setting both is an error.
+         */
+        std::optional<std::vector<std::string>> field_names;
+
+        /**
+         * Checks applied to the messages. `none` is the fastest, for trusted input;
+         * `full` is meant for data coming from untrusted sources.
+         */
+        validation_level validation = validation_level::metadata;
+
+        /**
+         * Number of threads decompressing the buffers of a single compressed record batch.
+         * With 1, each buffer is decompressed when its array is decoded. Otherwise, all the
+         * buffers of the decoded fields are first decompressed concurrently into a single
+         * pre-sized body, then the arrays are built from it; 0 uses the hardware concurrency.
+         * This reduces the latency of reading large batches. It combines with `num_threads`,
+         * each record batch decoded in parallel then using its own decompression threads: the
+         * numbers of threads multiply. When the record batches are decoded on several threads,
+         * 0 decompresses the buffers of each one on its own thread instead, since the hardware
+         * concurrency is already used.
+         * The same threads convert the buffers of a stream written in the byte order opposite
+         * to the one of the host, one buffer per task.
+         */
+        size_t decompression_threads = 1;
+
+        /**
+         * Expands the run-end encoded fields into arrays of the type of their values, for the
+         * consumers that cannot handle run-end encoding. By default, they are decoded zero-copy
+         * as run-end encoded arrays. Only the primitive, boolean, binary and string values can
+         * be expanded: the other fields fail to decode.
+         */
+        bool expand_run_end_encoded = false;
+    };
+}
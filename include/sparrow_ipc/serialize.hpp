@@ -1,13 +1,16 @@
 #pragma once
 
+#include <bit>
 #include <ranges>
 
 #include <sparrow/record_batch.hpp>
 #include "sparrow_ipc/any_output_stream.hpp"
 #include "sparrow_ipc/compression.hpp"
 #include "sparrow_ipc/config/config.hpp"
+#include "sparrow_ipc/dictionary_tracker.hpp"
 #include "sparrow_ipc/magic_values.hpp"
 #include "sparrow_ipc/serialize_utils.hpp"
+#include "sparrow_ipc/tensor.hpp"
 #include "sparrow_ipc/utils.hpp"
 
 namespace sparrow_ipc
@@ -23,13 +26,36 @@ namespace sparrow_ipc
         int32_t metadata_length; ///< Length of the metadata (FlatBuffer message + padding)
         int64_t body_length;     ///< Length of the record batch body (data buffers)
     };
+
+    /**
+     * @brief Serializes a DictionaryBatch message following the Arrow IPC specification.
+     *
+     * The message has the layout of a record batch message, its body holding the buffers of the
+     * dictionary values.
+     *
+     * @param dictionary The dictionary values to serialize, as given by a dictionary_tracker
+     * @param stream The output stream where the serialized message will be written
+     * @param compression Optional: The compression type to use when serializing. The compressed
+     *                    buffers are cached for the duration of the call only, since the values
+     *                    of a delta are released once written.
+     * @param byte_order The byte order of the buffers, the one written in the schema of the stream
+     * @return The metadata and body lengths of the message, for the footer of the file format
+     */
+    SPARROW_IPC_API serialized_record_batch_info serialize_dictionary_batch(
+        const dictionary_batch& dictionary,
+        any_output_stream& stream,
+        std::optional<CompressionType> compression,
+        std::endian byte_order = std::endian::native
+    );
+
     /**
      * @brief Serializes a collection of record batches into a binary format.
      *
      * This function takes a collection of record batches and serializes them into a single
      * binary representation following the Arrow IPC format. The serialization includes:
      * - Schema message (derived from the first record batch)
-     * - All record batch data
+     * - All record batch data, each preceded by the DictionaryBatch messages of the dictionaries
+     *   it adds or changes
      * - End-of-stream marker
      *
      * @tparam R Container type that holds record batches (must support empty(), operator[], begin(), end())
@@ -39,6 +65,8 @@ namespace sparrow_ipc
      * @param compression Optional: The compression type to use when serializing.
      * @param cache Optional: A cache to store and retrieve compressed buffers, avoiding recompression.
      * If compression is given, cache should be set as well.
+     * @param byte_order The byte order of the buffers written in the stream. When it is not the
+     * native one, the cache is not used.
      * @throws std::invalid_argument If record batches have inconsistent schemas or if the collection
      *                               contains batches that cannot be serialized together.
      *
@@ -49,7 +77,8 @@ namespace sparrow_ipc
         requires std::same_as<std::ranges::range_value_t<R>, sparrow::record_batch>
     void serialize_record_batches_to_ipc_stream(const R& record_batches, any_output_stream& stream,
                                                 std::optional<CompressionType> compression,
-                                                std::optional<std::reference_wrapper<CompressionCache>> cache)
+                                                std::optional<std::reference_wrapper<CompressionCache>> cache,
+                                                std::endian byte_order = std::endian::native)
     {
         if (record_batches.empty())
         {
@@ -62,10 +91,15 @@ namespace sparrow_ipc
                 "All record batches must have the same schema to be serialized together."
             );
         }
-        serialize_schema_message(record_batches[0], stream);
+        serialize_schema_message(record_batches[0], stream, byte_order);
+        dictionary_tracker dictionaries;
         for (const auto& rb : record_batches)
         {
-            serialize_record_batch(rb, stream, compression, cache);
+            for (const auto& dictionary : dictionaries.update(rb))
+            {
+                serialize_dictionary_batch(dictionary, stream, compression, byte_order);
+            }
+            serialize_record_batch(rb, stream, compression, cache, byte_order);
         }
         stream.write(end_of_stream);
     }
@@ -84,6 +118,9 @@ namespace sparrow_ipc
      * @param stream The output stream where the serialized record batch will be written
      * @param compression Optional: The compression type to use when serializing.
      * @param cache Optional: A cache to store and retrieve compressed buffers, avoiding recompression.
+     * @param byte_order The byte order of the buffers, the one written in the schema of the stream.
+     * When it is not the native one, the buffers are converted in a copy of the record batch, and
+     * the cache is not used since it is keyed by the addresses of the buffers.
      * @note If compression is given, cache should be set as well.
      * @note The output follows Arrow IPC message format with proper alignment and
      *       includes both metadata and data portions of the record batch
@@ -93,21 +130,31 @@ namespace sparrow_ipc
     serialize_record_batch(const sparrow::record_batch& record_batch,
                            any_output_stream& stream,
                            std::optional<CompressionType> compression,
-                           std::optional<std::reference_wrapper<CompressionCache>> cache);
-    
+                           std::optional<std::reference_wrapper<CompressionCache>> cache,
+                           std::endian byte_order = std::endian::native);
+
+    /**
+     * @brief Serializes a dense tensor into a Tensor message following the Arrow IPC specification.
+     *
+     * The data of the tensor is written as is, as the single buffer of the message body: no
+     * reshape or copy into an intermediate buffer is needed. A Tensor message stands on its own
+     * and is read back with read_tensor.
+     *
+     * @param tensor The tensor to serialize
+     * @param stream The output stream where the serialized message will be written
+     * @throws std::invalid_argument If the tensor fails check_tensor
+     */
+    SPARROW_IPC_API void serialize_tensor(const tensor_view& tensor, any_output_stream& stream);
+
     /**
-     * @brief Serializes a schema message for a record batch into a byte buffer.
+     * @brief Serializes a sparse tensor into a SparseTensor message following the Arrow IPC specification.
      *
-     * This function creates a serialized schema message following the Arrow IPC format.
-     * The resulting buffer contains:
-     * 1. Continuation bytes at the beginning
-     * 2. A 4-byte length prefix indicating the size of the schema message
-     * 3. The actual FlatBuffer schema message bytes
-     * 4. Padding bytes to align the total size to 8-byte boundaries
+     * The body holds the indptr of a CSR or CSC tensor, then its indices and its non-zero values,
+     * each padded to 8 bytes. The message is read back with read_sparse_tensor.
      *
-     * @param record_batch The record batch containing the schema to serialize
-     * @param stream The output stream where the serialized schema message will be written
+     * @param tensor The sparse tensor to serialize, in COO, CSR or CSC layout
+     * @param stream The output stream where the serialized message will be written
+     * @throws std::invalid_argument If the tensor fails check_sparse_tensor
      */
-    SPARROW_IPC_API void
-    serialize_schema_message(const sparrow::record_batch& record_batch, any_output_stream& stream);
+    SPARROW_IPC_API void serialize_sparse_tensor(const sparse_tensor_view& tensor, any_output_stream& stream);
 }
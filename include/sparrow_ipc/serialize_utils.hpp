@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bit>
 #include <ranges>
 #include <vector>
 
@@ -21,10 +22,14 @@ namespace sparrow_ipc
      *
      * @param record_batch The record batch containing the schema to be serialized
      * @param stream The output stream where the serialized schema message will be written
+     * @param byte_order The byte order of the record batches written after the schema
      */
-    SPARROW_IPC_API void
-    serialize_schema_message(const sparrow::record_batch& record_batch, any_output_stream& stream);
-    
+    SPARROW_IPC_API void serialize_schema_message(
+        const sparrow::record_batch& record_batch,
+        any_output_stream& stream,
+        std::endian byte_order = std::endian::native
+    );
+
     /**
      * @brief Calculates the total serialized size of a schema message.
      *
@@ -36,10 +41,13 @@ namespace sparrow_ipc
      * - Padding to 8-byte alignment
      *
      * @param record_batch The record batch containing the schema to be measured
+     * @param byte_order The byte order written in the schema
      * @return The total size in bytes that the serialized schema message would occupy
      */
-    [[nodiscard]] SPARROW_IPC_API std::size_t
-    calculate_schema_message_size(const sparrow::record_batch& record_batch);
+    [[nodiscard]] SPARROW_IPC_API std::size_t calculate_schema_message_size(
+        const sparrow::record_batch& record_batch,
+        std::endian byte_order = std::endian::native
+    );
 
     /**
      * @brief Calculates the total serialized size of a record batch message.
@@ -1,3 +1,4 @@
+#include <bit>
 #include <cstddef>
 #include <numeric>
 
@@ -5,6 +6,7 @@
 
 #include "sparrow_ipc/any_output_stream.hpp"
 #include "sparrow_ipc/compression.hpp"
+#include "sparrow_ipc/dictionary_tracker.hpp"
 #include "sparrow_ipc/serialize.hpp"
 #include "sparrow_ipc/serialize_utils.hpp"
 
@@ -26,6 +28,10 @@ namespace sparrow_ipc
      * std::invalid_argument if inconsistencies are detected or if an empty collection
      * is provided.
      *
+     * The dictionaries of the dictionary-encoded columns are written before the first record
+     * batch using them, then only when they change: a dictionary extending the previous one is
+     * written as a delta holding the appended values.
+     *
      * Memory efficiency is achieved through:
      * - Pre-calculation of total serialization size
      * - Stream reservation to minimize memory reallocations
@@ -42,10 +48,16 @@ namespace sparrow_ipc
          * @param stream Reference to the stream object that will be used for serialization operations.
          *               The serializer stores a pointer to this stream for later use.
          * @param compression Optional: The compression type to use for record batch bodies.
+         * @param byte_order The byte order of the buffers written in the stream. Buffers are converted
+         *                   when it is not the native one.
          */
         template <writable_stream TStream>
-        serializer(TStream& stream, std::optional<CompressionType> compression = std::nullopt)
-            : m_stream(stream), m_compression(compression)
+        serializer(
+            TStream& stream,
+            std::optional<CompressionType> compression = std::nullopt,
+            std::endian byte_order = std::endian::native
+        )
+            : m_stream(stream), m_compression(compression), m_byte_order(byte_order)
         {
         }
 
@@ -105,10 +117,18 @@ namespace sparrow_ipc
                            m_stream.size(),
                            [&compressed_buffers_cache, this](size_t acc, const sparrow::record_batch& rb)
                            {
-                               return acc + calculate_record_batch_message_size(rb, m_compression, compressed_buffers_cache);
+                               // The batches written in another byte order are converted and compressed
+                               // when written, the size of their native buffers is an estimate
+                               return acc + calculate_record_batch_message_size(
+                                                rb,
+                                                m_byte_order == std::endian::native ? m_compression : std::nullopt,
+                                                compressed_buffers_cache
+                                            );
                            }
                        )
-                       + (m_schema_received ? 0 : calculate_schema_message_size(*record_batches.begin()));
+                       + (m_schema_received
+                              ? 0
+                              : calculate_schema_message_size(*record_batches.begin(), m_byte_order));
             };
 
             m_stream.reserve(reserve_function);
@@ -117,7 +137,7 @@ namespace sparrow_ipc
             {
                 m_schema_received = true;
                 m_dtypes = get_column_dtypes(*record_batches.begin());
-                serialize_schema_message(*record_batches.begin(), m_stream);
+                serialize_schema_message(*record_batches.begin(), m_stream, m_byte_order);
             }
 
             for (const auto& rb : record_batches)
@@ -126,7 +146,11 @@ namespace sparrow_ipc
                 {
                     throw std::invalid_argument("Record batch schema does not match serializer schema");
                 }
-                serialize_record_batch(rb, m_stream, m_compression, compressed_buffers_cache);
+                for (const auto& dictionary : m_dictionaries.update(rb))
+                {
+                    serialize_dictionary_batch(dictionary, m_stream, m_compression, m_byte_order);
+                }
+                serialize_record_batch(rb, m_stream, m_compression, compressed_buffers_cache, m_byte_order);
             }
         }
 
@@ -215,9 +239,11 @@ namespace sparrow_ipc
 
         bool m_schema_received{false};
         std::vector<sparrow::data_type> m_dtypes;
+        dictionary_tracker m_dictionaries;
         any_output_stream m_stream;
         bool m_ended{false};
         std::optional<CompressionType> m_compression;
+        std::endian m_byte_order;
     };
 
     inline serializer& end_stream(serializer& serializer)
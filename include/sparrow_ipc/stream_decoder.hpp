@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sparrow/record_batch.hpp>
+
+#include "sparrow_ipc/buffer_pool.hpp"
+#include "sparrow_ipc/config/config.hpp"
+#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/encapsulated_message.hpp"
+#include "sparrow_ipc/read_options.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief Push-based, resumable decoder of an Arrow IPC stream.
+     *
+     * The decoder accepts byte fragments of any size, for instance as they are received from
+     * a socket, and emits each record batch through a callback as soon as the body of its
+     * message is complete. Fragments do not have to be aligned on message boundaries.
+     * DictionaryBatch messages emit nothing: they update the dictionaries of the record
+     * batches that follow them.
+     *
+     * The decoder is a state machine going through the continuation and metadata length prefix,
+     * the metadata and the body of each encapsulated message. At most one message is buffered
+     * at any time; the emitted record batches share the ownership of that buffer, so they stay
+     * valid after the decoder moves on to the next message.
+     *
+     * Usage:
+     * @code
+     * stream_decoder decoder([&](sparrow::record_batch&& rb) { process(std::move(rb)); });
+     * while (auto n = ::recv(socket, buf, sizeof(buf), 0); n > 0)
+     * {
+     *     decoder.consume({buf, static_cast<size_t>(n)});
+     * }
+     * @endcode
+     */
+    class SPARROW_IPC_API stream_decoder
+    {
+    public:
+
+        using record_batch_callback = std::function<void(sparrow::record_batch&&)>;
+
+        /**
+         * @brief Constructs a decoder.
+         *
+         * @param callback Function called with each decoded record batch, in stream order
+         * @param options The read options; the field projection, if any, is applied to every
+         *                record batch. It is checked against the schema when the Schema message is decoded.
+         */
+        explicit stream_decoder(record_batch_callback callback, read_options options = {});
+
+        /**
+         * @brief Feeds a fragment of the stream to the decoder.
+         *
+         * The bytes are copied into the current message buffer, the fragment can be reused
+         * as soon as this function returns. The callback is called for every record batch
+         * completed by this fragment.
+         *
+         * @param fragment The next bytes of the stream
+         *
+         * @throws std::runtime_error If the data is not a valid Arrow IPC stream, contains unsupported
+         *         messages, or if data is received after the end-of-stream marker
+         */
+        void consume(std::span<const uint8_t> fragment);
+
+        /**
+         * @brief Gets the number of bytes needed to complete the current decoding step.
+         *
+         * Consumers can use this value to size their next read. It is 0 once the end
+         * of the stream has been reached.
+         */
+        [[nodiscard]] size_t next_required_size() const noexcept;
+
+        /**
+         * @brief Checks whether the Schema message has been decoded.
+         */
+        [[nodiscard]] bool has_schema() const noexcept;
+
+        /**
+         * @brief Gets the names of the decoded fields of the stream schema.
+         *
+         * @throws std::runtime_error If the Schema message has not been decoded yet
+         */
+        [[nodiscard]] const std::vector<std::string>& names() const;
+
+        /**
+         * @brief Checks whether the end-of-stream marker has been decoded.
+         */
+        [[nodiscard]] bool ended() const noexcept;
+
+    private:
+
+        enum class decoder_state
+        {
+            prefix,
+            metadata,
+            body,
+            end
+        };
+
+        using message_buffer = std::shared_ptr<pooled_byte_vector>;
+
+        // Copies as many bytes as possible from `fragment` into `destination`, starting at `m_filled`.
+        // Returns true when `destination` is full.
+        bool fill(std::span<uint8_t> destination, std::span<const uint8_t>& fragment);
+
+        void on_prefix_complete();
+        void on_metadata_complete();
+        void on_message_complete();
+
+        record_batch_callback m_callback;
+        read_options m_options;
+        decoder_state m_state = decoder_state::prefix;
+        std::array<uint8_t, encapsulated_message_prefix_size> m_prefix{};
+        size_t m_header_size = 0;
+        message_buffer m_message;
+        size_t m_filled = 0;
+        message_buffer m_schema_message;
+        std::optional<decoded_schema> m_schema;
+    };
+}
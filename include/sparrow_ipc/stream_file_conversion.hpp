@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "sparrow_ipc/any_output_stream.hpp"
+#include "sparrow_ipc/config/config.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief Converts an Arrow IPC stream into an Arrow IPC file without decoding it.
+     *
+     * The messages of the stream are copied byte for byte after the leading magic bytes, then
+     * the footer is written with the blocks computed from the index of the messages, and the
+     * schema copied from the Schema message. No body is read, decompressed or compressed: the
+     * conversion only costs the copy of the stream.
+     *
+     * @param stream_data The stream, with or without end-of-stream marker
+     * @param output The output stream the file is written to, from its start
+     * @param verify Whether the FlatBuffer metadata of each message is verified, which is
+     *               required for untrusted input
+     *
+     * @throws std::runtime_error If a message is invalid or truncated, if the stream does not
+     *         start with a Schema message, or if it holds other messages than dictionary and
+     *         record batches after it
+     */
+    SPARROW_IPC_API void
+    stream_to_file(std::span<const uint8_t> stream_data, any_output_stream& output, bool verify = true);
+
+    /**
+     * @brief Converts an Arrow IPC file into an Arrow IPC stream without decoding it.
+     *
+     * The messages of the stream portion of the file are copied byte for byte, followed by an
+     * end-of-stream marker. The footer is only used to locate the end of the stream portion.
+     *
+     * @param file_data The file
+     * @param output The output stream the stream is written to
+     * @param verify Whether the FlatBuffer metadata of each message is verified, which is
+     *               required for untrusted input
+     *
+     * @throws std::runtime_error If `file_data` is not a valid Arrow file, or if its stream
+     *         portion does not start with a Schema message
+     */
+    SPARROW_IPC_API void
+    file_to_stream(std::span<const uint8_t> file_data, any_output_stream& output, bool verify = true);
+}
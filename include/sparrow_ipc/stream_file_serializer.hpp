@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bit>
 #include <cstddef>
 #include <numeric>
 #include <optional>
@@ -10,7 +11,10 @@
 #include "sparrow_ipc/any_output_stream.hpp"
 #include "sparrow_ipc/compression.hpp"
 #include "sparrow_ipc/config/config.hpp"
+#include "sparrow_ipc/dictionary_tracker.hpp"
+#include "sparrow_ipc/encapsulated_message.hpp"
 #include "sparrow_ipc/magic_values.hpp"
+#include "sparrow_ipc/read_options.hpp"
 #include "sparrow_ipc/serialize.hpp"
 #include "sparrow_ipc/serialize_utils.hpp"
 
@@ -19,7 +23,8 @@ namespace sparrow_ipc
     /**
      * @brief Represents a block entry in the Arrow IPC file footer.
      *
-     * Each block describes the location and size of a record batch in the file.
+     * Each block describes the location and size of a record batch or dictionary batch message in
+     * the file.
      */
     struct record_batch_block
     {
@@ -34,14 +39,39 @@ namespace sparrow_ipc
      * @param record_batch A record batch containing the schema for the footer
      * @param record_batch_blocks Vector of block information for each record batch
      * @param stream The output stream to write the footer to
+     * @param dictionary_blocks Vector of block information for each dictionary batch
+     * @param byte_order The byte order of the record batches of the file, written in the schema
      * @return The size of the footer in bytes
      */
     SPARROW_IPC_API size_t write_footer(
         const sparrow::record_batch& record_batch,
         const std::vector<record_batch_block>& record_batch_blocks,
-        any_output_stream& stream
+        any_output_stream& stream,
+        const std::vector<record_batch_block>& dictionary_blocks = {},
+        std::endian byte_order = std::endian::native
     );
-    
+
+    /**
+     * @brief Writes the Arrow IPC file footer with the schema of an existing Schema message.
+     *
+     * The schema is copied byte for byte from the metadata of the message, without being decoded,
+     * so that it is identical to the one of the stream portion of the file.
+     *
+     * @param schema_message The Schema message of the stream
+     * @param record_batch_blocks Vector of block information for each record batch
+     * @param stream The output stream to write the footer to
+     * @param dictionary_blocks Vector of block information for each dictionary batch
+     * @return The size of the footer in bytes
+     *
+     * @throws std::runtime_error If `schema_message` is not a Schema message
+     */
+    SPARROW_IPC_API size_t write_footer(
+        const encapsulated_message& schema_message,
+        const std::vector<record_batch_block>& record_batch_blocks,
+        any_output_stream& stream,
+        const std::vector<record_batch_block>& dictionary_blocks = {}
+    );
+
     /**
      * @brief Deserializes Arrow IPC file format into a vector of record batches.
      *
@@ -66,6 +96,21 @@ namespace sparrow_ipc
     [[nodiscard]] SPARROW_IPC_API std::vector<sparrow::record_batch>
     deserialize_file(std::span<const uint8_t> data);
 
+    /**
+     * @brief Deserializes Arrow IPC file format with the given read options.
+     *
+     * The record batches are located through the footer blocks, so that they can be
+     * decoded concurrently when `options.num_threads` is not 1.
+     *
+     * @param data A span of bytes containing the serialized Arrow IPC file data
+     * @param options The options controlling the decoding; the validation level also applies
+     *                to the footer
+     *
+     * @return std::vector<sparrow::record_batch> The deserialized record batches, in file order
+     */
+    [[nodiscard]] SPARROW_IPC_API std::vector<sparrow::record_batch>
+    deserialize_file(std::span<const uint8_t> data, const read_options& options);
+
     /**
      * @brief A class for serializing Apache Arrow record batches to the IPC file format.
      *
@@ -77,13 +122,18 @@ namespace sparrow_ipc
      * @details The stream_file_serializer follows the Arrow IPC file format specification:
      * - File header magic bytes (ARROW1 + padding)
      * - Stream format data (schema + record batches + end-of-stream marker)
-     * - Footer (FlatBuffer containing schema and empty record batch blocks)
+     * - Footer (FlatBuffer containing schema, dictionary blocks and record batch blocks)
      * - Footer size (int32)
      * - Trailing magic bytes (ARROW1)
      *
      * The class validates that all record batches have consistent schemas and throws
      * std::invalid_argument if inconsistencies are detected.
      *
+     * The dictionaries of the dictionary-encoded columns are written before the first record
+     * batch using them. A dictionary extending the previous one is written as a delta; since the
+     * file format does not allow replacing a dictionary, any other change throws
+     * std::invalid_argument.
+     *
      * @note Unlike the stream serializer, the file serializer automatically writes the
      *       complete file format (including header and footer) when end() is called or
      *       when the destructor is invoked.
@@ -99,10 +149,16 @@ namespace sparrow_ipc
          * @param stream Reference to the stream object that will be used for serialization operations.
          *               The serializer stores a pointer to this stream for later use.
          * @param compression Optional compression type to apply to record batch bodies.
+         * @param byte_order The byte order of the buffers written in the file. Buffers are converted
+         *                   when it is not the native one.
          */
         template <writable_stream TStream>
-        stream_file_serializer(TStream& stream, std::optional<CompressionType> compression = std::nullopt)
-            : m_stream(stream), m_compression(compression)
+        stream_file_serializer(
+            TStream& stream,
+            std::optional<CompressionType> compression = std::nullopt,
+            std::endian byte_order = std::endian::native
+        )
+            : m_stream(stream), m_compression(compression), m_byte_order(byte_order)
         {
         }
 
@@ -176,10 +232,18 @@ namespace sparrow_ipc
                            m_stream.size(),
                            [&compressed_buffers_cache, this](size_t acc, const sparrow::record_batch& rb)
                            {
-                               return acc + calculate_record_batch_message_size(rb, m_compression, compressed_buffers_cache);
+                               // The batches written in another byte order are converted and compressed
+                               // when written, the size of their native buffers is an estimate
+                               return acc + calculate_record_batch_message_size(
+                                                rb,
+                                                m_byte_order == std::endian::native ? m_compression : std::nullopt,
+                                                compressed_buffers_cache
+                                            );
                            }
                        )
-                       + (m_schema_received ? 0 : calculate_schema_message_size(*record_batches.begin()));
+                       + (m_schema_received
+                              ? 0
+                              : calculate_schema_message_size(*record_batches.begin(), m_byte_order));
             };
 
             m_stream.reserve(reserve_function);
@@ -189,7 +253,7 @@ namespace sparrow_ipc
                 m_schema_received = true;
                 m_first_record_batch = *record_batches.begin();
                 m_dtypes = get_column_dtypes(*record_batches.begin());
-                serialize_schema_message(*record_batches.begin(), m_stream);
+                serialize_schema_message(*record_batches.begin(), m_stream, m_byte_order);
             }
 
             for (const auto& rb : record_batches)
@@ -199,11 +263,33 @@ namespace sparrow_ipc
                     throw std::invalid_argument("Record batch schema does not match file serializer schema");
                 }
                 
+                for (const auto& dictionary : m_dictionaries.update(rb))
+                {
+                    const int64_t dictionary_offset = static_cast<int64_t>(m_stream.size());
+                    const auto dictionary_info = serialize_dictionary_batch(
+                        dictionary,
+                        m_stream,
+                        m_compression,
+                        m_byte_order
+                    );
+                    m_dictionary_blocks.emplace_back(
+                        dictionary_offset,
+                        dictionary_info.metadata_length,
+                        dictionary_info.body_length
+                    );
+                }
+
                 // Offset is from the start of the file to the record batch message
                 const int64_t offset = static_cast<int64_t>(m_stream.size());
                 
                 // Serialize and get block info
-                const auto info = serialize_record_batch(rb, m_stream, m_compression, compressed_buffers_cache);
+                const auto info = serialize_record_batch(
+                    rb,
+                    m_stream,
+                    m_compression,
+                    compressed_buffers_cache,
+                    m_byte_order
+                );
                 
                 m_record_batch_blocks.emplace_back(offset, info.metadata_length, info.body_length);
             }
@@ -301,7 +387,10 @@ namespace sparrow_ipc
         any_output_stream m_stream;
         bool m_ended{false};
         std::optional<CompressionType> m_compression;
+        std::endian m_byte_order;
         std::vector<record_batch_block> m_record_batch_blocks;
+        dictionary_tracker m_dictionaries{false};
+        std::vector<record_batch_block> m_dictionary_blocks;
     };
 
     /**
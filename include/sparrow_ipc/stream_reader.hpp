@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sparrow/record_batch.hpp>
+
+#include "sparrow_ipc/any_input_stream.hpp"
+#include "sparrow_ipc/buffer_pool.hpp"
+#include "sparrow_ipc/config/config.hpp"
+#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/lazy_record_batch.hpp"
+#include "sparrow_ipc/read_options.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief Pull-based reader of an Arrow IPC stream.
+     *
+     * Contrary to `deserialize_stream`, which requires the whole stream in memory,
+     * the stream_reader reads one encapsulated message at a time from any readable
+     * stream (std::istream, file descriptor, custom type). The Schema message is read
+     * once, then each call to `next()` reads and decodes a single RecordBatch message,
+     * after the DictionaryBatch messages preceding it.
+     * The peak memory usage is thus bounded by the size of the largest message.
+     *
+     * The returned record batches own the memory of their message, so they remain
+     * valid after the reader is destroyed.
+     *
+     * Usage:
+     * @code
+     * std::ifstream file("data.arrows", std::ios::binary);
+     * stream_reader reader(file);
+     * while (auto batch = reader.next())
+     * {
+     *     process(*batch);
+     * }
+     * @endcode
+     */
+    class SPARROW_IPC_API stream_reader
+    {
+    public:
+
+        /**
+         * @brief Constructs a reader over a readable stream.
+         *
+         * Nothing is read until `names()` or `next()` is called.
+         *
+         * @tparam TStream The type of the stream, must satisfy readable_stream
+         * @param stream The stream to read from. It is stored by reference, so the caller must
+         *               ensure it outlives the reader.
+         * @param options The read options; the field projection, if any, is applied to every
+         *                record batch. It is checked against the schema when the Schema message is read.
+         */
+        template <readable_stream TStream>
+        explicit stream_reader(TStream& stream, read_options options = {});
+
+        /**
+         * @brief Reads and decodes the next record batch of the stream.
+         *
+         * @return The next record batch, or std::nullopt once the end of the stream is reached
+         *
+         * @throws std::runtime_error If the stream is truncated, is not a valid Arrow IPC stream,
+         *         or contains unsupported messages
+         */
+        [[nodiscard]] std::optional<sparrow::record_batch> next();
+
+        /**
+         * @brief Reads the next record batch of the stream, deferring the decoding of its columns.
+         *
+         * The message is read and checked against the schema; each column is decompressed and
+         * decoded when it is first accessed. The lazy record batch owns the memory of its message.
+         *
+         * @return The next lazy record batch, or std::nullopt once the end of the stream is reached
+         *
+         * @throws std::runtime_error If the stream is truncated, is not a valid Arrow IPC stream,
+         *         or contains unsupported messages
+         */
+        [[nodiscard]] std::optional<lazy_record_batch> next_lazy();
+
+        /**
+         * @brief Gets the names of the decoded fields of the stream schema.
+         *
+         * Reads the Schema message if it has not been read yet.
+         *
+         * @return The field names, restricted to the projection if one was given
+         * @throws std::runtime_error If the stream does not start with a Schema message
+         * @throws std::invalid_argument If the projection does not match the schema
+         */
+        [[nodiscard]] const std::vector<std::string>& names();
+
+        /**
+         * @brief Checks whether the end of the stream has been reached.
+         */
+        [[nodiscard]] bool ended() const noexcept;
+
+    private:
+
+        using message_buffer = std::shared_ptr<const pooled_byte_vector>;
+
+        /**
+         * @brief Reads the next encapsulated message of the stream.
+         *
+         * @return The message bytes (prefix, metadata, padding and body), or nullptr at the end
+         *         of the stream
+         */
+        [[nodiscard]] message_buffer read_message();
+
+        /**
+         * @brief Reads the Schema message if needed, then the next RecordBatch message.
+         *
+         * The DictionaryBatch messages preceding the RecordBatch are read into the dictionaries
+         * of the schema.
+         *
+         * @return The message bytes, or nullptr at the end of the stream
+         */
+        [[nodiscard]] message_buffer read_record_batch_message();
+
+        void read_schema();
+
+        any_input_stream m_stream;
+        read_options m_options;
+        message_buffer m_schema_message;
+        std::optional<decoded_schema> m_schema;
+        bool m_ended = false;
+    };
+
+    template <readable_stream TStream>
+    stream_reader::stream_reader(TStream& stream, read_options options)
+        : m_stream(stream)
+        , m_options(std::move(options))
+    {
+    }
+}
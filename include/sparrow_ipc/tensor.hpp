@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sparrow_ipc/config/config.hpp"
+#include "sparrow_ipc/encapsulated_message.hpp"
+
+namespace sparrow_ipc
+{
+    /**
+     * @brief A dimension of a tensor.
+     */
+    struct tensor_dimension
+    {
+        int64_t size = 0;
+        // Optional name of the dimension, empty when unnamed
+        std::string name;
+    };
+
+    /**
+     * @brief A dense tensor whose values are borrowed, written and read as a Tensor message.
+     *
+     * The values are not copied: a tensor read from a message points into the body of the
+     * message, and a tensor to write points to the memory of the caller.
+     */
+    struct tensor_view
+    {
+        // Type of the values, as a format string of the Arrow C data interface. Only the
+        // integer and floating point types are supported.
+        std::string format;
+        std::vector<tensor_dimension> shape;
+        // Number of bytes between two consecutive values of each dimension, or empty when the
+        // values are contiguous in row-major order
+        std::vector<int64_t> strides;
+        std::span<const uint8_t> data;
+        // Optional: an object keeping the memory of `data` alive
+        std::shared_ptr<const void> owner;
+    };
+
+    /**
+     * @brief Layout of the indices of the non-zero values of a sparse tensor.
+     */
+    enum class sparse_tensor_index
+    {
+        // Coordinates of each non-zero value, as a matrix of non_zero_length rows and one column
+        // per dimension
+        coo,
+        // Compressed sparse row matrix: `indptr` holds the offsets of each row in `indices`,
+        // which holds the column of each non-zero value
+        csr,
+        // Compressed sparse column matrix, like csr with the rows and columns swapped
+        csc
+    };
+
+    /**
+     * @brief A sparse tensor whose buffers are borrowed, written and read as a SparseTensor message.
+     *
+     * Like tensor_view, the buffers of a sparse tensor read from a message point into the body
+     * of the message.
+     */
+    struct sparse_tensor_view
+    {
+        // Type of the non-zero values, as a format string of the Arrow C data interface
+        std::string format;
+        std::vector<tensor_dimension> shape;
+        int64_t non_zero_length = 0;
+        sparse_tensor_index index = sparse_tensor_index::coo;
+        // Integer format of the indices
+        std::string indices_format = "l";
+        std::span<const uint8_t> indices;
+        // COO: number of bytes between two consecutive coordinates of each dimension of the
+        // indices matrix, or empty when the matrix is contiguous in row-major order
+        std::vector<int64_t> indices_strides;
+        // COO: whether the coordinates are sorted in lexicographical order without duplicates
+        bool is_canonical = false;
+        // CSR and CSC: integer format of the offsets
+        std::string indptr_format = "l";
+        // CSR and CSC: offsets of the non-zero values of each row, or column, in `indices`
+        std::span<const uint8_t> indptr;
+        std::span<const uint8_t> data;
+        // Optional: an object keeping the memory of the buffers alive
+        std::shared_ptr<const void> owner;
+    };
+
+    /**
+     * @brief Gets the size in bytes of the values of a tensor.
+     *
+     * @param format The format of the values, as a format string of the Arrow C data interface
+     * @throws std::invalid_argument If the format is not the one of an integer or floating point type
+     */
+    [[nodiscard]] SPARROW_IPC_API size_t tensor_value_size(std::string_view format);
+
+    /**
+     * @brief Checks that a tensor is well-formed before it is written.
+     *
+     * @throws std::invalid_argument If the type of the values is not supported, a dimension or
+     *         a stride is negative, the number of strides does not match the shape, or `data`
+     *         does not hold all the values
+     */
+    SPARROW_IPC_API void check_tensor(const tensor_view& tensor);
+
+    /**
+     * @brief Checks that a sparse tensor is well-formed before it is written.
+     *
+     * @throws std::invalid_argument If the type of the values or indices is not supported, a
+     *         CSR or CSC tensor is not a matrix, or a buffer is too small for the shape and the
+     *         number of non-zero values
+     */
+    SPARROW_IPC_API void check_sparse_tensor(const sparse_tensor_view& tensor);
+
+    /**
+     * @brief Reads a Tensor message without copying its values.
+     *
+     * @param message The encapsulated Tensor message
+     * @param body_owner Optional: an object keeping the memory of `message` alive, held by the
+     *                   returned tensor. When empty, the tensor borrows the message memory.
+     * @return The tensor, its data pointing into the body of the message
+     *
+     * @throws std::runtime_error If the message is not a Tensor message, its type is not
+     *         supported, or its data buffer does not hold the values described by its metadata
+     *
+     * @note The FlatBuffer metadata of `message` is expected to have been verified by the caller,
+     *       for instance with extract_encapsulated_message.
+     */
+    [[nodiscard]] SPARROW_IPC_API tensor_view
+    read_tensor(const encapsulated_message& message, std::shared_ptr<const void> body_owner = nullptr);
+
+    /**
+     * @brief Reads a SparseTensor message in COO, CSR or CSC layout without copying its buffers.
+     *
+     * @param message The encapsulated SparseTensor message
+     * @param body_owner Optional: an object keeping the memory of `message` alive, held by the
+     *                   returned tensor. When empty, the tensor borrows the message memory.
+     * @return The sparse tensor, its buffers pointing into the body of the message
+     *
+     * @throws std::runtime_error If the message is not a SparseTensor message, its index is a
+     *         CSF one, its types are not supported, or its buffers do not hold the values
+     *         described by its metadata
+     *
+     * @note The FlatBuffer metadata of `message` is expected to have been verified by the caller.
+     */
+    [[nodiscard]] SPARROW_IPC_API sparse_tensor_view
+    read_sparse_tensor(const encapsulated_message& message, std::shared_ptr<const void> body_owner = nullptr);
+}
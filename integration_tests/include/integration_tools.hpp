@@ -44,20 +44,20 @@ namespace integration_tools
     std::vector<uint8_t> json_to_stream(const nlohmann::json& json_data);
 
     /**
-     * @brief Reads an Arrow IPC stream and re-serializes it to file format.
+     * @brief Converts an Arrow IPC stream to file format, copying its messages without decoding them.
      *
      * @param input_stream_data Binary Arrow IPC stream data
-     * @return Vector of bytes containing the re-serialized Arrow IPC file format stream
-     * @throws std::runtime_error if the stream cannot be deserialized
+     * @return Vector of bytes containing the Arrow IPC file
+     * @throws std::runtime_error if the stream is invalid
      */
     std::vector<uint8_t> stream_to_file(std::span<const uint8_t> input_stream_data);
 
     /**
-     * @brief Reads an Arrow IPC file and re-serializes it to stream format.
+     * @brief Converts an Arrow IPC file to stream format, copying its messages without decoding them.
      *
      * @param input_file_data Binary Arrow IPC file data
-     * @return Vector of bytes containing the re-serialized Arrow IPC stream format
-     * @throws std::runtime_error if the file cannot be deserialized
+     * @return Vector of bytes containing the Arrow IPC stream
+     * @throws std::runtime_error if the file is invalid
      */
     std::vector<uint8_t> file_to_stream(std::span<const uint8_t> input_file_data);
 
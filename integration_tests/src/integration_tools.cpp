@@ -13,6 +13,7 @@
 #include <sparrow_ipc/deserialize.hpp>
 #include <sparrow_ipc/memory_output_stream.hpp>
 #include <sparrow_ipc/serializer.hpp>
+#include <sparrow_ipc/stream_file_conversion.hpp>
 
 #include <sparrow/json_reader/json_parser.hpp>
 
@@ -94,22 +95,19 @@ namespace integration_tools
             throw std::runtime_error("Input stream data is empty");
         }
 
-        std::vector<sparrow::record_batch> record_batches;
+        std::vector<uint8_t> output_file_data;
+        sparrow_ipc::memory_output_stream output(output_file_data);
+        sparrow_ipc::any_output_stream stream(output);
         try
         {
-            record_batches = sparrow_ipc::deserialize_stream(input_stream_data);
+            sparrow_ipc::stream_to_file(input_stream_data, stream);
         }
         catch (const std::exception& e)
         {
-            throw std::runtime_error("Failed to deserialize stream: " + std::string(e.what()));
+            throw std::runtime_error("Failed to convert stream: " + std::string(e.what()));
         }
 
-        std::vector<uint8_t> output_stream_data;
-        sparrow_ipc::memory_output_stream stream(output_stream_data);
-        sparrow_ipc::stream_file_serializer serializer(stream);
-        serializer << record_batches << sparrow_ipc::end_file;
-
-        return output_stream_data;
+        return output_file_data;
     }
 
     std::vector<uint8_t> file_to_stream(std::span<const uint8_t> input_file_data)
@@ -119,21 +117,18 @@ namespace integration_tools
             throw std::runtime_error("Input file data is empty");
         }
 
-        std::vector<sparrow::record_batch> record_batches;
+        std::vector<uint8_t> output_stream_data;
+        sparrow_ipc::memory_output_stream output(output_stream_data);
+        sparrow_ipc::any_output_stream stream(output);
         try
         {
-            record_batches = sparrow_ipc::deserialize_file(input_file_data);
+            sparrow_ipc::file_to_stream(input_file_data, stream);
         }
         catch (const std::exception& e)
         {
-            throw std::runtime_error("Failed to deserialize file: " + std::string(e.what()));
+            throw std::runtime_error("Failed to convert file: " + std::string(e.what()));
         }
 
-        std::vector<uint8_t> output_stream_data;
-        sparrow_ipc::memory_output_stream stream(output_stream_data);
-        sparrow_ipc::serializer serializer(stream);
-        serializer << record_batches << sparrow_ipc::end_stream;
-
         return output_stream_data;
     }
 
@@ -0,0 +1,14 @@
+#include "sparrow_ipc/any_input_stream.hpp"
+
+namespace sparrow_ipc
+{
+    size_t any_input_stream::read(std::span<std::uint8_t> span)
+    {
+        return m_impl->read(span);
+    }
+
+    size_t any_input_stream::position() const
+    {
+        return m_impl->position();
+    }
+}  // namespace sparrow_ipc
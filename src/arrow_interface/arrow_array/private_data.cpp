@@ -34,4 +34,9 @@ namespace sparrow_ipc
     {
         return m_buffers.size();
     }
+
+    void arrow_array_private_data::set_owner(std::shared_ptr<const void> owner) noexcept
+    {
+        m_owner = std::move(owner);
+    }
 }
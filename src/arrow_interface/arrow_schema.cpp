@@ -11,4 +11,25 @@ namespace sparrow_ipc
         release_common_non_owning_arrow(*schema);
         *schema = {};
     }
-}
\ No newline at end of file
+
+    ArrowSchema make_shared_arrow_schema(
+        const char* format,
+        const char* name,
+        const char* metadata,
+        int64_t flags,
+        std::shared_ptr<const void> owner
+    )
+    {
+        ArrowSchema schema{};
+        schema.private_data = new non_owning_arrow_schema_private_data(format, name, metadata, std::move(owner));
+        schema.format = format;
+        schema.name = name;
+        schema.metadata = metadata;
+        schema.flags = flags;
+        schema.n_children = 0;
+        schema.children = nullptr;
+        schema.dictionary = nullptr;
+        schema.release = release_non_owning_arrow_schema;
+        return schema;
+    }
+}
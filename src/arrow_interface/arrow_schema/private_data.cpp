@@ -8,14 +8,29 @@ namespace sparrow_ipc
         std::optional<std::string> metadata
     )
         : m_format(format)
+        , m_format_ptr(m_format.c_str())
         , m_name(name)
         , m_metadata(std::move(metadata))
+        , m_metadata_ptr(m_metadata.has_value() ? m_metadata->c_str() : nullptr)
+    {
+    }
+
+    non_owning_arrow_schema_private_data::non_owning_arrow_schema_private_data(
+        const char* format,
+        const char* name,
+        const char* metadata,
+        std::shared_ptr<const void> owner
+    )
+        : m_format_ptr(format)
+        , m_name(name)
+        , m_metadata_ptr(metadata)
+        , m_owner(std::move(owner))
     {
     }
 
     const char* non_owning_arrow_schema_private_data::format_ptr() const noexcept
     {
-        return m_format.data();
+        return m_format_ptr;
     }
 
     const char* non_owning_arrow_schema_private_data::name_ptr() const noexcept
@@ -25,6 +40,6 @@ namespace sparrow_ipc
 
     const char* non_owning_arrow_schema_private_data::metadata_ptr() const noexcept
     {
-        return m_metadata.has_value() ? m_metadata->c_str() : nullptr;
+        return m_metadata_ptr;
     }
 }
\ No newline at end of file
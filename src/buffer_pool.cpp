@@ -0,0 +1,148 @@
+#include "sparrow_ipc/buffer_pool.hpp"
+
+#include <bit>
+#include <new>
+
+namespace sparrow_ipc
+{
+    namespace
+    {
+        constexpr size_t min_block_shift = static_cast<size_t>(std::countr_zero(buffer_pool::min_block_size));
+
+        // Index of the size class of a request, size_class_count for the requests bypassing the pool
+        size_t size_class(size_t size)
+        {
+            if (size <= buffer_pool::min_block_size)
+            {
+                return 0;
+            }
+            return static_cast<size_t>(std::bit_width(size - 1)) - min_block_shift;
+        }
+
+        constexpr size_t block_size(size_t index)
+        {
+            return buffer_pool::min_block_size << index;
+        }
+
+        void* allocate_block(size_t size)
+        {
+            return ::operator new(size, std::align_val_t{buffer_pool::alignment});
+        }
+
+        void free_block(void* pointer) noexcept
+        {
+            ::operator delete(pointer, std::align_val_t{buffer_pool::alignment});
+        }
+    }
+
+    static_assert(block_size(20) == buffer_pool::max_block_size);
+
+    buffer_pool::buffer_pool(size_t limit)
+        : m_max_cached_bytes(limit)
+    {
+    }
+
+    buffer_pool::~buffer_pool()
+    {
+        release_cached();
+    }
+
+    const std::shared_ptr<buffer_pool>& buffer_pool::default_pool()
+    {
+        // Never destroyed: buffers released during the static destruction still return to it
+        static const auto* pool = new std::shared_ptr<buffer_pool>(std::make_shared<buffer_pool>());
+        return *pool;
+    }
+
+    void* buffer_pool::allocate(size_t size)
+    {
+        const size_t index = size_class(size);
+        if (index >= size_class_count)
+        {
+            return allocate_block(size);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto& idle_blocks = m_idle_blocks[index];
+            if (!idle_blocks.empty())
+            {
+                void* block = idle_blocks.back();
+                idle_blocks.pop_back();
+                m_stats.cached_bytes -= block_size(index);
+                ++m_stats.reused_blocks;
+                return block;
+            }
+            ++m_stats.allocated_blocks;
+        }
+        return allocate_block(block_size(index));
+    }
+
+    void buffer_pool::deallocate(void* pointer, size_t size) noexcept
+    {
+        if (pointer == nullptr)
+        {
+            return;
+        }
+        const size_t index = size_class(size);
+        if (index < size_class_count)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stats.cached_bytes + block_size(index) <= m_max_cached_bytes)
+            {
+                try
+                {
+                    m_idle_blocks[index].push_back(pointer);
+                    m_stats.cached_bytes += block_size(index);
+                    return;
+                }
+                catch (const std::bad_alloc&)
+                {
+                    // The block is freed below
+                }
+            }
+        }
+        free_block(pointer);
+    }
+
+    void buffer_pool::release_cached() noexcept
+    {
+        trim(0);
+    }
+
+    size_t buffer_pool::max_cached_bytes() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_max_cached_bytes;
+    }
+
+    void buffer_pool::set_max_cached_bytes(size_t limit) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_max_cached_bytes = limit;
+        }
+        trim(limit);
+    }
+
+    buffer_pool::statistics buffer_pool::stats() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    void buffer_pool::trim(size_t limit) noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // The largest blocks are released first
+        for (size_t index = size_class_count; index-- > 0 && m_stats.cached_bytes > limit;)
+        {
+            auto& idle_blocks = m_idle_blocks[index];
+            while (!idle_blocks.empty() && m_stats.cached_bytes > limit)
+            {
+                free_block(idle_blocks.back());
+                idle_blocks.pop_back();
+                m_stats.cached_bytes -= block_size(index);
+            }
+        }
+    }
+}
@@ -0,0 +1,264 @@
+#include "byte_swap.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "sparrow_ipc/flatbuffer_utils.hpp"
+
+namespace sparrow_ipc::details
+{
+    namespace
+    {
+        // Size in bytes of a view of binary and string views, and of the data inlined in it
+        constexpr size_t VIEW_SIZE = 16;
+        constexpr int32_t MAX_INLINED_SIZE = 12;
+
+        // Reverses the bytes of the value of `Size` bytes at `source` into `destination`. The value
+        // is loaded before being stored, so that both may be the same memory.
+        template <size_t Size>
+        void reverse_value(const uint8_t* source, uint8_t* destination)
+        {
+            std::array<uint8_t, Size> value;
+            std::memcpy(value.data(), source, Size);
+            std::ranges::reverse(value);
+            std::memcpy(destination, value.data(), Size);
+        }
+
+        // Reverses the bytes of each value of `Size` bytes. The loop has a fixed stride and no
+        // branch, so that the compiler turns it into byte shuffles of vector registers.
+        template <size_t Size>
+        void reverse_values(const uint8_t* source, uint8_t* destination, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                reverse_value<Size>(source + i * Size, destination + i * Size);
+            }
+        }
+
+        void swap_month_day_nano(const uint8_t* source, uint8_t* destination, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t offset = i * 16;
+                reverse_value<4>(source + offset, destination + offset);
+                reverse_value<4>(source + offset + 4, destination + offset + 4);
+                reverse_value<8>(source + offset + 8, destination + offset + 8);
+            }
+        }
+
+        void swap_views(const uint8_t* source, uint8_t* destination, size_t count, bool source_is_native)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t offset = i * VIEW_SIZE;
+                int32_t length = 0;
+                if (source_is_native)
+                {
+                    std::memcpy(&length, source + offset, sizeof(length));
+                }
+                std::array<uint8_t, VIEW_SIZE> view;
+                std::memcpy(view.data(), source + offset, VIEW_SIZE);
+                reverse_value<4>(view.data(), view.data());
+                if (!source_is_native)
+                {
+                    std::memcpy(&length, view.data(), sizeof(length));
+                }
+                // The prefix and the inlined data are bytes, only the buffer index and the offset
+                // of the data that is not inlined are integers
+                if (length > MAX_INLINED_SIZE)
+                {
+                    reverse_value<4>(view.data() + 8, view.data() + 8);
+                    reverse_value<4>(view.data() + 12, view.data() + 12);
+                }
+                std::memcpy(destination + offset, view.data(), VIEW_SIZE);
+            }
+        }
+
+        // Size in bytes of the values of a buffer of `kind`
+        size_t value_size(byte_swap_kind kind)
+        {
+            switch (kind)
+            {
+                case byte_swap_kind::none:
+                    return 1;
+                case byte_swap_kind::bytes_2:
+                    return 2;
+                case byte_swap_kind::bytes_4:
+                    return 4;
+                case byte_swap_kind::bytes_8:
+                    return 8;
+                case byte_swap_kind::bytes_16:
+                case byte_swap_kind::month_day_nano:
+                case byte_swap_kind::views:
+                    return 16;
+                case byte_swap_kind::bytes_32:
+                    return 32;
+            }
+            return 1;
+        }
+
+        void byte_swap_array(const sparrow::arrow_proxy& proxy)
+        {
+            const std::vector<byte_swap_kind> kinds = get_byte_swap_kinds(proxy.data_type());
+            size_t buffer_index = 0;
+            for_each_body_buffer(
+                proxy,
+                [&](std::span<const uint8_t> buffer)
+                {
+                    const byte_swap_kind kind = buffer_index < kinds.size() ? kinds[buffer_index]
+                                                                            : byte_swap_kind::none;
+                    ++buffer_index;
+                    if (kind != byte_swap_kind::none && !buffer.empty())
+                    {
+                        // The buffers belong to the copy made by byte_swapped
+                        std::span<uint8_t> mutable_buffer(const_cast<uint8_t*>(buffer.data()), buffer.size());
+                        byte_swap_copy(kind, buffer, mutable_buffer, true);
+                    }
+                }
+            );
+            for (const auto& child : proxy.children())
+            {
+                byte_swap_array(child);
+            }
+        }
+    }
+
+    std::vector<byte_swap_kind> get_byte_swap_kinds(sparrow::data_type data_type)
+    {
+        using enum byte_swap_kind;
+        switch (data_type)
+        {
+            case sparrow::data_type::NA:
+            case sparrow::data_type::RUN_ENCODED:
+                return {};
+            case sparrow::data_type::BOOL:
+            case sparrow::data_type::INT8:
+            case sparrow::data_type::UINT8:
+            case sparrow::data_type::FIXED_WIDTH_BINARY:
+            case sparrow::data_type::STRUCT:
+            case sparrow::data_type::FIXED_SIZED_LIST:
+                return {none, none};
+            case sparrow::data_type::SPARSE_UNION:
+                return {none};
+            case sparrow::data_type::INT16:
+            case sparrow::data_type::UINT16:
+            case sparrow::data_type::HALF_FLOAT:
+                return {none, bytes_2};
+            case sparrow::data_type::INT32:
+            case sparrow::data_type::UINT32:
+            case sparrow::data_type::FLOAT:
+            case sparrow::data_type::DATE_DAYS:
+            case sparrow::data_type::TIME_SECONDS:
+            case sparrow::data_type::TIME_MILLISECONDS:
+            case sparrow::data_type::INTERVAL_MONTHS:
+            case sparrow::data_type::INTERVAL_DAYS_TIME:
+            case sparrow::data_type::DECIMAL32:
+            case sparrow::data_type::LIST:
+            case sparrow::data_type::MAP:
+                return {none, bytes_4};
+            case sparrow::data_type::INT64:
+            case sparrow::data_type::UINT64:
+            case sparrow::data_type::DOUBLE:
+            case sparrow::data_type::DATE_MILLISECONDS:
+            case sparrow::data_type::TIME_MICROSECONDS:
+            case sparrow::data_type::TIME_NANOSECONDS:
+            case sparrow::data_type::TIMESTAMP_SECONDS:
+            case sparrow::data_type::TIMESTAMP_MILLISECONDS:
+            case sparrow::data_type::TIMESTAMP_MICROSECONDS:
+            case sparrow::data_type::TIMESTAMP_NANOSECONDS:
+            case sparrow::data_type::DURATION_SECONDS:
+            case sparrow::data_type::DURATION_MILLISECONDS:
+            case sparrow::data_type::DURATION_MICROSECONDS:
+            case sparrow::data_type::DURATION_NANOSECONDS:
+            case sparrow::data_type::DECIMAL64:
+            case sparrow::data_type::LARGE_LIST:
+                return {none, bytes_8};
+            case sparrow::data_type::DECIMAL128:
+                return {none, bytes_16};
+            case sparrow::data_type::DECIMAL256:
+                return {none, bytes_32};
+            case sparrow::data_type::INTERVAL_MONTHS_DAYS_NANOSECONDS:
+                return {none, month_day_nano};
+            case sparrow::data_type::STRING:
+            case sparrow::data_type::BINARY:
+                return {none, bytes_4, none};
+            case sparrow::data_type::LARGE_STRING:
+            case sparrow::data_type::LARGE_BINARY:
+                return {none, bytes_8, none};
+            case sparrow::data_type::STRING_VIEW:
+            case sparrow::data_type::BINARY_VIEW:
+                return {none, views};
+            case sparrow::data_type::LIST_VIEW:
+                return {none, bytes_4, bytes_4};
+            case sparrow::data_type::LARGE_LIST_VIEW:
+                return {none, bytes_8, bytes_8};
+            case sparrow::data_type::DENSE_UNION:
+                return {none, bytes_4};
+            default:
+                throw std::runtime_error(
+                    "Cannot convert the byte order of data type "
+                    + std::to_string(static_cast<int>(data_type))
+                );
+        }
+    }
+
+    void byte_swap_copy(
+        byte_swap_kind kind,
+        std::span<const uint8_t> source,
+        std::span<uint8_t> destination,
+        bool source_is_native
+    )
+    {
+        if (destination.size() < source.size())
+        {
+            throw std::runtime_error("Byte swap destination is smaller than its source");
+        }
+        const size_t size = value_size(kind);
+        const size_t count = source.size() / size;
+        const uint8_t* in = source.data();
+        uint8_t* out = destination.data();
+        switch (kind)
+        {
+            case byte_swap_kind::none:
+                break;
+            case byte_swap_kind::bytes_2:
+                reverse_values<2>(in, out, count);
+                break;
+            case byte_swap_kind::bytes_4:
+                reverse_values<4>(in, out, count);
+                break;
+            case byte_swap_kind::bytes_8:
+                reverse_values<8>(in, out, count);
+                break;
+            case byte_swap_kind::bytes_16:
+                reverse_values<16>(in, out, count);
+                break;
+            case byte_swap_kind::bytes_32:
+                reverse_values<32>(in, out, count);
+                break;
+            case byte_swap_kind::month_day_nano:
+                swap_month_day_nano(in, out, count);
+                break;
+            case byte_swap_kind::views:
+                swap_views(in, out, count, source_is_native);
+                break;
+        }
+        // Bytes that are not part of a whole value, and the whole buffer when there is nothing to swap
+        const size_t swapped_size = kind == byte_swap_kind::none ? 0 : count * size;
+        if (in != out && swapped_size < source.size())
+        {
+            std::memcpy(out + swapped_size, in + swapped_size, source.size() - swapped_size);
+        }
+    }
+
+    sparrow::array byte_swapped(const sparrow::array& array)
+    {
+        // Copying an array copies its buffers
+        sparrow::array copy = array;
+        byte_swap_array(sparrow::detail::array_access::get_arrow_proxy(copy));
+        return copy;
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <sparrow/array.hpp>
+#include <sparrow/types/data_type.hpp>
+
+namespace sparrow_ipc::details
+{
+    /**
+     * @brief How the byte order of the values of a buffer is converted.
+     */
+    enum class byte_swap_kind
+    {
+        // Bytes, bitmaps and binary data are the same in both byte orders
+        none,
+        // Values of 2, 4, 8, 16 or 32 bytes, whose bytes are reversed: integers, floating point
+        // numbers, offsets, and decimals of 128 and 256 bits
+        bytes_2,
+        bytes_4,
+        bytes_8,
+        bytes_16,
+        bytes_32,
+        // Intervals of 16 bytes: months and days on 4 bytes, then nanoseconds on 8 bytes
+        month_day_nano,
+        // Views of 16 bytes of binary and string views: the length, then either the inlined
+        // data, or a prefix followed by the index and offset of the data in the variadic buffers
+        views
+    };
+
+    /**
+     * @brief Gets how to convert the byte order of the own buffers of an array, its children
+     *        and the variadic data buffers of a view excluded.
+     *
+     * @param data_type The data type of the array; a dictionary-encoded array has the type of
+     *                  its indices
+     * @return One kind per buffer, in the order of the buffers of the Arrow columnar format
+     *
+     * @throws std::runtime_error If the byte order of the type cannot be converted
+     */
+    [[nodiscard]] std::vector<byte_swap_kind> get_byte_swap_kinds(sparrow::data_type data_type);
+
+    /**
+     * @brief Copies a buffer while converting the byte order of its values.
+     *
+     * The values are converted one at a time with fixed-width loops that the compiler vectorizes,
+     * so `source` and `destination` may be the same memory. The trailing bytes of a buffer not
+     * holding a whole value are copied unchanged.
+     *
+     * @param kind The layout of the values of the buffer
+     * @param source The buffer to convert
+     * @param destination The converted buffer, at least as large as `source`
+     * @param source_is_native Whether `source` is in the byte order of the host: the views use
+     *                         their length to tell whether their data is inlined
+     */
+    void byte_swap_copy(
+        byte_swap_kind kind,
+        std::span<const uint8_t> source,
+        std::span<uint8_t> destination,
+        bool source_is_native
+    );
+
+    /**
+     * @brief Copies an array and its children with the byte order of their buffers reversed.
+     *
+     * The dictionary of a dictionary-encoded array is left in the byte order of the host: it is
+     * written by its own DictionaryBatch messages.
+     *
+     * @throws std::runtime_error If the byte order of a type of the array cannot be converted
+     */
+    [[nodiscard]] sparrow::array byte_swapped(const sparrow::array& array);
+}
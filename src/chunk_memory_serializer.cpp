@@ -2,8 +2,12 @@
 
 namespace sparrow_ipc
 {
-    chunk_serializer::chunk_serializer(chunked_memory_output_stream<std::vector<std::vector<uint8_t>>>& stream, std::optional<CompressionType> compression)
-        : m_pstream(&stream), m_compression(compression)
+    chunk_serializer::chunk_serializer(
+        chunked_memory_output_stream<std::vector<std::vector<uint8_t>>>& stream,
+        std::optional<CompressionType> compression,
+        std::endian byte_order
+    )
+        : m_pstream(&stream), m_compression(compression), m_byte_order(byte_order)
     {
     }
 
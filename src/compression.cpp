@@ -1,13 +1,18 @@
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <iterator>
+#include <mutex>
 #include <stdexcept>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include <lz4frame.h>
 #include <zstd.h>
 
+#include "sparrow_ipc/buffer_pool.hpp"
+
 #include "compression_impl.hpp"
 
 namespace sparrow_ipc
@@ -158,34 +163,246 @@ namespace sparrow_ipc
         using compress_func = std::function<std::vector<uint8_t>(std::span<const uint8_t>)>;
         using decompress_func = std::function<sparrow::buffer<uint8_t>(std::span<const uint8_t>, int64_t)>;
 
-        std::vector<std::uint8_t> lz4_compress_with_header(std::span<const std::uint8_t> data)
+        /**
+         * Pool of codec contexts shared by all the threads.
+         *
+         * Creating a context allocates its internal state (several hundred kilobytes for ZSTD), so
+         * the contexts are kept once released and handed out again for the next buffers, including
+         * the buffers of the next batches and the ones decompressed by other threads.
+         */
+        template <typename Context, Context* (*create)(), void (*destroy)(Context*)>
+        class codec_context_pool
         {
-            const std::int64_t uncompressed_size = data.size();
-            const size_t max_compressed_size = LZ4F_compressFrameBound(uncompressed_size, nullptr);
-            std::vector<std::uint8_t> result(details::CompressionHeaderSize + max_compressed_size);
-            const size_t compressed_size = LZ4F_compressFrame(result.data() + details::CompressionHeaderSize, max_compressed_size, data.data(), uncompressed_size, nullptr);
-            if (LZ4F_isError(compressed_size))
+        public:
+
+            /**
+             * @brief Context borrowed from the pool, returned to it on destruction.
+             */
+            class lease
+            {
+            public:
+
+                lease(codec_context_pool& pool, Context* context)
+                    : m_pool(pool)
+                    , m_context(context)
+                {
+                }
+
+                ~lease()
+                {
+                    if (m_context != nullptr)
+                    {
+                        m_pool.release(m_context);
+                    }
+                }
+
+                lease(const lease&) = delete;
+                lease& operator=(const lease&) = delete;
+
+                [[nodiscard]] Context* get() const noexcept
+                {
+                    return m_context;
+                }
+
+                /**
+                 * @brief Destroys the context instead of returning it to the pool, for contexts
+                 * left in an unknown state by an error.
+                 */
+                void discard() noexcept
+                {
+                    destroy(m_context);
+                    m_context = nullptr;
+                }
+
+            private:
+
+                codec_context_pool& m_pool;
+                Context* m_context;
+            };
+
+            codec_context_pool() = default;
+            codec_context_pool(const codec_context_pool&) = delete;
+            codec_context_pool& operator=(const codec_context_pool&) = delete;
+
+            ~codec_context_pool()
+            {
+                for (Context* context : m_contexts)
+                {
+                    destroy(context);
+                }
+            }
+
+            [[nodiscard]] lease acquire()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!m_contexts.empty())
+                    {
+                        Context* context = m_contexts.back();
+                        m_contexts.pop_back();
+                        return lease(*this, context);
+                    }
+                }
+                return lease(*this, create());
+            }
+
+        private:
+
+            void release(Context* context)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_contexts.push_back(context);
+            }
+
+            std::mutex m_mutex;
+            std::vector<Context*> m_contexts;
+        };
+
+        LZ4F_cctx* create_lz4_cctx()
+        {
+            LZ4F_cctx* context = nullptr;
+            if (LZ4F_isError(LZ4F_createCompressionContext(&context, LZ4F_VERSION)))
+            {
+                throw std::runtime_error("Failed to create an LZ4 compression context");
+            }
+            return context;
+        }
+
+        void free_lz4_cctx(LZ4F_cctx* context)
+        {
+            LZ4F_freeCompressionContext(context);
+        }
+
+        LZ4F_dctx* create_lz4_dctx()
+        {
+            LZ4F_dctx* context = nullptr;
+            if (LZ4F_isError(LZ4F_createDecompressionContext(&context, LZ4F_VERSION)))
+            {
+                throw std::runtime_error("Failed to create an LZ4 decompression context");
+            }
+            return context;
+        }
+
+        void free_lz4_dctx(LZ4F_dctx* context)
+        {
+            LZ4F_freeDecompressionContext(context);
+        }
+
+        ZSTD_CCtx* create_zstd_cctx()
+        {
+            ZSTD_CCtx* context = ZSTD_createCCtx();
+            if (context == nullptr)
+            {
+                throw std::runtime_error("Failed to create a ZSTD compression context");
+            }
+            return context;
+        }
+
+        void free_zstd_cctx(ZSTD_CCtx* context)
+        {
+            ZSTD_freeCCtx(context);
+        }
+
+        ZSTD_DCtx* create_zstd_dctx()
+        {
+            ZSTD_DCtx* context = ZSTD_createDCtx();
+            if (context == nullptr)
             {
-                throw std::runtime_error("Failed to compress data with LZ4 frame format");
+                throw std::runtime_error("Failed to create a ZSTD decompression context");
             }
+            return context;
+        }
+
+        void free_zstd_dctx(ZSTD_DCtx* context)
+        {
+            ZSTD_freeDCtx(context);
+        }
+
+        using lz4_cctx_pool = codec_context_pool<LZ4F_cctx, create_lz4_cctx, free_lz4_cctx>;
+        using lz4_dctx_pool = codec_context_pool<LZ4F_dctx, create_lz4_dctx, free_lz4_dctx>;
+        using zstd_cctx_pool = codec_context_pool<ZSTD_CCtx, create_zstd_cctx, free_zstd_cctx>;
+        using zstd_dctx_pool = codec_context_pool<ZSTD_DCtx, create_zstd_dctx, free_zstd_dctx>;
+
+        lz4_cctx_pool& get_lz4_cctx_pool()
+        {
+            static lz4_cctx_pool pool;
+            return pool;
+        }
+
+        lz4_dctx_pool& get_lz4_dctx_pool()
+        {
+            static lz4_dctx_pool pool;
+            return pool;
+        }
+
+        zstd_cctx_pool& get_zstd_cctx_pool()
+        {
+            static zstd_cctx_pool pool;
+            return pool;
+        }
+
+        zstd_dctx_pool& get_zstd_dctx_pool()
+        {
+            static zstd_dctx_pool pool;
+            return pool;
+        }
+
+        std::vector<std::uint8_t> lz4_compress_with_header(std::span<const std::uint8_t> data)
+        {
+            const std::int64_t uncompressed_size = static_cast<std::int64_t>(data.size());
+            LZ4F_preferences_t preferences{};
+            preferences.autoFlush = 1;
+            // The bound of LZ4F_compressBound covers the data and the frame footer, not the header
+            const size_t capacity = LZ4F_HEADER_SIZE_MAX + LZ4F_compressBound(data.size(), &preferences);
+            std::vector<std::uint8_t> result(details::CompressionHeaderSize + capacity);
+            std::uint8_t* const destination = result.data() + details::CompressionHeaderSize;
+
+            // LZ4F_compressBegin resets the context, whatever state a previous error left it in
+            auto context = get_lz4_cctx_pool().acquire();
+            size_t compressed_size = 0;
+            auto check = [](size_t written)
+            {
+                if (LZ4F_isError(written))
+                {
+                    throw std::runtime_error("Failed to compress data with LZ4 frame format");
+                }
+                return written;
+            };
+            compressed_size += check(LZ4F_compressBegin(context.get(), destination, capacity, &preferences));
+            compressed_size += check(LZ4F_compressUpdate(
+                context.get(),
+                destination + compressed_size,
+                capacity - compressed_size,
+                data.data(),
+                data.size(),
+                nullptr
+            ));
+            compressed_size += check(
+                LZ4F_compressEnd(context.get(), destination + compressed_size, capacity - compressed_size, nullptr)
+            );
             memcpy(result.data(), &uncompressed_size, sizeof(uncompressed_size));
             result.resize(details::CompressionHeaderSize + compressed_size);
             return result;
         }
 
-        sparrow::buffer<std::uint8_t> lz4_decompress(std::span<const std::uint8_t> data, const std::int64_t decompressed_size)
+        void lz4_decompress_into(std::span<const std::uint8_t> data, std::span<std::uint8_t> destination)
         {
-            sparrow::buffer<std::uint8_t> decompressed_data(decompressed_size, sparrow::buffer<std::uint8_t>::default_allocator());
-            LZ4F_dctx* dctx = nullptr;
-            LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION);
+            auto context = get_lz4_dctx_pool().acquire();
             size_t compressed_size_in_out = data.size();
-            size_t decompressed_size_in_out = decompressed_size;
-            const size_t result = LZ4F_decompress(dctx, decompressed_data.data(), &decompressed_size_in_out, data.data(), &compressed_size_in_out, nullptr);
-            if (LZ4F_isError(result) || (decompressed_size_in_out != (size_t)decompressed_size))
+            size_t decompressed_size_in_out = destination.size();
+            const size_t result = LZ4F_decompress(context.get(), destination.data(), &decompressed_size_in_out, data.data(), &compressed_size_in_out, nullptr);
+            // A context is only ready for the next frame once a whole frame has been decoded
+            if (LZ4F_isError(result) || (result != 0) || (decompressed_size_in_out != destination.size()))
             {
+                context.discard();
                 throw std::runtime_error("Failed to decompress data with LZ4 frame format");
             }
-            LZ4F_freeDecompressionContext(dctx);
+        }
+
+        sparrow::buffer<std::uint8_t> lz4_decompress(std::span<const std::uint8_t> data, const std::int64_t decompressed_size)
+        {
+            sparrow::buffer<std::uint8_t> decompressed_data(decompressed_size, pool_allocator<std::uint8_t>());
+            lz4_decompress_into(data, std::span<std::uint8_t>(decompressed_data.data(), decompressed_data.size()));
             return decompressed_data;
         }
 
@@ -194,7 +411,9 @@ namespace sparrow_ipc
             const std::int64_t uncompressed_size = data.size();
             const size_t max_compressed_size = ZSTD_compressBound(uncompressed_size);
             std::vector<std::uint8_t> result(details::CompressionHeaderSize + max_compressed_size);
-            const size_t compressed_size = ZSTD_compress(result.data() + details::CompressionHeaderSize, max_compressed_size, data.data(), uncompressed_size, 1);
+            // ZSTD_compressCCtx resets the session of the context on every call
+            auto context = get_zstd_cctx_pool().acquire();
+            const size_t compressed_size = ZSTD_compressCCtx(context.get(), result.data() + details::CompressionHeaderSize, max_compressed_size, data.data(), uncompressed_size, 1);
             if (ZSTD_isError(compressed_size))
             {
                 throw std::runtime_error("Failed to compress data with ZSTD");
@@ -204,14 +423,20 @@ namespace sparrow_ipc
             return result;
         }
 
-        sparrow::buffer<std::uint8_t> zstd_decompress(std::span<const std::uint8_t> data, const std::int64_t decompressed_size)
+        void zstd_decompress_into(std::span<const std::uint8_t> data, std::span<std::uint8_t> destination)
         {
-            sparrow::buffer<std::uint8_t> decompressed_data(decompressed_size, sparrow::buffer<std::uint8_t>::default_allocator());
-            const size_t result = ZSTD_decompress(decompressed_data.data(), decompressed_size, data.data(), data.size());
-            if (ZSTD_isError(result) || (result != (size_t)decompressed_size))
+            auto context = get_zstd_dctx_pool().acquire();
+            const size_t result = ZSTD_decompressDCtx(context.get(), destination.data(), destination.size(), data.data(), data.size());
+            if (ZSTD_isError(result) || (result != destination.size()))
             {
                 throw std::runtime_error("Failed to decompress data with ZSTD");
             }
+        }
+
+        sparrow::buffer<std::uint8_t> zstd_decompress(std::span<const std::uint8_t> data, const std::int64_t decompressed_size)
+        {
+            sparrow::buffer<std::uint8_t> decompressed_data(decompressed_size, pool_allocator<std::uint8_t>());
+            zstd_decompress_into(data, std::span<std::uint8_t>(decompressed_data.data(), decompressed_data.size()));
             return decompressed_data;
         }
 
@@ -331,4 +556,64 @@ namespace sparrow_ipc
             }
         }
     }
+
+    namespace details
+    {
+        size_t get_decompressed_size(std::span<const std::uint8_t> data)
+        {
+            if (data.empty())
+            {
+                return 0;
+            }
+            if (data.size() < CompressionHeaderSize)
+            {
+                throw std::runtime_error("Invalid compressed data: missing decompressed size");
+            }
+            std::int64_t decompressed_size = 0;
+            memcpy(&decompressed_size, data.data(), sizeof(decompressed_size));
+            if (decompressed_size == -1)
+            {
+                return data.size() - CompressionHeaderSize;
+            }
+            if (decompressed_size < 0)
+            {
+                throw std::runtime_error("Invalid compressed data: negative decompressed size");
+            }
+            return static_cast<size_t>(decompressed_size);
+        }
+
+        void decompress_into(
+            const CompressionType compression_type,
+            std::span<const std::uint8_t> data,
+            std::span<std::uint8_t> destination
+        )
+        {
+            if (data.empty())
+            {
+                return;
+            }
+            if (destination.size() != get_decompressed_size(data))
+            {
+                throw std::runtime_error("Decompression destination does not match the decompressed size.");
+            }
+            std::int64_t decompressed_size = 0;
+            memcpy(&decompressed_size, data.data(), sizeof(decompressed_size));
+            const auto compressed_data = data.subspan(CompressionHeaderSize);
+            if (decompressed_size == -1)
+            {
+                std::ranges::copy(compressed_data, destination.begin());
+                return;
+            }
+            switch (compression_type)
+            {
+                case CompressionType::LZ4_FRAME:
+                    lz4_decompress_into(compressed_data, destination);
+                    return;
+                case CompressionType::ZSTD:
+                    zstd_decompress_into(compressed_data, destination);
+                    return;
+            }
+            throw std::invalid_argument("Unsupported compression type.");
+        }
+    }
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 #include "Message_generated.h"
 
@@ -14,5 +16,28 @@ namespace sparrow_ipc
 
         org::apache::arrow::flatbuf::CompressionType to_fb_compression_type(CompressionType compression_type);
         CompressionType from_fb_compression_type(org::apache::arrow::flatbuf::CompressionType compression_type);
+
+        /**
+         * @brief Reads the size of a compressed buffer once decompressed.
+         *
+         * @param data The compressed buffer, starting with its 8-byte uncompressed length
+         * @return The decompressed size. For a buffer stored uncompressed, the size of its payload.
+         * @throws std::runtime_error If the uncompressed length is missing or invalid
+         */
+        size_t get_decompressed_size(std::span<const std::uint8_t> data);
+
+        /**
+         * @brief Decompresses a buffer into memory allocated by the caller.
+         *
+         * @param compression_type The codec of the buffer
+         * @param data The compressed buffer, starting with its 8-byte uncompressed length
+         * @param destination The memory receiving the data, of `get_decompressed_size(data)` bytes
+         * @throws std::runtime_error If the data cannot be decompressed
+         */
+        void decompress_into(
+            CompressionType compression_type,
+            std::span<const std::uint8_t> data,
+            std::span<std::uint8_t> destination
+        );
     }
 }
@@ -0,0 +1,596 @@
+#include "sparrow_ipc/concatenate.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "sparrow_ipc/compression.hpp"
+#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/deserialize_utils.hpp"
+#include "sparrow_ipc/encapsulated_message.hpp"
+#include "sparrow_ipc/magic_values.hpp"
+#include "sparrow_ipc/message_index.hpp"
+#include "sparrow_ipc/stream_file_serializer.hpp"
+#include "sparrow_ipc/utils.hpp"
+
+#include "compression_impl.hpp"
+#include "decoder_plan.hpp"
+#include "file_footer.hpp"
+
+namespace sparrow_ipc
+{
+    namespace
+    {
+        using org::apache::arrow::flatbuf::MessageHeader;
+
+        // Layout of the values of a field, with their size when fixed
+        using field_layout = std::pair<details::run_values_layout, size_t>;
+
+        // An input with the index of its messages and its schema
+        struct indexed_input
+        {
+            std::span<const uint8_t> data;
+            message_index index;
+            decoded_schema schema;
+        };
+
+        std::span<const uint8_t> message_bytes(const encapsulated_message& message)
+        {
+            return message.as_span().subspan(0, message.total_length());
+        }
+
+        encapsulated_message message_at(const indexed_input& input, size_t index)
+        {
+            return extract_encapsulated_message(input.data.subspan(input.index.messages[index].offset)).first;
+        }
+
+        indexed_input index_input(std::span<const uint8_t> input, size_t position, bool verify)
+        {
+            indexed_input result{.data = is_arrow_file_magic(input) ? details::file_stream_portion(input) : input};
+            result.index = scan_stream(result.data, verify);
+            if (result.index.messages.empty() || result.index.messages.front().type != MessageHeader::Schema)
+            {
+                throw std::runtime_error(
+                    "Input " + std::to_string(position) + " does not start with a Schema message."
+                );
+            }
+            result.schema = decode_schema(*message_at(result, 0).flat_buffer_message()->header_as_Schema());
+            return result;
+        }
+
+        bool same_field(const details::field_decoder& lhs, const details::field_decoder& rhs)
+        {
+            return lhs.name == rhs.name && lhs.format == rhs.format && lhs.flags == rhs.flags
+                   && lhs.metadata == rhs.metadata && lhs.dictionary_id == rhs.dictionary_id
+                   && lhs.unsupported_reason == rhs.unsupported_reason
+                   && std::ranges::equal(lhs.children, rhs.children, same_field);
+        }
+
+        // Compares the plans compiled from the schemas, which resolve the type of every field
+        void check_same_schema(
+            const details::decoder_plan& expected,
+            const details::decoder_plan& actual,
+            size_t position
+        )
+        {
+            const bool same = expected.swap_byte_order == actual.swap_byte_order
+                              && std::ranges::equal(expected.fields, actual.fields, same_field)
+                              && std::ranges::equal(
+                                  expected.dictionaries,
+                                  actual.dictionaries,
+                                  [](const details::dictionary_decoder& lhs, const details::dictionary_decoder& rhs)
+                                  {
+                                      return lhs.id == rhs.id && same_field(lhs.values, rhs.values);
+                                  }
+                              );
+            if (!same)
+            {
+                throw std::invalid_argument(
+                    "Input " + std::to_string(position) + " does not have the schema of the first input"
+                );
+            }
+        }
+
+        // Layouts of the fields of a schema whose record batches can be merged, or nothing
+        std::optional<std::vector<field_layout>> get_mergeable_layouts(const decoded_schema& schema)
+        {
+            if (schema.plan->swap_byte_order)
+            {
+                return std::nullopt;
+            }
+            std::vector<field_layout> layouts;
+            if (schema.schema->fields() == nullptr)
+            {
+                return layouts;
+            }
+            for (const auto* field : *schema.schema->fields())
+            {
+                const field_layout layout = details::get_values_layout(*field);
+                const bool nested = field->children() != nullptr && field->children()->size() != 0;
+                if (nested || field->dictionary() != nullptr
+                    || layout.first == details::run_values_layout::unsupported)
+                {
+                    return std::nullopt;
+                }
+                layouts.push_back(layout);
+            }
+            return layouts;
+        }
+
+        // Buffers of a field of merged record batches
+        struct merged_field
+        {
+            std::vector<uint8_t> validity;
+            // Values of a boolean or fixed-width field, offsets of a binary one
+            std::vector<uint8_t> values;
+            std::vector<uint8_t> data;
+            int64_t length = 0;
+            int64_t null_count = 0;
+        };
+
+        // Appends `count` bits of `source` to a bitmap of `bitmap_length` bits; an empty `source`
+        // appends set bits
+        void append_bits(
+            std::vector<uint8_t>& bitmap,
+            int64_t bitmap_length,
+            std::span<const uint8_t> source,
+            int64_t count
+        )
+        {
+            const auto begin = static_cast<size_t>(bitmap_length);
+            const auto bit_count = static_cast<size_t>(count);
+            bitmap.resize((begin + bit_count + 7) / 8, 0);
+            for (size_t i = 0; i < bit_count; ++i)
+            {
+                if (source.empty() || ((source[i / 8] >> (i % 8)) & 1) != 0)
+                {
+                    const size_t bit = begin + i;
+                    bitmap[bit / 8] = static_cast<uint8_t>(bitmap[bit / 8] | (1u << (bit % 8)));
+                }
+            }
+        }
+
+        template <std::signed_integral OffsetType>
+        void append_offset(std::vector<uint8_t>& offsets, OffsetType offset)
+        {
+            const size_t position = offsets.size();
+            offsets.resize(position + sizeof(OffsetType));
+            std::memcpy(offsets.data() + position, &offset, sizeof(OffsetType));
+        }
+
+        // Appends binary values, rebasing their offsets on the data merged so far
+        template <std::signed_integral OffsetType>
+        void append_binary(
+            merged_field& merged,
+            std::span<const uint8_t> offsets_buffer,
+            std::span<const uint8_t> data,
+            int64_t length
+        )
+        {
+            utils::check_offsets<OffsetType>(offsets_buffer, length, data.size());
+            if (length == 0)
+            {
+                return;
+            }
+            if (merged.values.empty())
+            {
+                append_offset<OffsetType>(merged.values, 0);
+            }
+            std::vector<OffsetType> offsets(static_cast<size_t>(length) + 1);
+            std::memcpy(offsets.data(), offsets_buffer.data(), offsets.size() * sizeof(OffsetType));
+            const auto first = static_cast<size_t>(offsets.front());
+            const auto last = static_cast<size_t>(offsets.back());
+            if (merged.data.size() + (last - first) > static_cast<size_t>(std::numeric_limits<OffsetType>::max()))
+            {
+                throw std::runtime_error("The data of the merged record batches overflows their offsets");
+            }
+            const auto base = static_cast<OffsetType>(merged.data.size());
+            for (size_t i = 1; i < offsets.size(); ++i)
+            {
+                const auto offset = static_cast<OffsetType>(base + offsets[i] - offsets.front());
+                append_offset<OffsetType>(merged.values, offset);
+            }
+            merged.data.insert(
+                merged.data.end(),
+                data.begin() + static_cast<std::ptrdiff_t>(first),
+                data.begin() + static_cast<std::ptrdiff_t>(last)
+            );
+        }
+
+        // Appends the fields of a RecordBatch message, decompressing its buffers if needed
+        void append_record_batch(
+            std::vector<merged_field>& fields,
+            const std::vector<field_layout>& layouts,
+            const encapsulated_message& message
+        )
+        {
+            const auto* record_batch = message.flat_buffer_message()->header_as_RecordBatch();
+            const auto* nodes = record_batch->nodes();
+            const auto* buffers = record_batch->buffers();
+            if (nodes == nullptr || buffers == nullptr || nodes->size() < fields.size())
+            {
+                throw std::runtime_error("RecordBatch does not describe the fields of its schema");
+            }
+            const std::span<const uint8_t> body = message.body();
+            size_t buffer_index = 0;
+            for (size_t i = 0; i < fields.size(); ++i)
+            {
+                merged_field& field = fields[i];
+                const auto [layout, value_width] = layouts[i];
+                const auto* node = nodes->Get(static_cast<flatbuffers::uoffset_t>(i));
+                const int64_t length = node->length();
+                if (length < 0 || node->null_count() < 0 || node->null_count() > length)
+                {
+                    throw std::runtime_error("Invalid FieldNode in RecordBatch");
+                }
+                const bool is_binary = layout == details::run_values_layout::binary
+                                       || layout == details::run_values_layout::large_binary;
+                if (buffer_index + (is_binary ? 3 : 2) > buffers->size())
+                {
+                    throw std::runtime_error("RecordBatch does not describe the buffers of its schema");
+                }
+                const auto validity = utils::get_decompressed_buffer(
+                    utils::get_buffer(*record_batch, body, buffer_index),
+                    record_batch->compression()
+                );
+                const auto values = utils::get_decompressed_buffer(
+                    utils::get_buffer(*record_batch, body, buffer_index),
+                    record_batch->compression()
+                );
+                const auto bit_bytes = static_cast<size_t>((length + 7) / 8);
+
+                std::span<const uint8_t> validity_bits;
+                if (node->null_count() != 0)
+                {
+                    validity_bits = utils::buffer_view(validity);
+                    utils::check_buffer_size(validity_bits, bit_bytes, "validity");
+                }
+                append_bits(field.validity, field.length, validity_bits, length);
+
+                const std::span<const uint8_t> values_view = utils::buffer_view(values);
+                switch (layout)
+                {
+                    case details::run_values_layout::bitmap:
+                        utils::check_buffer_size(values_view, bit_bytes, "values");
+                        append_bits(field.values, field.length, values_view.subspan(0, bit_bytes), length);
+                        break;
+                    case details::run_values_layout::fixed_width:
+                    {
+                        const size_t size = static_cast<size_t>(length) * value_width;
+                        utils::check_buffer_size(values_view, size, "values");
+                        field.values.insert(
+                            field.values.end(),
+                            values_view.begin(),
+                            values_view.begin() + static_cast<std::ptrdiff_t>(size)
+                        );
+                        break;
+                    }
+                    case details::run_values_layout::binary:
+                    case details::run_values_layout::large_binary:
+                    {
+                        const auto data = utils::get_decompressed_buffer(
+                            utils::get_buffer(*record_batch, body, buffer_index),
+                            record_batch->compression()
+                        );
+                        if (layout == details::run_values_layout::binary)
+                        {
+                            append_binary<int32_t>(field, values_view, utils::buffer_view(data), length);
+                        }
+                        else
+                        {
+                            append_binary<int64_t>(field, values_view, utils::buffer_view(data), length);
+                        }
+                        break;
+                    }
+                    case details::run_values_layout::unsupported:
+                        throw std::runtime_error("Record batches with nested fields cannot be merged");
+                }
+                field.length += length;
+                field.null_count += node->null_count();
+            }
+        }
+
+        // Writes the continuation bytes and the length of the metadata, the metadata and its padding
+        void write_metadata(const flatbuffers::FlatBufferBuilder& builder, any_output_stream& output)
+        {
+            output.write(continuation);
+            const auto size_with_padding = static_cast<int32_t>(utils::align_to_8(builder.GetSize()));
+            output.write(
+                std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&size_with_padding), sizeof(int32_t))
+            );
+            output.write(std::span<const uint8_t>(builder.GetBufferPointer(), builder.GetSize()));
+            output.add_padding();
+        }
+
+        // Writes the RecordBatch message of merged record batches, its buffers compressed with
+        // `compression` if set. Returns the metadata and body lengths of the message.
+        std::pair<int32_t, int64_t> write_merged_record_batch(
+            const std::vector<merged_field>& fields,
+            const std::vector<field_layout>& layouts,
+            int64_t num_rows,
+            std::optional<CompressionType> compression,
+            any_output_stream& output
+        )
+        {
+            std::vector<std::span<const uint8_t>> buffers;
+            std::vector<org::apache::arrow::flatbuf::FieldNode> nodes;
+            for (size_t i = 0; i < fields.size(); ++i)
+            {
+                const merged_field& field = fields[i];
+                nodes.emplace_back(field.length, field.null_count);
+                // Without nulls, the validity bitmap is omitted
+                buffers.push_back(
+                    field.null_count == 0 ? std::span<const uint8_t>() : std::span<const uint8_t>(field.validity)
+                );
+                buffers.push_back(field.values);
+                if (layouts[i].first == details::run_values_layout::binary
+                    || layouts[i].first == details::run_values_layout::large_binary)
+                {
+                    buffers.push_back(field.data);
+                }
+            }
+
+            CompressionCache cache;
+            if (compression.has_value())
+            {
+                for (auto& buffer : buffers)
+                {
+                    buffer = compress(compression.value(), buffer, cache);
+                }
+            }
+            std::vector<org::apache::arrow::flatbuf::Buffer> fb_buffers;
+            int64_t body_length = 0;
+            for (const auto& buffer : buffers)
+            {
+                fb_buffers.emplace_back(body_length, static_cast<int64_t>(buffer.size()));
+                body_length += static_cast<int64_t>(utils::align_to_8(buffer.size()));
+            }
+
+            flatbuffers::FlatBufferBuilder builder;
+            flatbuffers::Offset<org::apache::arrow::flatbuf::BodyCompression> compression_offset = 0;
+            if (compression.has_value())
+            {
+                compression_offset = org::apache::arrow::flatbuf::CreateBodyCompression(
+                    builder,
+                    details::to_fb_compression_type(compression.value()),
+                    org::apache::arrow::flatbuf::BodyCompressionMethod::BUFFER
+                );
+            }
+            auto nodes_offset = builder.CreateVectorOfStructs(nodes);
+            auto buffers_offset = builder.CreateVectorOfStructs(fb_buffers);
+            const auto record_batch_offset = org::apache::arrow::flatbuf::CreateRecordBatch(
+                builder,
+                num_rows,
+                nodes_offset,
+                buffers_offset,
+                compression_offset
+            );
+            const auto message_offset = org::apache::arrow::flatbuf::CreateMessage(
+                builder,
+                org::apache::arrow::flatbuf::MetadataVersion::V5,
+                MessageHeader::RecordBatch,
+                record_batch_offset.Union(),
+                body_length
+            );
+            builder.Finish(message_offset);
+
+            write_metadata(builder, output);
+            for (const auto& buffer : buffers)
+            {
+                output.write(buffer);
+                output.add_padding();
+            }
+            return {static_cast<int32_t>(encapsulated_message_header_size(builder.GetSize())), body_length};
+        }
+
+        // State of a concatenation: the blocks of the messages written, and the small record
+        // batches waiting to be merged, possibly from several inputs
+        struct concatenation
+        {
+            any_output_stream& output;
+            // Position in `output` of the start of the file or stream, from which blocks are counted
+            size_t start = 0;
+            std::vector<record_batch_block> record_batch_blocks;
+            std::vector<record_batch_block> dictionary_blocks;
+            int64_t min_batch_rows = 0;
+            // Layouts of the fields when the record batches are merged
+            std::optional<std::vector<field_layout>> layouts;
+            std::vector<encapsulated_message> pending;
+            int64_t pending_rows = 0;
+        };
+
+        int64_t current_offset(const concatenation& state)
+        {
+            return static_cast<int64_t>(state.output.size() - state.start);
+        }
+
+        void write_message(concatenation& state, const encapsulated_message& message, MessageHeader type)
+        {
+            const record_batch_block block{
+                current_offset(state),
+                static_cast<int32_t>(encapsulated_message_header_size(message.metadata_length())),
+                static_cast<int64_t>(message.body_length())
+            };
+            state.output.write(message_bytes(message));
+            auto& blocks = type == MessageHeader::RecordBatch ? state.record_batch_blocks : state.dictionary_blocks;
+            blocks.push_back(block);
+        }
+
+        void flush_pending(concatenation& state)
+        {
+            if (state.pending.size() == 1)
+            {
+                write_message(state, state.pending.front(), MessageHeader::RecordBatch);
+            }
+            else if (state.pending.size() > 1)
+            {
+                std::vector<merged_field> fields(state.layouts->size());
+                for (const encapsulated_message& message : state.pending)
+                {
+                    append_record_batch(fields, *state.layouts, message);
+                }
+                const auto* first = state.pending.front().flat_buffer_message()->header_as_RecordBatch();
+                const std::optional<CompressionType> compression =
+                    first->compression() == nullptr
+                        ? std::nullopt
+                        : std::optional(details::from_fb_compression_type(first->compression()->codec()));
+                const int64_t offset = current_offset(state);
+                const auto [metadata_length, body_length] = write_merged_record_batch(
+                    fields,
+                    *state.layouts,
+                    state.pending_rows,
+                    compression,
+                    state.output
+                );
+                state.record_batch_blocks.push_back({offset, metadata_length, body_length});
+            }
+            state.pending.clear();
+            state.pending_rows = 0;
+        }
+
+        void add_record_batch(concatenation& state, const encapsulated_message& message, int64_t num_rows)
+        {
+            if (!state.layouts.has_value() || num_rows >= state.min_batch_rows)
+            {
+                flush_pending(state);
+                write_message(state, message, MessageHeader::RecordBatch);
+                return;
+            }
+            state.pending.push_back(message);
+            state.pending_rows += num_rows;
+            if (state.pending_rows >= state.min_batch_rows)
+            {
+                flush_pending(state);
+            }
+        }
+
+        void concatenate(
+            std::span<const std::span<const uint8_t>> inputs,
+            any_output_stream& output,
+            bool file,
+            const concatenate_options& options
+        )
+        {
+            if (inputs.empty())
+            {
+                throw std::invalid_argument("Cannot concatenate without any input");
+            }
+            std::vector<indexed_input> indexed;
+            indexed.reserve(inputs.size());
+            size_t total_size = 0;
+            for (size_t i = 0; i < inputs.size(); ++i)
+            {
+                indexed.push_back(index_input(inputs[i], i, options.verify));
+                if (i > 0)
+                {
+                    check_same_schema(*indexed.front().schema.plan, *indexed.back().schema.plan, i);
+                }
+                total_size += indexed.back().index.end_offset;
+            }
+
+            concatenation state{.output = output, .start = output.size(), .min_batch_rows = options.min_batch_rows};
+            if (options.min_batch_rows > 0)
+            {
+                state.layouts = get_mergeable_layouts(indexed.front().schema);
+            }
+            output.reserve(output.size() + arrow_file_header_magic.size() + total_size + end_of_stream.size());
+            if (file)
+            {
+                output.write(arrow_file_header_magic);
+            }
+            const encapsulated_message schema_message = message_at(indexed.front(), 0);
+            output.write(message_bytes(schema_message));
+
+            // Dictionary batches of the first input, that the ones of the other inputs of a file must repeat
+            std::vector<encapsulated_message> first_dictionaries;
+            for (size_t i = 0; i < indexed.size(); ++i)
+            {
+                const indexed_input& input = indexed[i];
+                size_t dictionary_count = 0;
+                for (size_t j = 1; j < input.index.messages.size(); ++j)
+                {
+                    const message_info& info = input.index.messages[j];
+                    const encapsulated_message message = message_at(input, j);
+                    switch (info.type)
+                    {
+                        case MessageHeader::RecordBatch:
+                            add_record_batch(state, message, info.num_rows);
+                            break;
+                        case MessageHeader::DictionaryBatch:
+                            if (file && i > 0)
+                            {
+                                if (dictionary_count >= first_dictionaries.size()
+                                    || !std::ranges::equal(
+                                        message_bytes(message),
+                                        message_bytes(first_dictionaries[dictionary_count])
+                                    ))
+                                {
+                                    throw std::invalid_argument(
+                                        "The dictionaries of input " + std::to_string(i)
+                                        + " differ from the ones of the first input, which a file cannot replace"
+                                    );
+                                }
+                                ++dictionary_count;
+                                break;
+                            }
+                            if (file)
+                            {
+                                first_dictionaries.push_back(message);
+                            }
+                            flush_pending(state);
+                            write_message(state, message, MessageHeader::DictionaryBatch);
+                            break;
+                        default:
+                            throw std::runtime_error(
+                                "Input " + std::to_string(i) + " holds a message of type "
+                                + org::apache::arrow::flatbuf::EnumNameMessageHeader(info.type)
+                                + " that cannot be concatenated"
+                            );
+                    }
+                }
+            }
+            flush_pending(state);
+            output.write(end_of_stream);
+
+            if (file)
+            {
+                const size_t footer_size = write_footer(
+                    schema_message,
+                    state.record_batch_blocks,
+                    output,
+                    state.dictionary_blocks
+                );
+                const int32_t footer_size_i32 = static_cast<int32_t>(footer_size);
+                output.write(
+                    std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&footer_size_i32), sizeof(int32_t))
+                );
+                output.write(arrow_file_magic);
+            }
+        }
+    }
+
+    void concatenate_streams(
+        std::span<const std::span<const uint8_t>> inputs,
+        any_output_stream& output,
+        const concatenate_options& options
+    )
+    {
+        concatenate(inputs, output, false, options);
+    }
+
+    void concatenate_files(
+        std::span<const std::span<const uint8_t>> inputs,
+        any_output_stream& output,
+        const concatenate_options& options
+    )
+    {
+        concatenate(inputs, output, true, options);
+    }
+}
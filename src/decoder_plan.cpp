@@ -0,0 +1,2172 @@
+#include "decoder_plan.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include <sparrow/c_interface.hpp>
+#include <sparrow/types/data_type.hpp>
+#include <sparrow/utils/metadata.hpp>
+
+#include "sparrow_ipc/arrow_interface/arrow_array.hpp"
+#include "sparrow_ipc/arrow_interface/arrow_schema.hpp"
+#include "sparrow_ipc/buffer_pool.hpp"
+#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/deserialize_decimal_array.hpp"
+#include "sparrow_ipc/deserialize_duration_array.hpp"
+#include "sparrow_ipc/deserialize_fixedsizebinary_array.hpp"
+#include "sparrow_ipc/deserialize_interval_array.hpp"
+#include "sparrow_ipc/deserialize_null_array.hpp"
+#include "sparrow_ipc/deserialize_primitive_array.hpp"
+#include "sparrow_ipc/deserialize_time_related_arrays.hpp"
+#include "sparrow_ipc/deserialize_utils.hpp"
+#include "sparrow_ipc/deserialize_variable_size_binary_array.hpp"
+#include "sparrow_ipc/metadata.hpp"
+
+#include "byte_swap.hpp"
+#include "compression_impl.hpp"
+#include "parallel_for.hpp"
+
+namespace sparrow_ipc::details
+{
+    namespace
+    {
+        // Integer bit width constants
+        constexpr int32_t BIT_WIDTH_8 = 8;
+        constexpr int32_t BIT_WIDTH_16 = 16;
+        constexpr int32_t BIT_WIDTH_32 = 32;
+        constexpr int32_t BIT_WIDTH_64 = 64;
+
+        const org::apache::arrow::flatbuf::FieldNode*
+        field_node(const field_decoder& field, const org::apache::arrow::flatbuf::RecordBatch& record_batch)
+        {
+            return record_batch.nodes()->Get(static_cast<flatbuffers::uoffset_t>(field.node_index));
+        }
+
+        // Index of the first buffer of a field in a RecordBatch, after the variadic data buffers of
+        // the binary and string views located before it
+        size_t locate_first_buffer(const field_decoder& field, std::span<const size_t> variadic_offsets)
+        {
+            return variadic_offsets.empty() ? field.first_buffer
+                                            : field.first_buffer + variadic_offsets[field.first_variadic_count];
+        }
+
+        // Number of variadic data buffers of a field and of its children in a RecordBatch
+        size_t count_variadic_buffers(const field_decoder& field, std::span<const size_t> variadic_offsets)
+        {
+            if (field.variadic_count_entries == 0)
+            {
+                return 0;
+            }
+            return variadic_offsets[field.first_variadic_count + field.variadic_count_entries]
+                   - variadic_offsets[field.first_variadic_count];
+        }
+
+        // Number of variadic data buffers before each of the first `count` entries of
+        // `RecordBatch::variadicBufferCounts`, followed by their total; empty when `count` is 0.
+        std::vector<size_t>
+        get_variadic_offsets(const org::apache::arrow::flatbuf::RecordBatch& record_batch, size_t count)
+        {
+            std::vector<size_t> offsets;
+            if (count == 0)
+            {
+                return offsets;
+            }
+            const auto* counts = record_batch.variadicBufferCounts();
+            const size_t actual_count = counts == nullptr ? 0 : static_cast<size_t>(counts->size());
+            if (actual_count < count)
+            {
+                throw std::runtime_error(
+                    "RecordBatch describes " + std::to_string(actual_count)
+                    + " variadic buffer counts, but its schema requires " + std::to_string(count)
+                );
+            }
+            offsets.reserve(count + 1);
+            offsets.push_back(0);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const int64_t buffer_count = counts->Get(static_cast<flatbuffers::uoffset_t>(i));
+                if (buffer_count < 0)
+                {
+                    throw std::runtime_error("Invalid variadic buffer count: " + std::to_string(buffer_count));
+                }
+                offsets.push_back(offsets.back() + static_cast<size_t>(buffer_count));
+            }
+            return offsets;
+        }
+
+        template <template <typename...> class ArrayType, typename T>
+        sparrow::array decode_simple_array(
+            const field_decoder& field,
+            const decode_context& context,
+            ArrowSchema&& schema
+        )
+        {
+            size_t buffer_index = locate_first_buffer(field, context.variadic_offsets);
+            return sparrow::array(
+                detail::deserialize_non_owning_simple_array<ArrayType, T>(
+                    context.record_batch,
+                    context.body,
+                    std::move(schema),
+                    buffer_index,
+                    field_node(field, context.record_batch),
+                    context.validation
+                )
+            );
+        }
+
+        template <typename T>
+        sparrow::array decode_variable_size_binary(
+            const field_decoder& field,
+            const decode_context& context,
+            ArrowSchema&& schema
+        )
+        {
+            size_t buffer_index = locate_first_buffer(field, context.variadic_offsets);
+            return sparrow::array(
+                deserialize_non_owning_variable_size_binary<T>(
+                    context.record_batch,
+                    context.body,
+                    std::move(schema),
+                    buffer_index,
+                    field_node(field, context.record_batch),
+                    context.validation
+                )
+            );
+        }
+
+        sparrow::array decode_fixed_size_binary(
+            const field_decoder& field,
+            const decode_context& context,
+            ArrowSchema&& schema
+        )
+        {
+            size_t buffer_index = locate_first_buffer(field, context.variadic_offsets);
+            return sparrow::array(
+                deserialize_non_owning_fixedwidthbinary(
+                    context.record_batch,
+                    context.body,
+                    std::move(schema),
+                    buffer_index,
+                    field_node(field, context.record_batch),
+                    context.validation
+                )
+            );
+        }
+
+        template <typename T>
+        sparrow::array decode_decimal(
+            const field_decoder& field,
+            const decode_context& context,
+            ArrowSchema&& schema
+        )
+        {
+            size_t buffer_index = locate_first_buffer(field, context.variadic_offsets);
+            return sparrow::array(
+                deserialize_non_owning_decimal<T>(
+                    context.record_batch,
+                    context.body,
+                    std::move(schema),
+                    buffer_index,
+                    field_node(field, context.record_batch),
+                    context.validation
+                )
+            );
+        }
+
+        sparrow::array decode_null(const field_decoder& field, const decode_context& context, ArrowSchema&& schema)
+        {
+            return sparrow::array(deserialize_non_owning_null(
+                context.record_batch,
+                std::move(schema),
+                field_node(field, context.record_batch)
+            ));
+        }
+
+        sparrow::array decode_unsupported(const field_decoder& field, const decode_context&, ArrowSchema&& schema)
+        {
+            schema.release(&schema);
+            throw std::runtime_error(field.unsupported_reason);
+        }
+
+        ArrowSchema make_field_schema(const field_decoder& field, const std::shared_ptr<const decoder_plan>& plan)
+        {
+            // The schema of the array borrows its strings from the plan, shared by all the batches
+            return make_shared_arrow_schema(
+                field.format.c_str(),
+                field.name.c_str(),
+                field.metadata.has_value() ? field.metadata->c_str() : nullptr,
+                field.flags,
+                plan
+            );
+        }
+
+        void check_field_node(const field_decoder& field, const org::apache::arrow::flatbuf::FieldNode& node)
+        {
+            if (node.length() < 0 || node.null_count() < 0 || node.null_count() > node.length())
+            {
+                throw std::runtime_error(
+                    "Invalid FieldNode for field '" + field.name + "': length " + std::to_string(node.length())
+                    + ", null count " + std::to_string(node.null_count())
+                );
+            }
+        }
+
+        arrow_array_private_data::optionally_owned_buffer
+        read_buffer(const decode_context& context, size_t& buffer_index)
+        {
+            return utils::get_decompressed_buffer(
+                utils::get_buffer(context.record_batch, context.body, buffer_index),
+                context.record_batch.compression()
+            );
+        }
+
+        sparrow::array decode_child(const field_decoder& child, const decode_context& context)
+        {
+            if (context.validation != validation_level::none)
+            {
+                check_field_node(child, *field_node(child, context.record_batch));
+            }
+            return child.decode(child, context, make_field_schema(child, context.plan));
+        }
+
+        /**
+         * Decoded children of a nested array, released on destruction unless they have been
+         * handed over to their parent.
+         */
+        class decoded_children
+        {
+        public:
+
+            decoded_children(const field_decoder& field, const decode_context& context)
+            {
+                m_arrays.reserve(field.children.size());
+                m_schemas.reserve(field.children.size());
+                for (const field_decoder& child : field.children)
+                {
+                    auto [array, schema] = sparrow::extract_arrow_structures(decode_child(child, context));
+                    m_arrays.emplace_back(new ArrowArray(array));
+                    m_schemas.emplace_back(new ArrowSchema(schema));
+                }
+            }
+
+            [[nodiscard]] size_t size() const noexcept
+            {
+                return m_arrays.size();
+            }
+
+            [[nodiscard]] int64_t length(size_t index) const
+            {
+                return m_arrays[index]->length;
+            }
+
+            [[nodiscard]] const ArrowArray& array(size_t index) const
+            {
+                return *m_arrays[index];
+            }
+
+            // The children are then released by the release callbacks of their parent
+            void transfer_to(ArrowArray& array, ArrowSchema& schema)
+            {
+                auto arrays = std::make_unique<ArrowArray*[]>(size());
+                auto schemas = std::make_unique<ArrowSchema*[]>(size());
+                for (size_t i = 0; i < size(); ++i)
+                {
+                    arrays[i] = m_arrays[i].release();
+                    schemas[i] = m_schemas[i].release();
+                }
+                array.n_children = static_cast<int64_t>(size());
+                array.children = arrays.release();
+                schema.n_children = static_cast<int64_t>(size());
+                schema.children = schemas.release();
+                m_arrays.clear();
+                m_schemas.clear();
+            }
+
+        private:
+
+            std::vector<std::unique_ptr<ArrowArray, arrow_array_deleter>> m_arrays;
+            std::vector<std::unique_ptr<ArrowSchema, arrow_schema_deleter>> m_schemas;
+        };
+
+        // Runs the decoding of a nested or view field, releasing its schema if the decoding fails.
+        template <std::invocable<ArrowSchema&> Decode>
+        sparrow::array decode_nested(ArrowSchema& schema, Decode&& decode)
+        {
+            try
+            {
+                return decode(schema);
+            }
+            catch (...)
+            {
+                if (schema.release != nullptr)
+                {
+                    schema.release(&schema);
+                }
+                throw;
+            }
+        }
+
+        void check_child_length(const field_decoder& field, int64_t child_length, int64_t required_length)
+        {
+            if (child_length < required_length)
+            {
+                throw std::runtime_error(
+                    "The child array of field '" + field.name + "' holds " + std::to_string(child_length)
+                    + " values, but its parent requires " + std::to_string(required_length)
+                );
+            }
+        }
+
+        // Number of values a FixedSizeList field of `length` lists requires from its child array
+        int64_t fixed_size_list_child_length(const field_decoder& field, int64_t length)
+        {
+            if (length < 0 || (field.list_size != 0 && length > std::numeric_limits<int64_t>::max() / field.list_size))
+            {
+                throw std::runtime_error(
+                    "Invalid length " + std::to_string(length) + " for FixedSizeList field '" + field.name
+                    + "' of list size " + std::to_string(field.list_size)
+                );
+            }
+            return length * field.list_size;
+        }
+
+        sparrow::array make_nested_array(
+            int64_t length,
+            int64_t null_count,
+            std::vector<arrow_array_private_data::optionally_owned_buffer>&& buffers,
+            decoded_children& children,
+            ArrowSchema& schema
+        )
+        {
+            ArrowArray array = make_arrow_array<arrow_array_private_data>(
+                length,
+                null_count,
+                0,
+                0,
+                nullptr,
+                nullptr,
+                std::move(buffers)
+            );
+            children.transfer_to(array, schema);
+            ArrowSchema owned_schema = schema;
+            // The array now owns the schema, which must not be released on error
+            schema.release = nullptr;
+            return sparrow::array(std::move(array), std::move(owned_schema));
+        }
+
+        // Size of a view of a binary or string view array, and size of the values inlined in it
+        constexpr size_t view_size = 16;
+        constexpr int32_t max_inlined_size = 12;
+
+        // Checks that the non-null views of a binary or string view array are either inlined, or
+        // designate bytes of a data buffer.
+        void check_views(
+            const field_decoder& field,
+            std::span<const uint8_t> validity,
+            std::span<const uint8_t> views_buffer,
+            int64_t length,
+            std::span<const int64_t> data_sizes
+        )
+        {
+            for (size_t i = 0; i < static_cast<size_t>(length); ++i)
+            {
+                if (!validity.empty() && ((validity[i / 8] >> (i % 8)) & 1) == 0)
+                {
+                    continue;
+                }
+                // Size, then the inlined values or a prefix, the index of a data buffer and an offset
+                const uint8_t* view = views_buffer.data() + i * view_size;
+                int32_t size = 0;
+                int32_t buffer_index = 0;
+                int32_t offset = 0;
+                std::memcpy(&size, view, sizeof(size));
+                std::memcpy(&buffer_index, view + 8, sizeof(buffer_index));
+                std::memcpy(&offset, view + 12, sizeof(offset));
+                const bool inlined = size <= max_inlined_size;
+                if (size < 0
+                    || (!inlined
+                        && (buffer_index < 0 || std::cmp_greater_equal(buffer_index, data_sizes.size())
+                            || offset < 0 || int64_t{offset} + size > data_sizes[static_cast<size_t>(buffer_index)])))
+                {
+                    throw std::runtime_error(
+                        "Invalid view " + std::to_string(i) + " in field '" + field.name + "': size "
+                        + std::to_string(size) + ", data buffer " + std::to_string(buffer_index) + ", offset "
+                        + std::to_string(offset)
+                    );
+                }
+            }
+        }
+
+        sparrow::array decode_binary_view(const field_decoder& field, const decode_context& context, ArrowSchema&& schema)
+        {
+            return decode_nested(
+                schema,
+                [&](ArrowSchema& view_schema)
+                {
+                    const auto* node = field_node(field, context.record_batch);
+                    const int64_t length = node->length();
+                    const size_t data_buffer_count = count_variadic_buffers(field, context.variadic_offsets);
+                    size_t buffer_index = locate_first_buffer(field, context.variadic_offsets);
+                    // validity, views, data buffers, and the sizes of the data buffers, which the C data
+                    // interface requires but the IPC format does not hold
+                    std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+                    buffers.reserve(data_buffer_count + 3);
+                    buffers.push_back(read_buffer(context, buffer_index));
+                    buffers.push_back(read_buffer(context, buffer_index));
+                    sparrow::buffer<uint8_t> sizes_buffer(
+                        data_buffer_count * sizeof(int64_t),
+                        pool_allocator<uint8_t>()
+                    );
+                    const std::span<int64_t> data_sizes(
+                        reinterpret_cast<int64_t*>(sizes_buffer.data()),
+                        data_buffer_count
+                    );
+                    for (size_t i = 0; i < data_buffer_count; ++i)
+                    {
+                        buffers.push_back(read_buffer(context, buffer_index));
+                        data_sizes[i] = static_cast<int64_t>(utils::buffer_view(buffers.back()).size());
+                    }
+
+                    if (context.validation != validation_level::none)
+                    {
+                        utils::check_buffer_size(
+                            utils::buffer_view(buffers[1]),
+                            static_cast<size_t>(length) * view_size,
+                            "views"
+                        );
+                    }
+                    const int64_t null_count = utils::get_null_count(
+                        utils::buffer_view(buffers[0]),
+                        length,
+                        node,
+                        context.validation
+                    );
+                    if (context.validation == validation_level::full)
+                    {
+                        check_views(
+                            field,
+                            null_count == 0 ? std::span<const uint8_t>{} : utils::buffer_view(buffers[0]),
+                            utils::buffer_view(buffers[1]),
+                            length,
+                            data_sizes
+                        );
+                    }
+                    buffers.emplace_back(std::move(sizes_buffer));
+
+                    ArrowArray array = make_arrow_array<arrow_array_private_data>(
+                        length,
+                        null_count,
+                        0,
+                        0,
+                        nullptr,
+                        nullptr,
+                        std::move(buffers)
+                    );
+                    ArrowSchema owned_schema = view_schema;
+                    // The array now owns the schema, which must not be released on error
+                    view_schema.release = nullptr;
+                    return sparrow::array(std::move(array), std::move(owned_schema));
+                }
+            );
+        }
+
+        template <std::signed_integral OffsetType>
+        sparrow::array decode_list(const field_decoder& field, const decode_context& context, ArrowSchema&& schema)
+        {
+            return decode_nested(
+                schema,
+                [&](ArrowSchema& list_schema)
+                {
+                    decoded_children children(field, context);
+                    const auto* node = field_node(field, context.record_batch);
+                    const int64_t length = node->length();
+                    size_t buffer_index = locate_first_buffer(field, context.variadic_offsets);
+                    std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+                    buffers.push_back(read_buffer(context, buffer_index));
+                    buffers.push_back(read_buffer(context, buffer_index));
+
+                    if (context.validation == validation_level::full)
+                    {
+                        utils::check_offsets<OffsetType>(
+                            utils::buffer_view(buffers[1]),
+                            length,
+                            static_cast<size_t>(children.length(0))
+                        );
+                    }
+                    else if (context.validation == validation_level::metadata && length > 0)
+                    {
+                        utils::check_buffer_size(
+                            utils::buffer_view(buffers[1]),
+                            (static_cast<size_t>(length) + 1) * sizeof(OffsetType),
+                            "offsets"
+                        );
+                    }
+                    const int64_t null_count = utils::get_null_count(
+                        utils::buffer_view(buffers[0]),
+                        length,
+                        node,
+                        context.validation
+                    );
+                    return make_nested_array(length, null_count, std::move(buffers), children, list_schema);
+                }
+            );
+        }
+
+        sparrow::array
+        decode_fixed_size_list(const field_decoder& field, const decode_context& context, ArrowSchema&& schema)
+        {
+            return decode_nested(
+                schema,
+                [&](ArrowSchema& list_schema)
+                {
+                    decoded_children children(field, context);
+                    const auto* node = field_node(field, context.record_batch);
+                    const int64_t length = node->length();
+                    size_t buffer_index = locate_first_buffer(field, context.variadic_offsets);
+                    std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+                    buffers.push_back(read_buffer(context, buffer_index));
+
+                    if (context.validation != validation_level::none)
+                    {
+                        check_child_length(field, children.length(0), fixed_size_list_child_length(field, length));
+                    }
+                    const int64_t null_count = utils::get_null_count(
+                        utils::buffer_view(buffers[0]),
+                        length,
+                        node,
+                        context.validation
+                    );
+                    return make_nested_array(length, null_count, std::move(buffers), children, list_schema);
+                }
+            );
+        }
+
+        // Checks that each list of a list view array is within its child array.
+        template <std::signed_integral OffsetType>
+        void check_list_views(
+            const field_decoder& field,
+            std::span<const uint8_t> offsets_buffer,
+            std::span<const uint8_t> sizes_buffer,
+            int64_t length,
+            int64_t child_length
+        )
+        {
+            if (length == 0)
+            {
+                return;
+            }
+            const auto count = static_cast<size_t>(length);
+            utils::check_buffer_size(offsets_buffer, count * sizeof(OffsetType), "offsets");
+            utils::check_buffer_size(sizes_buffer, count * sizeof(OffsetType), "sizes");
+            const auto* offsets = reinterpret_cast<const OffsetType*>(offsets_buffer.data());
+            const auto* sizes = reinterpret_cast<const OffsetType*>(sizes_buffer.data());
+            // Negative offsets and sizes wrap around to values above the limit; the comparisons are
+            // accumulated without branches, so that the loop is vectorized by the compiler
+            const auto limit = static_cast<uint64_t>(child_length);
+            unsigned invalid = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto offset = static_cast<uint64_t>(static_cast<int64_t>(offsets[i]));
+                const auto size = static_cast<uint64_t>(static_cast<int64_t>(sizes[i]));
+                invalid |= static_cast<unsigned>(offset > limit) | static_cast<unsigned>(size > limit - offset);
+            }
+            if (invalid != 0)
+            {
+                throw std::runtime_error(
+                    "Invalid list views in field '" + field.name + "': they must be within its child array of "
+                    + std::to_string(child_length) + " values"
+                );
+            }
+        }
+
+        template <std::signed_integral OffsetType>
+        sparrow::array decode_list_view(const field_decoder& field, const decode_context& context, ArrowSchema&& schema)
+        {
+            return decode_nested(
+                schema,
+                [&](ArrowSchema& list_schema)
+                {
+                    decoded_children children(field, context);
+                    const auto* node = field_node(field, context.record_batch);
+                    const int64_t length = node->length();
+                    size_t buffer_index = locate_first_buffer(field, context.variadic_offsets);
+                    // validity, offsets, sizes
+                    std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+                    buffers.push_back(read_buffer(context, buffer_index));
+                    buffers.push_back(read_buffer(context, buffer_index));
+                    buffers.push_back(read_buffer(context, buffer_index));
+
+                    if (context.validation == validation_level::full)
+                    {
+                        check_list_views<OffsetType>(
+                            field,
+                            utils::buffer_view(buffers[1]),
+                            utils::buffer_view(buffers[2]),
+                            length,
+                            children.length(0)
+                        );
+                    }
+                    else if (context.validation == validation_level::metadata)
+                    {
+                        const size_t size = static_cast<size_t>(length) * sizeof(OffsetType);
+                        utils::check_buffer_size(utils::buffer_view(buffers[1]), size, "offsets");
+                        utils::check_buffer_size(utils::buffer_view(buffers[2]), size, "sizes");
+                    }
+                    const int64_t null_count = utils::get_null_count(
+                        utils::buffer_view(buffers[0]),
+                        length,
+                        node,
+                        context.validation
+                    );
+                    return make_nested_array(length, null_count, std::move(buffers), children, list_schema);
+                }
+            );
+        }
+
+        sparrow::array decode_struct(const field_decoder& field, const decode_context& context, ArrowSchema&& schema)
+        {
+            return decode_nested(
+                schema,
+                [&](ArrowSchema& struct_schema)
+                {
+                    decoded_children children(field, context);
+                    const auto* node = field_node(field, context.record_batch);
+                    const int64_t length = node->length();
+                    size_t buffer_index = locate_first_buffer(field, context.variadic_offsets);
+                    std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+                    buffers.push_back(read_buffer(context, buffer_index));
+
+                    if (context.validation != validation_level::none)
+                    {
+                        for (size_t i = 0; i < children.size(); ++i)
+                        {
+                            check_child_length(field, children.length(i), length);
+                        }
+                    }
+                    const int64_t null_count = utils::get_null_count(
+                        utils::buffer_view(buffers[0]),
+                        length,
+                        node,
+                        context.validation
+                    );
+                    return make_nested_array(length, null_count, std::move(buffers), children, struct_schema);
+                }
+            );
+        }
+
+        // Checks that the type ids of a union designate its children, and that the offsets of a dense
+        // union are within the designated child.
+        void check_union_values(
+            const field_decoder& field,
+            const decoded_children& children,
+            std::span<const uint8_t> type_ids_buffer,
+            std::span<const uint8_t> offsets_buffer,
+            int64_t length
+        )
+        {
+            // Child of each type id, -1 for the undeclared ones
+            std::array<int32_t, 128> child_indices;
+            child_indices.fill(-1);
+            for (size_t i = 0; i < field.type_ids.size(); ++i)
+            {
+                child_indices[static_cast<size_t>(field.type_ids[i])] = static_cast<int32_t>(i);
+            }
+            const auto* type_ids = reinterpret_cast<const int8_t*>(type_ids_buffer.data());
+            const auto* offsets = reinterpret_cast<const int32_t*>(offsets_buffer.data());
+            for (size_t i = 0; i < static_cast<size_t>(length); ++i)
+            {
+                const int8_t type_id = type_ids[i];
+                const int32_t child = type_id < 0 ? -1 : child_indices[static_cast<size_t>(type_id)];
+                if (child < 0)
+                {
+                    throw std::runtime_error(
+                        "Invalid type id " + std::to_string(type_id) + " in union field '" + field.name + "'"
+                    );
+                }
+                if (offsets != nullptr
+                    && (offsets[i] < 0 || offsets[i] >= children.length(static_cast<size_t>(child))))
+                {
+                    throw std::runtime_error(
+                        "Invalid offset " + std::to_string(offsets[i]) + " in union field '" + field.name + "'"
+                    );
+                }
+            }
+        }
+
+        template <org::apache::arrow::flatbuf::UnionMode Mode>
+        sparrow::array decode_union(const field_decoder& field, const decode_context& context, ArrowSchema&& schema)
+        {
+            constexpr bool dense = Mode == org::apache::arrow::flatbuf::UnionMode::Dense;
+            return decode_nested(
+                schema,
+                [&](ArrowSchema& union_schema)
+                {
+                    decoded_children children(field, context);
+                    const int64_t length = field_node(field, context.record_batch)->length();
+                    size_t buffer_index = locate_first_buffer(field, context.variadic_offsets);
+                    // Unions have no validity buffer: type ids, and offsets when dense
+                    std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+                    buffers.push_back(read_buffer(context, buffer_index));
+                    if constexpr (dense)
+                    {
+                        buffers.push_back(read_buffer(context, buffer_index));
+                    }
+
+                    if (context.validation != validation_level::none)
+                    {
+                        utils::check_buffer_size(
+                            utils::buffer_view(buffers[0]),
+                            static_cast<size_t>(length),
+                            "type ids"
+                        );
+                        if constexpr (dense)
+                        {
+                            utils::check_buffer_size(
+                                utils::buffer_view(buffers[1]),
+                                static_cast<size_t>(length) * sizeof(int32_t),
+                                "offsets"
+                            );
+                        }
+                        else
+                        {
+                            for (size_t i = 0; i < children.size(); ++i)
+                            {
+                                check_child_length(field, children.length(i), length);
+                            }
+                        }
+                    }
+                    if (context.validation == validation_level::full && length > 0)
+                    {
+                        check_union_values(
+                            field,
+                            children,
+                            utils::buffer_view(buffers[0]),
+                            dense ? utils::buffer_view(buffers[1]) : std::span<const uint8_t>{},
+                            length
+                        );
+                    }
+                    return make_nested_array(length, 0, std::move(buffers), children, union_schema);
+                }
+            );
+        }
+
+        template <std::signed_integral RunEndType>
+        sparrow::array
+        decode_run_end_encoded(const field_decoder& field, const decode_context& context, ArrowSchema&& schema)
+        {
+            return decode_nested(
+                schema,
+                [&](ArrowSchema& ree_schema)
+                {
+                    decoded_children children(field, context);
+                    const auto* node = field_node(field, context.record_batch);
+                    const int64_t length = node->length();
+                    const ArrowArray& run_ends_array = children.array(0);
+                    if (context.validation != validation_level::none)
+                    {
+                        if (children.length(0) != children.length(1) || run_ends_array.null_count != 0)
+                        {
+                            throw std::runtime_error(
+                                "The run ends of field '" + field.name
+                                + "' must be non-null and as many as its values"
+                            );
+                        }
+                    }
+                    const std::span<const RunEndType> run_ends(
+                        run_ends_array.length == 0 ? nullptr
+                                                   : static_cast<const RunEndType*>(run_ends_array.buffers[1]),
+                        static_cast<size_t>(run_ends_array.length)
+                    );
+                    if (context.validation == validation_level::full)
+                    {
+                        check_run_ends(run_ends, length, field.name);
+                    }
+
+                    if (!context.plan->expand_run_end_encoded)
+                    {
+                        // Run-end encoded arrays have no buffer of their own
+                        return make_nested_array(length, node->null_count(), {}, children, ree_schema);
+                    }
+                    const field_decoder& values = field.children[1];
+                    if (field.run_layout == run_values_layout::unsupported)
+                    {
+                        throw std::runtime_error(
+                            "Run-end encoded field '" + field.name + "' cannot be expanded: its values of format '"
+                            + values.format + "' are not of a primitive, boolean, binary or string type"
+                        );
+                    }
+                    expanded_runs expanded = expand_runs(
+                        run_ends,
+                        children.array(1),
+                        field.run_layout,
+                        field.value_width,
+                        length
+                    );
+                    // The expanded array takes the type of the values, and the name of the field
+                    ArrowSchema values_schema = make_shared_arrow_schema(
+                        values.format.c_str(),
+                        field.name.c_str(),
+                        field.metadata.has_value() ? field.metadata->c_str() : nullptr,
+                        field.flags,
+                        context.plan
+                    );
+                    ree_schema.release(&ree_schema);
+                    ArrowArray array = make_arrow_array<arrow_array_private_data>(
+                        length,
+                        expanded.null_count,
+                        0,
+                        0,
+                        nullptr,
+                        nullptr,
+                        std::move(expanded.buffers)
+                    );
+                    return sparrow::array(std::move(array), std::move(values_schema));
+                }
+            );
+        }
+
+        const std::shared_ptr<const dictionary>& find_dictionary(const field_decoder& field, const decode_context& context)
+        {
+            if (context.dictionaries != nullptr)
+            {
+                const auto it = context.dictionaries->dictionaries.find(field.dictionary_id);
+                if (it != context.dictionaries->dictionaries.end())
+                {
+                    return it->second;
+                }
+            }
+            throw std::runtime_error(
+                "The dictionary " + std::to_string(field.dictionary_id) + " of field '" + field.name
+                + "' has not been read: its DictionaryBatch must precede the RecordBatch messages using it"
+            );
+        }
+
+        // Checks that the non-null indices of a dictionary-encoded array designate values of its dictionary.
+        template <std::integral IndexType>
+        void check_dictionary_indices(
+            const field_decoder& field,
+            std::span<const uint8_t> validity,
+            std::span<const uint8_t> indices_buffer,
+            int64_t length,
+            int64_t dictionary_length
+        )
+        {
+            const auto* indices = reinterpret_cast<const IndexType*>(indices_buffer.data());
+            for (size_t i = 0; i < static_cast<size_t>(length); ++i)
+            {
+                if (!validity.empty() && ((validity[i / 8] >> (i % 8)) & 1) == 0)
+                {
+                    continue;
+                }
+                if (std::cmp_less(indices[i], 0) || std::cmp_greater_equal(indices[i], dictionary_length))
+                {
+                    throw std::runtime_error(
+                        "Invalid index " + std::to_string(indices[i]) + " in dictionary-encoded field '"
+                        + field.name + "', whose dictionary holds " + std::to_string(dictionary_length) + " values"
+                    );
+                }
+            }
+        }
+
+        template <std::integral IndexType>
+        sparrow::array decode_dictionary(const field_decoder& field, const decode_context& context, ArrowSchema&& schema)
+        {
+            return decode_nested(
+                schema,
+                [&](ArrowSchema& indices_schema)
+                {
+                    const std::shared_ptr<const dictionary>& values = find_dictionary(field, context);
+                    const auto* node = field_node(field, context.record_batch);
+                    const int64_t length = node->length();
+                    size_t buffer_index = locate_first_buffer(field, context.variadic_offsets);
+                    // validity, indices
+                    std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+                    buffers.push_back(read_buffer(context, buffer_index));
+                    buffers.push_back(read_buffer(context, buffer_index));
+
+                    if (context.validation != validation_level::none)
+                    {
+                        utils::check_buffer_size(
+                            utils::buffer_view(buffers[1]),
+                            static_cast<size_t>(length) * sizeof(IndexType),
+                            "indices"
+                        );
+                    }
+                    const int64_t null_count = utils::get_null_count(
+                        utils::buffer_view(buffers[0]),
+                        length,
+                        node,
+                        context.validation
+                    );
+                    if (context.validation == validation_level::full)
+                    {
+                        check_dictionary_indices<IndexType>(
+                            field,
+                            null_count == 0 ? std::span<const uint8_t>{} : utils::buffer_view(buffers[0]),
+                            utils::buffer_view(buffers[1]),
+                            length,
+                            values->values().length
+                        );
+                    }
+
+                    // The array of indices owns a view of the dictionary, shared with the other batches
+                    dictionary_view view = make_dictionary_view(values);
+                    ArrowArray array = make_arrow_array<arrow_array_private_data>(
+                        length,
+                        null_count,
+                        0,
+                        0,
+                        nullptr,
+                        nullptr,
+                        std::move(buffers)
+                    );
+                    array.dictionary = view.array.release();
+                    indices_schema.dictionary = view.schema.release();
+                    ArrowSchema owned_schema = indices_schema;
+                    // The array now owns the schema, which must not be released on error
+                    indices_schema.release = nullptr;
+                    return sparrow::array(std::move(array), std::move(owned_schema));
+                }
+            );
+        }
+
+        template <template <typename...> class ArrayType, typename T>
+        void set_simple_array_decoder(field_decoder& decoder, std::string_view format_suffix = {})
+        {
+            decoder.decode = &decode_simple_array<ArrayType, T>;
+            decoder.format = std::string(
+                data_type_to_format(sparrow::detail::get_data_type_from_array<ArrayType<T>>::get())
+            );
+            decoder.format += format_suffix;
+        }
+
+        template <typename T>
+        void set_variable_size_binary_decoder(field_decoder& decoder)
+        {
+            decoder.decode = &decode_variable_size_binary<T>;
+            decoder.format = std::string(data_type_to_format(sparrow::detail::get_data_type_from_array<T>::get()));
+        }
+
+        void set_unsupported_decoder(field_decoder& decoder, std::string reason)
+        {
+            decoder.decode = &decode_unsupported;
+            decoder.unsupported_reason = std::move(reason);
+        }
+
+        template <std::integral IndexType>
+        void set_dictionary_decoder(field_decoder& decoder)
+        {
+            decoder.decode = &decode_dictionary<IndexType>;
+            decoder.format = std::string(
+                data_type_to_format(sparrow::detail::get_data_type_from_array<sparrow::primitive_array<IndexType>>::get())
+            );
+        }
+
+        // Resolves a dictionary-encoded field, decoded as its indices referencing its dictionary.
+        void resolve_dictionary_decoder(const org::apache::arrow::flatbuf::Field& field, field_decoder& decoder)
+        {
+            const auto* encoding = field.dictionary();
+            decoder.dictionary_id = encoding->id();
+            if (encoding->isOrdered())
+            {
+                decoder.flags |= static_cast<int64_t>(sparrow::ArrowFlag::DICTIONARY_ORDERED);
+            }
+            // Without an index type, the indices are signed 32-bit integers
+            const auto* index_type = encoding->indexType();
+            const int32_t bit_width = index_type == nullptr ? BIT_WIDTH_32 : index_type->bitWidth();
+            if (index_type == nullptr || index_type->is_signed())
+            {
+                switch (bit_width)
+                {
+                    // clang-format off
+                    case BIT_WIDTH_8:  set_dictionary_decoder<int8_t>(decoder); return;
+                    case BIT_WIDTH_16: set_dictionary_decoder<int16_t>(decoder); return;
+                    case BIT_WIDTH_32: set_dictionary_decoder<int32_t>(decoder); return;
+                    case BIT_WIDTH_64: set_dictionary_decoder<int64_t>(decoder); return;
+                    // clang-format on
+                }
+            }
+            else
+            {
+                switch (bit_width)
+                {
+                    // clang-format off
+                    case BIT_WIDTH_8:  set_dictionary_decoder<uint8_t>(decoder); return;
+                    case BIT_WIDTH_16: set_dictionary_decoder<uint16_t>(decoder); return;
+                    case BIT_WIDTH_32: set_dictionary_decoder<uint32_t>(decoder); return;
+                    case BIT_WIDTH_64: set_dictionary_decoder<uint64_t>(decoder); return;
+                    // clang-format on
+                }
+            }
+            set_unsupported_decoder(decoder, "Unsupported dictionary index bit width: " + std::to_string(bit_width));
+        }
+
+        void resolve_value_decoder(const org::apache::arrow::flatbuf::Field& field, field_decoder& decoder);
+
+        // Resolves the decoding function of a field of a RecordBatch.
+        void resolve_decoder(const org::apache::arrow::flatbuf::Field& field, field_decoder& decoder)
+        {
+            if (field.dictionary() != nullptr)
+            {
+                resolve_dictionary_decoder(field, decoder);
+                return;
+            }
+            resolve_value_decoder(field, decoder);
+        }
+
+        // Locates and resolves the children of a nested field, whose buffers and FieldNodes follow
+        // the `own_buffer_count` buffers and the FieldNode of the field.
+        void compile_children(
+            const org::apache::arrow::flatbuf::Field& field,
+            field_decoder& decoder,
+            size_t own_buffer_count
+        )
+        {
+            if (field.children() == nullptr)
+            {
+                return;
+            }
+            size_t buffer_index = decoder.first_buffer + own_buffer_count;
+            size_t node_index = decoder.node_index + 1;
+            size_t variadic_index = decoder.first_variadic_count;
+            decoder.children.reserve(field.children()->size());
+            for (const auto* child : *field.children())
+            {
+                field_decoder& child_decoder = decoder.children.emplace_back();
+                child_decoder.name = child->name() == nullptr ? "" : child->name()->str();
+                if (child->custom_metadata() != nullptr)
+                {
+                    child_decoder.metadata = sparrow::get_metadata_from_key_values(
+                        to_sparrow_metadata(*child->custom_metadata())
+                    );
+                }
+                if (child->nullable())
+                {
+                    child_decoder.flags = static_cast<int64_t>(sparrow::ArrowFlag::NULLABLE);
+                }
+                child_decoder.first_buffer = buffer_index;
+                child_decoder.buffer_count = utils::count_field_buffers(*child);
+                child_decoder.node_index = node_index;
+                child_decoder.node_count = utils::count_field_nodes(*child);
+                child_decoder.first_variadic_count = variadic_index;
+                child_decoder.variadic_count_entries = utils::count_field_variadic_buffer_counts(*child);
+                buffer_index += child_decoder.buffer_count;
+                node_index += child_decoder.node_count;
+                variadic_index += child_decoder.variadic_count_entries;
+                resolve_decoder(*child, child_decoder);
+            }
+        }
+
+        // Resolves a nested field having a fixed number of children.
+        void set_nested_decoder(
+            const org::apache::arrow::flatbuf::Field& field,
+            field_decoder& decoder,
+            field_decode_function decode,
+            std::string format,
+            size_t own_buffer_count,
+            size_t children_count
+        )
+        {
+            const size_t actual_count = field.children() == nullptr ? 0 : field.children()->size();
+            if (actual_count != children_count)
+            {
+                set_unsupported_decoder(
+                    decoder,
+                    "Field '" + decoder.name + "' of format '" + format + "' has " + std::to_string(actual_count)
+                        + " children instead of " + std::to_string(children_count)
+                );
+                return;
+            }
+            decoder.decode = decode;
+            decoder.format = std::move(format);
+            compile_children(field, decoder, own_buffer_count);
+        }
+
+        // Resolves the decoding function of the values of a field, and its type parameters, from
+        // the field type.
+        void resolve_value_decoder(const org::apache::arrow::flatbuf::Field& field, field_decoder& decoder)
+        {
+            const auto field_type = field.type_type();
+            switch (field_type)
+            {
+                case org::apache::arrow::flatbuf::Type::Bool:
+                    set_simple_array_decoder<sparrow::primitive_array, bool>(decoder);
+                    return;
+                case org::apache::arrow::flatbuf::Type::Int:
+                {
+                    const auto* int_type = field.type_as_Int();
+                    const auto bit_width = int_type->bitWidth();
+                    if (int_type->is_signed())
+                    {
+                        switch (bit_width)
+                        {
+                            // clang-format off
+                            case BIT_WIDTH_8:  set_simple_array_decoder<sparrow::primitive_array, int8_t>(decoder); return;
+                            case BIT_WIDTH_16: set_simple_array_decoder<sparrow::primitive_array, int16_t>(decoder); return;
+                            case BIT_WIDTH_32: set_simple_array_decoder<sparrow::primitive_array, int32_t>(decoder); return;
+                            case BIT_WIDTH_64: set_simple_array_decoder<sparrow::primitive_array, int64_t>(decoder); return;
+                            // clang-format on
+                        }
+                    }
+                    else
+                    {
+                        switch (bit_width)
+                        {
+                            // clang-format off
+                            case BIT_WIDTH_8:  set_simple_array_decoder<sparrow::primitive_array, uint8_t>(decoder); return;
+                            case BIT_WIDTH_16: set_simple_array_decoder<sparrow::primitive_array, uint16_t>(decoder); return;
+                            case BIT_WIDTH_32: set_simple_array_decoder<sparrow::primitive_array, uint32_t>(decoder); return;
+                            case BIT_WIDTH_64: set_simple_array_decoder<sparrow::primitive_array, uint64_t>(decoder); return;
+                            // clang-format on
+                        }
+                    }
+                    set_unsupported_decoder(decoder, "Unsupported integer bit width: " + std::to_string(bit_width));
+                    return;
+                }
+                case org::apache::arrow::flatbuf::Type::FloatingPoint:
+                {
+                    const auto precision = field.type_as_FloatingPoint()->precision();
+                    switch (precision)
+                    {
+                        case org::apache::arrow::flatbuf::Precision::HALF:
+                            set_simple_array_decoder<sparrow::primitive_array, sparrow::float16_t>(decoder);
+                            return;
+                        case org::apache::arrow::flatbuf::Precision::SINGLE:
+                            set_simple_array_decoder<sparrow::primitive_array, float>(decoder);
+                            return;
+                        case org::apache::arrow::flatbuf::Precision::DOUBLE:
+                            set_simple_array_decoder<sparrow::primitive_array, double>(decoder);
+                            return;
+                    }
+                    set_unsupported_decoder(
+                        decoder,
+                        "Unsupported floating point precision: " + std::to_string(static_cast<int>(precision))
+                    );
+                    return;
+                }
+                case org::apache::arrow::flatbuf::Type::List:
+                    // validity, offsets
+                    set_nested_decoder(field, decoder, &decode_list<int32_t>, "+l", 2, 1);
+                    return;
+                case org::apache::arrow::flatbuf::Type::LargeList:
+                    set_nested_decoder(field, decoder, &decode_list<int64_t>, "+L", 2, 1);
+                    return;
+                case org::apache::arrow::flatbuf::Type::ListView:
+                    set_nested_decoder(field, decoder, &decode_list_view<int32_t>, "+vl", 3, 1);
+                    return;
+                case org::apache::arrow::flatbuf::Type::LargeListView:
+                    set_nested_decoder(field, decoder, &decode_list_view<int64_t>, "+vL", 3, 1);
+                    return;
+                case org::apache::arrow::flatbuf::Type::FixedSizeList:
+                {
+                    const int32_t list_size = field.type_as_FixedSizeList()->listSize();
+                    if (list_size < 0)
+                    {
+                        set_unsupported_decoder(decoder, "Invalid FixedSizeList size: " + std::to_string(list_size));
+                        return;
+                    }
+                    decoder.list_size = list_size;
+                    // validity
+                    set_nested_decoder(
+                        field,
+                        decoder,
+                        &decode_fixed_size_list,
+                        "+w:" + std::to_string(list_size),
+                        1,
+                        1
+                    );
+                    return;
+                }
+                case org::apache::arrow::flatbuf::Type::Struct_:
+                    decoder.decode = &decode_struct;
+                    decoder.format = "+s";
+                    // validity
+                    compile_children(field, decoder, 1);
+                    return;
+                case org::apache::arrow::flatbuf::Type::Map:
+                {
+                    // A Map is laid out as a List of non-nullable key/value structs
+                    const auto* entries = field.children() != nullptr && field.children()->size() == 1
+                                              ? field.children()->Get(0)
+                                              : nullptr;
+                    if (entries == nullptr || entries->type_type() != org::apache::arrow::flatbuf::Type::Struct_
+                        || entries->children() == nullptr || entries->children()->size() != 2)
+                    {
+                        set_unsupported_decoder(
+                            decoder,
+                            "Field '" + decoder.name + "' of type Map must have a single struct child of two fields"
+                        );
+                        return;
+                    }
+                    if (field.type_as_Map()->keysSorted())
+                    {
+                        decoder.flags |= static_cast<int64_t>(sparrow::ArrowFlag::MAP_KEYS_SORTED);
+                    }
+                    // validity, offsets
+                    set_nested_decoder(field, decoder, &decode_list<int32_t>, "+m", 2, 1);
+                    return;
+                }
+                case org::apache::arrow::flatbuf::Type::Union:
+                {
+                    const auto* union_type = field.type_as_Union();
+                    const size_t children_count = field.children() == nullptr ? 0 : field.children()->size();
+                    // Without explicit type ids, the type id of a child is its index
+                    std::vector<int32_t> type_ids(children_count);
+                    std::iota(type_ids.begin(), type_ids.end(), 0);
+                    if (union_type->typeIds() != nullptr)
+                    {
+                        type_ids.assign(union_type->typeIds()->begin(), union_type->typeIds()->end());
+                    }
+                    std::array<bool, 128> declared{};
+                    std::string format = union_type->mode() == org::apache::arrow::flatbuf::UnionMode::Dense
+                                             ? "+ud:"
+                                             : "+us:";
+                    for (size_t i = 0; i < type_ids.size(); ++i)
+                    {
+                        const int32_t type_id = type_ids[i];
+                        if (type_id < 0 || type_id >= 128 || declared[static_cast<size_t>(type_id)])
+                        {
+                            set_unsupported_decoder(
+                                decoder,
+                                "Invalid type id " + std::to_string(type_id) + " of union field '" + decoder.name + "'"
+                            );
+                            return;
+                        }
+                        declared[static_cast<size_t>(type_id)] = true;
+                        decoder.type_ids.push_back(static_cast<int8_t>(type_id));
+                        format += (i == 0 ? "" : ",") + std::to_string(type_id);
+                    }
+                    if (union_type->mode() == org::apache::arrow::flatbuf::UnionMode::Dense)
+                    {
+                        // type ids, offsets
+                        set_nested_decoder(
+                            field,
+                            decoder,
+                            &decode_union<org::apache::arrow::flatbuf::UnionMode::Dense>,
+                            std::move(format),
+                            2,
+                            type_ids.size()
+                        );
+                    }
+                    else
+                    {
+                        // type ids
+                        set_nested_decoder(
+                            field,
+                            decoder,
+                            &decode_union<org::apache::arrow::flatbuf::UnionMode::Sparse>,
+                            std::move(format),
+                            1,
+                            type_ids.size()
+                        );
+                    }
+                    return;
+                }
+                case org::apache::arrow::flatbuf::Type::RunEndEncoded:
+                {
+                    // Children: run ends and values
+                    const auto* children = field.children();
+                    const auto* run_ends_type = children != nullptr && children->size() == 2
+                                                    ? children->Get(0)->type_as_Int()
+                                                    : nullptr;
+                    if (run_ends_type == nullptr || !run_ends_type->is_signed())
+                    {
+                        set_unsupported_decoder(
+                            decoder,
+                            "Field '" + decoder.name + "' of type RunEndEncoded must have signed integer run ends"
+                            " and values"
+                        );
+                        return;
+                    }
+                    const auto* values = children->Get(1);
+                    if (values->dictionary() == nullptr)
+                    {
+                        std::tie(decoder.run_layout, decoder.value_width) = get_values_layout(*values);
+                    }
+                    switch (run_ends_type->bitWidth())
+                    {
+                        case BIT_WIDTH_16:
+                            set_nested_decoder(field, decoder, &decode_run_end_encoded<int16_t>, "+r", 0, 2);
+                            return;
+                        case BIT_WIDTH_32:
+                            set_nested_decoder(field, decoder, &decode_run_end_encoded<int32_t>, "+r", 0, 2);
+                            return;
+                        case BIT_WIDTH_64:
+                            set_nested_decoder(field, decoder, &decode_run_end_encoded<int64_t>, "+r", 0, 2);
+                            return;
+                        default:
+                            set_unsupported_decoder(
+                                decoder,
+                                "Unsupported run ends bit width: " + std::to_string(run_ends_type->bitWidth())
+                            );
+                            return;
+                    }
+                }
+                case org::apache::arrow::flatbuf::Type::FixedSizeBinary:
+                    decoder.decode = &decode_fixed_size_binary;
+                    decoder.format = "w:" + std::to_string(field.type_as_FixedSizeBinary()->byteWidth());
+                    return;
+                case org::apache::arrow::flatbuf::Type::Binary:
+                    set_variable_size_binary_decoder<sparrow::binary_array>(decoder);
+                    return;
+                case org::apache::arrow::flatbuf::Type::LargeBinary:
+                    set_variable_size_binary_decoder<sparrow::big_binary_array>(decoder);
+                    return;
+                case org::apache::arrow::flatbuf::Type::Utf8:
+                    set_variable_size_binary_decoder<sparrow::string_array>(decoder);
+                    return;
+                case org::apache::arrow::flatbuf::Type::LargeUtf8:
+                    set_variable_size_binary_decoder<sparrow::big_string_array>(decoder);
+                    return;
+                case org::apache::arrow::flatbuf::Type::BinaryView:
+                    decoder.decode = &decode_binary_view;
+                    decoder.format = "vz";
+                    return;
+                case org::apache::arrow::flatbuf::Type::Utf8View:
+                    decoder.decode = &decode_binary_view;
+                    decoder.format = "vu";
+                    return;
+                case org::apache::arrow::flatbuf::Type::Interval:
+                {
+                    const auto interval_unit = field.type_as_Interval()->unit();
+                    switch (interval_unit)
+                    {
+                        case org::apache::arrow::flatbuf::IntervalUnit::YEAR_MONTH:
+                            set_simple_array_decoder<sparrow::interval_array, sparrow::chrono::months>(decoder);
+                            return;
+                        case org::apache::arrow::flatbuf::IntervalUnit::DAY_TIME:
+                            set_simple_array_decoder<sparrow::interval_array, sparrow::days_time_interval>(decoder);
+                            return;
+                        case org::apache::arrow::flatbuf::IntervalUnit::MONTH_DAY_NANO:
+                            set_simple_array_decoder<sparrow::interval_array, sparrow::month_day_nanoseconds_interval>(
+                                decoder
+                            );
+                            return;
+                    }
+                    set_unsupported_decoder(
+                        decoder,
+                        "Unsupported interval unit: " + std::to_string(static_cast<int>(interval_unit))
+                    );
+                    return;
+                }
+                case org::apache::arrow::flatbuf::Type::Duration:
+                {
+                    const auto time_unit = field.type_as_Duration()->unit();
+                    switch (time_unit)
+                    {
+                        case org::apache::arrow::flatbuf::TimeUnit::SECOND:
+                            set_simple_array_decoder<sparrow::duration_array, std::chrono::seconds>(decoder);
+                            return;
+                        case org::apache::arrow::flatbuf::TimeUnit::MILLISECOND:
+                            set_simple_array_decoder<sparrow::duration_array, std::chrono::milliseconds>(decoder);
+                            return;
+                        case org::apache::arrow::flatbuf::TimeUnit::MICROSECOND:
+                            set_simple_array_decoder<sparrow::duration_array, std::chrono::microseconds>(decoder);
+                            return;
+                        case org::apache::arrow::flatbuf::TimeUnit::NANOSECOND:
+                            set_simple_array_decoder<sparrow::duration_array, std::chrono::nanoseconds>(decoder);
+                            return;
+                    }
+                    set_unsupported_decoder(
+                        decoder,
+                        "Unsupported duration time unit: " + std::to_string(static_cast<int>(time_unit))
+                    );
+                    return;
+                }
+                case org::apache::arrow::flatbuf::Type::Timestamp:
+                {
+                    const auto* timestamp_type = field.type_as_Timestamp();
+                    const auto time_unit = timestamp_type->unit();
+                    if (timestamp_type->timezone() != nullptr)
+                    {
+                        const std::string timezone = timestamp_type->timezone()->str();
+                        switch (time_unit)
+                        {
+                            case org::apache::arrow::flatbuf::TimeUnit::SECOND:
+                                set_simple_array_decoder<sparrow::timestamp_array, sparrow::timestamp_second>(decoder, timezone);
+                                return;
+                            case org::apache::arrow::flatbuf::TimeUnit::MILLISECOND:
+                                set_simple_array_decoder<sparrow::timestamp_array, sparrow::timestamp_millisecond>(decoder, timezone);
+                                return;
+                            case org::apache::arrow::flatbuf::TimeUnit::MICROSECOND:
+                                set_simple_array_decoder<sparrow::timestamp_array, sparrow::timestamp_microsecond>(decoder, timezone);
+                                return;
+                            case org::apache::arrow::flatbuf::TimeUnit::NANOSECOND:
+                                set_simple_array_decoder<sparrow::timestamp_array, sparrow::timestamp_nanosecond>(decoder, timezone);
+                                return;
+                        }
+                    }
+                    else
+                    {
+                        switch (time_unit)
+                        {
+                            case org::apache::arrow::flatbuf::TimeUnit::SECOND:
+                                set_simple_array_decoder<sparrow::timestamp_without_timezone_array, sparrow::zoned_time_without_timezone_seconds>(decoder);
+                                return;
+                            case org::apache::arrow::flatbuf::TimeUnit::MILLISECOND:
+                                set_simple_array_decoder<sparrow::timestamp_without_timezone_array, sparrow::zoned_time_without_timezone_milliseconds>(decoder);
+                                return;
+                            case org::apache::arrow::flatbuf::TimeUnit::MICROSECOND:
+                                set_simple_array_decoder<sparrow::timestamp_without_timezone_array, sparrow::zoned_time_without_timezone_microseconds>(decoder);
+                                return;
+                            case org::apache::arrow::flatbuf::TimeUnit::NANOSECOND:
+                                set_simple_array_decoder<sparrow::timestamp_without_timezone_array, sparrow::zoned_time_without_timezone_nanoseconds>(decoder);
+                                return;
+                        }
+                    }
+                    set_unsupported_decoder(
+                        decoder,
+                        "Unsupported timestamp time unit: " + std::to_string(static_cast<int>(time_unit))
+                    );
+                    return;
+                }
+                case org::apache::arrow::flatbuf::Type::Date:
+                {
+                    const auto date_unit = field.type_as_Date()->unit();
+                    switch (date_unit)
+                    {
+                        case org::apache::arrow::flatbuf::DateUnit::DAY:
+                            set_simple_array_decoder<sparrow::date_array, sparrow::date_days>(decoder);
+                            return;
+                        case org::apache::arrow::flatbuf::DateUnit::MILLISECOND:
+                            set_simple_array_decoder<sparrow::date_array, sparrow::date_milliseconds>(decoder);
+                            return;
+                    }
+                    set_unsupported_decoder(
+                        decoder,
+                        "Unsupported date unit: " + std::to_string(static_cast<int>(date_unit))
+                    );
+                    return;
+                }
+                case org::apache::arrow::flatbuf::Type::Time:
+                {
+                    const auto time_unit = field.type_as_Time()->unit();
+                    switch (time_unit)
+                    {
+                        case org::apache::arrow::flatbuf::TimeUnit::SECOND:
+                            set_simple_array_decoder<sparrow::time_array, sparrow::chrono::time_seconds>(decoder);
+                            return;
+                        case org::apache::arrow::flatbuf::TimeUnit::MILLISECOND:
+                            set_simple_array_decoder<sparrow::time_array, sparrow::chrono::time_milliseconds>(decoder);
+                            return;
+                        case org::apache::arrow::flatbuf::TimeUnit::MICROSECOND:
+                            set_simple_array_decoder<sparrow::time_array, sparrow::chrono::time_microseconds>(decoder);
+                            return;
+                        case org::apache::arrow::flatbuf::TimeUnit::NANOSECOND:
+                            set_simple_array_decoder<sparrow::time_array, sparrow::chrono::time_nanoseconds>(decoder);
+                            return;
+                    }
+                    set_unsupported_decoder(
+                        decoder,
+                        "Unsupported time unit: " + std::to_string(static_cast<int>(time_unit))
+                    );
+                    return;
+                }
+                case org::apache::arrow::flatbuf::Type::Null:
+                    decoder.decode = &decode_null;
+                    decoder.format = std::string(
+                        data_type_to_format(sparrow::detail::get_data_type_from_array<sparrow::null_array>::get())
+                    );
+                    return;
+                case org::apache::arrow::flatbuf::Type::Decimal:
+                {
+                    const auto* decimal_type = field.type_as_Decimal();
+                    const int32_t bit_width = decimal_type->bitWidth();
+                    decoder.format = "d:" + std::to_string(decimal_type->precision()) + ","
+                                     + std::to_string(decimal_type->scale());
+                    if (bit_width != 128)  // The size is implicit for 128-bit decimals
+                    {
+                        decoder.format += "," + std::to_string(bit_width);
+                    }
+                    switch (bit_width)
+                    {
+                        case 32:
+                            decoder.decode = &decode_decimal<sparrow::decimal<int32_t>>;
+                            return;
+                        case 64:
+                            decoder.decode = &decode_decimal<sparrow::decimal<int64_t>>;
+                            return;
+                        case 128:
+                            decoder.decode = &decode_decimal<sparrow::decimal<sparrow::int128_t>>;
+                            return;
+                        case 256:
+                            decoder.decode = &decode_decimal<sparrow::decimal<sparrow::int256_t>>;
+                            return;
+                    }
+                    set_unsupported_decoder(
+                        decoder,
+                        "Unsupported decimal bit width: " + std::to_string(bit_width)
+                    );
+                    return;
+                }
+                default:
+                    set_unsupported_decoder(
+                        decoder,
+                        "Unsupported field type: " + std::to_string(static_cast<int>(field_type)) + " for field '"
+                            + (field.name() == nullptr ? "" : field.name()->str()) + "'"
+                    );
+                    return;
+            }
+        }
+
+        // Compiles the decoders of the dictionaries of a field and of its descendants, once per
+        // dictionary id.
+        void compile_dictionary_decoders(const org::apache::arrow::flatbuf::Field& field, decoder_plan& plan)
+        {
+            const auto* encoding = field.dictionary();
+            if (encoding != nullptr
+                && std::ranges::none_of(
+                    plan.dictionaries,
+                    [id = encoding->id()](const dictionary_decoder& decoder)
+                    {
+                        return decoder.id == id;
+                    }
+                ))
+            {
+                dictionary_decoder& decoder = plan.dictionaries.emplace_back();
+                decoder.id = encoding->id();
+                field_decoder& values = decoder.values;
+                values.flags = static_cast<int64_t>(sparrow::ArrowFlag::NULLABLE);
+                try
+                {
+                    values.buffer_count = utils::count_value_buffers(field);
+                    values.node_count = utils::count_value_nodes(field);
+                    values.variadic_count_entries = utils::count_value_variadic_buffer_counts(field);
+                    resolve_value_decoder(field, values);
+                    std::tie(decoder.layout, decoder.value_width) = get_values_layout(field);
+                }
+                catch (const std::runtime_error& e)
+                {
+                    set_unsupported_decoder(values, e.what());
+                }
+            }
+            if (field.children() != nullptr)
+            {
+                for (const auto* child : *field.children())
+                {
+                    compile_dictionary_decoders(*child, plan);
+                }
+            }
+        }
+
+        // Checks that the top-level FieldNodes of the decoded fields match the RecordBatch. The
+        // FieldNodes of the children are checked when the children are decoded.
+        void check_field_nodes(const decoder_plan& plan, const org::apache::arrow::flatbuf::RecordBatch& record_batch)
+        {
+            if (record_batch.length() < 0)
+            {
+                throw std::runtime_error("Invalid RecordBatch length: " + std::to_string(record_batch.length()));
+            }
+            for (const field_decoder& field : plan.fields)
+            {
+                if (field.decode == &decode_unsupported)
+                {
+                    continue;
+                }
+                const auto* node = field_node(field, record_batch);
+                check_field_node(field, *node);
+                if (node->length() != record_batch.length())
+                {
+                    throw std::runtime_error(
+                        "Invalid FieldNode for field '" + field.name + "': length " + std::to_string(node->length())
+                        + ", null count " + std::to_string(node->null_count()) + ", in a RecordBatch of length "
+                        + std::to_string(record_batch.length())
+                    );
+                }
+            }
+        }
+    }
+
+    std::pair<run_values_layout, size_t> get_values_layout(const org::apache::arrow::flatbuf::Field& values)
+    {
+        switch (values.type_type())
+        {
+            case org::apache::arrow::flatbuf::Type::Bool:
+                return {run_values_layout::bitmap, 0};
+            case org::apache::arrow::flatbuf::Type::Int:
+                return {run_values_layout::fixed_width, static_cast<size_t>(values.type_as_Int()->bitWidth() / 8)};
+            case org::apache::arrow::flatbuf::Type::FloatingPoint:
+                switch (values.type_as_FloatingPoint()->precision())
+                {
+                    case org::apache::arrow::flatbuf::Precision::HALF:
+                        return {run_values_layout::fixed_width, 2};
+                    case org::apache::arrow::flatbuf::Precision::SINGLE:
+                        return {run_values_layout::fixed_width, 4};
+                    case org::apache::arrow::flatbuf::Precision::DOUBLE:
+                        return {run_values_layout::fixed_width, 8};
+                }
+                break;
+            case org::apache::arrow::flatbuf::Type::Decimal:
+                return {
+                    run_values_layout::fixed_width,
+                    static_cast<size_t>(values.type_as_Decimal()->bitWidth() / 8)
+                };
+            case org::apache::arrow::flatbuf::Type::Date:
+                return {
+                    run_values_layout::fixed_width,
+                    values.type_as_Date()->unit() == org::apache::arrow::flatbuf::DateUnit::DAY ? 4u : 8u
+                };
+            case org::apache::arrow::flatbuf::Type::Time:
+                return {run_values_layout::fixed_width, static_cast<size_t>(values.type_as_Time()->bitWidth() / 8)};
+            case org::apache::arrow::flatbuf::Type::Timestamp:
+            case org::apache::arrow::flatbuf::Type::Duration:
+                return {run_values_layout::fixed_width, 8};
+            case org::apache::arrow::flatbuf::Type::Interval:
+                switch (values.type_as_Interval()->unit())
+                {
+                    case org::apache::arrow::flatbuf::IntervalUnit::YEAR_MONTH:
+                        return {run_values_layout::fixed_width, 4};
+                    case org::apache::arrow::flatbuf::IntervalUnit::DAY_TIME:
+                        return {run_values_layout::fixed_width, 8};
+                    case org::apache::arrow::flatbuf::IntervalUnit::MONTH_DAY_NANO:
+                        return {run_values_layout::fixed_width, 16};
+                }
+                break;
+            case org::apache::arrow::flatbuf::Type::FixedSizeBinary:
+                return {
+                    run_values_layout::fixed_width,
+                    static_cast<size_t>(std::max(values.type_as_FixedSizeBinary()->byteWidth(), 0))
+                };
+            case org::apache::arrow::flatbuf::Type::Binary:
+            case org::apache::arrow::flatbuf::Type::Utf8:
+                return {run_values_layout::binary, 0};
+            case org::apache::arrow::flatbuf::Type::LargeBinary:
+            case org::apache::arrow::flatbuf::Type::LargeUtf8:
+                return {run_values_layout::large_binary, 0};
+            default:
+                break;
+        }
+        return {run_values_layout::unsupported, 0};
+    }
+
+    decoder_plan compile_decoder_plan(const decoded_schema& schema)
+    {
+        decoder_plan plan;
+        plan.validation = schema.validation;
+        plan.expand_run_end_encoded = schema.expand_run_end_encoded;
+        const bool big_endian = schema.schema->endianness() == org::apache::arrow::flatbuf::Endianness::Big;
+        plan.swap_byte_order = big_endian != (std::endian::native == std::endian::big);
+        const std::vector<size_t>& field_indices = schema.field_indices;
+        if (field_indices.empty())
+        {
+            return plan;
+        }
+        const auto* fields = schema.schema->fields();
+
+        // The buffers and FieldNodes of the fields are laid out in schema order: locate the first
+        // ones of every field up to the last decoded one.
+        const size_t last_field = std::ranges::max(field_indices);
+        std::vector<size_t> first_buffers(last_field + 1, 0);
+        std::vector<size_t> buffer_counts(last_field + 1, 0);
+        std::vector<size_t> first_nodes(last_field + 1, 0);
+        std::vector<size_t> node_counts(last_field + 1, 0);
+        std::vector<size_t> first_variadic_counts(last_field + 1, 0);
+        std::vector<size_t> variadic_count_entries(last_field + 1, 0);
+        std::string layout_error;
+        size_t located_fields = 0;
+        size_t buffer_index = 0;
+        size_t node_index = 0;
+        size_t variadic_index = 0;
+        for (; located_fields <= last_field; ++located_fields)
+        {
+            const auto* field = fields->Get(static_cast<flatbuffers::uoffset_t>(located_fields));
+            try
+            {
+                buffer_counts[located_fields] = utils::count_field_buffers(*field);
+            }
+            catch (const std::runtime_error& e)
+            {
+                // The buffers of this field and of the following ones cannot be located
+                layout_error = e.what();
+                break;
+            }
+            first_buffers[located_fields] = buffer_index;
+            buffer_index += buffer_counts[located_fields];
+            first_nodes[located_fields] = node_index;
+            node_counts[located_fields] = utils::count_field_nodes(*field);
+            node_index += node_counts[located_fields];
+            first_variadic_counts[located_fields] = variadic_index;
+            variadic_count_entries[located_fields] = utils::count_field_variadic_buffer_counts(*field);
+            variadic_index += variadic_count_entries[located_fields];
+        }
+
+        plan.fields.reserve(field_indices.size());
+        for (size_t i = 0; i < field_indices.size(); ++i)
+        {
+            const size_t index = field_indices[i];
+            const auto* field = fields->Get(static_cast<flatbuffers::uoffset_t>(index));
+            field_decoder& decoder = plan.fields.emplace_back();
+            decoder.name = schema.field_names[i];
+            if (schema.fields_metadata[i].has_value())
+            {
+                decoder.metadata = sparrow::get_metadata_from_key_values(*schema.fields_metadata[i]);
+            }
+            if (field->nullable())
+            {
+                decoder.flags = static_cast<int64_t>(sparrow::ArrowFlag::NULLABLE);
+            }
+            if (index >= located_fields)
+            {
+                set_unsupported_decoder(decoder, layout_error);
+                continue;
+            }
+            decoder.first_buffer = first_buffers[index];
+            decoder.buffer_count = buffer_counts[index];
+            decoder.node_index = first_nodes[index];
+            decoder.node_count = node_counts[index];
+            decoder.first_variadic_count = first_variadic_counts[index];
+            decoder.variadic_count_entries = variadic_count_entries[index];
+            plan.required_buffer_count = std::max(
+                plan.required_buffer_count,
+                decoder.first_buffer + decoder.buffer_count
+            );
+            plan.required_node_count = std::max(plan.required_node_count, decoder.node_index + decoder.node_count);
+            plan.required_variadic_count_entries = std::max(
+                plan.required_variadic_count_entries,
+                decoder.first_variadic_count + decoder.variadic_count_entries
+            );
+            resolve_decoder(*field, decoder);
+            compile_dictionary_decoders(*field, plan);
+        }
+        return plan;
+    }
+
+    void check_record_batch(const decoder_plan& plan, const org::apache::arrow::flatbuf::RecordBatch& record_batch)
+    {
+        const size_t buffer_count = record_batch.buffers() == nullptr
+                                        ? 0
+                                        : static_cast<size_t>(record_batch.buffers()->size());
+        const std::vector<size_t> variadic_offsets = get_variadic_offsets(
+            record_batch,
+            plan.required_variadic_count_entries
+        );
+        const size_t required_buffer_count = plan.required_buffer_count
+                                             + (variadic_offsets.empty() ? 0 : variadic_offsets.back());
+        if (buffer_count < required_buffer_count)
+        {
+            throw std::runtime_error(
+                "RecordBatch describes " + std::to_string(buffer_count) + " buffers, but its schema requires "
+                + std::to_string(required_buffer_count)
+            );
+        }
+
+        const size_t node_count = record_batch.nodes() == nullptr
+                                      ? 0
+                                      : static_cast<size_t>(record_batch.nodes()->size());
+        if (node_count < plan.required_node_count)
+        {
+            throw std::runtime_error(
+                "RecordBatch describes " + std::to_string(node_count) + " field nodes, but its schema requires "
+                + std::to_string(plan.required_node_count)
+            );
+        }
+        if (plan.validation != validation_level::none)
+        {
+            check_field_nodes(plan, record_batch);
+        }
+    }
+
+    sparrow::array decode_field(
+        const std::shared_ptr<const decoder_plan>& plan,
+        size_t index,
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        const dictionary_set* dictionaries
+    )
+    {
+        const field_decoder& field = plan->fields[index];
+        const std::vector<size_t> variadic_offsets = get_variadic_offsets(
+            record_batch,
+            plan->required_variadic_count_entries
+        );
+        const decode_context context{record_batch, body, plan->validation, plan, dictionaries, variadic_offsets};
+        return field.decode(field, context, make_field_schema(field, plan));
+    }
+
+    std::vector<sparrow::array> execute_decoder_plan(
+        const std::shared_ptr<const decoder_plan>& plan,
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        const dictionary_set* dictionaries
+    )
+    {
+        check_record_batch(*plan, record_batch);
+        const std::vector<size_t> variadic_offsets = get_variadic_offsets(
+            record_batch,
+            plan->required_variadic_count_entries
+        );
+        const decode_context context{record_batch, body, plan->validation, plan, dictionaries, variadic_offsets};
+        std::vector<sparrow::array> arrays;
+        arrays.reserve(plan->fields.size());
+        for (const field_decoder& field : plan->fields)
+        {
+            arrays.push_back(field.decode(field, context, make_field_schema(field, plan)));
+        }
+        return arrays;
+    }
+
+    namespace
+    {
+        // Buffers are laid out in the copies of a body at 64-byte aligned offsets
+        constexpr size_t COPY_BUFFER_ALIGNMENT = 64;
+
+        // Copy of a RecordBatch whose buffers are described by `buffers`, pointing into `body`
+        std::shared_ptr<const decompressed_record_batch> make_record_batch_copy(
+            const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+            const std::vector<org::apache::arrow::flatbuf::Buffer>& buffers,
+            sparrow::buffer<uint8_t> body
+        )
+        {
+            flatbuffers::FlatBufferBuilder builder;
+            std::vector<org::apache::arrow::flatbuf::FieldNode> nodes;
+            if (record_batch.nodes() != nullptr)
+            {
+                nodes.reserve(record_batch.nodes()->size());
+                for (const auto* node : *record_batch.nodes())
+                {
+                    nodes.push_back(*node);
+                }
+            }
+            const auto nodes_offset = builder.CreateVectorOfStructs(nodes);
+            const auto buffers_offset = builder.CreateVectorOfStructs(buffers);
+            flatbuffers::Offset<flatbuffers::Vector<int64_t>> variadic_counts_offset = 0;
+            if (record_batch.variadicBufferCounts() != nullptr)
+            {
+                variadic_counts_offset = builder.CreateVector(
+                    record_batch.variadicBufferCounts()->data(),
+                    record_batch.variadicBufferCounts()->size()
+                );
+            }
+            builder.Finish(org::apache::arrow::flatbuf::CreateRecordBatch(
+                builder,
+                record_batch.length(),
+                nodes_offset,
+                buffers_offset,
+                0,
+                variadic_counts_offset
+            ));
+            return std::make_shared<const decompressed_record_batch>(builder.Release(), std::move(body));
+        }
+
+        // Appends the buffers of a decoded field and of its children, with the conversion of
+        // their byte order. The buffers of an unsupported field are copied as they are, decoding
+        // the field reports why it is not supported.
+        void collect_byte_swaps(
+            const field_decoder& field,
+            std::span<const size_t> variadic_offsets,
+            std::vector<std::pair<size_t, byte_swap_kind>>& swaps
+        )
+        {
+            const size_t first_buffer = locate_first_buffer(field, variadic_offsets);
+            const size_t buffer_count = field.buffer_count + count_variadic_buffers(field, variadic_offsets);
+            if (field.decode == &decode_unsupported)
+            {
+                for (size_t i = 0; i < buffer_count; ++i)
+                {
+                    swaps.emplace_back(first_buffer + i, byte_swap_kind::none);
+                }
+                return;
+            }
+            // The own buffers of a field are followed by the ones of its children, and the
+            // variadic data buffers of a view are not converted
+            const size_t own_buffer_count = field.children.empty()
+                                                ? buffer_count
+                                                : locate_first_buffer(field.children.front(), variadic_offsets)
+                                                      - first_buffer;
+            const std::vector<byte_swap_kind> kinds = get_byte_swap_kinds(
+                sparrow::format_to_data_type(field.format)
+            );
+            for (size_t i = 0; i < own_buffer_count; ++i)
+            {
+                swaps.emplace_back(first_buffer + i, i < kinds.size() ? kinds[i] : byte_swap_kind::none);
+            }
+            for (const field_decoder& child : field.children)
+            {
+                collect_byte_swaps(child, variadic_offsets, swaps);
+            }
+        }
+
+        // Copies the buffers of the decoded fields of a RecordBatch in the byte order of the host,
+        // decompressing them first when the RecordBatch is compressed
+        std::shared_ptr<const decompressed_record_batch> copy_byte_swapped(
+            std::span<const field_decoder> fields,
+            const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+            std::span<const uint8_t> body,
+            std::span<const size_t> variadic_offsets,
+            size_t num_threads
+        )
+        {
+            std::vector<std::pair<size_t, byte_swap_kind>> swaps;
+            for (const field_decoder& field : fields)
+            {
+                collect_byte_swaps(field, variadic_offsets, swaps);
+            }
+
+            const auto* body_compression = record_batch.compression();
+            std::vector<org::apache::arrow::flatbuf::Buffer> buffers(
+                record_batch.buffers() == nullptr ? 0 : record_batch.buffers()->size()
+            );
+            std::vector<std::span<const uint8_t>> sources(swaps.size());
+            size_t body_size = 0;
+            for (size_t i = 0; i < swaps.size(); ++i)
+            {
+                const size_t index = swaps[i].first;
+                size_t buffer_index = index;
+                sources[i] = utils::get_buffer(record_batch, body, buffer_index);
+                const size_t size = body_compression == nullptr ? sources[i].size()
+                                                                 : get_decompressed_size(sources[i]);
+                buffers[index] = org::apache::arrow::flatbuf::Buffer(
+                    static_cast<int64_t>(body_size),
+                    static_cast<int64_t>(size)
+                );
+                body_size += (size + COPY_BUFFER_ALIGNMENT - 1) / COPY_BUFFER_ALIGNMENT * COPY_BUFFER_ALIGNMENT;
+            }
+
+            sparrow::buffer<uint8_t> swapped_body(body_size, pool_allocator<uint8_t>());
+            parallel_for(
+                swaps.size(),
+                num_threads,
+                [&](size_t i)
+                {
+                    const auto& buffer = buffers[swaps[i].first];
+                    const std::span<uint8_t> destination(
+                        swapped_body.data() + buffer.offset(),
+                        static_cast<size_t>(buffer.length())
+                    );
+                    if (body_compression == nullptr)
+                    {
+                        byte_swap_copy(swaps[i].second, sources[i], destination, false);
+                        return;
+                    }
+                    // Buffers are decompressed then converted in place
+                    decompress_into(from_fb_compression_type(body_compression->codec()), sources[i], destination);
+                    byte_swap_copy(swaps[i].second, destination, destination, false);
+                }
+            );
+            return make_record_batch_copy(record_batch, buffers, std::move(swapped_body));
+        }
+    }
+
+    std::shared_ptr<const dictionary_set> read_dictionary_batch(
+        const std::shared_ptr<const decoder_plan>& plan,
+        const std::shared_ptr<const dictionary_set>& dictionaries,
+        const org::apache::arrow::flatbuf::DictionaryBatch& dictionary_batch,
+        std::span<const uint8_t> body,
+        const std::shared_ptr<const void>& body_owner
+    )
+    {
+        const auto it = std::ranges::find_if(
+            plan->dictionaries,
+            [id = dictionary_batch.id()](const dictionary_decoder& decoder)
+            {
+                return decoder.id == id;
+            }
+        );
+        if (it == plan->dictionaries.end())
+        {
+            // The dictionary is not used by the decoded fields
+            return dictionaries;
+        }
+        const field_decoder& values = it->values;
+        const auto* record_batch = dictionary_batch.data();
+        if (record_batch == nullptr)
+        {
+            throw std::runtime_error(
+                "DictionaryBatch of dictionary " + std::to_string(it->id) + " has no RecordBatch."
+            );
+        }
+        const size_t buffer_count = record_batch->buffers() == nullptr
+                                        ? 0
+                                        : static_cast<size_t>(record_batch->buffers()->size());
+        const size_t node_count = record_batch->nodes() == nullptr
+                                      ? 0
+                                      : static_cast<size_t>(record_batch->nodes()->size());
+        const std::vector<size_t> variadic_offsets = get_variadic_offsets(*record_batch, values.variadic_count_entries);
+        const size_t required_buffer_count = values.buffer_count + count_variadic_buffers(values, variadic_offsets);
+        if (buffer_count < required_buffer_count || node_count < values.node_count)
+        {
+            throw std::runtime_error(
+                "DictionaryBatch of dictionary " + std::to_string(it->id) + " describes "
+                + std::to_string(buffer_count) + " buffers and " + std::to_string(node_count)
+                + " field nodes, but its values require " + std::to_string(required_buffer_count) + " and "
+                + std::to_string(values.node_count)
+            );
+        }
+        if (plan->validation != validation_level::none && values.decode != &decode_unsupported)
+        {
+            check_field_node(values, *field_node(values, *record_batch));
+        }
+
+        // The values are decoded from a converted copy of their buffers, which they keep alive.
+        // Dictionaries are usually small: their buffers are converted by the calling thread.
+        std::shared_ptr<const decompressed_record_batch> swapped;
+        if (plan->swap_byte_order)
+        {
+            swapped = copy_byte_swapped(std::span(&values, 1), *record_batch, body, variadic_offsets, 1);
+        }
+
+        // Dictionaries may be nested in the values of other dictionaries
+        const decode_context context{
+            swapped == nullptr ? *record_batch : swapped->record_batch(),
+            swapped == nullptr ? body : swapped->body(),
+            plan->validation,
+            plan,
+            dictionaries.get(),
+            variadic_offsets
+        };
+        sparrow::array array = values.decode(values, context, make_field_schema(values, plan));
+        std::shared_ptr<const void> owner = body_owner;
+        if (swapped != nullptr)
+        {
+            owner = swapped;
+        }
+        if (owner != nullptr)
+        {
+            attach_owner(sparrow::detail::array_access::get_arrow_proxy(array).array(), owner);
+        }
+
+        auto result = dictionaries == nullptr ? std::make_shared<dictionary_set>()
+                                              : std::make_shared<dictionary_set>(*dictionaries);
+        std::shared_ptr<const dictionary>& entry = result->dictionaries[it->id];
+        if (!dictionary_batch.isDelta())
+        {
+            entry = make_dictionary(std::move(array));
+        }
+        else if (entry == nullptr)
+        {
+            throw std::runtime_error(
+                "Delta DictionaryBatch of dictionary " + std::to_string(it->id) + ", which has not been read"
+            );
+        }
+        else
+        {
+            entry = append_to_dictionary(*entry, std::move(array), it->layout, it->value_width);
+        }
+        return result;
+    }
+
+    decompressed_record_batch::decompressed_record_batch(
+        flatbuffers::DetachedBuffer metadata,
+        sparrow::buffer<uint8_t> body
+    )
+        : m_metadata(std::move(metadata))
+        , m_body(std::move(body))
+    {
+    }
+
+    const org::apache::arrow::flatbuf::RecordBatch& decompressed_record_batch::record_batch() const
+    {
+        return *flatbuffers::GetRoot<org::apache::arrow::flatbuf::RecordBatch>(m_metadata.data());
+    }
+
+    std::span<const uint8_t> decompressed_record_batch::body() const
+    {
+        return {m_body.data(), m_body.size()};
+    }
+
+    std::shared_ptr<const decompressed_record_batch> decompress_record_batch(
+        const decoder_plan& plan,
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        size_t num_threads
+    )
+    {
+        check_record_batch(plan, record_batch);
+        const CompressionType codec = from_fb_compression_type(record_batch.compression()->codec());
+
+        // Only the buffers of the decoded fields are decompressed, variadic data buffers included
+        const std::vector<size_t> variadic_offsets = get_variadic_offsets(
+            record_batch,
+            plan.required_variadic_count_entries
+        );
+        std::vector<size_t> buffer_indices;
+        for (const field_decoder& field : plan.fields)
+        {
+            const size_t first_buffer = locate_first_buffer(field, variadic_offsets);
+            const size_t buffer_count = field.buffer_count + count_variadic_buffers(field, variadic_offsets);
+            for (size_t i = 0; i < buffer_count; ++i)
+            {
+                buffer_indices.push_back(first_buffer + i);
+            }
+        }
+
+        // Lay out the decompressed buffers in the new body
+        std::vector<org::apache::arrow::flatbuf::Buffer> buffers(
+            record_batch.buffers() == nullptr ? 0 : record_batch.buffers()->size()
+        );
+        std::vector<std::span<const uint8_t>> compressed(buffer_indices.size());
+        size_t body_size = 0;
+        for (size_t i = 0; i < buffer_indices.size(); ++i)
+        {
+            const size_t index = buffer_indices[i];
+            size_t buffer_index = index;
+            compressed[i] = utils::get_buffer(record_batch, body, buffer_index);
+            const size_t size = get_decompressed_size(compressed[i]);
+            buffers[index] = org::apache::arrow::flatbuf::Buffer(
+                static_cast<int64_t>(body_size),
+                static_cast<int64_t>(size)
+            );
+            body_size += (size + COPY_BUFFER_ALIGNMENT - 1) / COPY_BUFFER_ALIGNMENT * COPY_BUFFER_ALIGNMENT;
+        }
+
+        sparrow::buffer<uint8_t> decompressed_body(body_size, pool_allocator<uint8_t>());
+        parallel_for(
+            buffer_indices.size(),
+            num_threads,
+            [&](size_t i)
+            {
+                const auto& buffer = buffers[buffer_indices[i]];
+                decompress_into(
+                    codec,
+                    compressed[i],
+                    std::span<uint8_t>(
+                        decompressed_body.data() + buffer.offset(),
+                        static_cast<size_t>(buffer.length())
+                    )
+                );
+            }
+        );
+
+        return make_record_batch_copy(record_batch, buffers, std::move(decompressed_body));
+    }
+
+    std::shared_ptr<const decompressed_record_batch> byte_swap_record_batch(
+        const decoder_plan& plan,
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        size_t num_threads
+    )
+    {
+        check_record_batch(plan, record_batch);
+        const std::vector<size_t> variadic_offsets = get_variadic_offsets(
+            record_batch,
+            plan.required_variadic_count_entries
+        );
+        return copy_byte_swapped(plan.fields, record_batch, body, variadic_offsets, num_threads);
+    }
+
+    void attach_owner(ArrowArray& array, const std::shared_ptr<const void>& owner)
+    {
+        if (array.release == &arrow_array_release<arrow_array_private_data>)
+        {
+            static_cast<arrow_array_private_data*>(array.private_data)->set_owner(owner);
+        }
+        for (int64_t i = 0; i < array.n_children; ++i)
+        {
+            if (array.children[i] != nullptr)
+            {
+                attach_owner(*array.children[i], owner);
+            }
+        }
+    }
+}
@@ -0,0 +1,313 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sparrow/array.hpp>
+#include <sparrow/buffer/buffer.hpp>
+#include <sparrow/c_interface.hpp>
+
+#include "Message_generated.h"
+#include "sparrow_ipc/read_options.hpp"
+
+#include "dictionary.hpp"
+#include "run_end_encoding.hpp"
+
+namespace sparrow_ipc
+{
+    struct decoded_schema;
+}
+
+namespace sparrow_ipc::details
+{
+    struct decoder_plan;
+    struct field_decoder;
+
+    /**
+     * @brief The RecordBatch being decoded, and what its fields need to decode it.
+     */
+    struct decode_context
+    {
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch;
+        std::span<const uint8_t> body;
+        validation_level validation;
+        // Owner of the strings of the schemas of the decoded arrays
+        const std::shared_ptr<const decoder_plan>& plan;
+        // Dictionaries read before the RecordBatch, or nullptr
+        const dictionary_set* dictionaries = nullptr;
+        // Number of variadic data buffers before each entry of `RecordBatch::variadicBufferCounts`
+        // used by the plan, followed by their total; empty when the plan has no view field
+        std::span<const size_t> variadic_offsets = {};
+    };
+
+    using field_decode_function = sparrow::array (*)(
+        const field_decoder& field,
+        const decode_context& context,
+        ArrowSchema&& schema
+    );
+
+    /**
+     * @brief Pre-resolved decoding step of one decoded field.
+     *
+     * The type dispatch (type, bit width, precision, unit...) is done once when the plan is
+     * compiled; decoding the field of a RecordBatch is a single indirect call. The strings of
+     * the ArrowSchema of the field are built once too: the schemas of the decoded arrays borrow
+     * them, and share the ownership of the plan.
+     *
+     * Nested fields hold the steps of their children, located in the RecordBatch as well: the
+     * buffers and FieldNodes of a field are followed by the ones of its children, depth-first.
+     * The binary and string views are the exception: the number of their variadic data buffers
+     * is given by each RecordBatch, so the buffers located after them are shifted by the
+     * variadic buffers of the views before them when the RecordBatch is decoded.
+     */
+    struct field_decoder
+    {
+        field_decode_function decode = nullptr;
+        // Index of the first buffer of the field in `RecordBatch::buffers`, children included,
+        // ignoring the variadic data buffers
+        size_t first_buffer = 0;
+        size_t buffer_count = 0;
+        // Index of the first entry of the field in `RecordBatch::variadicBufferCounts`, children included
+        size_t first_variadic_count = 0;
+        size_t variadic_count_entries = 0;
+        // Index of the FieldNode of the field in `RecordBatch::nodes`, followed by the ones of its children
+        size_t node_index = 0;
+        size_t node_count = 1;
+        // Number of values of each list of a FixedSizeList field
+        int64_t list_size = 0;
+        // Type id of each child of a Union field
+        std::vector<int8_t> type_ids;
+        // Layout of the values of a RunEndEncoded field, and their size when fixed
+        run_values_layout run_layout = run_values_layout::unsupported;
+        size_t value_width = 0;
+        // Id of the dictionary of a dictionary-encoded field
+        int64_t dictionary_id = 0;
+        std::string name;
+        std::string format;
+        // Metadata serialized in the layout of the C data interface
+        std::optional<std::string> metadata;
+        int64_t flags = 0;
+        // Reason why the field cannot be decoded, reported when a RecordBatch is decoded
+        std::string unsupported_reason;
+        std::vector<field_decoder> children;
+    };
+
+    /**
+     * @brief Pre-resolved decoding step of the values of a dictionary.
+     *
+     * The values are the single field of the RecordBatch of the DictionaryBatch messages of the
+     * dictionary: their buffers and FieldNodes start at the first ones.
+     */
+    struct dictionary_decoder
+    {
+        int64_t id = 0;
+        field_decoder values;
+        // Layout of the values, telling how delta batches are appended, and their size when fixed
+        run_values_layout layout = run_values_layout::unsupported;
+        size_t value_width = 0;
+    };
+
+    /**
+     * @brief Decoding program of the RecordBatch messages of a schema.
+     *
+     * The plan holds one step per decoded field, in output order. Since the buffers of a field
+     * are at a fixed position in every RecordBatch of the stream, fields that are not decoded
+     * do not appear in the plan at all.
+     */
+    struct decoder_plan
+    {
+        std::vector<field_decoder> fields;
+        // Decoders of the dictionaries used by the decoded fields, children included
+        std::vector<dictionary_decoder> dictionaries;
+        // Minimum number of buffers a RecordBatch must describe
+        size_t required_buffer_count = 0;
+        // Minimum number of FieldNodes a RecordBatch must describe
+        size_t required_node_count = 0;
+        // Minimum number of entries of `RecordBatch::variadicBufferCounts` a RecordBatch must describe
+        size_t required_variadic_count_entries = 0;
+        validation_level validation = validation_level::metadata;
+        // Whether the RunEndEncoded fields are expanded into the layout of their values
+        bool expand_run_end_encoded = false;
+        // Whether the buffers are in the byte order opposite to the one of the host, given by the
+        // endianness of the schema: they are then decoded from a converted copy
+        bool swap_byte_order = false;
+    };
+
+    /**
+     * @brief Compiles the decoder plan of the decoded fields of a schema.
+     *
+     * @param schema The decoded schema, giving the fields to decode with their name and metadata,
+     *               and the validation level
+     */
+    [[nodiscard]] decoder_plan compile_decoder_plan(const decoded_schema& schema);
+
+    /**
+     * @brief Gets the layout of the values of a field, ignoring its dictionary encoding, with the
+     *        size in bytes of a value when it is fixed.
+     *
+     * @return The layout, `run_values_layout::unsupported` for nested, null and view types
+     */
+    [[nodiscard]] std::pair<run_values_layout, size_t>
+    get_values_layout(const org::apache::arrow::flatbuf::Field& values);
+
+    /**
+     * @brief Checks that a RecordBatch describes the buffers and FieldNodes its plan requires.
+     *
+     * The buffers required include the variadic data buffers of the binary and string views. With
+     * a validation level other than `none`, the FieldNodes of the decoded fields are also checked
+     * against the length of the RecordBatch.
+     *
+     * @throws std::runtime_error If the RecordBatch does not match the plan
+     */
+    void check_record_batch(const decoder_plan& plan, const org::apache::arrow::flatbuf::RecordBatch& record_batch);
+
+    /**
+     * @brief Decodes a single field of a RecordBatch, already checked with check_record_batch.
+     *
+     * @param plan The plan compiled from the schema of the stream, shared with the decoded array
+     * @param index The index of the field in `plan->fields`
+     * @param record_batch The FlatBuffer RecordBatch
+     * @param body The body of the RecordBatch message
+     * @param dictionaries The dictionaries read before the RecordBatch, or nullptr
+     * @return The decoded array
+     *
+     * @throws std::runtime_error If the field is not supported, fails the checks of the
+     *         validation level of the plan, or uses a dictionary that has not been read
+     */
+    [[nodiscard]] sparrow::array decode_field(
+        const std::shared_ptr<const decoder_plan>& plan,
+        size_t index,
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        const dictionary_set* dictionaries
+    );
+
+    /**
+     * @brief Decodes the arrays of a RecordBatch by running the plan of its schema.
+     *
+     * @param plan The plan compiled from the schema of the stream, shared with the decoded arrays
+     * @param record_batch The FlatBuffer RecordBatch
+     * @param body The body of the RecordBatch message
+     * @param dictionaries The dictionaries read before the RecordBatch, or nullptr
+     * @return One array per decoded field, in output order
+     *
+     * @throws std::runtime_error If the RecordBatch does not match the schema, contains
+     *         unsupported types, fails the checks of the validation level of the plan, or uses
+     *         a dictionary that has not been read
+     */
+    [[nodiscard]] std::vector<sparrow::array> execute_decoder_plan(
+        const std::shared_ptr<const decoder_plan>& plan,
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        const dictionary_set* dictionaries
+    );
+
+    /**
+     * @brief Reads a DictionaryBatch into the dictionaries of a stream.
+     *
+     * The values of the batch are decoded with the plan of their dictionary id, then either
+     * replace the dictionary or, for a delta batch, are appended to it. `dictionaries` is left
+     * unchanged, so that the arrays decoded before the batch keep their dictionary.
+     *
+     * @param plan The plan compiled from the schema of the stream
+     * @param dictionaries The dictionaries read before the batch, or nullptr
+     * @param dictionary_batch The FlatBuffer DictionaryBatch
+     * @param body The body of the DictionaryBatch message
+     * @param body_owner Optional: an object keeping the memory of `body` alive, shared with the
+     *                   values of the dictionary
+     * @return The dictionaries after the batch, or `dictionaries` itself when no decoded field
+     *         uses the dictionary of the batch
+     *
+     * @throws std::runtime_error If the batch does not match the type of its dictionary, fails
+     *         the checks of the validation level of the plan, or is a delta for a dictionary that
+     *         has not been read or whose values cannot be appended to
+     */
+    [[nodiscard]] std::shared_ptr<const dictionary_set> read_dictionary_batch(
+        const std::shared_ptr<const decoder_plan>& plan,
+        const std::shared_ptr<const dictionary_set>& dictionaries,
+        const org::apache::arrow::flatbuf::DictionaryBatch& dictionary_batch,
+        std::span<const uint8_t> body,
+        const std::shared_ptr<const void>& body_owner
+    );
+
+    /**
+     * @brief Uncompressed copy of the buffers of a compressed RecordBatch, or copy in the byte
+     *        order of the host of the buffers of a RecordBatch written in the other one.
+     *
+     * The metadata describes the same FieldNodes as the original RecordBatch, without
+     * compression, with the buffers pointing into `body`. Buffers of the fields that are not
+     * decoded are empty.
+     */
+    class decompressed_record_batch
+    {
+    public:
+
+        decompressed_record_batch(flatbuffers::DetachedBuffer metadata, sparrow::buffer<uint8_t> body);
+
+        [[nodiscard]] const org::apache::arrow::flatbuf::RecordBatch& record_batch() const;
+
+        [[nodiscard]] std::span<const uint8_t> body() const;
+
+    private:
+
+        flatbuffers::DetachedBuffer m_metadata;
+        sparrow::buffer<uint8_t> m_body;
+    };
+
+    /**
+     * @brief Decompresses the buffers of the decoded fields of a RecordBatch concurrently.
+     *
+     * The decompressed sizes are read from the buffer headers first, so that all the buffers
+     * are decompressed in place into a single body allocated once.
+     *
+     * @param plan The plan of the schema, giving the buffers to decompress
+     * @param record_batch The compressed FlatBuffer RecordBatch
+     * @param body The body of the RecordBatch message
+     * @param num_threads The number of threads, 0 meaning the hardware concurrency
+     * @return The uncompressed RecordBatch, to be decoded with the same plan
+     *
+     * @throws std::runtime_error If the RecordBatch does not match the plan or a buffer cannot
+     *         be decompressed
+     */
+    [[nodiscard]] std::shared_ptr<const decompressed_record_batch> decompress_record_batch(
+        const decoder_plan& plan,
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        size_t num_threads
+    );
+
+    /**
+     * @brief Converts the buffers of the decoded fields of a RecordBatch to the byte order of the host.
+     *
+     * The fixed-width values, offsets, decimals and views of the fields are converted one buffer per
+     * task, into a single body allocated once. A compressed RecordBatch is decompressed at the same
+     * time, each buffer being converted in place once decompressed.
+     *
+     * @param plan The plan of the schema, giving the buffers to convert and their layout
+     * @param record_batch The FlatBuffer RecordBatch, in the byte order opposite to the one of the host
+     * @param body The body of the RecordBatch message
+     * @param num_threads The number of threads, 0 meaning the hardware concurrency
+     * @return The converted RecordBatch, to be decoded with the same plan
+     *
+     * @throws std::runtime_error If the RecordBatch does not match the plan, a buffer cannot be
+     *         decompressed, or the byte order of a decoded type cannot be converted
+     */
+    [[nodiscard]] std::shared_ptr<const decompressed_record_batch> byte_swap_record_batch(
+        const decoder_plan& plan,
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        size_t num_threads
+    );
+
+    /**
+     * @brief Makes the buffers borrowed by `array` and its descendants keep `owner` alive.
+     *
+     * The dictionaries are left untouched: they keep the memory of their own message alive.
+     */
+    void attach_owner(ArrowArray& array, const std::shared_ptr<const void>& owner);
+}
@@ -1,29 +1,25 @@
 #include "sparrow_ipc/deserialize.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
 #include <sparrow/types/data_type.hpp>
 
-#include "sparrow_ipc/deserialize_decimal_array.hpp"
-#include "sparrow_ipc/deserialize_duration_array.hpp"
-#include "sparrow_ipc/deserialize_fixedsizebinary_array.hpp"
-#include "sparrow_ipc/deserialize_interval_array.hpp"
-#include "sparrow_ipc/deserialize_null_array.hpp"
-#include "sparrow_ipc/deserialize_primitive_array.hpp"
-#include "sparrow_ipc/deserialize_time_related_arrays.hpp"
-#include "sparrow_ipc/deserialize_variable_size_binary_array.hpp"
 #include "sparrow_ipc/encapsulated_message.hpp"
 #include "sparrow_ipc/magic_values.hpp"
 #include "sparrow_ipc/metadata.hpp"
 
+#include "decoder_plan.hpp"
+#include "parallel_for.hpp"
+
 namespace sparrow_ipc
 {
     namespace
     {
-        // Integer bit width constants
-        constexpr int32_t BIT_WIDTH_8 = 8;
-        constexpr int32_t BIT_WIDTH_16 = 16;
-        constexpr int32_t BIT_WIDTH_32 = 32;
-        constexpr int32_t BIT_WIDTH_64 = 64;
-
         // End-of-stream marker size in bytes
         constexpr size_t END_OF_STREAM_MARKER_SIZE = 8;
     }
@@ -41,528 +37,243 @@ namespace sparrow_ipc
         return static_cast<const org::apache::arrow::flatbuf::RecordBatch*>(batch_message->header());
     }
 
-    /**
-     * @brief Deserializes arrays from an Apache Arrow RecordBatch using the provided schema.
-     *
-     * This function processes each field in the schema and deserializes the corresponding
-     * data from the RecordBatch into sparrow::array objects. It handles various Arrow data
-     * types including primitive types (bool, integers, floating point), binary data, string
-     * data, fixed-size binary data, and interval types.
-     *
-     * @param record_batch The Apache Arrow FlatBuffer RecordBatch containing the serialized data
-     * @param schema The Apache Arrow FlatBuffer Schema defining the structure and types of the data
-     * @param encapsulated_message The message containing the binary data buffers
-     * @param field_metadata Metadata associated with each field in the schema
-     *
-     * @return std::vector<sparrow::array> A vector of deserialized arrays, one for each field in the schema
-     *
-     * @throws std::runtime_error If an unsupported data type, integer bit width, floating point precision,
-     *         or interval unit is encountered
-     *
-     * @note The function maintains a buffer index that is incremented as it processes each field
-     *       to correctly map data buffers to their corresponding arrays.
-     */
-    std::vector<sparrow::array> get_arrays_from_record_batch(
-        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
-        const org::apache::arrow::flatbuf::Schema& schema,
-        const encapsulated_message& encapsulated_message,
-        const std::vector<std::optional<std::vector<sparrow::metadata_pair>>>& field_metadata
-    )
+    namespace
     {
-        size_t buffer_index = 0;
-
-        const size_t num_fields = schema.fields() == nullptr ? 0 : static_cast<size_t>(schema.fields()->size());
-        std::vector<sparrow::array> arrays;
-        if (num_fields == 0)
+        std::vector<size_t> resolve_field_indices(
+            const std::vector<std::string>& schema_field_names,
+            const read_options& options
+        )
         {
-            return arrays;
-        }
-        arrays.reserve(num_fields);
-        size_t field_idx = 0;
-        for (const auto field : *(schema.fields()))
-        {
-            const ::flatbuffers::Vector<::flatbuffers::Offset<org::apache::arrow::flatbuf::KeyValue>>*
-                fb_custom_metadata = field->custom_metadata();
-            const std::optional<std::vector<sparrow::metadata_pair>>& metadata = field_metadata[field_idx++];
-            const std::string name = field->name() == nullptr ? "" : field->name()->str();
-            const bool nullable = field->nullable();
-            const auto field_type = field->type_type();
-            // TODO rename all the deserialize_non_owning... fcts since this is not correct anymore
-            const auto deserialize_non_owning_primitive_array_lambda = [&]<typename T>()
+            const size_t num_fields = schema_field_names.size();
+            if (options.field_indices.has_value() && options.field_names.has_value())
             {
-                return deserialize_non_owning_primitive_array<T>(
-                    record_batch,
-                    encapsulated_message.body(),
-                    name,
-                    metadata,
-                    nullable,
-                    buffer_index
-                );
-            };
-
-            const auto deserialize_non_owning_date_array_lambda = [&]<typename T>()
-            {
-                return deserialize_non_owning_date_array<T>(
-                    record_batch,
-                    encapsulated_message.body(),
-                    name,
-                    metadata,
-                    nullable,
-                    buffer_index
-                );
-            };
-
-            const auto deserialize_non_owning_timestamp_array_lambda = [&]<typename T>(const std::string& timezone)
-            {
-                return deserialize_non_owning_timestamp_array<T>(
-                    record_batch,
-                    encapsulated_message.body(),
-                    name,
-                    metadata,
-                    nullable,
-                    buffer_index,
-                    timezone
-                );
-            };
-
-            const auto deserialize_non_owning_timestamp_without_timezone_array_lambda = [&]<typename T>()
-            {
-                return deserialize_non_owning_timestamp_without_timezone_array<T>(
-                    record_batch,
-                    encapsulated_message.body(),
-                    name,
-                    metadata,
-                    nullable,
-                    buffer_index
-                );
-            };
-
-            const auto deserialize_non_owning_time_array_lambda = [&]<typename T>()
-            {
-                return deserialize_non_owning_time_array<T>(
-                    record_batch,
-                    encapsulated_message.body(),
-                    name,
-                    metadata,
-                    nullable,
-                    buffer_index
-                );
-            };
+                throw std::invalid_argument("Only one of field_indices and field_names can be set.");
+            }
 
-            switch (field_type)
+            std::vector<size_t> indices;
+            if (options.field_indices.has_value())
             {
-                case org::apache::arrow::flatbuf::Type::Bool:
-                    arrays.emplace_back(
-                        deserialize_non_owning_primitive_array_lambda.template operator()<bool>()
-                    );
-                    break;
-                case org::apache::arrow::flatbuf::Type::Int:
+                indices = *options.field_indices;
+                for (const size_t index : indices)
                 {
-                    const auto* int_type = field->type_as_Int();
-                    const auto bit_width = int_type->bitWidth();
-                    const bool is_signed = int_type->is_signed();
-
-                    if (is_signed)
+                    if (index >= num_fields)
                     {
-                        switch (bit_width)
-                        {
-                                // clang-format off
-                                        case BIT_WIDTH_8:  arrays.emplace_back(deserialize_non_owning_primitive_array_lambda.template operator()<int8_t>()); break;
-                                        case BIT_WIDTH_16: arrays.emplace_back(deserialize_non_owning_primitive_array_lambda.template operator()<int16_t>()); break;
-                                        case BIT_WIDTH_32: arrays.emplace_back(deserialize_non_owning_primitive_array_lambda.template operator()<int32_t>()); break;
-                                        case BIT_WIDTH_64: arrays.emplace_back(deserialize_non_owning_primitive_array_lambda.template operator()<int64_t>()); break;
-                                        default: throw std::runtime_error("Unsupported integer bit width: " + std::to_string(bit_width));
-                                // clang-format on
-                        }
-                    }
-                    else
-                    {
-                        switch (bit_width)
-                        {
-                                // clang-format off
-                                        case BIT_WIDTH_8:  arrays.emplace_back(deserialize_non_owning_primitive_array_lambda.template operator()<uint8_t>()); break;
-                                        case BIT_WIDTH_16: arrays.emplace_back(deserialize_non_owning_primitive_array_lambda.template operator()<uint16_t>()); break;
-                                        case BIT_WIDTH_32: arrays.emplace_back(deserialize_non_owning_primitive_array_lambda.template operator()<uint32_t>()); break;
-                                        case BIT_WIDTH_64: arrays.emplace_back(deserialize_non_owning_primitive_array_lambda.template operator()<uint64_t>()); break;
-                                        default: throw std::runtime_error("Unsupported integer bit width: " + std::to_string(bit_width));
-                                // clang-format on
-                        }
+                        throw std::invalid_argument(
+                            "Field index " + std::to_string(index) + " is out of range, the schema has "
+                            + std::to_string(num_fields) + " fields."
+                        );
                     }
                 }
-                break;
-                case org::apache::arrow::flatbuf::Type::FloatingPoint:
+            }
+            else if (options.field_names.has_value())
+            {
+                indices.reserve(options.field_names->size());
+                for (const std::string& name : *options.field_names)
                 {
-                    const auto* float_type = field->type_as_FloatingPoint();
-                    switch (float_type->precision())
+                    const auto it = std::ranges::find(schema_field_names, name);
+                    if (it == schema_field_names.end())
                     {
-                            // clang-format off
-                                    case org::apache::arrow::flatbuf::Precision::HALF:
-                                        arrays.emplace_back(deserialize_non_owning_primitive_array_lambda.template operator()<sparrow::float16_t>());
-                                        break;
-                                    case org::apache::arrow::flatbuf::Precision::SINGLE:
-                                        arrays.emplace_back(deserialize_non_owning_primitive_array_lambda.template operator()<float>());
-                                        break;
-                                    case org::apache::arrow::flatbuf::Precision::DOUBLE:
-                                        arrays.emplace_back(deserialize_non_owning_primitive_array_lambda.template operator()<double>());
-                                        break;
-                                    default:
-                                        throw std::runtime_error(
-                                            "Unsupported floating point precision: "
-                                            + std::to_string(static_cast<int>(float_type->precision()))
-                                        );
-                            // clang-format on
+                        throw std::invalid_argument("Unknown field '" + name + "' in projection.");
                     }
-                    break;
+                    indices.push_back(static_cast<size_t>(std::distance(schema_field_names.begin(), it)));
                 }
-                case org::apache::arrow::flatbuf::Type::FixedSizeBinary:
+            }
+            else
+            {
+                indices.resize(num_fields);
+                std::iota(indices.begin(), indices.end(), size_t{0});
+                return indices;
+            }
+
+            std::vector<bool> selected(num_fields, false);
+            for (const size_t index : indices)
+            {
+                if (selected[index])
                 {
-                    const auto* fixed_size_binary_field = field->type_as_FixedSizeBinary();
-                    arrays.emplace_back(deserialize_non_owning_fixedwidthbinary(
-                        record_batch,
-                        encapsulated_message.body(),
-                        name,
-                        metadata,
-                        nullable,
-                        buffer_index,
-                        fixed_size_binary_field->byteWidth()
-                    ));
-                    break;
-                }
-                case org::apache::arrow::flatbuf::Type::Binary:
-                    arrays.emplace_back(
-                        deserialize_non_owning_variable_size_binary<sparrow::binary_array>(
-                            record_batch,
-                            encapsulated_message.body(),
-                            name,
-                            metadata,
-                            nullable,
-                            buffer_index
-                        )
-                    );
-                    break;
-                case org::apache::arrow::flatbuf::Type::LargeBinary:
-                    arrays.emplace_back(
-                        deserialize_non_owning_variable_size_binary<sparrow::big_binary_array>(
-                            record_batch,
-                            encapsulated_message.body(),
-                            name,
-                            metadata,
-                            nullable,
-                            buffer_index
-                        )
-                    );
-                    break;
-                case org::apache::arrow::flatbuf::Type::Utf8:
-                    arrays.emplace_back(
-                        deserialize_non_owning_variable_size_binary<sparrow::string_array>(
-                            record_batch,
-                            encapsulated_message.body(),
-                            name,
-                            metadata,
-                            nullable,
-                            buffer_index
-                        )
+                    throw std::invalid_argument(
+                        "Field '" + schema_field_names[index] + "' is selected more than once."
                     );
-                    break;
-                case org::apache::arrow::flatbuf::Type::LargeUtf8:
-                    arrays.emplace_back(
-                        deserialize_non_owning_variable_size_binary<sparrow::big_string_array>(
-                            record_batch,
-                            encapsulated_message.body(),
-                            name,
-                            metadata,
-                            nullable,
-                            buffer_index
-                        )
-                    );
-                    break;
-                case org::apache::arrow::flatbuf::Type::Interval:
-                {
-                    const auto* interval_type = field->type_as_Interval();
-                    const org::apache::arrow::flatbuf::IntervalUnit interval_unit = interval_type->unit();
-                    switch (interval_unit)
-                    {
-                        case org::apache::arrow::flatbuf::IntervalUnit::YEAR_MONTH:
-                            arrays.emplace_back(
-                                deserialize_non_owning_interval_array<sparrow::chrono::months>(
-                                    record_batch,
-                                    encapsulated_message.body(),
-                                    name,
-                                    metadata,
-                                    nullable,
-                                    buffer_index
-                                )
-                            );
-                            break;
-                        case org::apache::arrow::flatbuf::IntervalUnit::DAY_TIME:
-                            arrays.emplace_back(
-                                deserialize_non_owning_interval_array<sparrow::days_time_interval>(
-                                    record_batch,
-                                    encapsulated_message.body(),
-                                    name,
-                                    metadata,
-                                    nullable,
-                                    buffer_index
-                                )
-                            );
-                            break;
-                        case org::apache::arrow::flatbuf::IntervalUnit::MONTH_DAY_NANO:
-                            arrays.emplace_back(
-                                deserialize_non_owning_interval_array<sparrow::month_day_nanoseconds_interval>(
-                                    record_batch,
-                                    encapsulated_message.body(),
-                                    name,
-                                    metadata,
-                                    nullable,
-                                    buffer_index
-                                )
-                            );
-                            break;
-                        default:
-                            throw std::runtime_error(
-                                "Unsupported interval unit: " + std::to_string(static_cast<int>(interval_unit))
-                            );
-                    }
-                }
-                break;
-                case org::apache::arrow::flatbuf::Type::Duration:
-                {
-                    const auto* duration_type = field->type_as_Duration();
-                    const org::apache::arrow::flatbuf::TimeUnit time_unit = duration_type->unit();
-                    switch (time_unit)
-                    {
-                        case org::apache::arrow::flatbuf::TimeUnit::SECOND:
-                            arrays.emplace_back(
-                                deserialize_non_owning_duration_array<std::chrono::seconds>(
-                                    record_batch,
-                                    encapsulated_message.body(),
-                                    name,
-                                    metadata,
-                                    nullable,
-                                    buffer_index
-                                )
-                            );
-                            break;
-                        case org::apache::arrow::flatbuf::TimeUnit::MILLISECOND:
-                            arrays.emplace_back(
-                                deserialize_non_owning_duration_array<std::chrono::milliseconds>(
-                                    record_batch,
-                                    encapsulated_message.body(),
-                                    name,
-                                    metadata,
-                                    nullable,
-                                    buffer_index
-                                )
-                            );
-                            break;
-                        case org::apache::arrow::flatbuf::TimeUnit::MICROSECOND:
-                            arrays.emplace_back(
-                                deserialize_non_owning_duration_array<std::chrono::microseconds>(
-                                    record_batch,
-                                    encapsulated_message.body(),
-                                    name,
-                                    metadata,
-                                    nullable,
-                                    buffer_index
-                                )
-                            );
-                            break;
-                        case org::apache::arrow::flatbuf::TimeUnit::NANOSECOND:
-                            arrays.emplace_back(
-                                deserialize_non_owning_duration_array<std::chrono::nanoseconds>(
-                                    record_batch,
-                                    encapsulated_message.body(),
-                                    name,
-                                    metadata,
-                                    nullable,
-                                    buffer_index
-                                )
-                            );
-                            break;
-                        default:
-                            throw std::runtime_error(
-                                "Unsupported duration time unit: "
-                                + std::to_string(static_cast<int>(time_unit))
-                            );
-                    }
                 }
-                break;
-                case org::apache::arrow::flatbuf::Type::Timestamp:
-                {
-                    const auto timestamp_type = field->type_as_Timestamp();
-                    const auto time_unit = timestamp_type->unit();
-                    const bool has_timezone = timestamp_type->timezone() != nullptr;
+                selected[index] = true;
+            }
+            return indices;
+        }
+    }
 
-                    if (has_timezone)
-                    {
-                        const std::string timezone = timestamp_type->timezone()->str();
-                        switch (time_unit)
-                        {
-                            case org::apache::arrow::flatbuf::TimeUnit::SECOND:
-                                arrays.emplace_back(deserialize_non_owning_timestamp_array_lambda.template operator()<sparrow::timestamp_second>(timezone));
-                                break;
-                            case org::apache::arrow::flatbuf::TimeUnit::MILLISECOND:
-                                arrays.emplace_back(deserialize_non_owning_timestamp_array_lambda.template operator()<sparrow::timestamp_millisecond>(timezone));
-                                break;
-                            case org::apache::arrow::flatbuf::TimeUnit::MICROSECOND:
-                                arrays.emplace_back(deserialize_non_owning_timestamp_array_lambda.template operator()<sparrow::timestamp_microsecond>(timezone));
-                                break;
-                            case org::apache::arrow::flatbuf::TimeUnit::NANOSECOND:
-                                arrays.emplace_back(deserialize_non_owning_timestamp_array_lambda.template operator()<sparrow::timestamp_nanosecond>(timezone));
-                                break;
-                        }
-                    }
-                    else
-                    {
-                        switch (time_unit)
-                        {
-                            case org::apache::arrow::flatbuf::TimeUnit::SECOND:
-                                arrays.emplace_back(deserialize_non_owning_timestamp_without_timezone_array_lambda.template operator()<sparrow::zoned_time_without_timezone_seconds>());
-                                break;
-                            case org::apache::arrow::flatbuf::TimeUnit::MILLISECOND:
-                                arrays.emplace_back(deserialize_non_owning_timestamp_without_timezone_array_lambda.template operator()<sparrow::zoned_time_without_timezone_milliseconds>());
-                                break;
-                            case org::apache::arrow::flatbuf::TimeUnit::MICROSECOND:
-                                arrays.emplace_back(deserialize_non_owning_timestamp_without_timezone_array_lambda.template operator()<sparrow::zoned_time_without_timezone_microseconds>());
-                                break;
-                            case org::apache::arrow::flatbuf::TimeUnit::NANOSECOND:
-                                arrays.emplace_back(deserialize_non_owning_timestamp_without_timezone_array_lambda.template operator()<sparrow::zoned_time_without_timezone_nanoseconds>());
-                                break;
-                        }
-                    }
-                    break;
-                }
-                case org::apache::arrow::flatbuf::Type::Date:
-                {
-                    const auto date_type = field->type_as_Date();
-                    const auto date_unit = date_type->unit();
-                    switch (date_unit)
-                    {
-                        case org::apache::arrow::flatbuf::DateUnit::DAY:
-                            arrays.emplace_back(deserialize_non_owning_date_array_lambda.template operator()<sparrow::date_days>());
-                            break;
-                        case org::apache::arrow::flatbuf::DateUnit::MILLISECOND:
-                            arrays.emplace_back(deserialize_non_owning_date_array_lambda.template operator()<sparrow::date_milliseconds>());
-                            break;
-                    }
-                    break;
-                }
-                case org::apache::arrow::flatbuf::Type::Time:
-                {
-                    const auto time_type = field->type_as_Time();
-                    const auto time_unit = time_type->unit();
-                    switch (time_unit)
-                    {
-                        case org::apache::arrow::flatbuf::TimeUnit::SECOND:
-                            arrays.emplace_back(deserialize_non_owning_time_array_lambda.template operator()<sparrow::chrono::time_seconds>());
-                            break;
-                        case org::apache::arrow::flatbuf::TimeUnit::MILLISECOND:
-                            arrays.emplace_back(deserialize_non_owning_time_array_lambda.template operator()<sparrow::chrono::time_milliseconds>());
-                            break;
-                        case org::apache::arrow::flatbuf::TimeUnit::MICROSECOND:
-                            arrays.emplace_back(deserialize_non_owning_time_array_lambda.template operator()<sparrow::chrono::time_microseconds>());
-                            break;
-                        case org::apache::arrow::flatbuf::TimeUnit::NANOSECOND:
-                            arrays.emplace_back(deserialize_non_owning_time_array_lambda.template operator()<sparrow::chrono::time_nanoseconds>());
-                            break;
-                    }
-                    break;
-                }
-                case org::apache::arrow::flatbuf::Type::Null:
-                    arrays.emplace_back(deserialize_non_owning_null(
-                        record_batch,
-                        encapsulated_message.body(),
-                        name,
-                        metadata,
-                        nullable,
-                        buffer_index
-                    ));
-                    break;
-                case org::apache::arrow::flatbuf::Type::Decimal:
+    decoded_schema decode_schema(const org::apache::arrow::flatbuf::Schema& schema, const read_options& options)
+    {
+        decoded_schema result;
+        result.schema = &schema;
+        result.validation = options.validation;
+        result.decompression_threads = options.decompression_threads;
+        result.expand_run_end_encoded = options.expand_run_end_encoded;
+        if (schema.fields() == nullptr)
+        {
+            resolve_field_indices({}, options);
+            result.plan = std::make_shared<const details::decoder_plan>();
+            return result;
+        }
+        const size_t size = static_cast<size_t>(schema.fields()->size());
+        std::vector<std::string> field_names;
+        field_names.reserve(size);
+        for (const auto field : *(schema.fields()))
+        {
+            if (field != nullptr && field->name() != nullptr)
+            {
+                field_names.emplace_back(field->name()->str());
+            }
+            else
+            {
+                field_names.emplace_back("_unnamed_");
+            }
+        }
+
+        result.field_indices = resolve_field_indices(field_names, options);
+        result.field_names.reserve(result.field_indices.size());
+        result.fields_metadata.reserve(result.field_indices.size());
+        for (const size_t index : result.field_indices)
+        {
+            const auto* field = schema.fields()->Get(static_cast<flatbuffers::uoffset_t>(index));
+            result.field_names.push_back(std::move(field_names[index]));
+            const ::flatbuffers::Vector<::flatbuffers::Offset<org::apache::arrow::flatbuf::KeyValue>>*
+                fb_custom_metadata = field->custom_metadata();
+            std::optional<std::vector<sparrow::metadata_pair>>
+                metadata = fb_custom_metadata == nullptr
+                               ? std::nullopt
+                               : std::make_optional(to_sparrow_metadata(*fb_custom_metadata));
+            result.fields_metadata.push_back(std::move(metadata));
+        }
+        result.plan = std::make_shared<const details::decoder_plan>(
+            details::compile_decoder_plan(result)
+        );
+        return result;
+    }
+
+    void decode_dictionary_batch(
+        const encapsulated_message& message,
+        decoded_schema& schema,
+        std::shared_ptr<const void> body_owner
+    )
+    {
+        if (schema.schema == nullptr || schema.plan == nullptr)
+        {
+            throw std::runtime_error("DictionaryBatch encountered before Schema message.");
+        }
+        const auto* dictionary_batch = message.flat_buffer_message()->header_as_DictionaryBatch();
+        if (dictionary_batch == nullptr)
+        {
+            throw std::runtime_error("DictionaryBatch message header is null.");
+        }
+        schema.dictionaries = details::read_dictionary_batch(
+            schema.plan,
+            schema.dictionaries,
+            *dictionary_batch,
+            message.body(),
+            body_owner
+        );
+    }
+
+    namespace
+    {
+        // Decodes a RecordBatch message with the dictionaries read before it
+        sparrow::record_batch decode_record_batch_message(
+            const encapsulated_message& message,
+            const decoded_schema& schema,
+            const details::dictionary_set* dictionaries,
+            std::shared_ptr<const void> body_owner
+        )
+        {
+            if (schema.schema == nullptr || schema.plan == nullptr)
+            {
+                throw std::runtime_error("RecordBatch encountered before Schema message.");
+            }
+            const auto* record_batch = message.flat_buffer_message()->header_as_RecordBatch();
+            if (record_batch == nullptr)
+            {
+                throw std::runtime_error("RecordBatch message header is null.");
+            }
+            std::vector<sparrow::array> arrays;
+            const bool compressed = record_batch->compression() != nullptr && schema.decompression_threads != 1;
+            if (schema.plan->swap_byte_order || compressed)
+            {
+                // The arrays are built from the converted or decompressed copy of the body, which they keep alive
+                auto decompressed = schema.plan->swap_byte_order
+                                        ? details::byte_swap_record_batch(
+                                              *schema.plan,
+                                              *record_batch,
+                                              message.body(),
+                                              schema.decompression_threads
+                                          )
+                                        : details::decompress_record_batch(
+                                              *schema.plan,
+                                              *record_batch,
+                                              message.body(),
+                                              schema.decompression_threads
+                                          );
+                arrays = details::execute_decoder_plan(
+                    schema.plan,
+                    decompressed->record_batch(),
+                    decompressed->body(),
+                    dictionaries
+                );
+                body_owner = std::move(decompressed);
+            }
+            else
+            {
+                arrays = details::execute_decoder_plan(schema.plan, *record_batch, message.body(), dictionaries);
+            }
+            if (body_owner != nullptr)
+            {
+                for (auto& array : arrays)
                 {
-                    const auto decimal_field = field->type_as_Decimal();
-                    const auto scale = decimal_field->scale();
-                    const auto precision = decimal_field->precision();
-                    if (decimal_field->bitWidth() == 32)
-                    {
-                        arrays.emplace_back(
-                            deserialize_non_owning_decimal<sparrow::decimal<int32_t>>(
-                                record_batch,
-                                encapsulated_message.body(),
-                                name,
-                                metadata,
-                                nullable,
-                                buffer_index,
-                                scale,
-                                precision
-                            )
-                        );
-                    }
-                    else if (decimal_field->bitWidth() == 64)
-                    {
-                        arrays.emplace_back(
-                            deserialize_non_owning_decimal<sparrow::decimal<int64_t>>(
-                                record_batch,
-                                encapsulated_message.body(),
-                                name,
-                                metadata,
-                                nullable,
-                                buffer_index,
-                                scale,
-                                precision
-                            )
-                        );
-                    }
-                    else if (decimal_field->bitWidth() == 128)
-                    {
-                        arrays.emplace_back(
-                            deserialize_non_owning_decimal<sparrow::decimal<sparrow::int128_t>>(
-                                record_batch,
-                                encapsulated_message.body(),
-                                name,
-                                metadata,
-                                nullable,
-                                buffer_index,
-                                scale,
-                                precision
-                            )
-                        );
-                    }
-                    else if (decimal_field->bitWidth() == 256)
-                    {
-                        arrays.emplace_back(
-                            deserialize_non_owning_decimal<sparrow::decimal<sparrow::int256_t>>(
-                                record_batch,
-                                encapsulated_message.body(),
-                                name,
-                                metadata,
-                                nullable,
-                                buffer_index,
-                                scale,
-                                precision
-                            )
-                        );
-                    }
-                    break;
+                    details::attach_owner(sparrow::detail::array_access::get_arrow_proxy(array).array(), body_owner);
                 }
-                default:
-                    throw std::runtime_error(
-                        "Unsupported field type: " + std::to_string(static_cast<int>(field_type))
-                        + " for field '" + name + "'"
-                    );
             }
+            // sparrow::record_batch owns its column names, this is the only per-batch copy of the schema
+            auto names_copy = schema.field_names;
+            return sparrow::record_batch(std::move(names_copy), std::move(arrays));
         }
-        return arrays;
+    }
+
+    sparrow::record_batch decode_record_batch(
+        const encapsulated_message& message,
+        const decoded_schema& schema,
+        std::shared_ptr<const void> body_owner
+    )
+    {
+        return decode_record_batch_message(message, schema, schema.dictionaries.get(), std::move(body_owner));
     }
 
     std::vector<sparrow::record_batch> deserialize_stream(std::span<const uint8_t> data)
     {
-        const org::apache::arrow::flatbuf::Schema* schema = nullptr;
-        std::vector<sparrow::record_batch> record_batches;
-        std::vector<std::string> field_names;
-        std::vector<bool> fields_nullable;
-        std::vector<sparrow::data_type> field_types;
-        std::vector<std::optional<std::vector<sparrow::metadata_pair>>> fields_metadata;
+        return deserialize_stream(data, read_options{});
+    }
+
+    std::vector<sparrow::record_batch>
+    deserialize_stream(std::span<const uint8_t> data, const read_options& options)
+    {
+        return deserialize_stream(data, nullptr, options);
+    }
+
+    std::vector<sparrow::record_batch>
+    deserialize_stream(std::vector<uint8_t>&& data, const read_options& options)
+    {
+        auto owner = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+        const std::span<const uint8_t> span(*owner);
+        return deserialize_stream(span, std::move(owner), options);
+    }
+
+    std::vector<sparrow::record_batch> deserialize_stream(
+        std::span<const uint8_t> data,
+        std::shared_ptr<const void> owner,
+        const read_options& options
+    )
+    {
+        std::optional<decoded_schema> schema;
+        // Messages are indexed first, so that the record batches can be decoded independently,
+        // each with the dictionaries read before it
+        std::vector<encapsulated_message> record_batch_messages;
+        std::vector<std::shared_ptr<const details::dictionary_set>> record_batch_dictionaries;
 
         while (!data.empty())
         {
@@ -573,7 +284,10 @@ namespace sparrow_ipc
                 break;
             }
 
-            const auto [encapsulated_message, rest] = extract_encapsulated_message(data);
+            const auto [encapsulated_message, rest] = extract_encapsulated_message(
+                data,
+                options.validation != validation_level::none
+            );
             const org::apache::arrow::flatbuf::Message* message = encapsulated_message.flat_buffer_message();
 
             if (message == nullptr)
@@ -584,72 +298,53 @@ namespace sparrow_ipc
             switch (message->header_type())
             {
                 case org::apache::arrow::flatbuf::MessageHeader::Schema:
-                {
-                    schema = message->header_as_Schema();
-                    const size_t size = schema->fields() == nullptr
-                                            ? 0
-                                            : static_cast<size_t>(schema->fields()->size());
-                    field_names.reserve(size);
-                    fields_nullable.reserve(size);
-                    fields_metadata.reserve(size);
-                    if (schema->fields() == nullptr)
-                    {
-                        break;
-                    }
-                    for (const auto field : *(schema->fields()))
-                    {
-                        if (field != nullptr && field->name() != nullptr)
-                        {
-                            field_names.emplace_back(field->name()->str());
-                        }
-                        else
-                        {
-                            field_names.emplace_back("_unnamed_");
-                        }
-                        fields_nullable.push_back(field->nullable());
-                        const ::flatbuffers::Vector<::flatbuffers::Offset<org::apache::arrow::flatbuf::KeyValue>>*
-                            fb_custom_metadata = field->custom_metadata();
-                        std::optional<std::vector<sparrow::metadata_pair>>
-                            metadata = fb_custom_metadata == nullptr
-                                           ? std::nullopt
-                                           : std::make_optional(to_sparrow_metadata(*fb_custom_metadata));
-                        fields_metadata.push_back(std::move(metadata));
-                    }
-                }
-                break;
+                    schema = decode_schema(*message->header_as_Schema(), options);
+                    break;
                 case org::apache::arrow::flatbuf::MessageHeader::RecordBatch:
-                {
-                    if (schema == nullptr)
+                    if (!schema.has_value())
                     {
                         throw std::runtime_error("RecordBatch encountered before Schema message.");
                     }
-                    const auto* record_batch = message->header_as_RecordBatch();
-                    if (record_batch == nullptr)
+                    record_batch_messages.push_back(encapsulated_message);
+                    record_batch_dictionaries.push_back(schema->dictionaries);
+                    break;
+                case org::apache::arrow::flatbuf::MessageHeader::DictionaryBatch:
+                    if (!schema.has_value())
                     {
-                        throw std::runtime_error("RecordBatch message header is null.");
+                        throw std::runtime_error("DictionaryBatch encountered before Schema message.");
                     }
-                    std::vector<sparrow::array> arrays = get_arrays_from_record_batch(
-                        *record_batch,
-                        *schema,
-                        encapsulated_message,
-                        fields_metadata
-                    );
-                    auto names_copy = field_names;
-                    sparrow::record_batch sp_record_batch(std::move(names_copy), std::move(arrays));
-                    record_batches.emplace_back(std::move(sp_record_batch));
-                }
-                break;
+                    decode_dictionary_batch(encapsulated_message, *schema, owner);
+                    break;
                 case org::apache::arrow::flatbuf::MessageHeader::Tensor:
-                case org::apache::arrow::flatbuf::MessageHeader::DictionaryBatch:
                 case org::apache::arrow::flatbuf::MessageHeader::SparseTensor:
-                    throw std::runtime_error(
-                        "Unsupported message type: Tensor, DictionaryBatch, or SparseTensor"
-                    );
+                    throw std::runtime_error("Unsupported message type: Tensor or SparseTensor");
                 default:
                     throw std::runtime_error("Unknown message header type.");
             }
             data = rest;
         }
-        return record_batches;
+
+        // The decompression threads of each record batch are nested in the threads decoding them
+        const size_t thread_count = details::resolve_thread_count(options.num_threads, record_batch_messages.size());
+        if (schema.has_value())
+        {
+            schema->decompression_threads = details::resolve_nested_thread_count(
+                schema->decompression_threads,
+                thread_count
+            );
+        }
+        return details::parallel_transform(
+            record_batch_messages.size(),
+            thread_count,
+            [&](size_t i)
+            {
+                return decode_record_batch_message(
+                    record_batch_messages[i],
+                    *schema,
+                    record_batch_dictionaries[i].get(),
+                    owner
+                );
+            }
+        );
     }
 }
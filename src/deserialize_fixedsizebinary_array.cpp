@@ -1,5 +1,6 @@
 #include "sparrow_ipc/deserialize_fixedsizebinary_array.hpp"
 
+#include <string>
 #include <unordered_set>
 
 namespace sparrow_ipc
@@ -7,33 +8,14 @@ namespace sparrow_ipc
     sparrow::fixed_width_binary_array deserialize_non_owning_fixedwidthbinary(
         const org::apache::arrow::flatbuf::RecordBatch& record_batch,
         std::span<const uint8_t> body,
-        std::string_view name,
-        const std::optional<std::vector<sparrow::metadata_pair>>& metadata,
-        bool nullable,
+        ArrowSchema&& schema,
         size_t& buffer_index,
-        int32_t byte_width
+        const org::apache::arrow::flatbuf::FieldNode* node,
+        validation_level validation
     )
     {
-        const std::string format = "w:" + std::to_string(byte_width);
-        
-        // Set up flags based on nullable
-        std::optional<std::unordered_set<sparrow::ArrowFlag>> flags;
-        if (nullable)
-        {
-            flags = std::unordered_set<sparrow::ArrowFlag>{sparrow::ArrowFlag::NULLABLE};
-        }
-        
-        ArrowSchema schema = make_non_owning_arrow_schema(
-            format,
-            name.data(),
-            metadata,
-            flags,
-            0,
-            nullptr,
-            nullptr
-        );
-
         const auto compression = record_batch.compression();
+        const int64_t length = utils::get_length(record_batch, node);
         std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
 
         auto validity_buffer_span = utils::get_buffer(record_batch, body, buffer_index);
@@ -50,11 +32,25 @@ namespace sparrow_ipc
             buffers.push_back(data_buffer_span);
         }
 
-        // TODO bitmap_ptr is not used anymore... Leave it for now, and remove later if no need confirmed
-        const auto [bitmap_ptr, null_count] = utils::get_bitmap_pointer_and_null_count(validity_buffer_span, record_batch.length());
+        if (validation != validation_level::none)
+        {
+            // The format of the schema is "w:<byte width>"
+            const size_t byte_width = std::stoul(std::string(schema.format).substr(2));
+            utils::check_buffer_size(
+                utils::buffer_view(buffers[1]),
+                static_cast<size_t>(length) * byte_width,
+                "values"
+            );
+        }
+        const int64_t null_count = utils::get_null_count(
+            utils::buffer_view(buffers[0]),
+            length,
+            node,
+            validation
+        );
 
         ArrowArray array = make_arrow_array<arrow_array_private_data>(
-            record_batch.length(),
+            length,
             null_count,
             0,
             0,
@@ -65,4 +61,36 @@ namespace sparrow_ipc
         sparrow::arrow_proxy ap{std::move(array), std::move(schema)};
         return sparrow::fixed_width_binary_array{std::move(ap)};
     }
+
+    sparrow::fixed_width_binary_array deserialize_non_owning_fixedwidthbinary(
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        std::span<const uint8_t> body,
+        std::string_view name,
+        const std::optional<std::vector<sparrow::metadata_pair>>& metadata,
+        bool nullable,
+        size_t& buffer_index,
+        int32_t byte_width
+    )
+    {
+        const std::string format = "w:" + std::to_string(byte_width);
+        
+        // Set up flags based on nullable
+        std::optional<std::unordered_set<sparrow::ArrowFlag>> flags;
+        if (nullable)
+        {
+            flags = std::unordered_set<sparrow::ArrowFlag>{sparrow::ArrowFlag::NULLABLE};
+        }
+        
+        ArrowSchema schema = make_non_owning_arrow_schema(
+            format,
+            name.data(),
+            metadata,
+            flags,
+            0,
+            nullptr,
+            nullptr
+        );
+
+        return deserialize_non_owning_fixedwidthbinary(record_batch, body, std::move(schema), buffer_index);
+    }
 }
@@ -5,9 +5,31 @@
 
 #include "sparrow_ipc/arrow_interface/arrow_array.hpp"
 #include "sparrow_ipc/arrow_interface/arrow_schema.hpp"
+#include "sparrow_ipc/deserialize_utils.hpp"
 
 namespace sparrow_ipc
 {
+    sparrow::null_array deserialize_non_owning_null(
+        const org::apache::arrow::flatbuf::RecordBatch& record_batch,
+        ArrowSchema&& schema,
+        const org::apache::arrow::flatbuf::FieldNode* node
+    )
+    {
+        const int64_t length = utils::get_length(record_batch, node);
+        std::vector<sparrow_ipc::arrow_array_private_data::optionally_owned_buffer> buffers;
+        ArrowArray array = make_arrow_array<sparrow_ipc::arrow_array_private_data>(
+            length,
+            length,
+            0,
+            0,
+            nullptr,
+            nullptr,
+            std::move(buffers)
+        );
+        sparrow::arrow_proxy ap{std::move(array), std::move(schema)};
+        return sparrow::null_array{std::move(ap)};
+    }
+
     sparrow::null_array deserialize_non_owning_null(
         const org::apache::arrow::flatbuf::RecordBatch& record_batch,
         std::span<const uint8_t> body,
@@ -29,17 +51,6 @@ namespace sparrow_ipc
         }
 
         ArrowSchema schema = make_non_owning_arrow_schema(format, name.data(), metadata, flags, 0, nullptr, nullptr);
-        std::vector<sparrow_ipc::arrow_array_private_data::optionally_owned_buffer> buffers;
-        ArrowArray array = make_arrow_array<sparrow_ipc::arrow_array_private_data>(
-            record_batch.length(),
-            record_batch.length(),
-            0,
-            0,
-            nullptr,
-            nullptr,
-            std::move(buffers)
-        );
-        sparrow::arrow_proxy ap{std::move(array), std::move(schema)};
-        return sparrow::null_array{std::move(ap)};
+        return deserialize_non_owning_null(record_batch, std::move(schema));
     }
 }
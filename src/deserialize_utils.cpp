@@ -1,5 +1,9 @@
 #include "sparrow_ipc/deserialize_utils.hpp"
 
+#include <bit>
+#include <cstring>
+#include <string>
+
 #include "compression_impl.hpp"
 
 namespace sparrow_ipc::utils
@@ -14,11 +18,81 @@ namespace sparrow_ipc::utils
             return {nullptr, 0};
         }
         auto ptr = const_cast<uint8_t*>(validity_buffer_span.data());
-        const sparrow::dynamic_bitset_view<const std::uint8_t> bitmap_view{
-            ptr,
-            static_cast<size_t>(length)
-        };
-        return {ptr, bitmap_view.null_count()};
+        return {ptr, count_nulls(validity_buffer_span, length)};
+    }
+
+    int64_t count_nulls(std::span<const uint8_t> validity_bitmap, int64_t length)
+    {
+        if (validity_bitmap.empty() || length <= 0)
+        {
+            return 0;
+        }
+        const size_t bit_count = static_cast<size_t>(length);
+        check_buffer_size(validity_bitmap, (bit_count + 7) / 8, "validity");
+
+        constexpr size_t word_bits = 64;
+        const size_t word_count = bit_count / word_bits;
+        int64_t valid_count = 0;
+        for (size_t i = 0; i < word_count; ++i)
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, validity_bitmap.data() + i * sizeof(word), sizeof(word));
+            valid_count += std::popcount(word);
+        }
+        for (size_t i = word_count * word_bits; i < bit_count; ++i)
+        {
+            valid_count += (validity_bitmap[i / 8] >> (i % 8)) & 1;
+        }
+        return length - valid_count;
+    }
+
+    int64_t get_null_count(
+        std::span<const uint8_t> validity_bitmap,
+        int64_t length,
+        const org::apache::arrow::flatbuf::FieldNode* node,
+        validation_level validation
+    )
+    {
+        if (node != nullptr && validation != validation_level::full)
+        {
+            if (validation == validation_level::metadata && node->null_count() > 0)
+            {
+                check_buffer_size(validity_bitmap, (static_cast<size_t>(length) + 7) / 8, "validity");
+            }
+            return node->null_count();
+        }
+        const int64_t null_count = count_nulls(validity_bitmap, length);
+        if (node != nullptr && null_count != node->null_count())
+        {
+            throw std::runtime_error(
+                "The validity bitmap holds " + std::to_string(null_count) + " nulls, but its FieldNode "
+                + std::to_string(node->null_count())
+            );
+        }
+        return null_count;
+    }
+
+    void check_buffer_size(std::span<const uint8_t> buffer, size_t required_size, std::string_view buffer_name)
+    {
+        if (buffer.size() < required_size)
+        {
+            throw std::runtime_error(
+                "The " + std::string(buffer_name) + " buffer holds " + std::to_string(buffer.size())
+                + " bytes, but its array requires " + std::to_string(required_size)
+            );
+        }
+    }
+
+    std::span<const uint8_t>
+    buffer_view(const std::variant<sparrow::buffer<std::uint8_t>, std::span<const std::uint8_t>>& buffer)
+    {
+        return std::visit(
+            [](const auto& b)
+            {
+                return std::span<const uint8_t>(b.data(), b.size());
+            },
+            buffer
+        );
     }
 
     std::span<const uint8_t> get_buffer(
@@ -49,4 +123,130 @@ namespace sparrow_ipc::utils
             return buffer_span;
         }
     }
+
+    size_t count_field_buffers(const org::apache::arrow::flatbuf::Field& field)
+    {
+        // Dictionary-encoded fields only hold their indices in a RecordBatch
+        if (field.dictionary() != nullptr)
+        {
+            return 2;
+        }
+        return count_value_buffers(field);
+    }
+
+    size_t count_value_buffers(const org::apache::arrow::flatbuf::Field& field)
+    {
+        size_t children_buffers = 0;
+        if (field.children() != nullptr)
+        {
+            for (const auto child : *field.children())
+            {
+                children_buffers += count_field_buffers(*child);
+            }
+        }
+
+        switch (field.type_type())
+        {
+            case org::apache::arrow::flatbuf::Type::Null:
+                return 0;
+            case org::apache::arrow::flatbuf::Type::Bool:
+            case org::apache::arrow::flatbuf::Type::Int:
+            case org::apache::arrow::flatbuf::Type::FloatingPoint:
+            case org::apache::arrow::flatbuf::Type::Decimal:
+            case org::apache::arrow::flatbuf::Type::Date:
+            case org::apache::arrow::flatbuf::Type::Time:
+            case org::apache::arrow::flatbuf::Type::Timestamp:
+            case org::apache::arrow::flatbuf::Type::Interval:
+            case org::apache::arrow::flatbuf::Type::Duration:
+            case org::apache::arrow::flatbuf::Type::FixedSizeBinary:
+                // validity, values
+                return 2;
+            case org::apache::arrow::flatbuf::Type::Binary:
+            case org::apache::arrow::flatbuf::Type::LargeBinary:
+            case org::apache::arrow::flatbuf::Type::Utf8:
+            case org::apache::arrow::flatbuf::Type::LargeUtf8:
+                // validity, offsets, data
+                return 3;
+            case org::apache::arrow::flatbuf::Type::BinaryView:
+            case org::apache::arrow::flatbuf::Type::Utf8View:
+                // validity, views, followed by the variadic data buffers
+                return 2;
+            case org::apache::arrow::flatbuf::Type::List:
+            case org::apache::arrow::flatbuf::Type::LargeList:
+            case org::apache::arrow::flatbuf::Type::Map:
+                // validity, offsets
+                return 2 + children_buffers;
+            case org::apache::arrow::flatbuf::Type::ListView:
+            case org::apache::arrow::flatbuf::Type::LargeListView:
+                // validity, offsets, sizes
+                return 3 + children_buffers;
+            case org::apache::arrow::flatbuf::Type::FixedSizeList:
+            case org::apache::arrow::flatbuf::Type::Struct_:
+                // validity
+                return 1 + children_buffers;
+            case org::apache::arrow::flatbuf::Type::Union:
+            {
+                // Unions have no validity buffer: type ids, and offsets when dense
+                const auto* union_type = field.type_as_Union();
+                const bool dense = union_type != nullptr
+                                   && union_type->mode() == org::apache::arrow::flatbuf::UnionMode::Dense;
+                return (dense ? 2 : 1) + children_buffers;
+            }
+            case org::apache::arrow::flatbuf::Type::RunEndEncoded:
+                return children_buffers;
+            default:
+                throw std::runtime_error(
+                    "Unsupported field type: " + std::to_string(static_cast<int>(field.type_type()))
+                    + " for field '" + (field.name() == nullptr ? "" : field.name()->str()) + "'"
+                );
+        }
+    }
+
+    size_t count_field_nodes(const org::apache::arrow::flatbuf::Field& field)
+    {
+        if (field.dictionary() != nullptr)
+        {
+            return 1;
+        }
+        return count_value_nodes(field);
+    }
+
+    size_t count_value_nodes(const org::apache::arrow::flatbuf::Field& field)
+    {
+        if (field.children() == nullptr)
+        {
+            return 1;
+        }
+        size_t node_count = 1;
+        for (const auto child : *field.children())
+        {
+            node_count += count_field_nodes(*child);
+        }
+        return node_count;
+    }
+
+    size_t count_field_variadic_buffer_counts(const org::apache::arrow::flatbuf::Field& field)
+    {
+        if (field.dictionary() != nullptr)
+        {
+            return 0;
+        }
+        return count_value_variadic_buffer_counts(field);
+    }
+
+    size_t count_value_variadic_buffer_counts(const org::apache::arrow::flatbuf::Field& field)
+    {
+        size_t count = field.type_type() == org::apache::arrow::flatbuf::Type::BinaryView
+                               || field.type_type() == org::apache::arrow::flatbuf::Type::Utf8View
+                           ? 1
+                           : 0;
+        if (field.children() != nullptr)
+        {
+            for (const auto child : *field.children())
+            {
+                count += count_field_variadic_buffer_counts(*child);
+            }
+        }
+        return count;
+    }
 }
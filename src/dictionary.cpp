@@ -0,0 +1,429 @@
+#include "dictionary.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sparrow/buffer/buffer.hpp>
+
+#include "sparrow_ipc/arrow_interface/arrow_array.hpp"
+#include "sparrow_ipc/arrow_interface/arrow_schema.hpp"
+#include "sparrow_ipc/buffer_pool.hpp"
+
+namespace sparrow_ipc::details
+{
+    /**
+     * Growable buffers of the values of a dictionary extended by delta batches. The values up to
+     * `length` are never modified once written: the dictionaries sharing the storage each see a
+     * prefix of them.
+     */
+    struct dictionary_storage
+    {
+        run_values_layout layout = run_values_layout::unsupported;
+        size_t value_width = 0;
+        // Number of values the buffers have room for
+        size_t capacity = 0;
+        // Allocated when the first null value is appended
+        sparrow::buffer<uint8_t> validity;
+        // Bitmap, fixed-width values or offsets, depending on the layout
+        sparrow::buffer<uint8_t> values;
+        // Bytes of the binary layouts
+        sparrow::buffer<uint8_t> data;
+        int64_t length = 0;
+        int64_t null_count = 0;
+        size_t data_size = 0;
+    };
+
+    void arrow_array_deleter::operator()(ArrowArray* array) const noexcept
+    {
+        if (array->release != nullptr)
+        {
+            array->release(array);
+        }
+        delete array;
+    }
+
+    void arrow_schema_deleter::operator()(ArrowSchema* schema) const noexcept
+    {
+        if (schema->release != nullptr)
+        {
+            schema->release(schema);
+        }
+        delete schema;
+    }
+
+    namespace
+    {
+        sparrow::buffer<uint8_t> make_buffer(size_t size)
+        {
+            return sparrow::buffer<uint8_t>(size, pool_allocator<uint8_t>());
+        }
+
+        size_t bitmap_size(size_t length)
+        {
+            return (length + 7) / 8;
+        }
+
+        bool get_bit(const uint8_t* bitmap, size_t index)
+        {
+            return ((bitmap[index / 8] >> (index % 8)) & 1) != 0;
+        }
+
+        void set_bit(uint8_t* bitmap, size_t index, bool value)
+        {
+            const auto mask = static_cast<uint8_t>(1u << (index % 8));
+            bitmap[index / 8] = value ? static_cast<uint8_t>(bitmap[index / 8] | mask)
+                                      : static_cast<uint8_t>(bitmap[index / 8] & ~mask);
+        }
+
+        // Copies `count` bits of `source` to the bits of `destination` starting at `begin`
+        void copy_bits(const uint8_t* source, uint8_t* destination, size_t begin, size_t count)
+        {
+            size_t i = 0;
+            if (begin % 8 == 0)
+            {
+                std::memcpy(destination + begin / 8, source, count / 8);
+                i = count / 8 * 8;
+            }
+            for (; i < count; ++i)
+            {
+                set_bit(destination, begin + i, get_bit(source, i));
+            }
+        }
+
+        size_t values_buffer_size(run_values_layout layout, size_t value_width, size_t length)
+        {
+            switch (layout)
+            {
+                case run_values_layout::bitmap:
+                    return bitmap_size(length);
+                case run_values_layout::fixed_width:
+                    return length * value_width;
+                case run_values_layout::binary:
+                    return (length + 1) * sizeof(int32_t);
+                case run_values_layout::large_binary:
+                    return (length + 1) * sizeof(int64_t);
+                case run_values_layout::unsupported:
+                    break;
+            }
+            return 0;
+        }
+
+        template <std::signed_integral OffsetType>
+        size_t binary_data_size(const ArrowArray& values)
+        {
+            if (values.length == 0)
+            {
+                return 0;
+            }
+            const auto* offsets = static_cast<const OffsetType*>(values.buffers[1]);
+            return static_cast<size_t>(offsets[values.length] - offsets[0]);
+        }
+
+        size_t data_size(run_values_layout layout, const ArrowArray& values)
+        {
+            switch (layout)
+            {
+                case run_values_layout::binary:
+                    return binary_data_size<int32_t>(values);
+                case run_values_layout::large_binary:
+                    return binary_data_size<int64_t>(values);
+                default:
+                    return 0;
+            }
+        }
+
+        std::shared_ptr<dictionary_storage>
+        make_storage(run_values_layout layout, size_t value_width, size_t capacity, size_t data_capacity)
+        {
+            auto storage = std::make_shared<dictionary_storage>();
+            storage->layout = layout;
+            storage->value_width = value_width;
+            storage->capacity = capacity;
+            storage->values = make_buffer(values_buffer_size(layout, value_width, capacity));
+            storage->data = make_buffer(data_capacity);
+            return storage;
+        }
+
+        template <std::signed_integral OffsetType>
+        void append_binary(dictionary_storage& storage, const ArrowArray& values)
+        {
+            const auto begin = static_cast<size_t>(storage.length);
+            const auto count = static_cast<size_t>(values.length);
+            auto* offsets = reinterpret_cast<OffsetType*>(storage.values.data());
+            if (begin == 0)
+            {
+                offsets[0] = 0;
+            }
+            if (count == 0)
+            {
+                return;
+            }
+            const auto* source_offsets = static_cast<const OffsetType*>(values.buffers[1]);
+            const OffsetType first = source_offsets[0];
+            const auto size = static_cast<size_t>(source_offsets[count] - first);
+            if (storage.data_size + size > static_cast<size_t>(std::numeric_limits<OffsetType>::max()))
+            {
+                throw std::runtime_error("The values of a dictionary extended by delta batches overflow its offsets");
+            }
+            const auto base = static_cast<OffsetType>(storage.data_size);
+            for (size_t i = 1; i <= count; ++i)
+            {
+                offsets[begin + i] = static_cast<OffsetType>(base + (source_offsets[i] - first));
+            }
+            if (size > 0)
+            {
+                std::memcpy(
+                    storage.data.data() + storage.data_size,
+                    static_cast<const uint8_t*>(values.buffers[2]) + first,
+                    size
+                );
+            }
+            storage.data_size += size;
+        }
+
+        // Appends values, without offset, after the ones of the storage, which has room for them
+        void append_values(dictionary_storage& storage, const ArrowArray& values)
+        {
+            const auto begin = static_cast<size_t>(storage.length);
+            const auto count = static_cast<size_t>(values.length);
+            const auto* validity = values.null_count == 0 ? nullptr
+                                                          : static_cast<const uint8_t*>(values.buffers[0]);
+            if (validity != nullptr && storage.validity.empty())
+            {
+                // The values appended so far are all valid
+                storage.validity = make_buffer(bitmap_size(storage.capacity));
+                std::fill_n(storage.validity.data(), bitmap_size(begin), uint8_t{0xFF});
+            }
+            if (!storage.validity.empty())
+            {
+                if (validity != nullptr)
+                {
+                    copy_bits(validity, storage.validity.data(), begin, count);
+                }
+                else
+                {
+                    for (size_t i = begin; i < begin + count; ++i)
+                    {
+                        set_bit(storage.validity.data(), i, true);
+                    }
+                }
+            }
+
+            switch (storage.layout)
+            {
+                case run_values_layout::bitmap:
+                    if (count > 0)
+                    {
+                        copy_bits(static_cast<const uint8_t*>(values.buffers[1]), storage.values.data(), begin, count);
+                    }
+                    break;
+                case run_values_layout::fixed_width:
+                    if (count > 0)
+                    {
+                        std::memcpy(
+                            storage.values.data() + begin * storage.value_width,
+                            values.buffers[1],
+                            count * storage.value_width
+                        );
+                    }
+                    break;
+                case run_values_layout::binary:
+                    append_binary<int32_t>(storage, values);
+                    break;
+                case run_values_layout::large_binary:
+                    append_binary<int64_t>(storage, values);
+                    break;
+                case run_values_layout::unsupported:
+                    throw std::runtime_error("The values of this dictionary cannot be appended to");
+            }
+            storage.length += values.length;
+            storage.null_count += std::max<int64_t>(values.null_count, 0);
+        }
+
+        // Non-owned buffers of the first `length` values of the storage
+        std::vector<arrow_array_private_data::optionally_owned_buffer> storage_buffers(const dictionary_storage& storage)
+        {
+            const auto length = static_cast<size_t>(storage.length);
+            std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+            buffers.emplace_back(
+                storage.validity.empty() ? std::span<const uint8_t>{}
+                                         : std::span<const uint8_t>(storage.validity.data(), bitmap_size(length))
+            );
+            buffers.emplace_back(std::span<const uint8_t>(
+                storage.values.data(),
+                values_buffer_size(storage.layout, storage.value_width, length)
+            ));
+            if (storage.layout == run_values_layout::binary || storage.layout == run_values_layout::large_binary)
+            {
+                buffers.emplace_back(std::span<const uint8_t>(storage.data.data(), storage.data_size));
+            }
+            return buffers;
+        }
+
+        std::unique_ptr<ArrowArray, arrow_array_deleter>
+        make_array_view(const ArrowArray& source, const std::shared_ptr<const void>& owner)
+        {
+            std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+            buffers.reserve(static_cast<size_t>(source.n_buffers));
+            for (int64_t i = 0; i < source.n_buffers; ++i)
+            {
+                // Only the addresses of the buffers are handed out, their extent is not needed
+                const auto* buffer = static_cast<const uint8_t*>(source.buffers[i]);
+                buffers.emplace_back(std::span<const uint8_t>(buffer, buffer == nullptr ? 0 : 1));
+            }
+            std::unique_ptr<ArrowArray, arrow_array_deleter> view(new ArrowArray(
+                make_arrow_array<arrow_array_private_data>(
+                    source.length,
+                    source.null_count,
+                    source.offset,
+                    0,
+                    nullptr,
+                    nullptr,
+                    std::move(buffers)
+                )
+            ));
+            static_cast<arrow_array_private_data*>(view->private_data)->set_owner(owner);
+            if (source.n_children > 0)
+            {
+                // Filled one child at a time, so that the view can be released at any point
+                view->children = new ArrowArray*[static_cast<size_t>(source.n_children)]{};
+                view->n_children = source.n_children;
+                for (int64_t i = 0; i < source.n_children; ++i)
+                {
+                    view->children[i] = make_array_view(*source.children[i], owner).release();
+                }
+            }
+            if (source.dictionary != nullptr)
+            {
+                view->dictionary = make_array_view(*source.dictionary, owner).release();
+            }
+            return view;
+        }
+
+        std::unique_ptr<ArrowSchema, arrow_schema_deleter>
+        make_schema_view(const ArrowSchema& source, const std::shared_ptr<const void>& owner)
+        {
+            std::unique_ptr<ArrowSchema, arrow_schema_deleter> view(new ArrowSchema(
+                make_shared_arrow_schema(source.format, source.name, source.metadata, source.flags, owner)
+            ));
+            if (source.n_children > 0)
+            {
+                view->children = new ArrowSchema*[static_cast<size_t>(source.n_children)]{};
+                view->n_children = source.n_children;
+                for (int64_t i = 0; i < source.n_children; ++i)
+                {
+                    view->children[i] = make_schema_view(*source.children[i], owner).release();
+                }
+            }
+            if (source.dictionary != nullptr)
+            {
+                view->dictionary = make_schema_view(*source.dictionary, owner).release();
+            }
+            return view;
+        }
+    }
+
+    dictionary::dictionary(ArrowArray values, ArrowSchema schema, std::shared_ptr<dictionary_storage> storage) noexcept
+        : m_values(values)
+        , m_schema(schema)
+        , m_storage(std::move(storage))
+    {
+    }
+
+    dictionary::~dictionary()
+    {
+        if (m_values.release != nullptr)
+        {
+            m_values.release(&m_values);
+        }
+        if (m_schema.release != nullptr)
+        {
+            m_schema.release(&m_schema);
+        }
+    }
+
+    const ArrowArray& dictionary::values() const noexcept
+    {
+        return m_values;
+    }
+
+    const ArrowSchema& dictionary::schema() const noexcept
+    {
+        return m_schema;
+    }
+
+    const std::shared_ptr<dictionary_storage>& dictionary::storage() const noexcept
+    {
+        return m_storage;
+    }
+
+    std::shared_ptr<const dictionary> make_dictionary(sparrow::array&& values)
+    {
+        auto [array, schema] = sparrow::extract_arrow_structures(std::move(values));
+        return std::make_shared<const dictionary>(array, schema);
+    }
+
+    std::shared_ptr<const dictionary> append_to_dictionary(
+        const dictionary& base,
+        sparrow::array&& delta,
+        run_values_layout layout,
+        size_t value_width
+    )
+    {
+        if (layout == run_values_layout::unsupported)
+        {
+            throw std::runtime_error(
+                "Delta DictionaryBatch messages are only supported for dictionaries of primitive, boolean,"
+                " binary or string values, not of format '" + std::string(base.schema().format) + "'"
+            );
+        }
+        auto [delta_array, delta_schema] = sparrow::extract_arrow_structures(std::move(delta));
+        // The new dictionary takes the schema of the delta, which describes the same values
+        auto result_schema = std::unique_ptr<ArrowSchema, arrow_schema_deleter>(new ArrowSchema(delta_schema));
+        const auto delta_values = std::unique_ptr<ArrowArray, arrow_array_deleter>(new ArrowArray(delta_array));
+
+        const ArrowArray& base_values = base.values();
+        const auto length = static_cast<size_t>(base_values.length + delta_values->length);
+        const size_t total_data_size = data_size(layout, base_values) + data_size(layout, *delta_values);
+        std::shared_ptr<dictionary_storage> storage = base.storage();
+        // The bitmaps are appended to in place only from a byte boundary, so that the bytes read by
+        // the previous versions of the dictionary are never written to
+        const bool writes_shared_byte = base_values.length % 8 != 0
+                                        && (layout == run_values_layout::bitmap
+                                            || (storage != nullptr && !storage->validity.empty()));
+        const bool in_place = storage != nullptr && storage->length == base_values.length
+                              && storage->capacity >= length && storage->data.size() >= total_data_size
+                              && !writes_shared_byte;
+        if (!in_place)
+        {
+            storage = make_storage(layout, value_width, 2 * length, 2 * total_data_size);
+            append_values(*storage, base_values);
+        }
+        append_values(*storage, *delta_values);
+
+        ArrowArray values = make_arrow_array<arrow_array_private_data>(
+            storage->length,
+            storage->null_count,
+            0,
+            0,
+            nullptr,
+            nullptr,
+            storage_buffers(*storage)
+        );
+        ArrowSchema schema = *result_schema;
+        result_schema->release = nullptr;
+        return std::make_shared<const dictionary>(values, schema, std::move(storage));
+    }
+
+    dictionary_view make_dictionary_view(const std::shared_ptr<const dictionary>& values)
+    {
+        return {make_array_view(values->values(), values), make_schema_view(values->schema(), values)};
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+
+#include <sparrow/array.hpp>
+#include <sparrow/c_interface.hpp>
+
+#include "run_end_encoding.hpp"
+
+namespace sparrow_ipc::details
+{
+    struct arrow_array_deleter
+    {
+        void operator()(ArrowArray* array) const noexcept;
+    };
+
+    struct arrow_schema_deleter
+    {
+        void operator()(ArrowSchema* schema) const noexcept;
+    };
+
+    struct dictionary_storage;
+
+    /**
+     * @brief Values of a dictionary, as known at one point of a stream.
+     *
+     * A dictionary is immutable: a delta DictionaryBatch produces a new dictionary, and the
+     * arrays decoded before it keep the values they were decoded with. The values read from a
+     * single DictionaryBatch borrow the memory of its message. The values extended by delta
+     * batches live in growable buffers shared with the following versions of the dictionary,
+     * each version seeing a prefix of them.
+     */
+    class dictionary
+    {
+    public:
+
+        /**
+         * @brief Takes the ownership of the values of a dictionary.
+         *
+         * @param values The values, without offset
+         * @param schema The schema of the values
+         * @param storage The growable buffers `values` points into, if any
+         */
+        dictionary(ArrowArray values, ArrowSchema schema, std::shared_ptr<dictionary_storage> storage = nullptr) noexcept;
+
+        ~dictionary();
+
+        dictionary(const dictionary&) = delete;
+        dictionary& operator=(const dictionary&) = delete;
+
+        [[nodiscard]] const ArrowArray& values() const noexcept;
+
+        [[nodiscard]] const ArrowSchema& schema() const noexcept;
+
+        [[nodiscard]] const std::shared_ptr<dictionary_storage>& storage() const noexcept;
+
+    private:
+
+        ArrowArray m_values;
+        ArrowSchema m_schema;
+        std::shared_ptr<dictionary_storage> m_storage;
+    };
+
+    /**
+     * @brief The dictionaries of a stream at one point of it, by dictionary id.
+     *
+     * A set is never modified once shared: every DictionaryBatch produces a new set, so that the
+     * RecordBatch messages can be decoded concurrently, each with the dictionaries preceding it.
+     */
+    struct dictionary_set
+    {
+        std::map<int64_t, std::shared_ptr<const dictionary>> dictionaries;
+    };
+
+    /**
+     * @brief Makes a dictionary from the decoded values of a DictionaryBatch.
+     */
+    [[nodiscard]] std::shared_ptr<const dictionary> make_dictionary(sparrow::array&& values);
+
+    /**
+     * @brief Appends the values of a delta DictionaryBatch to a dictionary.
+     *
+     * When `base` is the latest version of its growable buffers and they have room for the new
+     * values, the values are appended in place and `base` keeps seeing its own prefix of them.
+     * Otherwise, the values of `base` are copied once into new buffers twice as large as needed,
+     * so that a sequence of deltas copies each value a constant number of times on average.
+     *
+     * @param base The dictionary before the delta
+     * @param delta The decoded values of the delta batch
+     * @param layout The layout of the values
+     * @param value_width The size in bytes of a value, for the fixed-width layout
+     * @return The dictionary holding the values of `base` followed by the ones of `delta`
+     *
+     * @throws std::runtime_error If the values are nested, or their offsets overflow
+     */
+    [[nodiscard]] std::shared_ptr<const dictionary> append_to_dictionary(
+        const dictionary& base,
+        sparrow::array&& delta,
+        run_values_layout layout,
+        size_t value_width
+    );
+
+    /**
+     * @brief Zero-copy view of a dictionary, to be attached to an array of indices.
+     */
+    struct dictionary_view
+    {
+        std::unique_ptr<ArrowArray, arrow_array_deleter> array;
+        std::unique_ptr<ArrowSchema, arrow_schema_deleter> schema;
+    };
+
+    /**
+     * @brief Makes a view of the values of a dictionary, which it keeps alive.
+     *
+     * The view references the buffers and the schema strings of the dictionary without copying
+     * them, so that each decoded array of indices can own its dictionary.
+     */
+    [[nodiscard]] dictionary_view make_dictionary_view(const std::shared_ptr<const dictionary>& values);
+}
@@ -0,0 +1,430 @@
+#include "sparrow_ipc/dictionary_tracker.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include <sparrow/arrow_interface/arrow_array.hpp>
+#include <sparrow/arrow_interface/arrow_schema.hpp>
+#include <sparrow/buffer/buffer.hpp>
+
+#include "sparrow_ipc/arrow_interface/arrow_array.hpp"
+#include "sparrow_ipc/buffer_pool.hpp"
+#include "sparrow_ipc/utils.hpp"
+
+#include "dictionary.hpp"
+#include "run_end_encoding.hpp"
+
+namespace sparrow_ipc
+{
+    namespace
+    {
+        using details::run_values_layout;
+
+        // Layout of the values of a dictionary, telling how they are compared and sliced
+        std::pair<run_values_layout, size_t> get_values_layout(const ArrowSchema& schema)
+        {
+            if (schema.n_children != 0 || schema.dictionary != nullptr)
+            {
+                return {run_values_layout::unsupported, 0};
+            }
+            const std::string_view format = schema.format;
+            if (format == "b")
+            {
+                return {run_values_layout::bitmap, 0};
+            }
+            if (format == "u" || format == "z")
+            {
+                return {run_values_layout::binary, 0};
+            }
+            if (format == "U" || format == "Z")
+            {
+                return {run_values_layout::large_binary, 0};
+            }
+            if (format == "c" || format == "C")
+            {
+                return {run_values_layout::fixed_width, 1};
+            }
+            if (format == "s" || format == "S" || format == "e")
+            {
+                return {run_values_layout::fixed_width, 2};
+            }
+            if (format == "i" || format == "I" || format == "f" || format == "tdD" || format == "tts"
+                || format == "ttm" || format == "tiM")
+            {
+                return {run_values_layout::fixed_width, 4};
+            }
+            if (format == "l" || format == "L" || format == "g" || format == "tdm" || format == "ttu"
+                || format == "ttn" || format == "tiD" || format.starts_with("ts") || format.starts_with("tD"))
+            {
+                return {run_values_layout::fixed_width, 8};
+            }
+            if (format == "tin")
+            {
+                return {run_values_layout::fixed_width, 16};
+            }
+            if (format.starts_with("w:"))
+            {
+                const auto width = utils::parse_format(format, ":");
+                if (width.has_value() && width.value() > 0)
+                {
+                    return {run_values_layout::fixed_width, static_cast<size_t>(width.value())};
+                }
+            }
+            else if (format.starts_with("d:"))
+            {
+                const auto decimal = utils::parse_decimal_format(format);
+                if (decimal.has_value())
+                {
+                    const int32_t bit_width = std::get<2>(decimal.value()).value_or(128);
+                    return {run_values_layout::fixed_width, static_cast<size_t>(bit_width / 8)};
+                }
+            }
+            return {run_values_layout::unsupported, 0};
+        }
+
+        const uint8_t* get_buffer(const ArrowArray& array, int64_t index)
+        {
+            return index < array.n_buffers ? static_cast<const uint8_t*>(array.buffers[index]) : nullptr;
+        }
+
+        const uint8_t* get_validity(const ArrowArray& array)
+        {
+            return array.null_count == 0 ? nullptr : get_buffer(array, 0);
+        }
+
+        bool get_bit(const uint8_t* bitmap, size_t index)
+        {
+            return ((bitmap[index / 8] >> (index % 8)) & 1) != 0;
+        }
+
+        bool bits_equal(const uint8_t* first, size_t first_begin, const uint8_t* second, size_t second_begin, size_t count)
+        {
+            if (first_begin % 8 == 0 && second_begin % 8 == 0)
+            {
+                const size_t bytes = count / 8;
+                if (std::memcmp(first + first_begin / 8, second + second_begin / 8, bytes) != 0)
+                {
+                    return false;
+                }
+                first_begin += bytes * 8;
+                second_begin += bytes * 8;
+                count -= bytes * 8;
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (get_bit(first, first_begin + i) != get_bit(second, second_begin + i))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool validity_equal(const ArrowArray& first, const ArrowArray& second, size_t count)
+        {
+            const uint8_t* first_validity = get_validity(first);
+            const uint8_t* second_validity = get_validity(second);
+            const auto first_offset = static_cast<size_t>(first.offset);
+            const auto second_offset = static_cast<size_t>(second.offset);
+            if (first_validity != nullptr && second_validity != nullptr)
+            {
+                return bits_equal(first_validity, first_offset, second_validity, second_offset, count);
+            }
+            // A missing bitmap means that every value is valid
+            const uint8_t* validity = first_validity != nullptr ? first_validity : second_validity;
+            const size_t offset = first_validity != nullptr ? first_offset : second_offset;
+            for (size_t i = 0; validity != nullptr && i < count; ++i)
+            {
+                if (!get_bit(validity, offset + i))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <std::signed_integral OffsetType>
+        bool binary_values_equal(const ArrowArray& first, const ArrowArray& second, size_t count)
+        {
+            const auto* first_offsets = reinterpret_cast<const OffsetType*>(get_buffer(first, 1)) + first.offset;
+            const auto* second_offsets = reinterpret_cast<const OffsetType*>(get_buffer(second, 1)) + second.offset;
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (first_offsets[i + 1] - first_offsets[i] != second_offsets[i + 1] - second_offsets[i])
+                {
+                    return false;
+                }
+            }
+            const auto size = static_cast<size_t>(first_offsets[count] - first_offsets[0]);
+            return size == 0
+                   || std::memcmp(
+                          get_buffer(first, 2) + first_offsets[0],
+                          get_buffer(second, 2) + second_offsets[0],
+                          size
+                      ) == 0;
+        }
+
+        // Whether the first `count` values of two arrays of the same layout are equal
+        bool values_equal(
+            const ArrowArray& first,
+            const ArrowArray& second,
+            size_t count,
+            run_values_layout layout,
+            size_t value_width
+        )
+        {
+            if (count == 0)
+            {
+                return true;
+            }
+            if (!validity_equal(first, second, count))
+            {
+                return false;
+            }
+            const auto first_offset = static_cast<size_t>(first.offset);
+            const auto second_offset = static_cast<size_t>(second.offset);
+            switch (layout)
+            {
+                case run_values_layout::bitmap:
+                    return bits_equal(get_buffer(first, 1), first_offset, get_buffer(second, 1), second_offset, count);
+                case run_values_layout::fixed_width:
+                    return std::memcmp(
+                               get_buffer(first, 1) + first_offset * value_width,
+                               get_buffer(second, 1) + second_offset * value_width,
+                               count * value_width
+                           )
+                           == 0;
+                case run_values_layout::binary:
+                    return binary_values_equal<int32_t>(first, second, count);
+                case run_values_layout::large_binary:
+                    return binary_values_equal<int64_t>(first, second, count);
+                case run_values_layout::unsupported:
+                    break;
+            }
+            return false;
+        }
+
+        sparrow::buffer<uint8_t> make_buffer(size_t size)
+        {
+            return sparrow::buffer<uint8_t>(size, pool_allocator<uint8_t>());
+        }
+
+        // Copies `count` bits of `source` starting at `begin` to a new bitmap
+        sparrow::buffer<uint8_t> copy_bits(const uint8_t* source, size_t begin, size_t count)
+        {
+            sparrow::buffer<uint8_t> bitmap = make_buffer((count + 7) / 8);
+            std::fill(bitmap.begin(), bitmap.end(), uint8_t{0});
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (get_bit(source, begin + i))
+                {
+                    bitmap[i / 8] = static_cast<uint8_t>(bitmap[i / 8] | (1u << (i % 8)));
+                }
+            }
+            return bitmap;
+        }
+
+        template <std::signed_integral OffsetType>
+        void copy_binary_values(
+            const ArrowArray& values,
+            size_t begin,
+            size_t count,
+            std::vector<arrow_array_private_data::optionally_owned_buffer>& buffers
+        )
+        {
+            const auto* offsets = reinterpret_cast<const OffsetType*>(get_buffer(values, 1)) + begin;
+            sparrow::buffer<uint8_t> copied_offsets = make_buffer((count + 1) * sizeof(OffsetType));
+            auto* typed_offsets = reinterpret_cast<OffsetType*>(copied_offsets.data());
+            for (size_t i = 0; i <= count; ++i)
+            {
+                typed_offsets[i] = static_cast<OffsetType>(offsets[i] - offsets[0]);
+            }
+            const auto size = static_cast<size_t>(offsets[count] - offsets[0]);
+            sparrow::buffer<uint8_t> data = make_buffer(size);
+            if (size > 0)
+            {
+                std::memcpy(data.data(), get_buffer(values, 2) + offsets[0], size);
+            }
+            buffers.emplace_back(std::move(copied_offsets));
+            buffers.emplace_back(std::move(data));
+        }
+
+        // Copies the values of a dictionary from `begin`, without offset
+        sparrow::array copy_values(
+            const ArrowArray& values,
+            const ArrowSchema& schema,
+            size_t begin,
+            run_values_layout layout,
+            size_t value_width
+        )
+        {
+            const size_t count = static_cast<size_t>(values.length) - begin;
+            begin += static_cast<size_t>(values.offset);
+            std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+            int64_t null_count = 0;
+            const uint8_t* validity = get_validity(values);
+            if (validity == nullptr)
+            {
+                buffers.emplace_back(std::span<const uint8_t>{});
+            }
+            else
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    null_count += get_bit(validity, begin + i) ? 0 : 1;
+                }
+                buffers.emplace_back(copy_bits(validity, begin, count));
+            }
+
+            switch (layout)
+            {
+                case run_values_layout::bitmap:
+                    buffers.emplace_back(copy_bits(get_buffer(values, 1), begin, count));
+                    break;
+                case run_values_layout::fixed_width:
+                {
+                    sparrow::buffer<uint8_t> data = make_buffer(count * value_width);
+                    if (count > 0)
+                    {
+                        std::memcpy(data.data(), get_buffer(values, 1) + begin * value_width, count * value_width);
+                    }
+                    buffers.emplace_back(std::move(data));
+                    break;
+                }
+                case run_values_layout::binary:
+                    copy_binary_values<int32_t>(values, begin, count, buffers);
+                    break;
+                case run_values_layout::large_binary:
+                    copy_binary_values<int64_t>(values, begin, count, buffers);
+                    break;
+                case run_values_layout::unsupported:
+                    return sparrow::array(sparrow::copy_array(values, schema), sparrow::copy_schema(schema));
+            }
+
+            ArrowArray array = make_arrow_array<arrow_array_private_data>(
+                static_cast<int64_t>(count),
+                null_count,
+                0,
+                0,
+                nullptr,
+                nullptr,
+                std::move(buffers)
+            );
+            return sparrow::array(std::move(array), sparrow::copy_schema(schema));
+        }
+
+        // Non-owning array of the values of a tracked dictionary, which it keeps alive
+        sparrow::array dictionary_values(const std::shared_ptr<const details::dictionary>& dictionary)
+        {
+            details::dictionary_view view = details::make_dictionary_view(dictionary);
+            ArrowArray array = *view.array;
+            view.array->release = nullptr;
+            ArrowSchema schema = *view.schema;
+            view.schema->release = nullptr;
+            return sparrow::array(std::move(array), std::move(schema));
+        }
+
+        struct tracker_state
+        {
+            std::map<int64_t, std::shared_ptr<const details::dictionary>>& dictionaries;
+            bool allow_replacement;
+            int64_t next_id = 0;
+            std::vector<dictionary_batch> batches;
+        };
+
+        // Finds the message to write for the dictionary `id`, if it changed since the previous one
+        void update_dictionary(tracker_state& state, int64_t id, const ArrowArray& values, const ArrowSchema& schema)
+        {
+            const auto [layout, value_width] = get_values_layout(schema);
+            std::shared_ptr<const details::dictionary>& written = state.dictionaries[id];
+            if (written != nullptr)
+            {
+                const ArrowArray& previous = written->values();
+                if (layout == run_values_layout::unsupported)
+                {
+                    const sparrow::array previous_values = dictionary_values(written);
+                    if (previous_values == copy_values(values, schema, 0, layout, value_width))
+                    {
+                        return;
+                    }
+                }
+                else if (values.length >= previous.length
+                         && values_equal(previous, values, static_cast<size_t>(previous.length), layout, value_width))
+                {
+                    if (values.length == previous.length)
+                    {
+                        return;
+                    }
+                    const auto begin = static_cast<size_t>(previous.length);
+                    written = details::append_to_dictionary(
+                        *written,
+                        copy_values(values, schema, begin, layout, value_width),
+                        layout,
+                        value_width
+                    );
+                    state.batches.push_back(
+                        {.id = id, .values = copy_values(values, schema, begin, layout, value_width), .is_delta = true}
+                    );
+                    return;
+                }
+                if (!state.allow_replacement)
+                {
+                    throw std::invalid_argument(
+                        "Dictionary " + std::to_string(id)
+                        + " is replaced by a different one, which the Arrow IPC file format does not support: "
+                          "only values appended to a dictionary can be written"
+                    );
+                }
+            }
+            written = details::make_dictionary(copy_values(values, schema, 0, layout, value_width));
+            state.batches.push_back({.id = id, .values = dictionary_values(written), .is_delta = false});
+        }
+
+        void collect_dictionaries(tracker_state& state, const ArrowArray& array, const ArrowSchema& schema)
+        {
+            if (schema.dictionary == nullptr)
+            {
+                for (int64_t i = 0; i < schema.n_children; ++i)
+                {
+                    collect_dictionaries(state, *array.children[i], *schema.children[i]);
+                }
+                return;
+            }
+            if (array.dictionary == nullptr)
+            {
+                throw std::invalid_argument("Dictionary-encoded array without dictionary");
+            }
+            // Numbered before the dictionaries nested in its values, but written after them
+            const int64_t id = state.next_id++;
+            const ArrowArray& values = *array.dictionary;
+            const ArrowSchema& values_schema = *schema.dictionary;
+            for (int64_t i = 0; i < values_schema.n_children; ++i)
+            {
+                collect_dictionaries(state, *values.children[i], *values_schema.children[i]);
+            }
+            update_dictionary(state, id, values, values_schema);
+        }
+    }
+
+    dictionary_tracker::dictionary_tracker(bool allow_replacement)
+        : m_allow_replacement(allow_replacement)
+    {
+    }
+
+    std::vector<dictionary_batch> dictionary_tracker::update(const sparrow::record_batch& record_batch)
+    {
+        tracker_state state{.dictionaries = m_dictionaries, .allow_replacement = m_allow_replacement};
+        for (const auto& column : record_batch.columns())
+        {
+            const auto& proxy = sparrow::detail::array_access::get_arrow_proxy(column);
+            collect_dictionaries(state, proxy.array(), proxy.schema());
+        }
+        return std::move(state.batches);
+    }
+}
@@ -1,6 +1,11 @@
 #include "sparrow_ipc/encapsulated_message.hpp"
 
+#include <cstring>
+#include <limits>
 #include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
 
 #include "sparrow_ipc/magic_values.hpp"
 #include "sparrow_ipc/utils.hpp"
@@ -69,7 +74,18 @@ namespace sparrow_ipc
 
     size_t encapsulated_message::body_length() const
     {
-        return static_cast<size_t>(flat_buffer_message()->bodyLength());
+        // The body length is read from untrusted metadata, that the FlatBuffer verifier accepts
+        // whatever its value: the readers add it to the header size to size their buffers
+        const int64_t body_length = flat_buffer_message()->bodyLength();
+        if (body_length < 0
+            || std::cmp_greater(
+                body_length,
+                std::numeric_limits<size_t>::max() - encapsulated_message_header_size(metadata_length())
+            ))
+        {
+            throw std::runtime_error("Invalid message body length: " + std::to_string(body_length));
+        }
+        return static_cast<size_t>(body_length);
     }
 
     std::span<const uint8_t> encapsulated_message::body() const
@@ -77,7 +93,7 @@ namespace sparrow_ipc
         const size_t offset = sizeof(uint32_t) * 2  // 4 bytes continuation + 4 bytes metadata size
                               + metadata_length();
         const size_t padded_offset = utils::align_to_8(offset);  // Round up to 8-byte boundary
-        if (m_data.size() < padded_offset + body_length())
+        if (m_data.size() < padded_offset || body_length() > m_data.size() - padded_offset)
         {
             throw std::runtime_error("Data size is smaller than expected from metadata.");
         }
@@ -97,8 +113,23 @@ namespace sparrow_ipc
         return m_data;
     }
 
+    void encapsulated_message::verify() const
+    {
+        if (m_data.size() < encapsulated_message_prefix_size
+            || m_data.size() - encapsulated_message_prefix_size < metadata_length())
+        {
+            throw std::runtime_error("Message metadata exceeds the message size.");
+        }
+        flatbuffers::Verifier verifier(m_data.data() + encapsulated_message_prefix_size, metadata_length());
+        if (!org::apache::arrow::flatbuf::VerifyMessageBuffer(verifier))
+        {
+            throw std::runtime_error("Invalid message: the FlatBuffer metadata failed verification.");
+        }
+        std::ignore = body_length();
+    }
+
     std::pair<encapsulated_message, std::span<const uint8_t>>
-    extract_encapsulated_message(std::span<const uint8_t> data)
+    extract_encapsulated_message(std::span<const uint8_t> data, bool verify)
     {
         if (data.size() < 8)
         {
@@ -110,7 +141,44 @@ namespace sparrow_ipc
             throw std::runtime_error("Buffer should start with continuation bytes, expected a valid message.");
         }
         encapsulated_message message(data);
+        if (verify)
+        {
+            message.verify();
+        }
+        const size_t header_size = encapsulated_message_header_size(message.metadata_length());
+        if (header_size > data.size() || message.body_length() > data.size() - header_size)
+        {
+            throw std::runtime_error("Data size is smaller than expected from metadata.");
+        }
         std::span<const uint8_t> rest = data.subspan(message.total_length());
         return {std::move(message), std::move(rest)};
     }
+
+    std::optional<size_t> parse_message_prefix(std::span<const uint8_t> prefix)
+    {
+        if (prefix.size() < encapsulated_message_prefix_size)
+        {
+            throw std::invalid_argument("Buffer is too small to contain a valid message prefix.");
+        }
+        if (!is_continuation(prefix.subspan(0, sizeof(uint32_t))))
+        {
+            throw std::runtime_error("Message should start with continuation bytes, expected a valid message.");
+        }
+        int32_t metadata_length = 0;
+        std::memcpy(&metadata_length, prefix.data() + sizeof(uint32_t), sizeof(metadata_length));
+        if (metadata_length < 0)
+        {
+            throw std::runtime_error("Invalid message metadata length: " + std::to_string(metadata_length));
+        }
+        if (metadata_length == 0)
+        {
+            return std::nullopt;
+        }
+        return static_cast<size_t>(metadata_length);
+    }
+
+    size_t encapsulated_message_header_size(size_t metadata_length)
+    {
+        return utils::align_to_8(encapsulated_message_prefix_size + metadata_length);
+    }
 }
@@ -0,0 +1,44 @@
+#include "sparrow_ipc/file_descriptor_input_stream.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+
+#if defined(_WIN32)
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+namespace sparrow_ipc
+{
+    file_descriptor_input_stream::file_descriptor_input_stream(int fd) noexcept
+        : m_fd(fd)
+    {
+    }
+
+    std::streamsize file_descriptor_input_stream::read(char* s, std::streamsize count)
+    {
+        while (true)
+        {
+#if defined(_WIN32)
+            const auto chunk = static_cast<unsigned int>(
+                std::min<std::streamsize>(count, std::numeric_limits<int>::max())
+            );
+            const auto result = ::_read(m_fd, s, chunk);
+#else
+            const auto result = ::read(m_fd, s, static_cast<size_t>(count));
+#endif
+            if (result < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            return static_cast<std::streamsize>(result);
+        }
+    }
+
+    int file_descriptor_input_stream::fd() const noexcept
+    {
+        return m_fd;
+    }
+}
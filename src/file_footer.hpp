@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace sparrow_ipc::details
+{
+    /**
+     * @brief Position of the footer of an Arrow IPC file.
+     */
+    struct footer_location
+    {
+        size_t offset = 0;
+        size_t size = 0;
+    };
+
+    /**
+     * @brief Locates the footer of an Arrow IPC file from its magic bytes and its footer size.
+     *
+     * The footer itself is not parsed nor verified.
+     *
+     * @throws std::runtime_error If the file is too small, if the magic bytes are missing or if
+     *         the footer size is invalid
+     */
+    [[nodiscard]] footer_location locate_footer(std::span<const uint8_t> file_data);
+
+    /**
+     * @brief Gets the data of an Arrow IPC file up to its footer: the leading magic bytes followed
+     *        by the stream portion of the file.
+     *
+     * @throws std::runtime_error In the same cases as locate_footer
+     */
+    [[nodiscard]] std::span<const uint8_t> file_stream_portion(std::span<const uint8_t> file_data);
+}
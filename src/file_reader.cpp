@@ -0,0 +1,258 @@
+#include "sparrow_ipc/file_reader.hpp"
+
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "sparrow_ipc/encapsulated_message.hpp"
+#include "sparrow_ipc/magic_values.hpp"
+#include "sparrow_ipc/memory_mapped_file.hpp"
+
+#include "file_footer.hpp"
+#include "parallel_for.hpp"
+
+namespace sparrow_ipc
+{
+    namespace details
+    {
+        footer_location locate_footer(std::span<const uint8_t> file_data)
+        {
+            // Magic (8) + Footer size (4) + Magic (6) = 18 bytes minimum
+            constexpr size_t min_file_size = 18;
+            if (file_data.size() < min_file_size)
+            {
+                throw std::runtime_error("File is too small to be a valid Arrow file");
+            }
+
+            if (!is_arrow_file_magic(file_data.subspan(0, arrow_file_magic_size)))
+            {
+                throw std::runtime_error("Invalid Arrow file: missing or incorrect magic bytes at start");
+            }
+
+            const size_t trailing_magic_offset = file_data.size() - arrow_file_magic_size;
+            if (!is_arrow_file_magic(file_data.subspan(trailing_magic_offset, arrow_file_magic_size)))
+            {
+                throw std::runtime_error("Invalid Arrow file: missing or incorrect magic bytes at end");
+            }
+
+            // The footer size is stored in the 4 bytes before the trailing magic
+            const size_t footer_size_offset = trailing_magic_offset - sizeof(int32_t);
+            int32_t footer_size = 0;
+            std::memcpy(&footer_size, file_data.data() + footer_size_offset, sizeof(int32_t));
+            if (footer_size <= 0 || static_cast<size_t>(footer_size) > file_data.size() - min_file_size)
+            {
+                throw std::runtime_error("Invalid footer size in Arrow file");
+            }
+            return {
+                .offset = footer_size_offset - static_cast<size_t>(footer_size),
+                .size = static_cast<size_t>(footer_size)
+            };
+        }
+
+        std::span<const uint8_t> file_stream_portion(std::span<const uint8_t> file_data)
+        {
+            return file_data.subspan(0, locate_footer(file_data).offset);
+        }
+    }
+
+    file_reader::file_reader(const std::filesystem::path& path, const read_options& options)
+    {
+        auto file = std::make_shared<const memory_mapped_file>(path);
+        m_data = file->data();
+        m_owner = std::move(file);
+        parse_footer(options);
+    }
+
+    file_reader::file_reader(
+        std::span<const uint8_t> data,
+        std::shared_ptr<const void> owner,
+        const read_options& options
+    )
+        : m_owner(std::move(owner))
+        , m_data(data)
+    {
+        parse_footer(options);
+    }
+
+    file_reader::file_reader(std::vector<uint8_t>&& data, const read_options& options)
+    {
+        auto content = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+        m_data = *content;
+        m_owner = std::move(content);
+        parse_footer(options);
+    }
+
+    void file_reader::parse_footer(const read_options& options)
+    {
+        const details::footer_location footer = details::locate_footer(m_data);
+        m_footer_offset = footer.offset;
+        if (options.validation != validation_level::none)
+        {
+            flatbuffers::Verifier verifier(m_data.data() + m_footer_offset, footer.size);
+            if (!org::apache::arrow::flatbuf::VerifyFooterBuffer(verifier))
+            {
+                throw std::runtime_error("Invalid Arrow file: the footer failed verification");
+            }
+        }
+        m_footer = org::apache::arrow::flatbuf::GetFooter(m_data.data() + m_footer_offset);
+        if (m_footer->schema() == nullptr)
+        {
+            throw std::runtime_error("Invalid Arrow file: footer has no schema");
+        }
+        m_schema = decode_schema(*m_footer->schema(), options);
+        read_dictionaries(m_schema);
+    }
+
+    void file_reader::read_dictionaries(decoded_schema& schema) const
+    {
+        const auto* blocks = m_footer->dictionaries();
+        if (blocks == nullptr)
+        {
+            return;
+        }
+        for (size_t i = 0; i < blocks->size(); ++i)
+        {
+            const encapsulated_message message = block_message(
+                *blocks->Get(static_cast<flatbuffers::uoffset_t>(i)),
+                i,
+                "dictionary",
+                schema.validation
+            );
+            if (message.flat_buffer_message()->header_type()
+                != org::apache::arrow::flatbuf::MessageHeader::DictionaryBatch)
+            {
+                throw std::runtime_error(
+                    "Invalid Arrow file: dictionary block " + std::to_string(i) + " is not a DictionaryBatch message"
+                );
+            }
+            decode_dictionary_batch(message, schema, m_owner);
+        }
+    }
+
+    size_t file_reader::num_record_batches() const noexcept
+    {
+        const auto* blocks = m_footer->recordBatches();
+        return blocks == nullptr ? 0 : static_cast<size_t>(blocks->size());
+    }
+
+    const decoded_schema& file_reader::schema() const noexcept
+    {
+        return m_schema;
+    }
+
+    const std::vector<std::string>& file_reader::names() const noexcept
+    {
+        return m_schema.field_names;
+    }
+
+    sparrow::record_batch file_reader::read_record_batch(size_t index) const
+    {
+        return read_record_batch(index, m_schema);
+    }
+
+    sparrow::record_batch file_reader::read_record_batch(size_t index, const decoded_schema& schema) const
+    {
+        return decode_record_batch(record_batch_message(index, schema), schema, m_owner);
+    }
+
+    lazy_record_batch file_reader::read_lazy_record_batch(size_t index) const
+    {
+        return lazy_record_batch(record_batch_message(index, m_schema), m_schema, m_owner);
+    }
+
+    encapsulated_message file_reader::record_batch_message(size_t index, const decoded_schema& schema) const
+    {
+        if (index >= num_record_batches())
+        {
+            throw std::out_of_range(
+                "Record batch index " + std::to_string(index) + " is out of range, the file has "
+                + std::to_string(num_record_batches()) + " record batches"
+            );
+        }
+        const encapsulated_message message = block_message(
+            *m_footer->recordBatches()->Get(static_cast<flatbuffers::uoffset_t>(index)),
+            index,
+            "record batch",
+            schema.validation
+        );
+        if (message.flat_buffer_message()->header_type() != org::apache::arrow::flatbuf::MessageHeader::RecordBatch)
+        {
+            throw std::runtime_error("Invalid Arrow file: block " + std::to_string(index) + " is not a RecordBatch message");
+        }
+        return message;
+    }
+
+    encapsulated_message file_reader::block_message(
+        const org::apache::arrow::flatbuf::Block& block,
+        size_t index,
+        std::string_view kind,
+        validation_level validation
+    ) const
+    {
+        // Each term is checked against the room left before the footer, so that nothing overflows
+        const auto footer_offset = static_cast<int64_t>(m_footer_offset);
+        if (block.offset() < static_cast<int64_t>(arrow_file_header_magic.size()) || block.offset() > footer_offset
+            || block.metaDataLength() < static_cast<int32_t>(encapsulated_message_prefix_size)
+            || block.metaDataLength() > footer_offset - block.offset() || block.bodyLength() < 0
+            || block.bodyLength() > footer_offset - block.offset() - block.metaDataLength())
+        {
+            throw std::runtime_error(
+                "Invalid Arrow file: " + std::string(kind) + " block " + std::to_string(index) + " is out of bounds"
+            );
+        }
+
+        const auto message_data = m_data.subspan(
+            static_cast<size_t>(block.offset()),
+            static_cast<size_t>(block.metaDataLength()) + static_cast<size_t>(block.bodyLength())
+        );
+        if (!parse_message_prefix(message_data).has_value())
+        {
+            throw std::runtime_error(
+                "Invalid Arrow file: " + std::string(kind) + " block " + std::to_string(index) + " is empty"
+            );
+        }
+        const encapsulated_message message(message_data);
+        if (validation != validation_level::none)
+        {
+            message.verify();
+        }
+        return message;
+    }
+
+    std::vector<sparrow::record_batch> file_reader::read_all(const read_options& options) const
+    {
+        // The decompression threads of each record batch are nested in the threads decoding them
+        const size_t thread_count = details::resolve_thread_count(options.num_threads, num_record_batches());
+        const size_t decompression_threads = details::resolve_nested_thread_count(
+            m_schema.decompression_threads,
+            thread_count
+        );
+        std::optional<decoded_schema> read_schema;
+        if (options.field_indices.has_value() || options.field_names.has_value())
+        {
+            // The decoding flags are the ones the reader was constructed with, as without projection
+            read_options projection_options = options;
+            projection_options.validation = m_schema.validation;
+            projection_options.decompression_threads = decompression_threads;
+            projection_options.expand_run_end_encoded = m_schema.expand_run_end_encoded;
+            read_schema = decode_schema(*m_footer->schema(), projection_options);
+            read_dictionaries(*read_schema);
+        }
+        else if (decompression_threads != m_schema.decompression_threads)
+        {
+            read_schema = m_schema;
+            read_schema->decompression_threads = decompression_threads;
+        }
+        const decoded_schema& schema = read_schema.has_value() ? *read_schema : m_schema;
+        return details::parallel_transform(
+            num_record_batches(),
+            thread_count,
+            [this, &schema](size_t i)
+            {
+                return read_record_batch(i, schema);
+            }
+        );
+    }
+}
@@ -2,6 +2,7 @@
 
 #include <numeric>
 #include <string>
+#include <vector>
 
 #include "compression_impl.hpp"
 #include "sparrow_ipc/magic_values.hpp"
@@ -28,10 +29,63 @@ namespace sparrow_ipc
                 timezone_offset);
             return {org::apache::arrow::flatbuf::Type::Timestamp, timestamp_type.Union()};
         }
+
+        // Type ids of the children of a union, listed in its format: "+ud:id1,id2,..."
+        flatbuffers::Offset<flatbuffers::Vector<int32_t>>
+        create_union_type_ids(flatbuffers::FlatBufferBuilder& builder, std::string_view format_str)
+        {
+            const auto words = utils::extract_words_after_colon(format_str);
+            if (words.empty())
+            {
+                return 0;
+            }
+            std::vector<int32_t> type_ids;
+            type_ids.reserve(words.size());
+            for (const auto word : words)
+            {
+                const auto type_id = utils::parse_to_int32(word);
+                if (!type_id.has_value())
+                {
+                    throw std::runtime_error(
+                        "Failed to parse union type ids from format string: " + std::string(format_str)
+                    );
+                }
+                type_ids.push_back(type_id.value());
+            }
+            return builder.CreateVector(type_ids);
+        }
+
+        flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<org::apache::arrow::flatbuf::TensorDim>>>
+        create_tensor_shape(flatbuffers::FlatBufferBuilder& builder, const std::vector<tensor_dimension>& shape)
+        {
+            std::vector<flatbuffers::Offset<org::apache::arrow::flatbuf::TensorDim>> dimensions;
+            dimensions.reserve(shape.size());
+            for (const auto& dimension : shape)
+            {
+                flatbuffers::Offset<flatbuffers::String> name_offset = 0;
+                if (!dimension.name.empty())
+                {
+                    name_offset = builder.CreateString(dimension.name);
+                }
+                dimensions.push_back(
+                    org::apache::arrow::flatbuf::CreateTensorDim(builder, dimension.size, name_offset)
+                );
+            }
+            return builder.CreateVector(dimensions);
+        }
+
+        // Integer type of the indices of a sparse tensor, from their integer format
+        flatbuffers::Offset<org::apache::arrow::flatbuf::Int>
+        create_tensor_index_type(flatbuffers::FlatBufferBuilder& builder, std::string_view format)
+        {
+            const auto bit_width = static_cast<int32_t>(tensor_value_size(format) * 8);
+            const bool is_signed = format == "c" || format == "s" || format == "i" || format == "l";
+            return org::apache::arrow::flatbuf::CreateInt(builder, bit_width, is_signed);
+        }
     }
 
     std::pair<org::apache::arrow::flatbuf::Type, flatbuffers::Offset<void>>
-    get_flatbuffer_type(flatbuffers::FlatBufferBuilder& builder, std::string_view format_str)
+    get_flatbuffer_type(flatbuffers::FlatBufferBuilder& builder, std::string_view format_str, int64_t flags)
     {
         const auto type = sparrow::format_to_data_type(format_str);
         switch (type)
@@ -325,8 +379,8 @@ namespace sparrow_ipc
             }
             case sparrow::data_type::MAP:
             {
-                // not sorted keys
-                const auto map_type = org::apache::arrow::flatbuf::CreateMap(builder, false);
+                const bool keys_sorted = (flags & static_cast<int64_t>(sparrow::ArrowFlag::MAP_KEYS_SORTED)) != 0;
+                const auto map_type = org::apache::arrow::flatbuf::CreateMap(builder, keys_sorted);
                 return {org::apache::arrow::flatbuf::Type::Map, map_type.Union()};
             }
             case sparrow::data_type::DENSE_UNION:
@@ -334,7 +388,7 @@ namespace sparrow_ipc
                 const auto union_type = org::apache::arrow::flatbuf::CreateUnion(
                     builder,
                     org::apache::arrow::flatbuf::UnionMode::Dense,
-                    0
+                    create_union_type_ids(builder, format_str)
                 );
                 return {org::apache::arrow::flatbuf::Type::Union, union_type.Union()};
             }
@@ -343,7 +397,7 @@ namespace sparrow_ipc
                 const auto union_type = org::apache::arrow::flatbuf::CreateUnion(
                     builder,
                     org::apache::arrow::flatbuf::UnionMode::Sparse,
-                    0
+                    create_union_type_ids(builder, format_str)
                 );
                 return {org::apache::arrow::flatbuf::Type::Union, union_type.Union()};
             }
@@ -445,26 +499,81 @@ namespace sparrow_ipc
         return builder.CreateVector(kv_offsets);
     }
 
+    ::flatbuffers::Offset<org::apache::arrow::flatbuf::DictionaryEncoding>
+    create_dictionary_encoding(flatbuffers::FlatBufferBuilder& builder, const ArrowSchema& arrow_schema, int64_t id)
+    {
+        const std::string_view format = arrow_schema.format;
+        int32_t bit_width = 0;
+        if (format == "c" || format == "C")
+        {
+            bit_width = 8;
+        }
+        else if (format == "s" || format == "S")
+        {
+            bit_width = 16;
+        }
+        else if (format == "i" || format == "I")
+        {
+            bit_width = 32;
+        }
+        else if (format == "l" || format == "L")
+        {
+            bit_width = 64;
+        }
+        else
+        {
+            throw std::invalid_argument(
+                "Unsupported dictionary index format: '" + std::string(format) + "', an integer format is expected"
+            );
+        }
+        const bool is_signed = format == "c" || format == "s" || format == "i" || format == "l";
+        const auto index_type = org::apache::arrow::flatbuf::CreateInt(builder, bit_width, is_signed);
+        return org::apache::arrow::flatbuf::CreateDictionaryEncoding(
+            builder,
+            id,
+            index_type,
+            (arrow_schema.flags & static_cast<int64_t>(sparrow::ArrowFlag::DICTIONARY_ORDERED)) != 0
+        );
+    }
+
     ::flatbuffers::Offset<org::apache::arrow::flatbuf::Field> create_field(
         flatbuffers::FlatBufferBuilder& builder,
         const ArrowSchema& arrow_schema,
         std::optional<std::string_view> name_override
     )
+    {
+        int64_t next_dictionary_id = 0;
+        return create_field(builder, arrow_schema, name_override, next_dictionary_id);
+    }
+
+    ::flatbuffers::Offset<org::apache::arrow::flatbuf::Field> create_field(
+        flatbuffers::FlatBufferBuilder& builder,
+        const ArrowSchema& arrow_schema,
+        std::optional<std::string_view> name_override,
+        int64_t& next_dictionary_id
+    )
     {
         flatbuffers::Offset<flatbuffers::String>
             fb_name_offset = name_override.has_value()
                                  ? builder.CreateString(name_override.value())
                                  : (arrow_schema.name == nullptr ? 0 : builder.CreateString(arrow_schema.name));
-        const auto [type_enum, type_offset] = get_flatbuffer_type(builder, arrow_schema.format);
+        // The type and children of a dictionary-encoded field are the ones of its values
+        flatbuffers::Offset<org::apache::arrow::flatbuf::DictionaryEncoding> fb_dictionary_offset = 0;
+        if (arrow_schema.dictionary != nullptr)
+        {
+            fb_dictionary_offset = create_dictionary_encoding(builder, arrow_schema, next_dictionary_id++);
+        }
+        const ArrowSchema& type_schema = arrow_schema.dictionary == nullptr ? arrow_schema : *arrow_schema.dictionary;
+        const auto [type_enum, type_offset] = get_flatbuffer_type(builder, type_schema.format, type_schema.flags);
         auto fb_metadata_offset = create_metadata(builder, arrow_schema);
-        const auto children = create_children(builder, arrow_schema);
+        const auto children = create_children(builder, type_schema, next_dictionary_id);
         const auto fb_field = org::apache::arrow::flatbuf::CreateField(
             builder,
             fb_name_offset,
             (arrow_schema.flags & static_cast<int64_t>(sparrow::ArrowFlag::NULLABLE)) != 0,
             type_enum,
             type_offset,
-            0,  // TODO: support dictionary
+            fb_dictionary_offset,
             children,
             fb_metadata_offset
         );
@@ -473,6 +582,13 @@ namespace sparrow_ipc
 
     ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<org::apache::arrow::flatbuf::Field>>>
     create_children(flatbuffers::FlatBufferBuilder& builder, const ArrowSchema& arrow_schema)
+    {
+        int64_t next_dictionary_id = 0;
+        return create_children(builder, arrow_schema, next_dictionary_id);
+    }
+
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<org::apache::arrow::flatbuf::Field>>>
+    create_children(flatbuffers::FlatBufferBuilder& builder, const ArrowSchema& arrow_schema, int64_t& next_dictionary_id)
     {
         std::vector<flatbuffers::Offset<org::apache::arrow::flatbuf::Field>> children_vec;
         children_vec.reserve(arrow_schema.n_children);
@@ -483,7 +599,12 @@ namespace sparrow_ipc
                 throw std::invalid_argument("ArrowSchema has null child pointer");
             }
             const auto& child = *arrow_schema.children[i];
-            flatbuffers::Offset<org::apache::arrow::flatbuf::Field> field = create_field(builder, child);
+            flatbuffers::Offset<org::apache::arrow::flatbuf::Field> field = create_field(
+                builder,
+                child,
+                std::nullopt,
+                next_dictionary_id
+            );
             children_vec.emplace_back(field);
         }
         return children_vec.empty() ? 0 : builder.CreateVector(children_vec);
@@ -496,26 +617,36 @@ namespace sparrow_ipc
         std::vector<flatbuffers::Offset<org::apache::arrow::flatbuf::Field>> children_vec;
         children_vec.reserve(columns.size());
         const auto names = record_batch.names();
+        // The dictionaries are numbered across the columns, like dictionary_tracker does
+        int64_t next_dictionary_id = 0;
         for (size_t i = 0; i < columns.size(); ++i)
         {
             const auto& arrow_schema = sparrow::detail::array_access::get_arrow_proxy(columns[i]).schema();
             flatbuffers::Offset<org::apache::arrow::flatbuf::Field> field = create_field(
                 builder,
                 arrow_schema,
-                names[i]
+                names[i],
+                next_dictionary_id
             );
             children_vec.emplace_back(field);
         }
         return children_vec.empty() ? 0 : builder.CreateVector(children_vec);
     }
 
-    flatbuffers::FlatBufferBuilder get_schema_message_builder(const sparrow::record_batch& record_batch)
+    org::apache::arrow::flatbuf::Endianness to_fb_endianness(std::endian byte_order)
+    {
+        return byte_order == std::endian::big ? org::apache::arrow::flatbuf::Endianness::Big
+                                              : org::apache::arrow::flatbuf::Endianness::Little;
+    }
+
+    flatbuffers::FlatBufferBuilder
+    get_schema_message_builder(const sparrow::record_batch& record_batch, std::endian byte_order)
     {
         flatbuffers::FlatBufferBuilder schema_builder;
         const auto fields_vec = create_children(schema_builder, record_batch);
         const auto schema_offset = org::apache::arrow::flatbuf::CreateSchema(
             schema_builder,
-            org::apache::arrow::flatbuf::Endianness::Little,  // TODO: make configurable
+            to_fb_endianness(byte_order),
             fields_vec
         );
         const auto schema_message_offset = org::apache::arrow::flatbuf::CreateMessage(
@@ -565,7 +696,7 @@ namespace sparrow_ipc
             arrow_proxy,
             flatbuf_buffers,
             offset,
-            [](const auto& buffer)
+            [](std::span<const uint8_t> buffer)
             {
                 return static_cast<int64_t>(buffer.size());
             }
@@ -597,13 +728,9 @@ namespace sparrow_ipc
             arrow_proxy,
             flatbuf_compressed_buffers,
             offset,
-            [&](const auto& buffer)
+            [&](std::span<const uint8_t> buffer)
             {
-                return get_compressed_size(
-                    compression_type,
-                    std::span<const uint8_t>(buffer.data(), buffer.size()),
-                    cache
-                );
+                return get_compressed_size(compression_type, buffer, cache);
             }
         );
     }
@@ -638,21 +765,25 @@ namespace sparrow_ipc
             {
                 throw std::invalid_argument("Compression type set but no cache is given.");
             }
-            for (const auto& buffer : arrow_proxy.buffers())
-            {
-                total_size += utils::align_to_8(get_compressed_size(
-                    compression.value(),
-                    std::span<const uint8_t>(buffer.data(), buffer.size()),
-                    cache.value().get()
-                ));
-            }
+            details::for_each_body_buffer(
+                arrow_proxy,
+                [&](std::span<const uint8_t> buffer)
+                {
+                    total_size += utils::align_to_8(
+                        get_compressed_size(compression.value(), buffer, cache.value().get())
+                    );
+                }
+            );
         }
         else
         {
-            for (const auto& buffer : arrow_proxy.buffers())
-            {
-                total_size += utils::align_to_8(buffer.size());
-            }
+            details::for_each_body_buffer(
+                arrow_proxy,
+                [&](std::span<const uint8_t> buffer)
+                {
+                    total_size += static_cast<int64_t>(utils::align_to_8(buffer.size()));
+                }
+            );
         }
 
         for (const auto& child : arrow_proxy.children())
@@ -681,6 +812,30 @@ namespace sparrow_ipc
         );
     }
 
+    void fill_variadic_buffer_counts(const sparrow::arrow_proxy& arrow_proxy, std::vector<int64_t>& counts)
+    {
+        const auto data_type = arrow_proxy.data_type();
+        if (data_type == sparrow::data_type::STRING_VIEW || data_type == sparrow::data_type::BINARY_VIEW)
+        {
+            // Validity and views, followed by the data buffers and the buffer of their sizes
+            counts.push_back(arrow_proxy.array().n_buffers - 3);
+        }
+        for (const auto& child : arrow_proxy.children())
+        {
+            fill_variadic_buffer_counts(child, counts);
+        }
+    }
+
+    std::vector<int64_t> create_variadic_buffer_counts(const sparrow::record_batch& record_batch)
+    {
+        std::vector<int64_t> counts;
+        for (const auto& column : record_batch.columns())
+        {
+            fill_variadic_buffer_counts(sparrow::detail::array_access::get_arrow_proxy(column), counts);
+        }
+        return counts;
+    }
+
     flatbuffers::FlatBufferBuilder get_record_batch_message_builder(
         const sparrow::record_batch& record_batch,
         std::optional<CompressionType> compression,
@@ -707,13 +862,19 @@ namespace sparrow_ipc
         const std::vector<org::apache::arrow::flatbuf::FieldNode> nodes = create_fieldnodes(record_batch);
         auto nodes_offset = record_batch_builder.CreateVectorOfStructs(nodes);
         auto buffers_offset = record_batch_builder.CreateVectorOfStructs(buffers);
+        const std::vector<int64_t> variadic_counts = create_variadic_buffer_counts(record_batch);
+        flatbuffers::Offset<flatbuffers::Vector<int64_t>> variadic_counts_offset = 0;
+        if (!variadic_counts.empty())
+        {
+            variadic_counts_offset = record_batch_builder.CreateVector(variadic_counts);
+        }
         const auto record_batch_offset = org::apache::arrow::flatbuf::CreateRecordBatch(
             record_batch_builder,
             static_cast<int64_t>(record_batch.nb_rows()),
             nodes_offset,
             buffers_offset,
             compression_offset,
-            0  // TODO :variadic buffer Counts
+            variadic_counts_offset
         );
 
         const int64_t body_size = calculate_body_size(record_batch, compression, cache);
@@ -729,6 +890,180 @@ namespace sparrow_ipc
         return record_batch_builder;
     }
 
+    flatbuffers::FlatBufferBuilder get_dictionary_batch_message_builder(
+        const dictionary_batch& dictionary,
+        std::optional<CompressionType> compression,
+        std::optional<std::reference_wrapper<CompressionCache>> cache
+    )
+    {
+        const auto& arrow_proxy = sparrow::detail::array_access::get_arrow_proxy(dictionary.values);
+        flatbuffers::FlatBufferBuilder dictionary_batch_builder;
+        flatbuffers::Offset<org::apache::arrow::flatbuf::BodyCompression> compression_offset = 0;
+        std::vector<org::apache::arrow::flatbuf::Buffer> buffers;
+        int64_t offset = 0;
+        if (compression)
+        {
+            if (!cache)
+            {
+                throw std::invalid_argument("Compression type set but no cache is given.");
+            }
+            fill_compressed_buffers(arrow_proxy, buffers, offset, compression.value(), cache.value().get());
+            compression_offset = org::apache::arrow::flatbuf::CreateBodyCompression(
+                dictionary_batch_builder,
+                details::to_fb_compression_type(compression.value()),
+                org::apache::arrow::flatbuf::BodyCompressionMethod::BUFFER
+            );
+        }
+        else
+        {
+            fill_buffers(arrow_proxy, buffers, offset);
+        }
+        // The values are the single column of the RecordBatch of the message
+        std::vector<org::apache::arrow::flatbuf::FieldNode> nodes;
+        fill_fieldnodes(arrow_proxy, nodes);
+        std::vector<int64_t> variadic_counts;
+        fill_variadic_buffer_counts(arrow_proxy, variadic_counts);
+        auto nodes_offset = dictionary_batch_builder.CreateVectorOfStructs(nodes);
+        auto buffers_offset = dictionary_batch_builder.CreateVectorOfStructs(buffers);
+        flatbuffers::Offset<flatbuffers::Vector<int64_t>> variadic_counts_offset = 0;
+        if (!variadic_counts.empty())
+        {
+            variadic_counts_offset = dictionary_batch_builder.CreateVector(variadic_counts);
+        }
+        const auto record_batch_offset = org::apache::arrow::flatbuf::CreateRecordBatch(
+            dictionary_batch_builder,
+            static_cast<int64_t>(arrow_proxy.length()),
+            nodes_offset,
+            buffers_offset,
+            compression_offset,
+            variadic_counts_offset
+        );
+        const auto dictionary_batch_offset = org::apache::arrow::flatbuf::CreateDictionaryBatch(
+            dictionary_batch_builder,
+            dictionary.id,
+            record_batch_offset,
+            dictionary.is_delta
+        );
+
+        const int64_t body_size = calculate_body_size(arrow_proxy, compression, cache);
+        const auto dictionary_batch_message_offset = org::apache::arrow::flatbuf::CreateMessage(
+            dictionary_batch_builder,
+            org::apache::arrow::flatbuf::MetadataVersion::V5,
+            org::apache::arrow::flatbuf::MessageHeader::DictionaryBatch,
+            dictionary_batch_offset.Union(),
+            body_size,  // body length
+            0           // custom metadata
+        );
+        dictionary_batch_builder.Finish(dictionary_batch_message_offset);
+        return dictionary_batch_builder;
+    }
+
+    flatbuffers::FlatBufferBuilder get_tensor_message_builder(const tensor_view& tensor)
+    {
+        flatbuffers::FlatBufferBuilder tensor_builder;
+        const auto [type_enum, type_offset] = get_flatbuffer_type(tensor_builder, tensor.format);
+        const auto shape_offset = create_tensor_shape(tensor_builder, tensor.shape);
+        flatbuffers::Offset<flatbuffers::Vector<int64_t>> strides_offset = 0;
+        if (!tensor.strides.empty())
+        {
+            strides_offset = tensor_builder.CreateVector(tensor.strides);
+        }
+        const org::apache::arrow::flatbuf::Buffer data_buffer(0, static_cast<int64_t>(tensor.data.size()));
+        const auto tensor_offset = org::apache::arrow::flatbuf::CreateTensor(
+            tensor_builder,
+            type_enum,
+            type_offset,
+            shape_offset,
+            strides_offset,
+            &data_buffer
+        );
+
+        const auto tensor_message_offset = org::apache::arrow::flatbuf::CreateMessage(
+            tensor_builder,
+            org::apache::arrow::flatbuf::MetadataVersion::V5,
+            org::apache::arrow::flatbuf::MessageHeader::Tensor,
+            tensor_offset.Union(),
+            static_cast<int64_t>(utils::align_to_8(tensor.data.size())),  // body length
+            0                                                              // custom metadata
+        );
+        tensor_builder.Finish(tensor_message_offset);
+        return tensor_builder;
+    }
+
+    flatbuffers::FlatBufferBuilder get_sparse_tensor_message_builder(const sparse_tensor_view& tensor)
+    {
+        flatbuffers::FlatBufferBuilder tensor_builder;
+        // Buffers of the body, each aligned to 8 bytes
+        std::vector<org::apache::arrow::flatbuf::Buffer> buffers;
+        int64_t offset = 0;
+        for (const auto buffer : details::sparse_tensor_body_buffers(tensor))
+        {
+            buffers.emplace_back(offset, static_cast<int64_t>(buffer.size()));
+            offset += static_cast<int64_t>(utils::align_to_8(buffer.size()));
+        }
+
+        flatbuffers::Offset<void> index_offset = 0;
+        auto index_type = org::apache::arrow::flatbuf::SparseTensorIndex::NONE;
+        if (tensor.index == sparse_tensor_index::coo)
+        {
+            const auto indices_type = create_tensor_index_type(tensor_builder, tensor.indices_format);
+            flatbuffers::Offset<flatbuffers::Vector<int64_t>> indices_strides_offset = 0;
+            if (!tensor.indices_strides.empty())
+            {
+                indices_strides_offset = tensor_builder.CreateVector(tensor.indices_strides);
+            }
+            const auto coo_offset = org::apache::arrow::flatbuf::CreateSparseTensorIndexCOO(
+                tensor_builder,
+                indices_type,
+                indices_strides_offset,
+                &buffers[0],
+                tensor.is_canonical
+            );
+            index_type = org::apache::arrow::flatbuf::SparseTensorIndex::SparseTensorIndexCOO;
+            index_offset = coo_offset.Union();
+        }
+        else
+        {
+            const auto indptr_type = create_tensor_index_type(tensor_builder, tensor.indptr_format);
+            const auto indices_type = create_tensor_index_type(tensor_builder, tensor.indices_format);
+            const auto csx_offset = org::apache::arrow::flatbuf::CreateSparseMatrixIndexCSX(
+                tensor_builder,
+                tensor.index == sparse_tensor_index::csr
+                    ? org::apache::arrow::flatbuf::SparseMatrixCompressedAxis::Row
+                    : org::apache::arrow::flatbuf::SparseMatrixCompressedAxis::Column,
+                indptr_type,
+                &buffers[0],
+                indices_type,
+                &buffers[1]
+            );
+            index_type = org::apache::arrow::flatbuf::SparseTensorIndex::SparseMatrixIndexCSX;
+            index_offset = csx_offset.Union();
+        }
+        const auto [type_enum, type_offset] = get_flatbuffer_type(tensor_builder, tensor.format);
+        const auto shape_offset = create_tensor_shape(tensor_builder, tensor.shape);
+        const auto tensor_offset = org::apache::arrow::flatbuf::CreateSparseTensor(
+            tensor_builder,
+            type_enum,
+            type_offset,
+            shape_offset,
+            tensor.non_zero_length,
+            index_type,
+            index_offset,
+            &buffers.back()
+        );
+
+        const auto tensor_message_offset = org::apache::arrow::flatbuf::CreateMessage(
+            tensor_builder,
+            org::apache::arrow::flatbuf::MetadataVersion::V5,
+            org::apache::arrow::flatbuf::MessageHeader::SparseTensor,
+            tensor_offset.Union(),
+            offset,  // body length
+            0        // custom metadata
+        );
+        tensor_builder.Finish(tensor_message_offset);
+        return tensor_builder;
+    }
+
     const org::apache::arrow::flatbuf::Footer* get_footer_from_file_data(std::span<const uint8_t> file_data)
     {
         // Footer size is stored 4 bytes before the trailing magic
@@ -0,0 +1,156 @@
+#include "sparrow_ipc/lazy_record_batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "decoder_plan.hpp"
+
+namespace sparrow_ipc
+{
+    struct lazy_record_batch::column
+    {
+        std::once_flag once;
+        std::optional<sparrow::array> array;
+        std::atomic<bool> materialized{false};
+    };
+
+    lazy_record_batch::lazy_record_batch(
+        const encapsulated_message& message,
+        const decoded_schema& schema,
+        std::shared_ptr<const void> body_owner
+    )
+        : m_plan(schema.plan)
+        , m_dictionaries(schema.dictionaries)
+        , m_names(schema.field_names)
+        , m_owner(std::move(body_owner))
+    {
+        if (schema.schema == nullptr || m_plan == nullptr)
+        {
+            throw std::runtime_error("RecordBatch encountered before Schema message.");
+        }
+        m_record_batch = message.flat_buffer_message()->header_as_RecordBatch();
+        if (m_record_batch == nullptr)
+        {
+            throw std::runtime_error("RecordBatch message header is null.");
+        }
+        m_body = message.body();
+        details::check_record_batch(*m_plan, *m_record_batch);
+        if (m_plan->swap_byte_order)
+        {
+            // The buffers written in the other byte order are converted once for all the columns,
+            // the columns are then decoded from the copy, which they keep alive
+            auto swapped = details::byte_swap_record_batch(
+                *m_plan,
+                *m_record_batch,
+                m_body,
+                schema.decompression_threads
+            );
+            m_record_batch = &swapped->record_batch();
+            m_body = swapped->body();
+            m_owner = std::move(swapped);
+        }
+        m_columns = std::make_unique<column[]>(m_plan->fields.size());
+    }
+
+    lazy_record_batch::~lazy_record_batch() = default;
+
+    lazy_record_batch::lazy_record_batch(lazy_record_batch&&) noexcept = default;
+
+    lazy_record_batch& lazy_record_batch::operator=(lazy_record_batch&&) noexcept = default;
+
+    size_t lazy_record_batch::nb_columns() const noexcept
+    {
+        return m_names.size();
+    }
+
+    size_t lazy_record_batch::nb_rows() const noexcept
+    {
+        return m_record_batch == nullptr ? 0 : static_cast<size_t>(m_record_batch->length());
+    }
+
+    const std::vector<std::string>& lazy_record_batch::names() const noexcept
+    {
+        return m_names;
+    }
+
+    const sparrow::array& lazy_record_batch::get_column(size_t index) const
+    {
+        if (index >= nb_columns())
+        {
+            throw std::out_of_range(
+                "Column index " + std::to_string(index) + " is out of range, the record batch has "
+                + std::to_string(nb_columns()) + " columns"
+            );
+        }
+        column& col = m_columns[index];
+        // If the decoding throws, the flag is not set and the next access tries again
+        std::call_once(
+            col.once,
+            [this, index, &col]()
+            {
+                sparrow::array array = details::decode_field(
+                    m_plan,
+                    index,
+                    *m_record_batch,
+                    m_body,
+                    m_dictionaries.get()
+                );
+                if (m_owner != nullptr)
+                {
+                    details::attach_owner(sparrow::detail::array_access::get_arrow_proxy(array).array(), m_owner);
+                }
+                col.array = std::move(array);
+                col.materialized.store(true, std::memory_order_release);
+            }
+        );
+        return *col.array;
+    }
+
+    const sparrow::array& lazy_record_batch::get_column(std::string_view name) const
+    {
+        const auto it = std::ranges::find(m_names, name);
+        if (it == m_names.end())
+        {
+            throw std::out_of_range("Unknown column '" + std::string(name) + "'");
+        }
+        return get_column(static_cast<size_t>(std::distance(m_names.begin(), it)));
+    }
+
+    bool lazy_record_batch::is_materialized(size_t index) const
+    {
+        if (index >= nb_columns())
+        {
+            throw std::out_of_range(
+                "Column index " + std::to_string(index) + " is out of range, the record batch has "
+                + std::to_string(nb_columns()) + " columns"
+            );
+        }
+        return m_columns[index].materialized.load(std::memory_order_acquire);
+    }
+
+    sparrow::record_batch lazy_record_batch::extract_record_batch()
+    {
+        std::vector<sparrow::array> arrays;
+        arrays.reserve(nb_columns());
+        for (size_t i = 0; i < nb_columns(); ++i)
+        {
+            std::ignore = get_column(i);
+            arrays.push_back(std::move(*m_columns[i].array));
+        }
+        sparrow::record_batch result(std::move(m_names), std::move(arrays));
+        m_names.clear();
+        m_columns.reset();
+        m_record_batch = nullptr;
+        m_body = {};
+        m_plan.reset();
+        m_dictionaries.reset();
+        m_owner.reset();
+        return result;
+    }
+}
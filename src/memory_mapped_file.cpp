@@ -0,0 +1,134 @@
+#include "sparrow_ipc/memory_mapped_file.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace sparrow_ipc
+{
+    memory_mapped_file::memory_mapped_file(const std::filesystem::path& path)
+    {
+#if defined(_WIN32)
+        HANDLE file = ::CreateFileW(
+            path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr
+        );
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Failed to open file: " + path.string());
+        }
+        LARGE_INTEGER file_size;
+        if (!::GetFileSizeEx(file, &file_size))
+        {
+            ::CloseHandle(file);
+            throw std::runtime_error("Failed to get the size of file: " + path.string());
+        }
+        m_size = static_cast<size_t>(file_size.QuadPart);
+        if (m_size > 0)
+        {
+            HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping == nullptr)
+            {
+                ::CloseHandle(file);
+                throw std::runtime_error("Failed to map file: " + path.string());
+            }
+            m_data = static_cast<const uint8_t*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            ::CloseHandle(mapping);
+        }
+        ::CloseHandle(file);
+        if (m_size > 0 && m_data == nullptr)
+        {
+            throw std::runtime_error("Failed to map file: " + path.string());
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Failed to open file: " + path.string());
+        }
+        struct stat file_stat;
+        if (::fstat(fd, &file_stat) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("Failed to get the size of file: " + path.string());
+        }
+        m_size = static_cast<size_t>(file_stat.st_size);
+        if (m_size > 0)
+        {
+            void* address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("Failed to map file: " + path.string());
+            }
+            m_data = static_cast<const uint8_t*>(address);
+        }
+        // The mapping remains valid once the file descriptor is closed
+        ::close(fd);
+#endif
+    }
+
+    memory_mapped_file::~memory_mapped_file()
+    {
+        unmap();
+    }
+
+    memory_mapped_file::memory_mapped_file(memory_mapped_file&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+    {
+    }
+
+    memory_mapped_file& memory_mapped_file::operator=(memory_mapped_file&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    std::span<const uint8_t> memory_mapped_file::data() const noexcept
+    {
+        return {m_data, m_size};
+    }
+
+    size_t memory_mapped_file::size() const noexcept
+    {
+        return m_size;
+    }
+
+    void memory_mapped_file::unmap() noexcept
+    {
+        if (m_data == nullptr)
+        {
+            return;
+        }
+#if defined(_WIN32)
+        ::UnmapViewOfFile(m_data);
+#else
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
@@ -0,0 +1,131 @@
+#include "sparrow_ipc/message_index.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "sparrow_ipc/encapsulated_message.hpp"
+#include "sparrow_ipc/magic_values.hpp"
+
+#include "compression_impl.hpp"
+
+namespace sparrow_ipc
+{
+    namespace
+    {
+        // Offset of the first message of a stream, after the leading magic bytes of a file
+        size_t first_message_offset(std::span<const uint8_t> data)
+        {
+            return is_arrow_file_magic(data) ? std::min(data.size(), arrow_file_header_magic.size()) : 0;
+        }
+
+        bool is_end_of_stream_at(std::span<const uint8_t> data, size_t offset)
+        {
+            return data.size() - offset >= end_of_stream.size()
+                   && is_end_of_stream(data.subspan(offset, end_of_stream.size()));
+        }
+
+        // Calls `visit(message, offset)` for each message up to the end-of-stream marker or the
+        // end of `data`, until it returns false. Returns the offset of the end of the last message.
+        template <typename Visit>
+        size_t for_each_message(std::span<const uint8_t> data, bool verify, Visit&& visit)
+        {
+            size_t offset = first_message_offset(data);
+            while (offset < data.size() && !is_end_of_stream_at(data, offset))
+            {
+                const encapsulated_message message = extract_encapsulated_message(data.subspan(offset), verify)
+                                                         .first;
+                if (!visit(message, offset))
+                {
+                    break;
+                }
+                offset += message.total_length();
+            }
+            return offset;
+        }
+
+        message_info make_message_info(const encapsulated_message& message, size_t offset)
+        {
+            const auto* flat_buffer_message = message.flat_buffer_message();
+            const size_t header_size = encapsulated_message_header_size(message.metadata_length());
+            message_info info{
+                .offset = offset,
+                .type = flat_buffer_message->header_type(),
+                .metadata_length = static_cast<int32_t>(header_size),
+                .body_length = static_cast<int64_t>(message.body_length())
+            };
+            const org::apache::arrow::flatbuf::RecordBatch* record_batch = nullptr;
+            if (const auto* dictionary_batch = flat_buffer_message->header_as_DictionaryBatch())
+            {
+                info.dictionary_id = dictionary_batch->id();
+                info.is_delta = dictionary_batch->isDelta();
+                record_batch = dictionary_batch->data();
+            }
+            else
+            {
+                record_batch = flat_buffer_message->header_as_RecordBatch();
+            }
+            if (record_batch != nullptr)
+            {
+                info.num_rows = record_batch->length();
+                if (record_batch->compression() != nullptr)
+                {
+                    info.compression = details::from_fb_compression_type(record_batch->compression()->codec());
+                }
+            }
+            return info;
+        }
+    }
+
+    message_index scan_stream(std::span<const uint8_t> data, bool verify)
+    {
+        message_index index;
+        index.end_offset = for_each_message(
+            data,
+            verify,
+            [&index](const encapsulated_message& message, size_t offset)
+            {
+                index.messages.push_back(make_message_info(message, offset));
+                return true;
+            }
+        );
+        index.has_end_of_stream = is_end_of_stream_at(data, index.end_offset);
+        return index;
+    }
+
+    int64_t count_rows(std::span<const uint8_t> data, bool verify)
+    {
+        int64_t rows = 0;
+        for_each_message(
+            data,
+            verify,
+            [&rows](const encapsulated_message& message, size_t)
+            {
+                if (const auto* record_batch = message.flat_buffer_message()->header_as_RecordBatch())
+                {
+                    rows += record_batch->length();
+                }
+                return true;
+            }
+        );
+        return rows;
+    }
+
+    decoded_schema read_schema(std::span<const uint8_t> data, const read_options& options)
+    {
+        const org::apache::arrow::flatbuf::Schema* schema = nullptr;
+        for_each_message(
+            data,
+            options.validation != validation_level::none,
+            [&schema](const encapsulated_message& message, size_t)
+            {
+                schema = message.flat_buffer_message()->header_as_Schema();
+                return false;
+            }
+        );
+        if (schema == nullptr)
+        {
+            throw std::runtime_error("Stream does not start with a Schema message.");
+        }
+        return decode_schema(*schema, options);
+    }
+}
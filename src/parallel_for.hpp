@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sparrow_ipc::details
+{
+    /**
+     * @brief Computes the number of threads to use for `task_count` independent tasks.
+     *
+     * @param requested The requested number of threads, 0 meaning the hardware concurrency
+     * @param task_count The number of tasks
+     */
+    [[nodiscard]] inline size_t resolve_thread_count(size_t requested, size_t task_count)
+    {
+        const size_t thread_count = requested == 0
+                                        ? std::max<size_t>(1, std::thread::hardware_concurrency())
+                                        : requested;
+        return std::min(thread_count, task_count);
+    }
+
+    /**
+     * @brief Computes the number of threads requested for the tasks run by each of the tasks
+     *        spread over `outer_thread_count` threads.
+     *
+     * The hardware concurrency, requested with 0, is already used by the outer tasks when they
+     * run on several threads: the nested tasks then run on the thread of their outer task.
+     * Explicit requests are kept, so that the number of threads multiplies.
+     */
+    [[nodiscard]] inline size_t resolve_nested_thread_count(size_t requested, size_t outer_thread_count)
+    {
+        return requested == 0 && outer_thread_count > 1 ? 1 : requested;
+    }
+
+    /**
+     * @brief Calls `fn(i)` for each i in [0, count), spreading the calls over `num_threads` threads.
+     *
+     * The calling thread takes part in the work. Tasks are handed out dynamically, so that
+     * uneven task costs are balanced between the threads. If some calls throw, the remaining
+     * tasks are skipped and the exception of the lowest index is rethrown once all threads
+     * are joined. If a thread cannot be started, the tasks are spread over the threads
+     * already started.
+     */
+    template <std::invocable<size_t> F>
+    void parallel_for(size_t count, size_t num_threads, F&& fn)
+    {
+        const size_t thread_count = resolve_thread_count(num_threads, count);
+        if (thread_count <= 1)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                fn(i);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next_index{0};
+        std::atomic<bool> failed{false};
+        std::mutex error_mutex;
+        std::exception_ptr error;
+        size_t error_index = std::numeric_limits<size_t>::max();
+
+        const auto worker = [&]()
+        {
+            while (!failed.load(std::memory_order_relaxed))
+            {
+                const size_t i = next_index.fetch_add(1, std::memory_order_relaxed);
+                if (i >= count)
+                {
+                    return;
+                }
+                try
+                {
+                    fn(i);
+                }
+                catch (...)
+                {
+                    const std::lock_guard<std::mutex> lock(error_mutex);
+                    if (i < error_index)
+                    {
+                        error_index = i;
+                        error = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count - 1);
+        for (size_t i = 1; i < thread_count; ++i)
+        {
+            try
+            {
+                threads.emplace_back(worker);
+            }
+            catch (const std::system_error&)
+            {
+                // Out of thread resources: the threads already started and the calling thread
+                // take the remaining tasks
+                break;
+            }
+        }
+        worker();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * @brief Returns the vector of `fn(i)` for i in [0, count), computed on `num_threads` threads.
+     *
+     * The results are in index order, whatever the order in which they were computed.
+     */
+    template <std::invocable<size_t> F>
+    [[nodiscard]] auto parallel_transform(size_t count, size_t num_threads, F&& fn)
+    {
+        using result_type = std::invoke_result_t<F&, size_t>;
+        std::vector<std::optional<result_type>> results(count);
+        parallel_for(
+            count,
+            num_threads,
+            [&](size_t i)
+            {
+                results[i].emplace(fn(i));
+            }
+        );
+        std::vector<result_type> values;
+        values.reserve(count);
+        for (auto& result : results)
+        {
+            values.push_back(std::move(*result));
+        }
+        return values;
+    }
+}
@@ -0,0 +1,329 @@
+#include "run_end_encoding.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <sparrow/buffer/buffer.hpp>
+
+#include "sparrow_ipc/buffer_pool.hpp"
+
+namespace sparrow_ipc::details
+{
+    namespace
+    {
+        sparrow::buffer<uint8_t> make_buffer(size_t size)
+        {
+            return sparrow::buffer<uint8_t>(size, pool_allocator<uint8_t>());
+        }
+
+        sparrow::buffer<uint8_t> make_zeroed_bitmap(size_t length)
+        {
+            sparrow::buffer<uint8_t> bitmap = make_buffer((length + 7) / 8);
+            std::fill(bitmap.begin(), bitmap.end(), uint8_t{0});
+            return bitmap;
+        }
+
+        bool get_bit(const uint8_t* bitmap, size_t index)
+        {
+            return ((bitmap[index / 8] >> (index % 8)) & 1) != 0;
+        }
+
+        // Sets the bits [begin, end) of a bitmap, whole bytes at a time inside the range
+        void set_bits(uint8_t* bitmap, size_t begin, size_t end)
+        {
+            for (; begin < end && begin % 8 != 0; ++begin)
+            {
+                bitmap[begin / 8] = static_cast<uint8_t>(bitmap[begin / 8] | (1u << (begin % 8)));
+            }
+            if (begin + 8 <= end)
+            {
+                std::fill(bitmap + begin / 8, bitmap + end / 8, uint8_t{0xFF});
+                begin = end / 8 * 8;
+            }
+            for (; begin < end; ++begin)
+            {
+                bitmap[begin / 8] = static_cast<uint8_t>(bitmap[begin / 8] | (1u << (begin % 8)));
+            }
+        }
+
+        // Calls `fill(run, begin, end)` for each run, clamped to [0, length)
+        template <std::signed_integral RunEndType, class F>
+        void for_each_run(std::span<const RunEndType> run_ends, size_t run_count, size_t length, F&& fill)
+        {
+            size_t begin = 0;
+            for (size_t run = 0; run < run_count && begin < length; ++run)
+            {
+                const auto run_end = static_cast<int64_t>(run_ends[run]);
+                const size_t end = run_end <= static_cast<int64_t>(begin)
+                                       ? begin
+                                       : std::min(static_cast<size_t>(run_end), length);
+                fill(run, begin, end);
+                begin = end;
+            }
+        }
+
+        template <class T, std::signed_integral RunEndType>
+        void fill_fixed_width_runs(
+            std::span<const RunEndType> run_ends,
+            size_t run_count,
+            size_t length,
+            const uint8_t* values,
+            uint8_t* output
+        )
+        {
+            T* typed_output = reinterpret_cast<T*>(output);
+            for_each_run(
+                run_ends,
+                run_count,
+                length,
+                [&](size_t run, size_t begin, size_t end)
+                {
+                    T value;
+                    std::memcpy(&value, values + run * sizeof(T), sizeof(T));
+                    std::fill(typed_output + begin, typed_output + end, value);
+                }
+            );
+        }
+
+        template <std::signed_integral RunEndType>
+        sparrow::buffer<uint8_t> expand_fixed_width(
+            std::span<const RunEndType> run_ends,
+            size_t run_count,
+            size_t length,
+            const uint8_t* values,
+            size_t value_width
+        )
+        {
+            sparrow::buffer<uint8_t> output = make_buffer(length * value_width);
+            std::fill(output.begin(), output.end(), uint8_t{0});
+            switch (value_width)
+            {
+                case 1:
+                    fill_fixed_width_runs<uint8_t>(run_ends, run_count, length, values, output.data());
+                    break;
+                case 2:
+                    fill_fixed_width_runs<uint16_t>(run_ends, run_count, length, values, output.data());
+                    break;
+                case 4:
+                    fill_fixed_width_runs<uint32_t>(run_ends, run_count, length, values, output.data());
+                    break;
+                case 8:
+                    fill_fixed_width_runs<uint64_t>(run_ends, run_count, length, values, output.data());
+                    break;
+                default:
+                    for_each_run(
+                        run_ends,
+                        run_count,
+                        length,
+                        [&](size_t run, size_t begin, size_t end)
+                        {
+                            const uint8_t* value = values + run * value_width;
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                                std::memcpy(output.data() + i * value_width, value, value_width);
+                            }
+                        }
+                    );
+                    break;
+            }
+            return output;
+        }
+
+        template <std::signed_integral RunEndType>
+        sparrow::buffer<uint8_t> expand_bitmap(
+            std::span<const RunEndType> run_ends,
+            size_t run_count,
+            size_t length,
+            const uint8_t* values
+        )
+        {
+            sparrow::buffer<uint8_t> output = make_zeroed_bitmap(length);
+            for_each_run(
+                run_ends,
+                run_count,
+                length,
+                [&](size_t run, size_t begin, size_t end)
+                {
+                    if (get_bit(values, run))
+                    {
+                        set_bits(output.data(), begin, end);
+                    }
+                }
+            );
+            return output;
+        }
+
+        template <std::signed_integral OffsetType, std::signed_integral RunEndType>
+        std::pair<sparrow::buffer<uint8_t>, sparrow::buffer<uint8_t>> expand_binary(
+            std::span<const RunEndType> run_ends,
+            size_t run_count,
+            size_t length,
+            const uint8_t* values_offsets,
+            const uint8_t* values_data
+        )
+        {
+            const auto* offsets = reinterpret_cast<const OffsetType*>(values_offsets);
+            size_t data_size = 0;
+            for_each_run(
+                run_ends,
+                run_count,
+                length,
+                [&](size_t run, size_t begin, size_t end)
+                {
+                    data_size += (end - begin) * static_cast<size_t>(offsets[run + 1] - offsets[run]);
+                }
+            );
+
+            sparrow::buffer<uint8_t> output_offsets = make_buffer((length + 1) * sizeof(OffsetType));
+            sparrow::buffer<uint8_t> output_data = make_buffer(data_size);
+            auto* typed_offsets = reinterpret_cast<OffsetType*>(output_offsets.data());
+            typed_offsets[0] = 0;
+            OffsetType offset = 0;
+            size_t covered = 0;
+            for_each_run(
+                run_ends,
+                run_count,
+                length,
+                [&](size_t run, size_t begin, size_t end)
+                {
+                    const auto value_size = static_cast<size_t>(offsets[run + 1] - offsets[run]);
+                    const uint8_t* value = values_data + offsets[run];
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        std::memcpy(output_data.data() + offset, value, value_size);
+                        offset += static_cast<OffsetType>(value_size);
+                        typed_offsets[i + 1] = offset;
+                    }
+                    covered = end;
+                }
+            );
+            // Values not covered by the runs are empty
+            std::fill(typed_offsets + covered + 1, typed_offsets + length + 1, offset);
+            return {std::move(output_offsets), std::move(output_data)};
+        }
+
+        const uint8_t* get_buffer(const ArrowArray& array, int64_t index)
+        {
+            return index < array.n_buffers ? static_cast<const uint8_t*>(array.buffers[index]) : nullptr;
+        }
+    }
+
+    template <std::signed_integral RunEndType>
+    void check_run_ends(std::span<const RunEndType> run_ends, int64_t length, std::string_view field_name)
+    {
+        if (length == 0)
+        {
+            return;
+        }
+        unsigned not_increasing = run_ends.empty() || run_ends[0] <= 0 ? 1u : 0u;
+        for (size_t i = 1; i < run_ends.size(); ++i)
+        {
+            not_increasing |= static_cast<unsigned>(run_ends[i] <= run_ends[i - 1]);
+        }
+        if (not_increasing != 0 || static_cast<int64_t>(run_ends.back()) < length)
+        {
+            throw std::runtime_error(
+                "Invalid run ends in field '" + std::string(field_name)
+                + "': they must be positive, strictly increasing and cover the " + std::to_string(length)
+                + " values of the array"
+            );
+        }
+    }
+
+    template <std::signed_integral RunEndType>
+    expanded_runs expand_runs(
+        std::span<const RunEndType> run_ends,
+        const ArrowArray& values,
+        run_values_layout layout,
+        size_t value_width,
+        int64_t length
+    )
+    {
+        const auto logical_length = static_cast<size_t>(length);
+        // A run without a value is ignored
+        const size_t run_count = std::min(
+            run_ends.size(),
+            static_cast<size_t>(std::max<int64_t>(values.length, 0))
+        );
+        expanded_runs result;
+
+        const uint8_t* values_validity = values.null_count == 0 ? nullptr : get_buffer(values, 0);
+        if (values_validity == nullptr)
+        {
+            result.buffers.emplace_back(std::span<const uint8_t>{});
+        }
+        else
+        {
+            sparrow::buffer<uint8_t> validity = make_zeroed_bitmap(logical_length);
+            size_t valid_count = 0;
+            for_each_run(
+                run_ends,
+                run_count,
+                logical_length,
+                [&](size_t run, size_t begin, size_t end)
+                {
+                    if (get_bit(values_validity, run))
+                    {
+                        set_bits(validity.data(), begin, end);
+                        valid_count += end - begin;
+                    }
+                }
+            );
+            result.null_count = length - static_cast<int64_t>(valid_count);
+            result.buffers.emplace_back(std::move(validity));
+        }
+
+        switch (layout)
+        {
+            case run_values_layout::bitmap:
+                result.buffers.emplace_back(
+                    expand_bitmap(run_ends, run_count, logical_length, get_buffer(values, 1))
+                );
+                break;
+            case run_values_layout::fixed_width:
+                result.buffers.emplace_back(
+                    expand_fixed_width(run_ends, run_count, logical_length, get_buffer(values, 1), value_width)
+                );
+                break;
+            case run_values_layout::binary:
+            case run_values_layout::large_binary:
+            {
+                auto [offsets, data] = layout == run_values_layout::binary
+                                           ? expand_binary<int32_t>(
+                                                 run_ends,
+                                                 run_count,
+                                                 logical_length,
+                                                 get_buffer(values, 1),
+                                                 get_buffer(values, 2)
+                                             )
+                                           : expand_binary<int64_t>(
+                                                 run_ends,
+                                                 run_count,
+                                                 logical_length,
+                                                 get_buffer(values, 1),
+                                                 get_buffer(values, 2)
+                                             );
+                result.buffers.emplace_back(std::move(offsets));
+                result.buffers.emplace_back(std::move(data));
+                break;
+            }
+            case run_values_layout::unsupported:
+                throw std::runtime_error("The values of this run-end encoded array cannot be expanded");
+        }
+        return result;
+    }
+
+    template void check_run_ends<int16_t>(std::span<const int16_t>, int64_t, std::string_view);
+    template void check_run_ends<int32_t>(std::span<const int32_t>, int64_t, std::string_view);
+    template void check_run_ends<int64_t>(std::span<const int64_t>, int64_t, std::string_view);
+
+    template expanded_runs
+    expand_runs<int16_t>(std::span<const int16_t>, const ArrowArray&, run_values_layout, size_t, int64_t);
+    template expanded_runs
+    expand_runs<int32_t>(std::span<const int32_t>, const ArrowArray&, run_values_layout, size_t, int64_t);
+    template expanded_runs
+    expand_runs<int64_t>(std::span<const int64_t>, const ArrowArray&, run_values_layout, size_t, int64_t);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <sparrow/c_interface.hpp>
+
+#include "sparrow_ipc/arrow_interface/arrow_array/private_data.hpp"
+
+namespace sparrow_ipc::details
+{
+    /**
+     * @brief Layout of the values of a run-end encoded array, telling how to expand it.
+     */
+    enum class run_values_layout
+    {
+        // The values cannot be expanded (nested, null or dictionary-encoded values)
+        unsupported,
+        // Boolean values, stored in a bitmap
+        bitmap,
+        // Values of a fixed number of bytes
+        fixed_width,
+        // Variable-size values with 32-bit offsets
+        binary,
+        // Variable-size values with 64-bit offsets
+        large_binary
+    };
+
+    /**
+     * @brief Buffers of a run-end encoded array expanded into the layout of its values.
+     */
+    struct expanded_runs
+    {
+        std::vector<arrow_array_private_data::optionally_owned_buffer> buffers;
+        int64_t null_count = 0;
+    };
+
+    /**
+     * @brief Checks that run ends are positive, strictly increasing and cover the array.
+     *
+     * @param run_ends The run ends child of the array
+     * @param length The logical length of the array
+     * @param field_name The name of the field, for the error message
+     *
+     * @throws std::runtime_error If the run ends are invalid
+     */
+    template <std::signed_integral RunEndType>
+    void check_run_ends(std::span<const RunEndType> run_ends, int64_t length, std::string_view field_name);
+
+    /**
+     * @brief Expands a run-end encoded array into the dense layout of its values.
+     *
+     * The value of each run is repeated over the run, with a fill specialized on the width of the
+     * values that the compiler vectorizes. The runs are clamped to the logical length of the array,
+     * so that invalid run ends cannot write outside of the expanded buffers.
+     *
+     * @param run_ends The run ends child of the array
+     * @param values The values child of the array, holding one value per run, without offset
+     * @param layout The layout of the values
+     * @param value_width The size in bytes of a value, for the fixed-width layout
+     * @param length The logical length of the array
+     * @return The validity buffer, empty when no value is null, followed by the buffers of the
+     *         values layout, allocated from the default buffer pool
+     */
+    template <std::signed_integral RunEndType>
+    [[nodiscard]] expanded_runs expand_runs(
+        std::span<const RunEndType> run_ends,
+        const ArrowArray& values,
+        run_values_layout layout,
+        size_t value_width,
+        int64_t length
+    );
+
+    extern template void check_run_ends<int16_t>(std::span<const int16_t>, int64_t, std::string_view);
+    extern template void check_run_ends<int32_t>(std::span<const int32_t>, int64_t, std::string_view);
+    extern template void check_run_ends<int64_t>(std::span<const int64_t>, int64_t, std::string_view);
+
+    extern template expanded_runs
+    expand_runs<int16_t>(std::span<const int16_t>, const ArrowArray&, run_values_layout, size_t, int64_t);
+    extern template expanded_runs
+    expand_runs<int32_t>(std::span<const int32_t>, const ArrowArray&, run_values_layout, size_t, int64_t);
+    extern template expanded_runs
+    expand_runs<int64_t>(std::span<const int64_t>, const ArrowArray&, run_values_layout, size_t, int64_t);
+}
@@ -2,12 +2,32 @@
 
 #include <cstdint>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "sparrow_ipc/flatbuffer_utils.hpp"
 #include "sparrow_ipc/utils.hpp"
 
+#include "byte_swap.hpp"
+
 namespace sparrow_ipc
 {
+    namespace
+    {
+        // Copy of a record batch with the byte order of its buffers reversed
+        sparrow::record_batch byte_swapped(const sparrow::record_batch& record_batch)
+        {
+            const auto names = record_batch.names();
+            std::vector<std::string> names_copy(names.begin(), names.end());
+            std::vector<sparrow::array> columns;
+            for (const auto& column : record_batch.columns())
+            {
+                columns.push_back(details::byte_swapped(column));
+            }
+            return sparrow::record_batch(std::move(names_copy), std::move(columns));
+        }
+    }
+
     void common_serialize(const flatbuffers::FlatBufferBuilder& builder, any_output_stream& stream)
     {
         stream.write(continuation);
@@ -22,18 +42,31 @@ namespace sparrow_ipc
         stream.add_padding();
     }
 
-    void serialize_schema_message(const sparrow::record_batch& record_batch, any_output_stream& stream)
+    void serialize_schema_message(
+        const sparrow::record_batch& record_batch,
+        any_output_stream& stream,
+        std::endian byte_order
+    )
     {
-        common_serialize(get_schema_message_builder(record_batch), stream);
+        common_serialize(get_schema_message_builder(record_batch, byte_order), stream);
     }
 
     serialized_record_batch_info serialize_record_batch(
         const sparrow::record_batch& record_batch,
         any_output_stream& stream,
         std::optional<CompressionType> compression,
-        std::optional<std::reference_wrapper<CompressionCache>> cache
+        std::optional<std::reference_wrapper<CompressionCache>> cache,
+        std::endian byte_order
     )
     {
+        if (byte_order != std::endian::native)
+        {
+            // The cache is keyed by buffer address: it must not outlive the converted copy
+            const sparrow::record_batch swapped = byte_swapped(record_batch);
+            CompressionCache compressed_buffers_cache;
+            return serialize_record_batch(swapped, stream, compression, compressed_buffers_cache);
+        }
+
         // Build and serialize metadata
         flatbuffers::FlatBufferBuilder builder = get_record_batch_message_builder(record_batch, compression, cache);
 
@@ -63,4 +96,63 @@ namespace sparrow_ipc
         const auto metadata_length = static_cast<int32_t>(utils::align_to_8(prefix_size + flatbuffer_size));
         return {.metadata_length = metadata_length, .body_length = body_length};
     }
+
+    serialized_record_batch_info serialize_dictionary_batch(
+        const dictionary_batch& dictionary,
+        any_output_stream& stream,
+        std::optional<CompressionType> compression,
+        std::endian byte_order
+    )
+    {
+        if (byte_order != std::endian::native)
+        {
+            const dictionary_batch swapped{
+                .id = dictionary.id,
+                .values = details::byte_swapped(dictionary.values),
+                .is_delta = dictionary.is_delta
+            };
+            return serialize_dictionary_batch(swapped, stream, compression);
+        }
+
+        // The cache is keyed by buffer address: it must not outlive the values of a delta
+        CompressionCache compressed_buffers_cache;
+        flatbuffers::FlatBufferBuilder builder = get_dictionary_batch_message_builder(
+            dictionary,
+            compression,
+            compressed_buffers_cache
+        );
+        common_serialize(builder, stream);
+
+        const size_t body_start = stream.size();
+        fill_body(
+            sparrow::detail::array_access::get_arrow_proxy(dictionary.values),
+            stream,
+            compression,
+            compressed_buffers_cache
+        );
+
+        const auto body_length = static_cast<int64_t>(stream.size() - body_start);
+        const size_t prefix_size = continuation.size() + sizeof(uint32_t);
+        const auto metadata_length = static_cast<int32_t>(utils::align_to_8(prefix_size + builder.GetSize()));
+        return {.metadata_length = metadata_length, .body_length = body_length};
+    }
+
+    void serialize_tensor(const tensor_view& tensor, any_output_stream& stream)
+    {
+        check_tensor(tensor);
+        common_serialize(get_tensor_message_builder(tensor), stream);
+        stream.write(tensor.data);
+        stream.add_padding();
+    }
+
+    void serialize_sparse_tensor(const sparse_tensor_view& tensor, any_output_stream& stream)
+    {
+        check_sparse_tensor(tensor);
+        common_serialize(get_sparse_tensor_message_builder(tensor), stream);
+        for (const auto buffer : details::sparse_tensor_body_buffers(tensor))
+        {
+            stream.write(buffer);
+            stream.add_padding();
+        }
+    }
 }
@@ -13,14 +13,14 @@ namespace sparrow_ipc
                    std::optional<CompressionType> compression,
                    std::optional<std::reference_wrapper<CompressionCache>> cache)
     {
-        std::for_each(arrow_proxy.buffers().begin(), arrow_proxy.buffers().end(), [&](const auto& buffer) {
+        details::for_each_body_buffer(arrow_proxy, [&](std::span<const uint8_t> buffer) {
             if (compression.has_value())
             {
                 if (!cache)
                 {
                     throw std::invalid_argument("Compression type set but no cache is given.");
                 }
-                auto compressed_buffer_with_header = compress(compression.value(), std::span<const uint8_t>(buffer.data(), buffer.size()), cache.value().get());
+                auto compressed_buffer_with_header = compress(compression.value(), buffer, cache.value().get());
                 stream.write(compressed_buffer_with_header);
             }
             else
@@ -45,10 +45,10 @@ namespace sparrow_ipc
         });
     }
 
-    std::size_t calculate_schema_message_size(const sparrow::record_batch& record_batch)
+    std::size_t calculate_schema_message_size(const sparrow::record_batch& record_batch, std::endian byte_order)
     {
         // Build the schema message to get its exact size
-        flatbuffers::FlatBufferBuilder schema_builder = get_schema_message_builder(record_batch);
+        flatbuffers::FlatBufferBuilder schema_builder = get_schema_message_builder(record_batch, byte_order);
         const flatbuffers::uoffset_t schema_len = schema_builder.GetSize();
 
         // Calculate total size:
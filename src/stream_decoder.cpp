@@ -0,0 +1,172 @@
+#include "sparrow_ipc/stream_decoder.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace sparrow_ipc
+{
+    stream_decoder::stream_decoder(record_batch_callback callback, read_options options)
+        : m_callback(std::move(callback))
+        , m_options(std::move(options))
+    {
+        if (!m_callback)
+        {
+            throw std::invalid_argument("stream_decoder requires a valid callback.");
+        }
+    }
+
+    bool stream_decoder::fill(std::span<uint8_t> destination, std::span<const uint8_t>& fragment)
+    {
+        const size_t count = std::min(destination.size() - m_filled, fragment.size());
+        std::copy_n(fragment.begin(), count, destination.begin() + static_cast<std::ptrdiff_t>(m_filled));
+        fragment = fragment.subspan(count);
+        m_filled += count;
+        if (m_filled < destination.size())
+        {
+            return false;
+        }
+        m_filled = 0;
+        return true;
+    }
+
+    void stream_decoder::consume(std::span<const uint8_t> fragment)
+    {
+        while (!fragment.empty())
+        {
+            switch (m_state)
+            {
+                case decoder_state::prefix:
+                    if (fill(m_prefix, fragment))
+                    {
+                        on_prefix_complete();
+                    }
+                    break;
+                case decoder_state::metadata:
+                    if (fill(std::span<uint8_t>(*m_message).first(m_header_size), fragment))
+                    {
+                        on_metadata_complete();
+                    }
+                    break;
+                case decoder_state::body:
+                    if (fill(*m_message, fragment))
+                    {
+                        on_message_complete();
+                    }
+                    break;
+                case decoder_state::end:
+                    throw std::runtime_error("Data received after the end of the stream.");
+            }
+        }
+    }
+
+    void stream_decoder::on_prefix_complete()
+    {
+        const std::optional<size_t> metadata_length = parse_message_prefix(m_prefix);
+        if (!metadata_length.has_value())
+        {
+            m_state = decoder_state::end;
+            return;
+        }
+        m_header_size = encapsulated_message_header_size(*metadata_length);
+        m_message = std::make_shared<pooled_byte_vector>(m_header_size);
+        std::ranges::copy(m_prefix, m_message->begin());
+        m_filled = m_prefix.size();
+        m_state = decoder_state::metadata;
+    }
+
+    void stream_decoder::on_metadata_complete()
+    {
+        const encapsulated_message header(*m_message);
+        if (m_options.validation != validation_level::none)
+        {
+            header.verify();
+        }
+        const size_t body_length = header.body_length();
+        if (body_length == 0)
+        {
+            on_message_complete();
+            return;
+        }
+        m_message->resize(m_header_size + body_length);
+        m_filled = m_header_size;
+        m_state = decoder_state::body;
+    }
+
+    void stream_decoder::on_message_complete()
+    {
+        // Reset the state before decoding, so that the decoder remains usable
+        // if the message is rejected or if the callback throws.
+        message_buffer message = std::move(m_message);
+        m_state = decoder_state::prefix;
+        m_filled = 0;
+
+        const encapsulated_message encapsulated(*message);
+        const auto* fb_message = encapsulated.flat_buffer_message();
+        switch (fb_message->header_type())
+        {
+            case org::apache::arrow::flatbuf::MessageHeader::Schema:
+                if (m_schema.has_value())
+                {
+                    throw std::runtime_error("Unexpected Schema message after the start of the stream.");
+                }
+                m_schema = decode_schema(*fb_message->header_as_Schema(), m_options);
+                m_schema_message = std::move(message);
+                break;
+            case org::apache::arrow::flatbuf::MessageHeader::RecordBatch:
+                if (!m_schema.has_value())
+                {
+                    throw std::runtime_error("RecordBatch encountered before Schema message.");
+                }
+                m_callback(decode_record_batch(encapsulated, *m_schema, std::move(message)));
+                break;
+            case org::apache::arrow::flatbuf::MessageHeader::DictionaryBatch:
+                if (!m_schema.has_value())
+                {
+                    throw std::runtime_error("DictionaryBatch encountered before Schema message.");
+                }
+                decode_dictionary_batch(encapsulated, *m_schema, std::move(message));
+                break;
+            case org::apache::arrow::flatbuf::MessageHeader::Tensor:
+            case org::apache::arrow::flatbuf::MessageHeader::SparseTensor:
+                throw std::runtime_error("Unsupported message type: Tensor or SparseTensor");
+            default:
+                throw std::runtime_error("Unknown message header type.");
+        }
+    }
+
+    size_t stream_decoder::next_required_size() const noexcept
+    {
+        switch (m_state)
+        {
+            case decoder_state::prefix:
+                return m_prefix.size() - m_filled;
+            case decoder_state::metadata:
+                return m_header_size - m_filled;
+            case decoder_state::body:
+                return m_message->size() - m_filled;
+            case decoder_state::end:
+                return 0;
+        }
+        return 0;
+    }
+
+    bool stream_decoder::has_schema() const noexcept
+    {
+        return m_schema.has_value();
+    }
+
+    const std::vector<std::string>& stream_decoder::names() const
+    {
+        if (!m_schema.has_value())
+        {
+            throw std::runtime_error("The Schema message has not been decoded yet.");
+        }
+        return m_schema->field_names;
+    }
+
+    bool stream_decoder::ended() const noexcept
+    {
+        return m_state == decoder_state::end;
+    }
+}
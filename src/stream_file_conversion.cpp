@@ -0,0 +1,94 @@
+#include "sparrow_ipc/stream_file_conversion.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "sparrow_ipc/encapsulated_message.hpp"
+#include "sparrow_ipc/magic_values.hpp"
+#include "sparrow_ipc/message_index.hpp"
+#include "sparrow_ipc/stream_file_serializer.hpp"
+
+#include "file_footer.hpp"
+
+namespace sparrow_ipc
+{
+    namespace
+    {
+        using org::apache::arrow::flatbuf::MessageHeader;
+
+        // Checks that the index starts with a Schema message, and returns that message
+        encapsulated_message schema_message(std::span<const uint8_t> data, const message_index& index)
+        {
+            if (index.messages.empty() || index.messages.front().type != MessageHeader::Schema)
+            {
+                throw std::runtime_error("Stream does not start with a Schema message.");
+            }
+            return extract_encapsulated_message(data.subspan(index.messages.front().offset)).first;
+        }
+    }
+
+    void stream_to_file(std::span<const uint8_t> stream_data, any_output_stream& output, bool verify)
+    {
+        const message_index index = scan_stream(stream_data, verify);
+        const encapsulated_message schema = schema_message(stream_data, index);
+
+        // The messages keep their relative offsets, shifted by the leading magic bytes of the file
+        const size_t stream_offset = index.messages.front().offset;
+        const auto file_offset = [stream_offset](size_t offset)
+        {
+            return static_cast<int64_t>(arrow_file_header_magic.size() + offset - stream_offset);
+        };
+        std::vector<record_batch_block> record_batch_blocks;
+        std::vector<record_batch_block> dictionary_blocks;
+        for (size_t i = 1; i < index.messages.size(); ++i)
+        {
+            const message_info& info = index.messages[i];
+            const record_batch_block block{file_offset(info.offset), info.metadata_length, info.body_length};
+            switch (info.type)
+            {
+                case MessageHeader::RecordBatch:
+                    record_batch_blocks.push_back(block);
+                    break;
+                case MessageHeader::DictionaryBatch:
+                    dictionary_blocks.push_back(block);
+                    break;
+                default:
+                    throw std::runtime_error(
+                        "Cannot convert to a file a stream holding a message of type "
+                        + std::string(org::apache::arrow::flatbuf::EnumNameMessageHeader(info.type))
+                    );
+            }
+        }
+
+        const std::span<const uint8_t> messages = stream_data.subspan(
+            stream_offset,
+            index.end_offset - stream_offset
+        );
+        output.reserve(output.size() + arrow_file_header_magic.size() + messages.size() + end_of_stream.size());
+        output.write(arrow_file_header_magic);
+        output.write(messages);
+        output.write(end_of_stream);
+
+        const size_t footer_size = write_footer(schema, record_batch_blocks, output, dictionary_blocks);
+        const int32_t footer_size_i32 = static_cast<int32_t>(footer_size);
+        output.write(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&footer_size_i32), sizeof(int32_t)));
+        output.write(arrow_file_magic);
+    }
+
+    void file_to_stream(std::span<const uint8_t> file_data, any_output_stream& output, bool verify)
+    {
+        const std::span<const uint8_t> stream_portion = details::file_stream_portion(file_data);
+        const message_index index = scan_stream(stream_portion, verify);
+        schema_message(stream_portion, index);
+
+        const size_t stream_offset = index.messages.front().offset;
+        const std::span<const uint8_t> messages = stream_portion.subspan(
+            stream_offset,
+            index.end_offset - stream_offset
+        );
+        output.reserve(output.size() + messages.size() + end_of_stream.size());
+        output.write(messages);
+        output.write(end_of_stream);
+    }
+}
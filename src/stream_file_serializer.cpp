@@ -4,7 +4,8 @@
 
 #include <File_generated.h>
 
-#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/encapsulated_message.hpp"
+#include "sparrow_ipc/file_reader.hpp"
 #include "sparrow_ipc/flatbuffer_utils.hpp"
 #include "sparrow_ipc/magic_values.hpp"
 
@@ -48,7 +49,13 @@ namespace sparrow_ipc
         m_stream.write(end_of_stream);
 
         // Write footer using the first record batch for schema and the tracked blocks
-        const size_t footer_size = write_footer(m_first_record_batch.value(), m_record_batch_blocks, m_stream);
+        const size_t footer_size = write_footer(
+            m_first_record_batch.value(),
+            m_record_batch_blocks,
+            m_stream,
+            m_dictionary_blocks,
+            m_byte_order
+        );
 
         // Write footer size (int32, little-endian)
         const int32_t footer_size_i32 = static_cast<int32_t>(footer_size);
@@ -62,10 +69,56 @@ namespace sparrow_ipc
         m_ended = true;
     }
 
+    namespace
+    {
+        std::vector<org::apache::arrow::flatbuf::Block> to_fb_blocks(const std::vector<record_batch_block>& blocks)
+        {
+            std::vector<org::apache::arrow::flatbuf::Block> fb_blocks;
+            fb_blocks.reserve(blocks.size());
+            for (const auto& block : blocks)
+            {
+                fb_blocks.emplace_back(block.offset, block.metadata_length, block.body_length);
+            }
+            return fb_blocks;
+        }
+
+        // Adds the footer referencing `schema_offset` and the blocks, then writes it
+        size_t finish_footer(
+            flatbuffers::FlatBufferBuilder& footer_builder,
+            flatbuffers::Offset<org::apache::arrow::flatbuf::Schema> schema_offset,
+            const std::vector<record_batch_block>& record_batch_blocks,
+            any_output_stream& stream,
+            const std::vector<record_batch_block>& dictionary_blocks
+        )
+        {
+            auto dictionaries_fb = footer_builder.CreateVectorOfStructs(to_fb_blocks(dictionary_blocks));
+            auto record_batches_fb = footer_builder.CreateVectorOfStructs(to_fb_blocks(record_batch_blocks));
+
+            // Create footer
+            auto footer = org::apache::arrow::flatbuf::CreateFooter(
+                footer_builder,
+                org::apache::arrow::flatbuf::MetadataVersion::V5,
+                schema_offset,
+                dictionaries_fb,
+                record_batches_fb
+            );
+
+            footer_builder.Finish(footer);
+
+            // Write footer
+            const uint8_t* footer_data = footer_builder.GetBufferPointer();
+            const flatbuffers::uoffset_t footer_size = footer_builder.GetSize();
+            stream.write(std::span<const uint8_t>(footer_data, footer_size));
+            return footer_size;
+        }
+    }
+
     size_t write_footer(
         const sparrow::record_batch& record_batch,
         const std::vector<record_batch_block>& record_batch_blocks,
-        any_output_stream& stream
+        any_output_stream& stream,
+        const std::vector<record_batch_block>& dictionary_blocks,
+        std::endian byte_order
     )
     {
         // Build footer using FlatBufferBuilder
@@ -75,87 +128,53 @@ namespace sparrow_ipc
         const auto fields_vec = create_children(footer_builder, record_batch);
         const auto schema_offset = org::apache::arrow::flatbuf::CreateSchema(
             footer_builder,
-            org::apache::arrow::flatbuf::Endianness::Little, // TODO: make configurable
+            to_fb_endianness(byte_order),
             fields_vec
         );
+        return finish_footer(footer_builder, schema_offset, record_batch_blocks, stream, dictionary_blocks);
+    }
 
-        // Create empty dictionaries vector // TODO: Support dictionaries if needed
-        auto dictionaries_fb = footer_builder.CreateVectorOfStructs(
-            std::vector<org::apache::arrow::flatbuf::Block>{}
-        );
-
-        // Create record batches vector from tracked blocks
-        std::vector<org::apache::arrow::flatbuf::Block> fb_blocks;
-        fb_blocks.reserve(record_batch_blocks.size());
-        for (const auto& block : record_batch_blocks)
+    size_t write_footer(
+        const encapsulated_message& schema_message,
+        const std::vector<record_batch_block>& record_batch_blocks,
+        any_output_stream& stream,
+        const std::vector<record_batch_block>& dictionary_blocks
+    )
+    {
+        const auto* schema = schema_message.flat_buffer_message()->header_as_Schema();
+        if (schema == nullptr)
         {
-            fb_blocks.emplace_back(block.offset, block.metadata_length, block.body_length);
+            throw std::runtime_error("Cannot write a footer from a message that is not a Schema message");
         }
-        auto record_batches_fb = footer_builder.CreateVectorOfStructs(fb_blocks);
 
-        // Create footer
-        auto footer = org::apache::arrow::flatbuf::CreateFooter(
-            footer_builder,
-            org::apache::arrow::flatbuf::MetadataVersion::V5,
-            schema_offset,
-            dictionaries_fb,
-            record_batches_fb
+        // FlatBuffers offsets are relative, so the whole metadata of the message is copied into the
+        // footer and the Schema table is referenced where it lies in the copy. The copy starts on an
+        // 8-byte boundary of the footer, as the metadata does in the message.
+        const std::span<const uint8_t> metadata = schema_message.as_span().subspan(
+            encapsulated_message_prefix_size,
+            schema_message.metadata_length()
         );
-
-        footer_builder.Finish(footer);
-
-        // Write footer
-        const uint8_t* footer_data = footer_builder.GetBufferPointer();
-        const flatbuffers::uoffset_t footer_size = footer_builder.GetSize();
-        stream.write(std::span<const uint8_t>(footer_data, footer_size));
-        return footer_size;
+        const auto schema_position = static_cast<size_t>(
+            reinterpret_cast<const uint8_t*>(schema) - metadata.data()
+        );
+        flatbuffers::FlatBufferBuilder footer_builder(metadata.size() + 1024);
+        footer_builder.PreAlign(metadata.size(), sizeof(int64_t));
+        footer_builder.PushBytes(metadata.data(), metadata.size());
+        const flatbuffers::Offset<org::apache::arrow::flatbuf::Schema> schema_offset(
+            static_cast<flatbuffers::uoffset_t>(footer_builder.GetSize() - schema_position)
+        );
+        return finish_footer(footer_builder, schema_offset, record_batch_blocks, stream, dictionary_blocks);
     }
 
     std::vector<sparrow::record_batch> deserialize_file(std::span<const uint8_t> data)
     {
-        // Validate minimum file size
-        // Magic (8) + Footer size (4) + Magic (6) = 18 bytes minimum
-        constexpr size_t min_file_size = 18;
-        if (data.size() < min_file_size)
-        {
-            throw std::runtime_error("File is too small to be a valid Arrow file");
-        }
-
-        // Check magic bytes at the beginning
-        if (!is_arrow_file_magic(data.subspan(0, arrow_file_magic_size)))
-        {
-            throw std::runtime_error("Invalid Arrow file: missing or incorrect magic bytes at start");
-        }
-
-        // Check magic bytes at the end
-        const size_t trailing_magic_offset = data.size() - arrow_file_magic_size;
-        if (!is_arrow_file_magic(data.subspan(trailing_magic_offset, arrow_file_magic_size)))
-        {
-            throw std::runtime_error("Invalid Arrow file: missing or incorrect magic bytes at end");
-        }
-
-        // Read footer size (4 bytes before the trailing magic)
-        const size_t footer_size_offset = data.size() - arrow_file_magic_size - sizeof(int32_t);
-        int32_t footer_size = 0;
-        std::memcpy(&footer_size, data.data() + footer_size_offset, sizeof(int32_t));
-
-        if (footer_size <= 0 || static_cast<size_t>(footer_size) > data.size() - min_file_size)
-        {
-            throw std::runtime_error("Invalid footer size in Arrow file");
-        }
+        return deserialize_file(data, read_options{});
+    }
 
-        // Calculate the end of the stream data (before footer)
-        const size_t footer_offset = footer_size_offset - footer_size;
-        
-        // Extract the stream portion (from after header magic to before footer)
-        // Stream data starts after the 8-byte header magic
-        const size_t stream_start = arrow_file_header_magic.size();
-        const size_t stream_length = footer_offset - stream_start;
-        
-        auto stream_data = data.subspan(stream_start, stream_length);
-        
-        // Use deserialize_stream to parse the stream format data
-        // This handles schema message, record batches, and end-of-stream marker
-        return deserialize_stream(stream_data);
+    std::vector<sparrow::record_batch> deserialize_file(std::span<const uint8_t> data, const read_options& options)
+    {
+        // Record batches are located through the footer blocks rather than by re-parsing
+        // the stream portion of the file
+        return file_reader(data, nullptr, options).read_all(options);
     }
 }
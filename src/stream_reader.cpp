@@ -0,0 +1,146 @@
+#include "sparrow_ipc/stream_reader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+
+#include "sparrow_ipc/encapsulated_message.hpp"
+
+namespace sparrow_ipc
+{
+    namespace
+    {
+        void read_exactly(any_input_stream& stream, std::span<uint8_t> destination, std::string_view what)
+        {
+            if (stream.read(destination) != destination.size())
+            {
+                throw std::runtime_error("Unexpected end of stream while reading " + std::string(what) + ".");
+            }
+        }
+    }
+
+    stream_reader::message_buffer stream_reader::read_message()
+    {
+        if (m_ended)
+        {
+            return nullptr;
+        }
+
+        std::array<uint8_t, encapsulated_message_prefix_size> prefix{};
+        const size_t prefix_size = m_stream.read(prefix);
+        if (prefix_size == 0)
+        {
+            // A stream without end-of-stream marker is still valid
+            m_ended = true;
+            return nullptr;
+        }
+        if (prefix_size != prefix.size())
+        {
+            throw std::runtime_error("Unexpected end of stream while reading a message prefix.");
+        }
+        const std::optional<size_t> metadata_length = parse_message_prefix(prefix);
+        if (!metadata_length.has_value())
+        {
+            m_ended = true;
+            return nullptr;
+        }
+
+        const size_t header_size = encapsulated_message_header_size(*metadata_length);
+        auto buffer = std::make_shared<pooled_byte_vector>(header_size);
+        std::ranges::copy(prefix, buffer->begin());
+        read_exactly(m_stream, std::span<uint8_t>(*buffer).subspan(prefix.size()), "message metadata");
+
+        const encapsulated_message header(*buffer);
+        if (m_options.validation != validation_level::none)
+        {
+            header.verify();
+        }
+        // Throws on negative body lengths and on message sizes overflowing size_t
+        const size_t body_length = header.body_length();
+        if (body_length > 0)
+        {
+            buffer->resize(header_size + body_length);
+            read_exactly(m_stream, std::span<uint8_t>(*buffer).subspan(header_size), "message body");
+        }
+        return buffer;
+    }
+
+    void stream_reader::read_schema()
+    {
+        if (m_schema.has_value())
+        {
+            return;
+        }
+        m_schema_message = read_message();
+        if (m_schema_message == nullptr)
+        {
+            // Empty stream
+            m_schema = decoded_schema{};
+            return;
+        }
+        const auto* message = encapsulated_message(*m_schema_message).flat_buffer_message();
+        if (message->header_type() != org::apache::arrow::flatbuf::MessageHeader::Schema)
+        {
+            throw std::runtime_error("Expected a Schema message at the start of the stream.");
+        }
+        m_schema = decode_schema(*message->header_as_Schema(), m_options);
+    }
+
+    stream_reader::message_buffer stream_reader::read_record_batch_message()
+    {
+        read_schema();
+        while (message_buffer buffer = read_message())
+        {
+            const encapsulated_message message(*buffer);
+            switch (message.flat_buffer_message()->header_type())
+            {
+                case org::apache::arrow::flatbuf::MessageHeader::RecordBatch:
+                    return buffer;
+                case org::apache::arrow::flatbuf::MessageHeader::DictionaryBatch:
+                    // The dictionary keeps its message alive
+                    decode_dictionary_batch(message, *m_schema, buffer);
+                    break;
+                case org::apache::arrow::flatbuf::MessageHeader::Schema:
+                    throw std::runtime_error("Unexpected Schema message after the start of the stream.");
+                case org::apache::arrow::flatbuf::MessageHeader::Tensor:
+                case org::apache::arrow::flatbuf::MessageHeader::SparseTensor:
+                    throw std::runtime_error("Unsupported message type: Tensor or SparseTensor");
+                default:
+                    throw std::runtime_error("Unknown message header type.");
+            }
+        }
+        return nullptr;
+    }
+
+    std::optional<sparrow::record_batch> stream_reader::next()
+    {
+        const message_buffer buffer = read_record_batch_message();
+        if (buffer == nullptr)
+        {
+            return std::nullopt;
+        }
+        return decode_record_batch(encapsulated_message(*buffer), *m_schema, buffer);
+    }
+
+    std::optional<lazy_record_batch> stream_reader::next_lazy()
+    {
+        const message_buffer buffer = read_record_batch_message();
+        if (buffer == nullptr)
+        {
+            return std::nullopt;
+        }
+        return std::make_optional<lazy_record_batch>(encapsulated_message(*buffer), *m_schema, buffer);
+    }
+
+    const std::vector<std::string>& stream_reader::names()
+    {
+        read_schema();
+        return m_schema->field_names;
+    }
+
+    bool stream_reader::ended() const noexcept
+    {
+        return m_ended;
+    }
+}
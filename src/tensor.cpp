@@ -0,0 +1,404 @@
+#include "sparrow_ipc/tensor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace sparrow_ipc
+{
+    namespace
+    {
+        constexpr int64_t max_extent = std::numeric_limits<int64_t>::max();
+
+        bool is_integer_format(std::string_view format)
+        {
+            return format == "c" || format == "C" || format == "s" || format == "S" || format == "i"
+                   || format == "I" || format == "l" || format == "L";
+        }
+
+        // Product of two non-negative values, or std::nullopt on overflow
+        std::optional<int64_t> checked_multiply(int64_t lhs, int64_t rhs)
+        {
+            if (lhs != 0 && rhs > max_extent / lhs)
+            {
+                return std::nullopt;
+            }
+            return lhs * rhs;
+        }
+
+        // Number of bytes spanned by the values of an array of non-negative sizes and strides, the
+        // strides being the row-major ones when empty, or std::nullopt on overflow
+        std::optional<int64_t>
+        byte_extent(std::span<const int64_t> sizes, std::span<const int64_t> strides, int64_t value_size)
+        {
+            if (std::ranges::find(sizes, 0) != sizes.end())
+            {
+                return 0;
+            }
+            std::optional<int64_t> extent = value_size;
+            for (size_t i = 0; i < sizes.size() && extent.has_value(); ++i)
+            {
+                if (strides.empty())
+                {
+                    extent = checked_multiply(*extent, sizes[i]);
+                    continue;
+                }
+                const auto step = checked_multiply(sizes[i] - 1, strides[i]);
+                extent = step.has_value() && *step <= max_extent - *extent ? std::optional(*extent + *step)
+                                                                             : std::nullopt;
+            }
+            return extent;
+        }
+
+        // Reason why an array described by its sizes and strides does not fit in a buffer, or an
+        // empty string
+        std::string check_extent(
+            std::string_view what,
+            std::span<const int64_t> sizes,
+            std::span<const int64_t> strides,
+            size_t value_size,
+            std::span<const uint8_t> buffer
+        )
+        {
+            if (std::ranges::any_of(sizes, [](int64_t size) { return size < 0; }))
+            {
+                return std::string(what) + " has a negative dimension";
+            }
+            if (!strides.empty())
+            {
+                if (strides.size() != sizes.size())
+                {
+                    return std::string(what) + " has " + std::to_string(strides.size()) + " strides for "
+                           + std::to_string(sizes.size()) + " dimensions";
+                }
+                if (std::ranges::any_of(strides, [](int64_t stride) { return stride < 0; }))
+                {
+                    return std::string(what) + " has a negative stride";
+                }
+            }
+            const auto extent = byte_extent(sizes, strides, static_cast<int64_t>(value_size));
+            if (!extent.has_value() || static_cast<uint64_t>(*extent) > buffer.size())
+            {
+                return std::string(what) + " needs "
+                       + (extent.has_value() ? std::to_string(*extent) : std::string("more")) + " bytes, "
+                       + std::to_string(buffer.size()) + " are given";
+            }
+            return {};
+        }
+
+        std::vector<int64_t> dimension_sizes(const std::vector<tensor_dimension>& shape)
+        {
+            std::vector<int64_t> sizes;
+            sizes.reserve(shape.size());
+            std::ranges::transform(shape, std::back_inserter(sizes), &tensor_dimension::size);
+            return sizes;
+        }
+
+        // Reason why a tensor is not well-formed, or an empty string
+        std::string tensor_error(const tensor_view& tensor)
+        {
+            return check_extent(
+                "The data of the tensor",
+                dimension_sizes(tensor.shape),
+                tensor.strides,
+                tensor_value_size(tensor.format),
+                tensor.data
+            );
+        }
+
+        // Reason why a sparse tensor is not well-formed, or an empty string
+        std::string sparse_tensor_error(const sparse_tensor_view& tensor)
+        {
+            const size_t value_size = tensor_value_size(tensor.format);
+            if (!is_integer_format(tensor.indices_format))
+            {
+                return "Unsupported sparse tensor indices format: '" + tensor.indices_format + "'";
+            }
+            const auto sizes = dimension_sizes(tensor.shape);
+            if (std::ranges::any_of(sizes, [](int64_t size) { return size < 0; }))
+            {
+                return "The sparse tensor has a negative dimension";
+            }
+            if (tensor.non_zero_length < 0)
+            {
+                return "The sparse tensor has a negative number of non-zero values";
+            }
+            const std::array<int64_t, 1> non_zero_sizes = {tensor.non_zero_length};
+            std::string error = check_extent(
+                "The data of the sparse tensor",
+                non_zero_sizes,
+                {},
+                value_size,
+                tensor.data
+            );
+            if (!error.empty())
+            {
+                return error;
+            }
+            const size_t indices_size = tensor_value_size(tensor.indices_format);
+            if (tensor.index == sparse_tensor_index::coo)
+            {
+                const std::array<int64_t, 2> indices_sizes = {
+                    tensor.non_zero_length,
+                    static_cast<int64_t>(sizes.size())
+                };
+                return check_extent(
+                    "The COO indices of the sparse tensor",
+                    indices_sizes,
+                    tensor.indices_strides,
+                    indices_size,
+                    tensor.indices
+                );
+            }
+            if (sizes.size() != 2)
+            {
+                return "A CSR or CSC sparse tensor must have 2 dimensions, not " + std::to_string(sizes.size());
+            }
+            if (!is_integer_format(tensor.indptr_format))
+            {
+                return "Unsupported sparse tensor indptr format: '" + tensor.indptr_format + "'";
+            }
+            const int64_t compressed_size = sizes[tensor.index == sparse_tensor_index::csr ? 0 : 1];
+            // Clamped so that the size does not overflow: such an indptr does not fit in any buffer
+            const std::array<int64_t, 1> indptr_sizes = {std::min(compressed_size, max_extent - 1) + 1};
+            error = check_extent(
+                "The indptr of the sparse tensor",
+                indptr_sizes,
+                {},
+                tensor_value_size(tensor.indptr_format),
+                tensor.indptr
+            );
+            if (!error.empty())
+            {
+                return error;
+            }
+            return check_extent(
+                "The indices of the sparse tensor",
+                non_zero_sizes,
+                {},
+                indices_size,
+                tensor.indices
+            );
+        }
+
+        std::string read_int_format(const org::apache::arrow::flatbuf::Int* int_type)
+        {
+            if (int_type == nullptr)
+            {
+                throw std::runtime_error("Missing integer type in tensor message.");
+            }
+            switch (int_type->bitWidth())
+            {
+                case 8:
+                    return int_type->is_signed() ? "c" : "C";
+                case 16:
+                    return int_type->is_signed() ? "s" : "S";
+                case 32:
+                    return int_type->is_signed() ? "i" : "I";
+                case 64:
+                    return int_type->is_signed() ? "l" : "L";
+                default:
+                    throw std::runtime_error(
+                        "Unsupported integer bit width in tensor message: " + std::to_string(int_type->bitWidth())
+                    );
+            }
+        }
+
+        // Format of the values of a Tensor or SparseTensor
+        template <typename Tensor>
+        std::string read_value_format(const Tensor& tensor)
+        {
+            switch (tensor.type_type())
+            {
+                case org::apache::arrow::flatbuf::Type::Int:
+                    return read_int_format(tensor.type_as_Int());
+                case org::apache::arrow::flatbuf::Type::FloatingPoint:
+                    switch (tensor.type_as_FloatingPoint()->precision())
+                    {
+                        case org::apache::arrow::flatbuf::Precision::HALF:
+                            return "e";
+                        case org::apache::arrow::flatbuf::Precision::SINGLE:
+                            return "f";
+                        case org::apache::arrow::flatbuf::Precision::DOUBLE:
+                            return "g";
+                    }
+                    throw std::runtime_error("Unsupported floating point precision in tensor message.");
+                default:
+                    throw std::runtime_error(
+                        "Unsupported tensor value type: " + std::to_string(static_cast<int>(tensor.type_type()))
+                    );
+            }
+        }
+
+        std::vector<tensor_dimension> read_shape(
+            const flatbuffers::Vector<flatbuffers::Offset<org::apache::arrow::flatbuf::TensorDim>>* shape
+        )
+        {
+            if (shape == nullptr)
+            {
+                throw std::runtime_error("Missing shape in tensor message.");
+            }
+            std::vector<tensor_dimension> dimensions;
+            dimensions.reserve(shape->size());
+            for (const auto* dimension : *shape)
+            {
+                dimensions.push_back(
+                    {.size = dimension->size(),
+                     .name = dimension->name() == nullptr ? std::string() : dimension->name()->str()}
+                );
+            }
+            return dimensions;
+        }
+
+        std::vector<int64_t> read_strides(const flatbuffers::Vector<int64_t>* strides)
+        {
+            if (strides == nullptr)
+            {
+                return {};
+            }
+            return std::vector<int64_t>(strides->begin(), strides->end());
+        }
+
+        std::span<const uint8_t> read_body_buffer(
+            const org::apache::arrow::flatbuf::Buffer* buffer,
+            std::span<const uint8_t> body
+        )
+        {
+            if (buffer == nullptr)
+            {
+                throw std::runtime_error("Missing buffer in tensor message.");
+            }
+            if (buffer->offset() < 0 || buffer->length() < 0
+                || static_cast<uint64_t>(buffer->offset()) > body.size()
+                || static_cast<uint64_t>(buffer->length()) > body.size() - static_cast<uint64_t>(buffer->offset()))
+            {
+                throw std::runtime_error("Buffer metadata exceeds body size");
+            }
+            return body.subspan(static_cast<size_t>(buffer->offset()), static_cast<size_t>(buffer->length()));
+        }
+    }
+
+    size_t tensor_value_size(std::string_view format)
+    {
+        if (format == "c" || format == "C")
+        {
+            return 1;
+        }
+        if (format == "s" || format == "S" || format == "e")
+        {
+            return 2;
+        }
+        if (format == "i" || format == "I" || format == "f")
+        {
+            return 4;
+        }
+        if (format == "l" || format == "L" || format == "g")
+        {
+            return 8;
+        }
+        throw std::invalid_argument(
+            "Unsupported tensor value format: '" + std::string(format)
+            + "', an integer or floating point format is expected"
+        );
+    }
+
+    void check_tensor(const tensor_view& tensor)
+    {
+        const std::string error = tensor_error(tensor);
+        if (!error.empty())
+        {
+            throw std::invalid_argument(error);
+        }
+    }
+
+    void check_sparse_tensor(const sparse_tensor_view& tensor)
+    {
+        const std::string error = sparse_tensor_error(tensor);
+        if (!error.empty())
+        {
+            throw std::invalid_argument(error);
+        }
+    }
+
+    tensor_view read_tensor(const encapsulated_message& message, std::shared_ptr<const void> body_owner)
+    {
+        const auto* flat_buffer_message = message.flat_buffer_message();
+        if (flat_buffer_message->header_type() != org::apache::arrow::flatbuf::MessageHeader::Tensor)
+        {
+            throw std::runtime_error("Expected a Tensor message.");
+        }
+        const auto& tensor = *flat_buffer_message->header_as_Tensor();
+        tensor_view result{
+            .format = read_value_format(tensor),
+            .shape = read_shape(tensor.shape()),
+            .strides = read_strides(tensor.strides()),
+            .data = read_body_buffer(tensor.data(), message.body()),
+            .owner = std::move(body_owner)
+        };
+        const std::string error = tensor_error(result);
+        if (!error.empty())
+        {
+            throw std::runtime_error("Invalid Tensor message: " + error);
+        }
+        return result;
+    }
+
+    sparse_tensor_view
+    read_sparse_tensor(const encapsulated_message& message, std::shared_ptr<const void> body_owner)
+    {
+        const auto* flat_buffer_message = message.flat_buffer_message();
+        if (flat_buffer_message->header_type() != org::apache::arrow::flatbuf::MessageHeader::SparseTensor)
+        {
+            throw std::runtime_error("Expected a SparseTensor message.");
+        }
+        const auto& tensor = *flat_buffer_message->header_as_SparseTensor();
+        const std::span<const uint8_t> body = message.body();
+        sparse_tensor_view result{
+            .format = read_value_format(tensor),
+            .shape = read_shape(tensor.shape()),
+            .non_zero_length = tensor.non_zero_length(),
+            .data = read_body_buffer(tensor.data(), body),
+            .owner = std::move(body_owner)
+        };
+        switch (tensor.sparseIndex_type())
+        {
+            case org::apache::arrow::flatbuf::SparseTensorIndex::SparseTensorIndexCOO:
+            {
+                const auto& coo = *tensor.sparseIndex_as_SparseTensorIndexCOO();
+                result.index = sparse_tensor_index::coo;
+                result.indices_format = read_int_format(coo.indicesType());
+                result.indices = read_body_buffer(coo.indicesBuffer(), body);
+                result.indices_strides = read_strides(coo.indicesStrides());
+                result.is_canonical = coo.isCanonical();
+                break;
+            }
+            case org::apache::arrow::flatbuf::SparseTensorIndex::SparseMatrixIndexCSX:
+            {
+                const auto& csx = *tensor.sparseIndex_as_SparseMatrixIndexCSX();
+                result.index = csx.compressedAxis() == org::apache::arrow::flatbuf::SparseMatrixCompressedAxis::Row
+                                   ? sparse_tensor_index::csr
+                                   : sparse_tensor_index::csc;
+                result.indices_format = read_int_format(csx.indicesType());
+                result.indices = read_body_buffer(csx.indicesBuffer(), body);
+                result.indptr_format = read_int_format(csx.indptrType());
+                result.indptr = read_body_buffer(csx.indptrBuffer(), body);
+                break;
+            }
+            case org::apache::arrow::flatbuf::SparseTensorIndex::SparseTensorIndexCSF:
+                throw std::runtime_error("Unsupported sparse tensor index: CSF");
+            default:
+                throw std::runtime_error("Missing or unknown sparse tensor index.");
+        }
+        const std::string error = sparse_tensor_error(result);
+        if (!error.empty())
+        {
+            throw std::runtime_error("Invalid SparseTensor message: " + error);
+        }
+        return result;
+    }
+}
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <optional>
+#include <vector>
 
 #include <doctest/doctest.h>
 
 #include <sparrow/record_batch.hpp>
 
+#include "Message_generated.h"
 #include "sparrow_ipc/compression.hpp"
+#include "sparrow_ipc/magic_values.hpp"
 
 namespace sparrow_ipc
 {
@@ -95,6 +100,27 @@ namespace sparrow_ipc
         );
     }
 
+    // Helper function to create an encapsulated RecordBatch message without buffers, declaring
+    // the given body length
+    inline std::vector<uint8_t> create_record_batch_message(int64_t body_length)
+    {
+        flatbuffers::FlatBufferBuilder builder;
+        const auto record_batch = org::apache::arrow::flatbuf::CreateRecordBatch(builder, 0);
+        builder.Finish(org::apache::arrow::flatbuf::CreateMessage(
+            builder,
+            org::apache::arrow::flatbuf::MetadataVersion::V5,
+            org::apache::arrow::flatbuf::MessageHeader::RecordBatch,
+            record_batch.Union(),
+            body_length
+        ));
+        const auto metadata_length = static_cast<int32_t>((builder.GetSize() + 7) / 8 * 8);
+        std::vector<uint8_t> message(8 + static_cast<size_t>(metadata_length), 0);
+        std::ranges::copy(continuation, message.begin());
+        std::memcpy(message.data() + 4, &metadata_length, sizeof(metadata_length));
+        std::memcpy(message.data() + 8, builder.GetBufferPointer(), builder.GetSize());
+        return message;
+    }
+
     // Helper function to create a compressible record batch for testing
     inline sp::record_batch create_compressible_test_record_batch()
     {
@@ -1,4 +1,6 @@
 
+#include <array>
+#include <memory>
 #include <optional>
 #include <ostream>  // Needed by doctest
 #include <string_view>
@@ -137,6 +139,32 @@ TEST_SUITE("C Data Interface")
             schema.release(&schema);
         }
 
+        SUBCASE("make_shared_arrow_schema")
+        {
+            const auto strings = std::make_shared<const std::array<std::string, 2>>(
+                std::array<std::string, 2>{"i", "shared"}
+            );
+            auto schema = sparrow_ipc::make_shared_arrow_schema(
+                (*strings)[0].c_str(),
+                (*strings)[1].c_str(),
+                nullptr,
+                static_cast<int64_t>(sparrow::ArrowFlag::NULLABLE),
+                strings
+            );
+            // The strings are borrowed, not copied
+            CHECK_EQ(schema.format, (*strings)[0].c_str());
+            CHECK_EQ(schema.name, (*strings)[1].c_str());
+            CHECK_EQ(schema.metadata, nullptr);
+            CHECK_EQ(schema.flags, static_cast<int64_t>(sparrow::ArrowFlag::NULLABLE));
+            CHECK_EQ(schema.n_children, 0);
+            CHECK_EQ(strings.use_count(), 2);
+
+            schema.release(&schema);
+            CHECK_EQ(strings.use_count(), 1);
+            CHECK_EQ(schema.format, nullptr);
+            CHECK_EQ(schema.private_data, nullptr);
+        }
+
         SUBCASE("ArrowSchema release")
         {
             ArrowSchema** children = new ArrowSchema*[2];
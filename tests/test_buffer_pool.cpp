@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <sparrow/buffer/buffer.hpp>
+#include <sparrow/record_batch.hpp>
+
+#include "sparrow_ipc/buffer_pool.hpp"
+#include "sparrow_ipc/memory_output_stream.hpp"
+#include "sparrow_ipc/serializer.hpp"
+#include "sparrow_ipc/stream_reader.hpp"
+#include "sparrow_ipc_tests_helpers.hpp"
+
+namespace sparrow_ipc
+{
+    namespace sp = sparrow;
+
+    TEST_SUITE("buffer_pool")
+    {
+        TEST_CASE("blocks are reused within their size class")
+        {
+            buffer_pool pool;
+            void* block = pool.allocate(1000);
+            CHECK_EQ(reinterpret_cast<std::uintptr_t>(block) % buffer_pool::alignment, 0);
+            pool.deallocate(block, 1000);
+            CHECK_EQ(pool.stats().cached_bytes, 1024);
+
+            // 900 bytes fall in the same 1024-byte class
+            void* reused = pool.allocate(900);
+            CHECK_EQ(reused, block);
+            CHECK_EQ(pool.stats().reused_blocks, 1);
+            CHECK_EQ(pool.stats().allocated_blocks, 1);
+            CHECK_EQ(pool.stats().cached_bytes, 0);
+
+            // 2000 bytes do not
+            void* other = pool.allocate(2000);
+            CHECK_EQ(pool.stats().allocated_blocks, 2);
+            pool.deallocate(reused, 900);
+            pool.deallocate(other, 2000);
+            CHECK_EQ(pool.stats().cached_bytes, 1024 + 2048);
+
+            pool.release_cached();
+            CHECK_EQ(pool.stats().cached_bytes, 0);
+        }
+
+        TEST_CASE("the idle blocks are bounded")
+        {
+            buffer_pool pool(1024);
+            void* first = pool.allocate(1024);
+            void* second = pool.allocate(1024);
+            pool.deallocate(first, 1024);
+            pool.deallocate(second, 1024);
+            CHECK_EQ(pool.stats().cached_bytes, 1024);
+
+            pool.set_max_cached_bytes(0);
+            CHECK_EQ(pool.max_cached_bytes(), 0);
+            CHECK_EQ(pool.stats().cached_bytes, 0);
+
+            // Requests above the largest class bypass the pool
+            void* large = pool.allocate(buffer_pool::max_block_size + 1);
+            CHECK_EQ(pool.stats().allocated_blocks, 2);
+            pool.deallocate(large, buffer_pool::max_block_size + 1);
+            CHECK_EQ(pool.stats().cached_bytes, 0);
+        }
+
+        TEST_CASE("sparrow buffers return their memory to the pool")
+        {
+            auto pool = std::make_shared<buffer_pool>();
+            {
+                sp::buffer<uint8_t> buffer(100, pool_allocator<uint8_t>(pool));
+                CHECK_EQ(buffer.size(), 100);
+                CHECK_EQ(pool->stats().allocated_blocks, 1);
+            }
+            CHECK_EQ(pool->stats().cached_bytes, 128);
+        }
+
+        TEST_CASE("reading same-shaped batches stops allocating")
+        {
+            std::vector<sp::record_batch> batches;
+            for (int i = 0; i < 4; ++i)
+            {
+                std::vector<int32_t> values(1000, i);
+                batches.push_back(sp::record_batch({{"values", sp::array(sp::primitive_array<int32_t>(values))}}));
+            }
+            std::vector<uint8_t> buffer;
+            memory_output_stream stream(buffer);
+            serializer ser(stream, CompressionType::ZSTD);
+            ser << batches << end_stream;
+
+            std::istringstream iss(std::string(buffer.begin(), buffer.end()));
+            stream_reader reader(iss);
+            const auto& pool = buffer_pool::default_pool();
+            REQUIRE(reader.next().has_value());
+            const size_t allocated_blocks = pool->stats().allocated_blocks;
+            for (size_t i = 1; i < batches.size(); ++i)
+            {
+                const auto batch = reader.next();
+                REQUIRE(batch.has_value());
+                CHECK(*batch == batches[i]);
+            }
+            CHECK_EQ(pool->stats().allocated_blocks, allocated_blocks);
+        }
+    }
+}
@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <future>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <doctest/doctest.h>
@@ -113,5 +116,51 @@ namespace sparrow_ipc
             size_t empty_size = get_compressed_size(compression_type, empty_data, cache);
             CHECK_EQ(empty_size, details::CompressionHeaderSize);
         }
+
+        TEST_CASE_TEMPLATE("Codec contexts are reused after errors and across threads", T, Lz4Compression, ZstdCompression)
+        {
+            const std::vector<uint8_t> original_data(compressible_test_string.begin(), compressible_test_string.end());
+            const auto compression_type = T::type;
+            CompressionCache cache;
+            const auto compressed_data = compress(compression_type, original_data, cache);
+
+            // Corrupting the magic number of the frame makes the decompression fail
+            auto corrupted_data = compressed_data;
+            corrupted_data[details::CompressionHeaderSize] = 0;
+            CHECK_THROWS_AS(std::ignore = decompress(compression_type, corrupted_data), std::runtime_error);
+
+            auto round_trip = [&]()
+            {
+                for (size_t i = 0; i < 50; ++i)
+                {
+                    CompressionCache local_cache;
+                    const auto compressed = compress(compression_type, original_data, local_cache);
+                    const auto decompressed = decompress(compression_type, compressed);
+                    const bool equal = std::visit(
+                        [&original_data](const auto& data)
+                        {
+                            return std::equal(data.begin(), data.end(), original_data.begin(), original_data.end());
+                        },
+                        decompressed
+                    );
+                    if (!equal)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+            std::vector<std::future<bool>> results;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                results.push_back(std::async(std::launch::async, round_trip));
+            }
+            CHECK(round_trip());
+            for (auto& result : results)
+            {
+                CHECK(result.get());
+            }
+        }
     }
 }
@@ -0,0 +1,177 @@
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <sparrow/record_batch.hpp>
+
+#include "sparrow_ipc/any_output_stream.hpp"
+#include "sparrow_ipc/concatenate.hpp"
+#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/file_reader.hpp"
+#include "sparrow_ipc/memory_output_stream.hpp"
+#include "sparrow_ipc/message_index.hpp"
+#include "sparrow_ipc/serializer.hpp"
+#include "sparrow_ipc/stream_file_serializer.hpp"
+
+#include "sparrow_ipc_tests_helpers.hpp"
+
+namespace sparrow_ipc
+{
+    namespace
+    {
+        std::vector<uint8_t>
+        make_stream(const std::vector<sp::record_batch>& batches, std::optional<CompressionType> compression)
+        {
+            std::vector<uint8_t> stream_data;
+            memory_output_stream output(stream_data);
+            serializer writer(output, compression);
+            writer << batches << end_stream;
+            return stream_data;
+        }
+
+        std::vector<uint8_t> concatenate(
+            const std::vector<std::vector<uint8_t>>& inputs,
+            bool file,
+            const concatenate_options& options = {}
+        )
+        {
+            const std::vector<std::span<const uint8_t>> spans(inputs.begin(), inputs.end());
+            std::vector<uint8_t> data;
+            memory_output_stream output(data);
+            any_output_stream stream(output);
+            if (file)
+            {
+                concatenate_files(spans, stream, options);
+            }
+            else
+            {
+                concatenate_streams(spans, stream, options);
+            }
+            return data;
+        }
+
+        size_t count_record_batches(std::span<const uint8_t> data)
+        {
+            size_t count = 0;
+            for (const message_info& info : scan_stream(data).messages)
+            {
+                count += info.type == org::apache::arrow::flatbuf::MessageHeader::RecordBatch ? 1 : 0;
+            }
+            return count;
+        }
+    }
+
+    TEST_SUITE("concatenate")
+    {
+        TEST_CASE("Streams are concatenated into a stream")
+        {
+            for (const auto& [compression, name] : compression_params)
+            {
+                SUBCASE(name)
+                {
+                    const std::vector<uint8_t> first = make_stream({create_test_record_batch()}, compression);
+                    const std::vector<uint8_t> second = make_stream(
+                        {create_compressible_test_record_batch(), create_test_record_batch()},
+                        compression
+                    );
+                    const std::vector<uint8_t> stream_data = concatenate({first, second}, false);
+
+                    const std::vector<sp::record_batch> batches = deserialize_stream(stream_data);
+                    REQUIRE_EQ(batches.size(), 3);
+                    CHECK_EQ(batches[0].nb_rows(), 5);
+                    CHECK_EQ(batches[1].nb_rows(), 1000);
+                    CHECK_EQ(batches[2].nb_rows(), 5);
+                }
+            }
+        }
+
+        TEST_CASE("Streams and files are concatenated into a file")
+        {
+            const std::vector<uint8_t> stream_data = make_stream({create_test_record_batch()}, std::nullopt);
+            std::vector<uint8_t> file_data;
+            memory_output_stream output(file_data);
+            {
+                stream_file_serializer writer(output);
+                writer << create_compressible_test_record_batch() << end_file;
+            }
+
+            const std::vector<uint8_t> result = concatenate({stream_data, file_data}, true);
+            const file_reader reader{std::span<const uint8_t>(result)};
+            REQUIRE_EQ(reader.num_record_batches(), 2);
+            const std::vector<sp::record_batch> batches = reader.read_all();
+            CHECK_EQ(batches[0].nb_rows(), 5);
+            CHECK_EQ(batches[1].nb_rows(), 1000);
+        }
+
+        TEST_CASE("Small record batches are merged")
+        {
+            for (const auto& [compression, name] : compression_params)
+            {
+                SUBCASE(name)
+                {
+                    const std::vector<uint8_t> first = make_stream(
+                        {create_test_record_batch(), create_test_record_batch()},
+                        compression
+                    );
+                    const std::vector<uint8_t> second = make_stream(
+                        {create_test_record_batch(), create_compressible_test_record_batch()},
+                        compression
+                    );
+                    const std::vector<uint8_t> stream_data = concatenate(
+                        {first, second},
+                        false,
+                        {.min_batch_rows = 12}
+                    );
+
+                    // The three batches of 5 rows are merged, the batch of 1000 rows is copied
+                    CHECK_EQ(count_record_batches(stream_data), 2);
+                    CHECK_EQ(count_rows(stream_data), 1015);
+
+                    const std::vector<sp::record_batch> batches = deserialize_stream(stream_data);
+                    REQUIRE_EQ(batches.size(), 2);
+                    REQUIRE_EQ(batches[0].nb_rows(), 15);
+                    batches[0].get_column(0).visit(
+                        [](const auto& impl)
+                        {
+                            if constexpr (sp::is_primitive_array_v<std::decay_t<decltype(impl)>>)
+                            {
+                                CHECK_EQ(impl[0].value(), 1);
+                                CHECK_EQ(impl[7].value(), 3);
+                                CHECK_EQ(impl[14].value(), 5);
+                            }
+                        }
+                    );
+                    batches[0].get_column(1).visit(
+                        [](const auto& impl)
+                        {
+                            if constexpr (sp::is_string_array_v<std::decay_t<decltype(impl)>>)
+                            {
+                                CHECK_EQ(impl[0].value(), "hello");
+                                CHECK_EQ(impl[6].value(), "world");
+                                CHECK_EQ(impl[14].value(), "batch");
+                            }
+                        }
+                    );
+                    CHECK_EQ(batches[1].nb_rows(), 1000);
+                }
+            }
+        }
+
+        TEST_CASE("Inputs with different schemas are rejected")
+        {
+            const std::vector<uint8_t> first = make_stream({create_test_record_batch()}, std::nullopt);
+            const std::vector<uint8_t> second = make_stream(
+                {sp::record_batch({{"int_col", sp::array(sp::primitive_array<int64_t>({1, 2}))}})},
+                std::nullopt
+            );
+            CHECK_THROWS_AS(concatenate({first, second}, false), std::invalid_argument);
+            CHECK_THROWS_AS(concatenate({first, second}, true), std::invalid_argument);
+            CHECK_THROWS_AS(concatenate({}, false), std::invalid_argument);
+        }
+    }
+}
@@ -1,16 +1,25 @@
+#include <bit>
+#include <cstring>
 #include <deque>
 #include <list>
+#include <memory>
 #include <numeric>
+#include <tuple>
 #include <vector>
 
 #include <doctest/doctest.h>
 #include <sparrow/record_batch.hpp>
 
+#include "sparrow_ipc/deserialize.hpp"
 #include "sparrow_ipc/deserializer.hpp"
+#include "sparrow_ipc/encapsulated_message.hpp"
 #include "sparrow_ipc/memory_output_stream.hpp"
 #include "sparrow_ipc/serializer.hpp"
 #include "sparrow_ipc_tests_helpers.hpp"
 
+#include "../src/decoder_plan.hpp"
+#include "../src/parallel_for.hpp"
+
 namespace sparrow_ipc
 {
     namespace sp = sparrow;
@@ -676,5 +685,753 @@ namespace sparrow_ipc
                 CHECK_EQ(batches.size(), 1);
             }
         }
+
+        TEST_CASE("deserialize_stream with several threads")
+        {
+            auto original_batches = create_test_record_batches(20);
+            auto serialized_data = serialize_record_batches(original_batches);
+            const auto sequential = deserialize_stream(std::span<const uint8_t>(serialized_data));
+            CHECK(deserialize_stream(std::span<const uint8_t>(serialized_data), {}) == sequential);
+            CHECK(
+                deserialize_stream(
+                    std::span<const uint8_t>(serialized_data),
+                    read_options{.num_threads = 0, .decompression_threads = 0}
+                )
+                == sequential
+            );
+            // Decompressing with the hardware concurrency in each of several decoding threads
+            // would start a number of threads growing with its square
+            CHECK_EQ(details::resolve_nested_thread_count(0, 4), 1);
+            CHECK_EQ(details::resolve_nested_thread_count(0, 1), 0);
+            CHECK_EQ(details::resolve_nested_thread_count(2, 4), 2);
+
+            for (const size_t num_threads : {size_t{0}, size_t{1}, size_t{4}, size_t{64}})
+            {
+                CAPTURE(num_threads);
+                const auto parallel = deserialize_stream(
+                    std::span<const uint8_t>(serialized_data),
+                    read_options{.num_threads = num_threads}
+                );
+                REQUIRE_EQ(parallel.size(), original_batches.size());
+                for (size_t i = 0; i < parallel.size(); ++i)
+                {
+                    CHECK(parallel[i] == sequential[i]);
+                    verify_test_record_batches_content(parallel[i], i);
+                }
+            }
+        }
+        TEST_CASE("decoder plan locates the buffers of the decoded fields")
+        {
+            const sp::record_batch batch(
+                {{"int_col", sp::array(sp::primitive_array<int32_t>({1, 2, 3}))},
+                 {"string_col", sp::array(sp::string_array(std::vector<std::string>{"a", "b", "c"}))},
+                 {"int64_col", sp::array(sp::primitive_array<int64_t>({4, 5, 6}))}}
+            );
+            const auto serialized_data = serialize_record_batches({batch});
+            // The Schema message follows the continuation and metadata length prefix
+            const auto* message = org::apache::arrow::flatbuf::GetMessage(serialized_data.data() + 8);
+            const auto& schema = *message->header_as_Schema();
+
+            const decoded_schema all_fields = decode_schema(schema);
+            REQUIRE(all_fields.plan != nullptr);
+            REQUIRE_EQ(all_fields.plan->fields.size(), 3);
+            CHECK_EQ(all_fields.plan->fields[0].first_buffer, 0);
+            CHECK_EQ(all_fields.plan->fields[1].first_buffer, 2);
+            CHECK_EQ(all_fields.plan->fields[2].first_buffer, 5);
+            CHECK_EQ(all_fields.plan->required_buffer_count, 7);
+
+            const decoded_schema projected = decode_schema(schema, read_options{.field_indices = std::vector<size_t>{2, 0}});
+            REQUIRE_EQ(projected.plan->fields.size(), 2);
+            CHECK_EQ(projected.plan->fields[0].first_buffer, 5);
+            CHECK_EQ(projected.plan->fields[0].buffer_count, 2);
+            CHECK_EQ(projected.plan->fields[0].node_index, 2);
+            CHECK_EQ(projected.plan->fields[1].first_buffer, 0);
+            CHECK_EQ(projected.plan->fields[1].node_index, 0);
+            CHECK_EQ(projected.plan->required_node_count, 3);
+            CHECK_EQ(projected.field_names, std::vector<std::string>{"int64_col", "int_col"});
+
+            const auto decoded = deserialize_stream(
+                std::span<const uint8_t>(serialized_data),
+                read_options{.field_indices = std::vector<size_t>{2, 0}}
+            );
+            REQUIRE_EQ(decoded.size(), 1);
+            CHECK(decoded[0].get_column("int64_col") == batch.get_column("int64_col"));
+            CHECK(decoded[0].get_column("int_col") == batch.get_column("int_col"));
+        }
+
+        TEST_CASE("validation levels")
+        {
+            const sp::record_batch batch(
+                {{"int_col",
+                  sp::array(sp::primitive_array<int32_t>(std::vector<int32_t>{1, 2, 3, 4}, std::vector<bool>{true, false, true, true}))},
+                 {"string_col", sp::array(sp::string_array(std::vector<std::string>{"a", "bb", "ccc", "dddd"}))}}
+            );
+            const auto serialized_data = serialize_record_batches({batch});
+
+            for (const auto level : {validation_level::none, validation_level::metadata, validation_level::full})
+            {
+                CAPTURE(static_cast<int>(level));
+                const auto decoded = deserialize_stream(
+                    std::span<const uint8_t>(serialized_data),
+                    read_options{.validation = level}
+                );
+                REQUIRE_EQ(decoded.size(), 1);
+                CHECK(decoded[0] == batch);
+                CHECK_EQ(decoded[0].get_column(0).null_count(), 1);
+            }
+
+            // Locate the RecordBatch message, which follows the Schema message, and its body
+            const auto message_header_size = [&](size_t message_offset)
+            {
+                int32_t metadata_length = 0;
+                std::memcpy(&metadata_length, serialized_data.data() + message_offset + 4, sizeof(metadata_length));
+                return (8 + static_cast<size_t>(metadata_length) + 7) / 8 * 8;
+            };
+            const size_t record_batch_offset = message_header_size(0);
+            const size_t body_offset = record_batch_offset + message_header_size(record_batch_offset);
+            const auto* message = org::apache::arrow::flatbuf::GetMessage(
+                serialized_data.data() + record_batch_offset + 8
+            );
+            const auto* record_batch = message->header_as_RecordBatch();
+            REQUIRE(record_batch != nullptr);
+            const auto buffer_offset = [&](flatbuffers::uoffset_t buffer_index)
+            {
+                return body_offset + static_cast<size_t>(record_batch->buffers()->Get(buffer_index)->offset());
+            };
+
+            SUBCASE("validity bitmap not matching the null count")
+            {
+                auto corrupted = serialized_data;
+                // Mark the null value of int_col as valid
+                corrupted[buffer_offset(0)] = static_cast<uint8_t>(corrupted[buffer_offset(0)] | 0x02);
+                const auto decoded = deserialize_stream(
+                    std::span<const uint8_t>(corrupted),
+                    read_options{.validation = validation_level::metadata}
+                );
+                // The null count is the one of the FieldNode
+                CHECK_EQ(decoded[0].get_column(0).null_count(), 1);
+                CHECK_THROWS_AS(
+                    std::ignore = deserialize_stream(
+                        std::span<const uint8_t>(corrupted),
+                        read_options{.validation = validation_level::full}
+                    ),
+                    std::runtime_error
+                );
+            }
+
+            SUBCASE("decreasing offsets")
+            {
+                auto corrupted = serialized_data;
+                // The offsets of string_col follow the buffers of int_col and its own validity
+                const int32_t offset = 0;
+                std::memcpy(corrupted.data() + buffer_offset(3) + 2 * sizeof(int32_t), &offset, sizeof(offset));
+                CHECK_NOTHROW(
+                    std::ignore = deserialize_stream(
+                        std::span<const uint8_t>(corrupted),
+                        read_options{.validation = validation_level::metadata}
+                    )
+                );
+                CHECK_THROWS_AS(
+                    std::ignore = deserialize_stream(
+                        std::span<const uint8_t>(corrupted),
+                        read_options{.validation = validation_level::full}
+                    ),
+                    std::runtime_error
+                );
+            }
+
+            SUBCASE("negative body length")
+            {
+                const std::vector<uint8_t> negative_message = create_record_batch_message(-8);
+                CHECK_THROWS_AS(
+                    std::ignore = extract_encapsulated_message(negative_message, true),
+                    std::runtime_error
+                );
+                CHECK_THROWS_AS(std::ignore = encapsulated_message(negative_message).body(), std::runtime_error);
+
+                std::vector<uint8_t> corrupted(
+                    serialized_data.begin(),
+                    serialized_data.begin() + static_cast<std::ptrdiff_t>(record_batch_offset)
+                );
+                corrupted.insert(corrupted.end(), negative_message.begin(), negative_message.end());
+                for (const auto level : {validation_level::none, validation_level::metadata})
+                {
+                    CAPTURE(static_cast<int>(level));
+                    CHECK_THROWS_AS(
+                        std::ignore = deserialize_stream(
+                            std::span<const uint8_t>(corrupted),
+                            read_options{.validation = level}
+                        ),
+                        std::runtime_error
+                    );
+                }
+            }
+
+            SUBCASE("invalid FlatBuffer metadata")
+            {
+                auto corrupted = serialized_data;
+                // Make the root offset of the RecordBatch message point outside of its metadata
+                const uint32_t root_offset = 0x7FFFFFF0;
+                std::memcpy(corrupted.data() + record_batch_offset + 8, &root_offset, sizeof(root_offset));
+                CHECK_THROWS_AS(
+                    std::ignore = deserialize_stream(
+                        std::span<const uint8_t>(corrupted),
+                        read_options{.validation = validation_level::metadata}
+                    ),
+                    std::runtime_error
+                );
+            }
+        }
+
+        TEST_CASE("deserialize an owned input")
+        {
+            const auto original_batches = create_test_record_batches(3);
+
+            SUBCASE("moved vector")
+            {
+                std::vector<sp::record_batch> decoded;
+                {
+                    auto serialized_data = serialize_record_batches(original_batches);
+                    decoded = deserialize_stream(std::move(serialized_data));
+                }
+                // The input buffer is gone from this scope, the batches keep it alive
+                REQUIRE_EQ(decoded.size(), original_batches.size());
+                for (size_t i = 0; i < decoded.size(); ++i)
+                {
+                    CHECK(decoded[i] == original_batches[i]);
+                }
+            }
+
+            SUBCASE("shared owner")
+            {
+                auto owner = std::make_shared<const std::vector<uint8_t>>(serialize_record_batches(original_batches));
+                const std::weak_ptr<const std::vector<uint8_t>> observer = owner;
+                auto decoded = deserialize_stream(
+                    std::span<const uint8_t>(*owner),
+                    owner,
+                    read_options{.num_threads = 2}
+                );
+                owner.reset();
+                CHECK_FALSE(observer.expired());
+                REQUIRE_EQ(decoded.size(), original_batches.size());
+                for (size_t i = 0; i < decoded.size(); ++i)
+                {
+                    CHECK(decoded[i] == original_batches[i]);
+                }
+                decoded.clear();
+                CHECK(observer.expired());
+            }
+        }
+
+        TEST_CASE("deserialize list columns")
+        {
+            const auto make_values = [](int32_t count)
+            {
+                std::vector<int32_t> values(static_cast<size_t>(count));
+                std::iota(values.begin(), values.end(), 0);
+                return sp::array(sp::primitive_array<int32_t>(values));
+            };
+            auto list_col = sp::list_array(
+                make_values(10),
+                sp::list_array::offset_buffer_from_sizes(std::vector<size_t>{2, 0, 3, 5}),
+                std::vector<bool>{true, false, true, true}
+            );
+            auto large_list_col = sp::big_list_array(
+                make_values(6),
+                sp::big_list_array::offset_buffer_from_sizes(std::vector<size_t>{1, 1, 1, 3}),
+                std::vector<bool>{true, true, true, true}
+            );
+            auto fixed_size_list_col = sp::fixed_sized_list_array(
+                2,
+                make_values(8),
+                std::vector<bool>{true, true, false, true}
+            );
+            // List of fixed-size lists, nesting the buffers and FieldNodes of two levels of children
+            auto nested_col = sp::list_array(
+                sp::array(sp::fixed_sized_list_array(3, make_values(15), std::vector<bool>(5, true))),
+                sp::list_array::offset_buffer_from_sizes(std::vector<size_t>{1, 2, 0, 2}),
+                std::vector<bool>{true, true, false, true}
+            );
+            const sp::record_batch batch(
+                {{"list_col", sp::array(std::move(list_col))},
+                 {"large_list_col", sp::array(std::move(large_list_col))},
+                 {"fixed_size_list_col", sp::array(std::move(fixed_size_list_col))},
+                 {"nested_col", sp::array(std::move(nested_col))}}
+            );
+
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    std::vector<uint8_t> serialized_data;
+                    memory_output_stream stream(serialized_data);
+                    serializer ser(stream, p.type);
+                    ser << batch << end_stream;
+
+                    for (const auto level : {validation_level::none, validation_level::metadata, validation_level::full})
+                    {
+                        CAPTURE(static_cast<int>(level));
+                        const auto decoded = deserialize_stream(
+                            std::span<const uint8_t>(serialized_data),
+                            read_options{.validation = level}
+                        );
+                        REQUIRE_EQ(decoded.size(), 1);
+                        CHECK(decoded[0] == batch);
+                        CHECK_EQ(decoded[0].get_column("list_col").null_count(), 1);
+                    }
+
+                    // The fields following a nested field are located after all its descendants
+                    const auto projected = deserialize_stream(
+                        std::span<const uint8_t>(serialized_data),
+                        read_options{.field_indices = std::vector<size_t>{3, 1}}
+                    );
+                    REQUIRE_EQ(projected.size(), 1);
+                    CHECK(projected[0].get_column("nested_col") == batch.get_column("nested_col"));
+                    CHECK(projected[0].get_column("large_list_col") == batch.get_column("large_list_col"));
+                }
+            }
+
+            const auto serialized_data = serialize_record_batches({batch});
+            const auto* message = org::apache::arrow::flatbuf::GetMessage(serialized_data.data() + 8);
+            const decoded_schema schema = decode_schema(*message->header_as_Schema());
+            REQUIRE_EQ(schema.plan->fields.size(), 4);
+            const auto& nested = schema.plan->fields[3];
+            // list_col and large_list_col: 4 buffers and 2 FieldNodes each, fixed_size_list_col: 3 and 2
+            CHECK_EQ(nested.first_buffer, 11);
+            CHECK_EQ(nested.node_index, 6);
+            CHECK_EQ(nested.buffer_count, 5);
+            CHECK_EQ(nested.node_count, 3);
+            REQUIRE_EQ(nested.children.size(), 1);
+            CHECK_EQ(nested.children[0].first_buffer, 13);
+            CHECK_EQ(nested.children[0].node_index, 7);
+            CHECK_EQ(nested.children[0].list_size, 3);
+            CHECK_EQ(schema.plan->required_node_count, 9);
+
+            SUBCASE("FixedSizeList length overflowing its child length")
+            {
+                // The RecordBatch message follows the Schema message
+                int32_t schema_metadata_length = 0;
+                std::memcpy(&schema_metadata_length, serialized_data.data() + 4, sizeof(schema_metadata_length));
+                const size_t record_batch_offset = 8 + static_cast<size_t>(schema_metadata_length);
+                const auto* record_batch_message = org::apache::arrow::flatbuf::GetMessage(
+                    serialized_data.data() + record_batch_offset + 8
+                );
+                const auto* record_batch = record_batch_message->header_as_RecordBatch();
+                REQUIRE(record_batch != nullptr);
+                // Give the fixed-size list child of nested_col a length whose product by its list
+                // size wraps around to a negative number
+                const auto* node = record_batch->nodes()->Get(7);
+                const auto node_offset = static_cast<size_t>(
+                    reinterpret_cast<const uint8_t*>(node) - serialized_data.data()
+                );
+                auto corrupted = serialized_data;
+                const int64_t length = int64_t{1} << 62;
+                std::memcpy(corrupted.data() + node_offset, &length, sizeof(length));
+                for (const auto level : {validation_level::metadata, validation_level::full})
+                {
+                    CAPTURE(static_cast<int>(level));
+                    CHECK_THROWS_AS(
+                        std::ignore = deserialize_stream(
+                            std::span<const uint8_t>(corrupted),
+                            read_options{.validation = level}
+                        ),
+                        std::runtime_error
+                    );
+                }
+            }
+        }
+
+        TEST_CASE("deserialize view columns")
+        {
+            const auto make_values = [](int32_t count)
+            {
+                std::vector<int32_t> values(static_cast<size_t>(count));
+                std::iota(values.begin(), values.end(), 0);
+                return sp::array(sp::primitive_array<int32_t>(values));
+            };
+            // Strings of up to 12 bytes are inlined in their view, the others are in a data buffer
+            auto string_view_col = sp::string_view_array(
+                std::vector<std::string>{"short", "longer than its view", "", "another long string value"},
+                std::vector<bool>{true, true, false, true}
+            );
+            // Unlike lists, the lists of list views may overlap and be out of order
+            auto list_view_col = sp::list_view_array(
+                make_values(10),
+                sp::list_view_array::offset_buffer_type{4, 0, 0, 2},
+                sp::list_view_array::size_buffer_type{3, 6, 0, 8},
+                std::vector<bool>{true, true, false, true}
+            );
+            auto large_list_view_col = sp::big_list_view_array(
+                sp::array(sp::string_view_array(std::vector<std::string>{"a", "a string that is not inlined", "c"})),
+                sp::big_list_view_array::offset_buffer_type{1, 0, 2, 0},
+                sp::big_list_view_array::size_buffer_type{2, 1, 1, 3},
+                std::vector<bool>{true, true, true, true}
+            );
+            const sp::record_batch batch(
+                {{"string_view_col", sp::array(std::move(string_view_col))},
+                 {"list_view_col", sp::array(std::move(list_view_col))},
+                 {"large_list_view_col", sp::array(std::move(large_list_view_col))},
+                 {"int_col", make_values(4)}}
+            );
+
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    std::vector<uint8_t> serialized_data;
+                    memory_output_stream stream(serialized_data);
+                    serializer ser(stream, p.type);
+                    ser << batch << end_stream;
+
+                    for (const auto level : {validation_level::none, validation_level::metadata, validation_level::full})
+                    {
+                        CAPTURE(static_cast<int>(level));
+                        const auto decoded = deserialize_stream(
+                            std::span<const uint8_t>(serialized_data),
+                            read_options{.validation = level}
+                        );
+                        REQUIRE_EQ(decoded.size(), 1);
+                        CHECK(decoded[0] == batch);
+                    }
+
+                    // The buffers of int_col follow the variadic data buffers of both string views
+                    const auto projected = deserialize_stream(
+                        std::span<const uint8_t>(serialized_data),
+                        read_options{.field_indices = std::vector<size_t>{3, 2}}
+                    );
+                    REQUIRE_EQ(projected.size(), 1);
+                    CHECK(projected[0].get_column("int_col") == batch.get_column("int_col"));
+                    CHECK(projected[0].get_column("large_list_view_col") == batch.get_column("large_list_view_col"));
+                }
+            }
+
+            const auto serialized_data = serialize_record_batches({batch});
+            int32_t schema_size = 0;
+            std::memcpy(&schema_size, serialized_data.data() + 4, sizeof(schema_size));
+            const auto* message = org::apache::arrow::flatbuf::GetMessage(
+                serialized_data.data() + 8 + schema_size + 8
+            );
+            const auto* variadic_counts = message->header_as_RecordBatch()->variadicBufferCounts();
+            REQUIRE_NE(variadic_counts, nullptr);
+            REQUIRE_EQ(variadic_counts->size(), 2);
+            CHECK_EQ(variadic_counts->Get(0), 1);
+            CHECK_EQ(variadic_counts->Get(1), 1);
+
+            const auto* schema_message = org::apache::arrow::flatbuf::GetMessage(serialized_data.data() + 8);
+            const decoded_schema schema = decode_schema(*schema_message->header_as_Schema());
+            REQUIRE_EQ(schema.plan->fields.size(), 4);
+            // string_view_col: 2 buffers, list_view_col: 5, large_list_view_col: 3 and a view child of 2
+            const auto& int_col = schema.plan->fields[3];
+            CHECK_EQ(int_col.first_buffer, 12);
+            CHECK_EQ(int_col.first_variadic_count, 2);
+            const auto& large_list_view = schema.plan->fields[2];
+            CHECK_EQ(large_list_view.first_variadic_count, 1);
+            CHECK_EQ(large_list_view.variadic_count_entries, 1);
+            REQUIRE_EQ(large_list_view.children.size(), 1);
+            CHECK_EQ(large_list_view.children[0].first_variadic_count, 1);
+            CHECK_EQ(schema.plan->required_variadic_count_entries, 2);
+        }
+
+        TEST_CASE("deserialize struct and map columns")
+        {
+            std::vector<sp::array> struct_children;
+            struct_children.emplace_back(sp::primitive_array<int32_t>({1, 2, 3, 4}));
+            struct_children.emplace_back(sp::string_array(std::vector<std::string>{"a", "bb", "", "dddd"}));
+            // Struct of a list, whose buffers follow the ones of the string child
+            struct_children.emplace_back(sp::list_array(
+                sp::array(sp::primitive_array<int64_t>({10, 20, 30, 40, 50})),
+                sp::list_array::offset_buffer_from_sizes(std::vector<size_t>{2, 0, 1, 2}),
+                std::vector<bool>{true, true, false, true}
+            ));
+            auto struct_col = sp::struct_array(std::move(struct_children), std::vector<bool>{true, false, true, true});
+            auto map_col = sp::map_array(
+                sp::array(sp::string_array(std::vector<std::string>{"x", "y", "z", "x", "w"})),
+                sp::array(sp::primitive_array<double>({1.0, 2.0, 3.0, 4.0, 5.0})),
+                sp::map_array::offset_buffer_from_sizes(std::vector<size_t>{2, 0, 1, 2}),
+                std::vector<bool>{true, false, true, true}
+            );
+            const sp::record_batch batch(
+                {{"struct_col", sp::array(std::move(struct_col))},
+                 {"int_col", sp::array(sp::primitive_array<int32_t>({5, 6, 7, 8}))},
+                 {"map_col", sp::array(std::move(map_col))}}
+            );
+
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    std::vector<uint8_t> serialized_data;
+                    memory_output_stream stream(serialized_data);
+                    serializer ser(stream, p.type);
+                    ser << batch << end_stream;
+
+                    for (const auto level : {validation_level::none, validation_level::metadata, validation_level::full})
+                    {
+                        CAPTURE(static_cast<int>(level));
+                        const auto decoded = deserialize_stream(
+                            std::span<const uint8_t>(serialized_data),
+                            read_options{.validation = level}
+                        );
+                        REQUIRE_EQ(decoded.size(), 1);
+                        CHECK(decoded[0] == batch);
+                        CHECK_EQ(decoded[0].get_column("struct_col").null_count(), 1);
+                        CHECK_EQ(decoded[0].get_column("map_col").null_count(), 1);
+                    }
+
+                    const auto projected = deserialize_stream(
+                        std::span<const uint8_t>(serialized_data),
+                        read_options{.field_indices = std::vector<size_t>{2, 1}}
+                    );
+                    REQUIRE_EQ(projected.size(), 1);
+                    CHECK(projected[0].get_column("map_col") == batch.get_column("map_col"));
+                    CHECK(projected[0].get_column("int_col") == batch.get_column("int_col"));
+                }
+            }
+
+            const auto serialized_data = serialize_record_batches({batch});
+            const auto* message = org::apache::arrow::flatbuf::GetMessage(serialized_data.data() + 8);
+            const decoded_schema schema = decode_schema(*message->header_as_Schema());
+            REQUIRE_EQ(schema.plan->fields.size(), 3);
+            CHECK_EQ(schema.plan->fields[0].format, "+s");
+            REQUIRE_EQ(schema.plan->fields[0].children.size(), 3);
+            // validity, then 2 + 3 + 4 buffers of the children
+            CHECK_EQ(schema.plan->fields[0].buffer_count, 10);
+            CHECK_EQ(schema.plan->fields[0].children[2].first_buffer, 6);
+            CHECK_EQ(schema.plan->fields[2].format, "+m");
+            CHECK_EQ(schema.plan->fields[2].first_buffer, 12);
+            CHECK_EQ(schema.plan->fields[2].node_index, 6);
+            REQUIRE_EQ(schema.plan->fields[2].children.size(), 1);
+            CHECK_EQ(schema.plan->fields[2].children[0].children.size(), 2);
+        }
+
+        TEST_CASE("deserialize union columns")
+        {
+            std::vector<sp::array> sparse_children;
+            sparse_children.emplace_back(sp::primitive_array<int32_t>({1, 2, 3, 4, 5}));
+            sparse_children.emplace_back(sp::string_array(std::vector<std::string>{"a", "b", "c", "d", "e"}));
+            sparse_children.emplace_back(sp::primitive_array<double>({0.5, 1.5, 2.5, 3.5, 4.5}));
+            auto sparse_col = sp::sparse_union_array(
+                std::move(sparse_children),
+                sp::sparse_union_array::type_id_buffer_type{0, 1, 2, 1, 0}
+            );
+
+            std::vector<sp::array> dense_children;
+            dense_children.emplace_back(sp::primitive_array<int64_t>({10, 20}));
+            dense_children.emplace_back(sp::string_array(std::vector<std::string>{"x", "yy", "zzz"}));
+            auto dense_col = sp::dense_union_array(
+                std::move(dense_children),
+                sp::dense_union_array::type_id_buffer_type{1, 0, 1, 1, 0},
+                sp::dense_union_array::offset_buffer_type{0, 0, 1, 2, 1}
+            );
+            const sp::record_batch batch(
+                {{"sparse_col", sp::array(std::move(sparse_col))},
+                 {"dense_col", sp::array(std::move(dense_col))},
+                 {"int_col", sp::array(sp::primitive_array<int32_t>({5, 6, 7, 8, 9}))}}
+            );
+
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    std::vector<uint8_t> serialized_data;
+                    memory_output_stream stream(serialized_data);
+                    serializer ser(stream, p.type);
+                    ser << batch << end_stream;
+
+                    for (const auto level : {validation_level::none, validation_level::metadata, validation_level::full})
+                    {
+                        CAPTURE(static_cast<int>(level));
+                        const auto decoded = deserialize_stream(
+                            std::span<const uint8_t>(serialized_data),
+                            read_options{.validation = level}
+                        );
+                        REQUIRE_EQ(decoded.size(), 1);
+                        CHECK(decoded[0] == batch);
+                    }
+
+                    const auto projected = deserialize_stream(
+                        std::span<const uint8_t>(serialized_data),
+                        read_options{.field_indices = std::vector<size_t>{2, 1}}
+                    );
+                    REQUIRE_EQ(projected.size(), 1);
+                    CHECK(projected[0].get_column("dense_col") == batch.get_column("dense_col"));
+                    CHECK(projected[0].get_column("int_col") == batch.get_column("int_col"));
+                }
+            }
+
+            const auto serialized_data = serialize_record_batches({batch});
+            const auto* message = org::apache::arrow::flatbuf::GetMessage(serialized_data.data() + 8);
+            const decoded_schema schema = decode_schema(*message->header_as_Schema());
+            REQUIRE_EQ(schema.plan->fields.size(), 3);
+            CHECK_EQ(schema.plan->fields[0].format, "+us:0,1,2");
+            // type ids, then 2 + 3 + 2 buffers of the children
+            CHECK_EQ(schema.plan->fields[0].buffer_count, 8);
+            CHECK_EQ(schema.plan->fields[1].format, "+ud:0,1");
+            CHECK_EQ(schema.plan->fields[1].first_buffer, 8);
+            CHECK_EQ(schema.plan->fields[1].buffer_count, 7);
+            CHECK_EQ(schema.plan->fields[2].first_buffer, 15);
+
+            SUBCASE("undeclared type id")
+            {
+                // Locate the type ids of the dense union in the body of the RecordBatch message
+                const auto message_size = [&](size_t message_offset)
+                {
+                    int32_t metadata_length = 0;
+                    std::memcpy(&metadata_length, serialized_data.data() + message_offset + 4, sizeof(metadata_length));
+                    return (8 + static_cast<size_t>(metadata_length) + 7) / 8 * 8;
+                };
+                const size_t record_batch_offset = message_size(0);
+                const size_t body_offset = record_batch_offset + message_size(record_batch_offset);
+                const auto* record_batch_message = org::apache::arrow::flatbuf::GetMessage(
+                    serialized_data.data() + record_batch_offset + 8
+                );
+                const auto* record_batch = record_batch_message->header_as_RecordBatch();
+                REQUIRE(record_batch != nullptr);
+                auto corrupted = serialized_data;
+                corrupted[body_offset + static_cast<size_t>(record_batch->buffers()->Get(8)->offset())] = 5;
+                CHECK_NOTHROW(
+                    std::ignore = deserialize_stream(
+                        std::span<const uint8_t>(corrupted),
+                        read_options{.validation = validation_level::metadata}
+                    )
+                );
+                CHECK_THROWS_AS(
+                    std::ignore = deserialize_stream(
+                        std::span<const uint8_t>(corrupted),
+                        read_options{.validation = validation_level::full}
+                    ),
+                    std::runtime_error
+                );
+            }
+        }
+
+        TEST_CASE("deserialize run-end encoded columns")
+        {
+            auto int_col = sp::run_end_encoded_array(
+                sp::array(sp::primitive_array<int32_t>({3, 5, 6})),
+                sp::array(sp::primitive_array<int64_t>(std::vector<int64_t>{7, 8, 9}, std::vector<bool>{true, false, true}))
+            );
+            auto string_col = sp::run_end_encoded_array(
+                sp::array(sp::primitive_array<int64_t>({2, 6})),
+                sp::array(sp::string_array(std::vector<std::string>{"ok", "failed"}))
+            );
+            auto bool_col = sp::run_end_encoded_array(
+                sp::array(sp::primitive_array<int16_t>({1, 6})),
+                sp::array(sp::primitive_array<bool>({true, false}))
+            );
+            const sp::record_batch batch(
+                {{"int_col", sp::array(std::move(int_col))},
+                 {"string_col", sp::array(std::move(string_col))},
+                 {"bool_col", sp::array(std::move(bool_col))}}
+            );
+
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    std::vector<uint8_t> serialized_data;
+                    memory_output_stream stream(serialized_data);
+                    serializer ser(stream, p.type);
+                    ser << batch << end_stream;
+
+                    for (const auto level : {validation_level::none, validation_level::metadata, validation_level::full})
+                    {
+                        CAPTURE(static_cast<int>(level));
+                        const auto decoded = deserialize_stream(
+                            std::span<const uint8_t>(serialized_data),
+                            read_options{.validation = level}
+                        );
+                        REQUIRE_EQ(decoded.size(), 1);
+                        CHECK(decoded[0] == batch);
+                        CHECK_EQ(decoded[0].get_column("int_col").data_type(), sp::data_type::RUN_ENCODED);
+
+                        const auto expanded = deserialize_stream(
+                            std::span<const uint8_t>(serialized_data),
+                            read_options{.validation = level, .expand_run_end_encoded = true}
+                        );
+                        REQUIRE_EQ(expanded.size(), 1);
+                        CHECK(
+                            expanded[0].get_column("int_col")
+                            == sp::array(sp::primitive_array<int64_t>(
+                                std::vector<int64_t>{7, 7, 7, 0, 0, 9},
+                                std::vector<bool>{true, true, true, false, false, true}
+                            ))
+                        );
+                        CHECK_EQ(expanded[0].get_column("int_col").null_count(), 2);
+                        CHECK(
+                            expanded[0].get_column("string_col")
+                            == sp::array(sp::string_array(
+                                std::vector<std::string>{"ok", "ok", "failed", "failed", "failed", "failed"}
+                            ))
+                        );
+                        CHECK(
+                            expanded[0].get_column("bool_col")
+                            == sp::array(sp::primitive_array<bool>({true, false, false, false, false, false}))
+                        );
+                    }
+                }
+            }
+        }
+
+        TEST_CASE("deserialize a stream written in the other byte order")
+        {
+            constexpr std::endian foreign = std::endian::native == std::endian::little ? std::endian::big
+                                                                                        : std::endian::little;
+            const sp::record_batch batch(
+                {{"int_col",
+                  sp::array(sp::primitive_array<int32_t>(
+                      std::vector<int32_t>{1, -2, 3},
+                      std::vector<bool>{true, false, true}
+                  ))},
+                 {"int64_col", sp::array(sp::primitive_array<int64_t>({int64_t{1} << 40, -5, 7}))},
+                 {"double_col", sp::array(sp::primitive_array<double>({0.5, -1.25, 1e10}))},
+                 {"string_col", sp::array(sp::string_array(std::vector<std::string>{"a", "bc", "def"}))},
+                 {"string_view_col",
+                  sp::array(sp::string_view_array(std::vector<std::string>{"short", "longer than its view", ""}))},
+                 {"list_view_col",
+                  sp::array(sp::list_view_array(
+                      sp::array(sp::primitive_array<int16_t>({10, 20, 30, 40})),
+                      sp::list_view_array::offset_buffer_type{2, 0, 1},
+                      sp::list_view_array::size_buffer_type{2, 1, 3},
+                      std::vector<bool>{true, true, true}
+                  ))}}
+            );
+
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    std::vector<uint8_t> serialized_data;
+                    memory_output_stream stream(serialized_data);
+                    serializer ser(stream, p.type, foreign);
+                    ser << batch << batch << end_stream;
+
+                    const auto* message = org::apache::arrow::flatbuf::GetMessage(serialized_data.data() + 8);
+                    const decoded_schema schema = decode_schema(*message->header_as_Schema());
+                    CHECK(schema.plan->swap_byte_order);
+                    CHECK_NE(serialized_data, serialize_record_batches({batch, batch}));
+
+                    for (const size_t threads : {size_t{1}, size_t{4}})
+                    {
+                        CAPTURE(threads);
+                        const auto decoded = deserialize_stream(
+                            std::span<const uint8_t>(serialized_data),
+                            read_options{.validation = validation_level::full, .decompression_threads = threads}
+                        );
+                        REQUIRE_EQ(decoded.size(), 2);
+                        CHECK(decoded[0] == batch);
+                        CHECK(decoded[1] == batch);
+                    }
+
+                    const auto projected = deserialize_stream(
+                        std::span<const uint8_t>(serialized_data),
+                        read_options{.field_names = std::vector<std::string>{"list_view_col", "int64_col"}}
+                    );
+                    REQUIRE_EQ(projected.size(), 2);
+                    CHECK(projected[0].get_column("list_view_col") == batch.get_column("list_view_col"));
+                    CHECK(projected[0].get_column("int64_col") == batch.get_column("int64_col"));
+                }
+            }
+        }
     }
 }
@@ -0,0 +1,476 @@
+#include <cstring>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <sparrow/record_batch.hpp>
+
+#include "Message_generated.h"
+#include "sparrow_ipc/chunk_memory_output_stream.hpp"
+#include "sparrow_ipc/chunk_memory_serializer.hpp"
+#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/magic_values.hpp"
+#include "sparrow_ipc/memory_output_stream.hpp"
+#include "sparrow_ipc/serializer.hpp"
+#include "sparrow_ipc/stream_file_serializer.hpp"
+#include "sparrow_ipc/stream_reader.hpp"
+
+namespace sparrow_ipc
+{
+    namespace sp = sparrow;
+    namespace fb = org::apache::arrow::flatbuf;
+
+    namespace
+    {
+        // Body of a message, with the Buffer describing each of its buffers
+        struct message_body
+        {
+            std::vector<uint8_t> bytes;
+            std::vector<fb::Buffer> buffers;
+
+            template <class T>
+            void add(const std::vector<T>& values)
+            {
+                const auto offset = static_cast<int64_t>(bytes.size());
+                const size_t size = values.size() * sizeof(T);
+                bytes.resize(bytes.size() + size);
+                if (size > 0)
+                {
+                    std::memcpy(bytes.data() + offset, values.data(), size);
+                }
+                bytes.resize((bytes.size() + 7) / 8 * 8, 0);
+                buffers.emplace_back(offset, static_cast<int64_t>(size));
+            }
+
+            void add_empty()
+            {
+                buffers.emplace_back(static_cast<int64_t>(bytes.size()), 0);
+            }
+        };
+
+        void append_message(
+            std::vector<uint8_t>& stream,
+            flatbuffers::FlatBufferBuilder& builder,
+            fb::MessageHeader header_type,
+            flatbuffers::Offset<void> header,
+            const std::vector<uint8_t>& body = {}
+        )
+        {
+            builder.Finish(fb::CreateMessage(
+                builder,
+                fb::MetadataVersion::V5,
+                header_type,
+                header,
+                static_cast<int64_t>(body.size())
+            ));
+            const auto metadata_size = static_cast<int32_t>((builder.GetSize() + 7) / 8 * 8);
+            stream.insert(stream.end(), continuation.begin(), continuation.end());
+            const auto* size_bytes = reinterpret_cast<const uint8_t*>(&metadata_size);
+            stream.insert(stream.end(), size_bytes, size_bytes + sizeof(metadata_size));
+            stream.insert(stream.end(), builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+            stream.resize(stream.size() + static_cast<size_t>(metadata_size) - builder.GetSize(), 0);
+            stream.insert(stream.end(), body.begin(), body.end());
+        }
+
+        // Schema with a string column encoded with dictionary 0 and int16 indices, and an int64
+        // column encoded with the ordered dictionary 1 and int8 indices
+        void append_schema(std::vector<uint8_t>& stream)
+        {
+            flatbuffers::FlatBufferBuilder builder;
+            const std::vector<flatbuffers::Offset<fb::Field>> fields = {
+                fb::CreateFieldDirect(
+                    builder,
+                    "city",
+                    true,
+                    fb::Type::Utf8,
+                    fb::CreateUtf8(builder).Union(),
+                    fb::CreateDictionaryEncoding(builder, 0, fb::CreateInt(builder, 16, true))
+                ),
+                fb::CreateFieldDirect(
+                    builder,
+                    "code",
+                    false,
+                    fb::Type::Int,
+                    fb::CreateInt(builder, 64, true).Union(),
+                    fb::CreateDictionaryEncoding(builder, 1, fb::CreateInt(builder, 8, true), true)
+                )
+            };
+            const auto schema = fb::CreateSchemaDirect(builder, fb::Endianness::Little, &fields);
+            append_message(stream, builder, fb::MessageHeader::Schema, schema.Union());
+        }
+
+        void append_string_dictionary(
+            std::vector<uint8_t>& stream,
+            int64_t id,
+            const std::vector<std::string>& values,
+            bool is_delta
+        )
+        {
+            std::vector<int32_t> offsets = {0};
+            std::string data;
+            for (const auto& value : values)
+            {
+                data += value;
+                offsets.push_back(static_cast<int32_t>(data.size()));
+            }
+            message_body body;
+            body.add_empty();
+            body.add(offsets);
+            body.add(std::vector<char>(data.begin(), data.end()));
+
+            flatbuffers::FlatBufferBuilder builder;
+            const auto length = static_cast<int64_t>(values.size());
+            const std::vector<fb::FieldNode> nodes = {fb::FieldNode(length, 0)};
+            const auto record_batch = fb::CreateRecordBatchDirect(builder, length, &nodes, &body.buffers);
+            const auto dictionary_batch = fb::CreateDictionaryBatch(builder, id, record_batch, is_delta);
+            append_message(stream, builder, fb::MessageHeader::DictionaryBatch, dictionary_batch.Union(), body.bytes);
+        }
+
+        void append_int64_dictionary(std::vector<uint8_t>& stream, int64_t id, const std::vector<int64_t>& values)
+        {
+            message_body body;
+            body.add_empty();
+            body.add(values);
+
+            flatbuffers::FlatBufferBuilder builder;
+            const auto length = static_cast<int64_t>(values.size());
+            const std::vector<fb::FieldNode> nodes = {fb::FieldNode(length, 0)};
+            const auto record_batch = fb::CreateRecordBatchDirect(builder, length, &nodes, &body.buffers);
+            const auto dictionary_batch = fb::CreateDictionaryBatch(builder, id, record_batch);
+            append_message(stream, builder, fb::MessageHeader::DictionaryBatch, dictionary_batch.Union(), body.bytes);
+        }
+
+        // RecordBatch of the schema of append_schema; a negative city index is a null
+        void append_record_batch(
+            std::vector<uint8_t>& stream,
+            const std::vector<int16_t>& city_indices,
+            const std::vector<int8_t>& code_indices
+        )
+        {
+            const auto length = static_cast<int64_t>(city_indices.size());
+            std::vector<uint8_t> validity((city_indices.size() + 7) / 8, 0);
+            int64_t null_count = 0;
+            for (size_t i = 0; i < city_indices.size(); ++i)
+            {
+                if (city_indices[i] >= 0)
+                {
+                    validity[i / 8] = static_cast<uint8_t>(validity[i / 8] | (1u << (i % 8)));
+                }
+                else
+                {
+                    ++null_count;
+                }
+            }
+            message_body body;
+            body.add(validity);
+            body.add(city_indices);
+            body.add_empty();
+            body.add(code_indices);
+
+            flatbuffers::FlatBufferBuilder builder;
+            const std::vector<fb::FieldNode> nodes = {fb::FieldNode(length, null_count), fb::FieldNode(length, 0)};
+            const auto record_batch = fb::CreateRecordBatchDirect(builder, length, &nodes, &body.buffers);
+            append_message(stream, builder, fb::MessageHeader::RecordBatch, record_batch.Union(), body.bytes);
+        }
+
+        void append_end_of_stream(std::vector<uint8_t>& stream)
+        {
+            stream.insert(stream.end(), end_of_stream.begin(), end_of_stream.end());
+        }
+
+        bool is_valid(const ArrowArray& array, int64_t index)
+        {
+            const auto* validity = static_cast<const uint8_t*>(array.buffers[0]);
+            const auto i = static_cast<size_t>(array.offset + index);
+            return validity == nullptr || ((validity[i / 8] >> (i % 8)) & 1) != 0;
+        }
+
+        // Values of the city column, read through its indices and its dictionary
+        std::vector<std::optional<std::string>> city_values(const sp::record_batch& batch)
+        {
+            sp::array column = batch.get_column("city");
+            const auto& proxy = sp::detail::array_access::get_arrow_proxy(column);
+            const ArrowArray& indices = proxy.array();
+            REQUIRE_NE(indices.dictionary, nullptr);
+            REQUIRE_NE(proxy.schema().dictionary, nullptr);
+            CHECK_EQ(std::string(proxy.schema().format), "s");
+            CHECK_EQ(std::string(proxy.schema().dictionary->format), "u");
+
+            const ArrowArray& values = *indices.dictionary;
+            const auto* index_data = static_cast<const int16_t*>(indices.buffers[1]) + indices.offset;
+            const auto* offsets = static_cast<const int32_t*>(values.buffers[1]) + values.offset;
+            const auto* data = static_cast<const char*>(values.buffers[2]);
+            std::vector<std::optional<std::string>> result;
+            for (int64_t i = 0; i < indices.length; ++i)
+            {
+                if (!is_valid(indices, i))
+                {
+                    result.emplace_back(std::nullopt);
+                    continue;
+                }
+                const int16_t index = index_data[i];
+                REQUIRE_LT(index, values.length);
+                result.emplace_back(std::string(data + offsets[index], data + offsets[index + 1]));
+            }
+            return result;
+        }
+
+        std::vector<int64_t> code_values(const sp::record_batch& batch)
+        {
+            sp::array column = batch.get_column("code");
+            const auto& proxy = sp::detail::array_access::get_arrow_proxy(column);
+            CHECK_EQ(std::string(proxy.schema().format), "c");
+            CHECK_NE(proxy.schema().flags & static_cast<int64_t>(sp::ArrowFlag::DICTIONARY_ORDERED), 0);
+            const ArrowArray& indices = proxy.array();
+            REQUIRE_NE(indices.dictionary, nullptr);
+            const auto* index_data = static_cast<const int8_t*>(indices.buffers[1]) + indices.offset;
+            const auto* values = static_cast<const int64_t*>(indices.dictionary->buffers[1]);
+            std::vector<int64_t> result;
+            for (int64_t i = 0; i < indices.length; ++i)
+            {
+                result.push_back(values[index_data[i]]);
+            }
+            return result;
+        }
+
+        using strings = std::vector<std::optional<std::string>>;
+
+        // Stream with a delta of the string dictionary and a replacement of the int64 one
+        std::vector<uint8_t> make_dictionary_stream()
+        {
+            std::vector<uint8_t> stream;
+            append_schema(stream);
+            append_string_dictionary(stream, 0, {"paris", "london"}, false);
+            append_int64_dictionary(stream, 1, {10, 20, 30});
+            append_record_batch(stream, {0, 1, -1, 0}, {2, 0, 1, 1});
+            append_string_dictionary(stream, 0, {"tokyo"}, true);
+            append_record_batch(stream, {2, 1}, {0, 2});
+            append_int64_dictionary(stream, 1, {7});
+            append_string_dictionary(stream, 0, {"", "lima"}, true);
+            append_record_batch(stream, {4, -1, 2}, {0, 0, 0});
+            append_end_of_stream(stream);
+            return stream;
+        }
+
+        void check_dictionary_batches(const std::vector<sp::record_batch>& batches)
+        {
+            REQUIRE_EQ(batches.size(), 3);
+            CHECK_EQ(city_values(batches[0]), strings{"paris", "london", std::nullopt, "paris"});
+            CHECK_EQ(code_values(batches[0]), std::vector<int64_t>{30, 10, 20, 20});
+            CHECK_EQ(city_values(batches[1]), strings{"tokyo", "london"});
+            CHECK_EQ(code_values(batches[1]), std::vector<int64_t>{10, 30});
+            CHECK_EQ(city_values(batches[2]), strings{"lima", std::nullopt, "tokyo"});
+            CHECK_EQ(code_values(batches[2]), std::vector<int64_t>{7, 7, 7});
+        }
+
+        using dictionary_messages = std::vector<std::pair<int64_t, bool>>;
+
+        // Id and isDelta flag of the DictionaryBatch messages of an encapsulated stream, in order
+        dictionary_messages get_dictionary_messages(std::span<const uint8_t> stream)
+        {
+            dictionary_messages result;
+            size_t position = 0;
+            while (position + 8 <= stream.size())
+            {
+                int32_t metadata_size = 0;
+                std::memcpy(&metadata_size, stream.data() + position + 4, sizeof(metadata_size));
+                position += 8;
+                if (metadata_size == 0)
+                {
+                    break;
+                }
+                const auto* message = fb::GetMessage(stream.data() + position);
+                position += static_cast<size_t>(metadata_size) + static_cast<size_t>(message->bodyLength());
+                if (message->header_type() == fb::MessageHeader::DictionaryBatch)
+                {
+                    const auto* dictionary_batch = message->header_as_DictionaryBatch();
+                    result.emplace_back(dictionary_batch->id(), dictionary_batch->isDelta());
+                }
+            }
+            return result;
+        }
+    }
+
+    TEST_SUITE("dictionary")
+    {
+        TEST_CASE("deserialize_stream with dictionaries and deltas")
+        {
+            const std::vector<uint8_t> stream = make_dictionary_stream();
+            for (const auto level : {validation_level::none, validation_level::metadata, validation_level::full})
+            {
+                CAPTURE(static_cast<int>(level));
+                for (const size_t num_threads : {size_t{1}, size_t{0}})
+                {
+                    CAPTURE(num_threads);
+                    const auto batches = deserialize_stream(
+                        std::span<const uint8_t>(stream),
+                        read_options{.num_threads = num_threads, .validation = level}
+                    );
+                    check_dictionary_batches(batches);
+                }
+            }
+        }
+
+        TEST_CASE("decoded arrays outlive the stream and the following dictionaries")
+        {
+            std::vector<sp::record_batch> batches = deserialize_stream(make_dictionary_stream());
+            check_dictionary_batches(batches);
+            const sp::record_batch first = std::move(batches[0]);
+            batches.clear();
+            CHECK_EQ(city_values(first), strings{"paris", "london", std::nullopt, "paris"});
+        }
+
+        TEST_CASE("stream_reader with dictionaries and deltas")
+        {
+            const std::vector<uint8_t> stream = make_dictionary_stream();
+            std::istringstream iss(std::string(stream.begin(), stream.end()));
+            stream_reader reader(iss);
+            std::vector<sp::record_batch> batches;
+            while (auto batch = reader.next())
+            {
+                batches.push_back(std::move(*batch));
+            }
+            check_dictionary_batches(batches);
+        }
+
+        TEST_CASE("projection skips the unused dictionaries")
+        {
+            const auto batches = deserialize_stream(
+                std::span<const uint8_t>(make_dictionary_stream()),
+                read_options{.field_names = std::vector<std::string>{"city"}}
+            );
+            REQUIRE_EQ(batches.size(), 3);
+            CHECK_EQ(batches[0].nb_columns(), 1);
+            CHECK_EQ(city_values(batches[2]), strings{"lima", std::nullopt, "tokyo"});
+        }
+
+        TEST_CASE("serializer writes dictionaries and deltas")
+        {
+            const auto batches = deserialize_stream(make_dictionary_stream());
+            for (const auto compression : {std::optional<CompressionType>{}, std::optional{CompressionType::LZ4_FRAME}})
+            {
+                CAPTURE(compression.has_value());
+                std::vector<uint8_t> stream;
+                memory_output_stream output(stream);
+                {
+                    serializer ser(output, compression);
+                    ser << batches << end_stream;
+                }
+
+                // The city dictionary only grows, the code one is replaced by the last batch
+                CHECK_EQ(
+                    get_dictionary_messages(stream),
+                    dictionary_messages{{0, false}, {1, false}, {0, true}, {0, true}, {1, false}}
+                );
+                check_dictionary_batches(deserialize_stream(std::span<const uint8_t>(stream)));
+            }
+        }
+
+        TEST_CASE("stream_file_serializer writes dictionaries and deltas")
+        {
+            auto batches = deserialize_stream(make_dictionary_stream());
+
+            SUBCASE("Deltas are written and listed in the footer")
+            {
+                batches.pop_back();
+                std::vector<uint8_t> file;
+                memory_output_stream output(file);
+                {
+                    stream_file_serializer ser(output);
+                    ser << batches << end_file;
+                }
+
+                CHECK_EQ(
+                    get_dictionary_messages(std::span<const uint8_t>(file).subspan(arrow_file_header_magic.size())),
+                    dictionary_messages{{0, false}, {1, false}, {0, true}}
+                );
+                const auto decoded = deserialize_file(std::span<const uint8_t>(file));
+                REQUIRE_EQ(decoded.size(), 2);
+                CHECK_EQ(city_values(decoded[1]), strings{"tokyo", "london"});
+                CHECK_EQ(code_values(decoded[1]), std::vector<int64_t>{10, 30});
+            }
+
+            SUBCASE("Replacing a dictionary throws")
+            {
+                std::vector<uint8_t> file;
+                memory_output_stream output(file);
+                stream_file_serializer ser(output);
+                CHECK_THROWS_AS(ser << batches, std::invalid_argument);
+            }
+        }
+
+        TEST_CASE("chunk_serializer writes dictionaries and deltas")
+        {
+            const auto batches = deserialize_stream(make_dictionary_stream());
+            std::vector<std::vector<uint8_t>> chunks;
+            chunked_memory_output_stream output(chunks);
+            chunk_serializer ser(output);
+            ser << batches;
+            ser.end();
+
+            // Schema, 5 DictionaryBatch, 3 RecordBatch and end of stream
+            CHECK_EQ(chunks.size(), 10);
+            std::vector<uint8_t> stream;
+            for (const auto& chunk : chunks)
+            {
+                stream.insert(stream.end(), chunk.begin(), chunk.end());
+            }
+            CHECK_EQ(
+                get_dictionary_messages(stream),
+                dictionary_messages{{0, false}, {1, false}, {0, true}, {0, true}, {1, false}}
+            );
+            check_dictionary_batches(deserialize_stream(std::span<const uint8_t>(stream)));
+        }
+
+        TEST_CASE("errors")
+        {
+            SUBCASE("RecordBatch before its dictionary")
+            {
+                std::vector<uint8_t> stream;
+                append_schema(stream);
+                append_string_dictionary(stream, 0, {"paris"}, false);
+                append_record_batch(stream, {0}, {0});
+                append_end_of_stream(stream);
+                CHECK_THROWS_AS((void) deserialize_stream(std::span<const uint8_t>(stream)), std::runtime_error);
+            }
+
+            SUBCASE("Delta before the dictionary")
+            {
+                std::vector<uint8_t> stream;
+                append_schema(stream);
+                append_string_dictionary(stream, 0, {"paris"}, true);
+                append_end_of_stream(stream);
+                CHECK_THROWS_AS((void) deserialize_stream(std::span<const uint8_t>(stream)), std::runtime_error);
+            }
+
+            SUBCASE("DictionaryBatch before the Schema")
+            {
+                std::vector<uint8_t> stream;
+                append_string_dictionary(stream, 0, {"paris"}, false);
+                append_end_of_stream(stream);
+                CHECK_THROWS_AS((void) deserialize_stream(std::span<const uint8_t>(stream)), std::runtime_error);
+            }
+
+            SUBCASE("Index out of the dictionary")
+            {
+                std::vector<uint8_t> stream;
+                append_schema(stream);
+                append_string_dictionary(stream, 0, {"paris"}, false);
+                append_int64_dictionary(stream, 1, {10});
+                append_record_batch(stream, {0, 1}, {0, 0});
+                append_end_of_stream(stream);
+                CHECK_THROWS_AS(
+                    (void) deserialize_stream(
+                        std::span<const uint8_t>(stream),
+                        read_options{.validation = validation_level::full}
+                    ),
+                    std::runtime_error
+                );
+            }
+        }
+    }
+}
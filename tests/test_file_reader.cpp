@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <sparrow/record_batch.hpp>
+
+#include "sparrow_ipc/file_reader.hpp"
+#include "sparrow_ipc/magic_values.hpp"
+#include "sparrow_ipc/memory_mapped_file.hpp"
+#include "sparrow_ipc/memory_output_stream.hpp"
+#include "sparrow_ipc/stream_file_serializer.hpp"
+#include "sparrow_ipc_tests_helpers.hpp"
+
+namespace sparrow_ipc
+{
+    namespace sp = sparrow;
+
+    namespace
+    {
+        std::vector<sp::record_batch> create_numbered_record_batches(size_t count)
+        {
+            std::vector<sp::record_batch> batches;
+            for (size_t i = 0; i < count; ++i)
+            {
+                std::vector<int32_t> values(10 + i, static_cast<int32_t>(i));
+                batches.push_back(sp::record_batch(
+                    {{"index", sp::array(sp::primitive_array<int32_t>(values))},
+                     {"label", sp::array(sp::string_array(std::vector<std::string>(10 + i, std::to_string(i))))}}
+                ));
+            }
+            return batches;
+        }
+
+        std::vector<uint8_t>
+        serialize_to_file_data(const std::vector<sp::record_batch>& batches, std::optional<CompressionType> compression)
+        {
+            std::vector<uint8_t> file_data;
+            memory_output_stream stream(file_data);
+            {
+                stream_file_serializer serializer(stream, compression);
+                serializer << batches << end_file;
+            }
+            return file_data;
+        }
+
+        std::filesystem::path write_temporary_file(const std::vector<uint8_t>& data, const std::string& name)
+        {
+            const auto path = std::filesystem::temp_directory_path() / name;
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            return path;
+        }
+    }
+
+    TEST_SUITE("file_reader")
+    {
+        TEST_CASE("random access from memory")
+        {
+            const auto batches = create_numbered_record_batches(5);
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    const auto file_data = serialize_to_file_data(batches, p.type);
+                    const file_reader reader(std::span<const uint8_t>(file_data));
+                    REQUIRE_EQ(reader.num_record_batches(), batches.size());
+                    CHECK_EQ(reader.names(), std::vector<std::string>{"index", "label"});
+
+                    // Read in reverse order
+                    for (size_t i = batches.size(); i-- > 0;)
+                    {
+                        CHECK(reader.read_record_batch(i) == batches[i]);
+                    }
+                    CHECK_THROWS_AS(std::ignore = reader.read_record_batch(batches.size()), std::out_of_range);
+                    CHECK(reader.read_all() == batches);
+                }
+            }
+        }
+
+        TEST_CASE("read all record batches with several threads")
+        {
+            const auto batches = create_numbered_record_batches(16);
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    const auto file_data = serialize_to_file_data(batches, p.type);
+                    const file_reader reader(std::span<const uint8_t>(file_data));
+                    CHECK(reader.read_all(read_options{.num_threads = 4}) == batches);
+                    CHECK(deserialize_file(file_data, read_options{.num_threads = 0}) == batches);
+                }
+            }
+        }
+
+        TEST_CASE("parallel decompression of the buffers of a record batch")
+        {
+            const auto batches = create_numbered_record_batches(3);
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    const auto file_data = serialize_to_file_data(batches, p.type);
+                    const file_reader reader(
+                        std::span<const uint8_t>(file_data),
+                        nullptr,
+                        read_options{.decompression_threads = 4}
+                    );
+                    CHECK(reader.read_record_batch(2) == batches[2]);
+                    CHECK(reader.read_all(read_options{.num_threads = 2}) == batches);
+
+                    const auto projected = deserialize_file(
+                        file_data,
+                        read_options{.field_names = std::vector<std::string>{"label"}, .decompression_threads = 0}
+                    );
+                    REQUIRE_EQ(projected.size(), batches.size());
+                    for (size_t i = 0; i < batches.size(); ++i)
+                    {
+                        REQUIRE_EQ(projected[i].nb_columns(), 1);
+                        CHECK(projected[i].get_column("label") == batches[i].get_column("label"));
+                    }
+                }
+            }
+        }
+
+        TEST_CASE("projection")
+        {
+            const auto batches = create_numbered_record_batches(4);
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    const auto file_data = serialize_to_file_data(batches, p.type);
+                    const file_reader reader(
+                        std::span<const uint8_t>(file_data),
+                        nullptr,
+                        read_options{.field_names = std::vector<std::string>{"label"}}
+                    );
+                    CHECK_EQ(reader.names(), std::vector<std::string>{"label"});
+                    const auto batch = reader.read_record_batch(3);
+                    REQUIRE_EQ(batch.nb_columns(), 1);
+                    CHECK(batch.get_column("label") == batches[3].get_column("label"));
+
+                    // A projection given to read_all replaces the one of the reader
+                    const auto all = reader.read_all(
+                        read_options{.num_threads = 2, .field_indices = std::vector<size_t>{1, 0}}
+                    );
+                    REQUIRE_EQ(all.size(), batches.size());
+                    for (size_t i = 0; i < batches.size(); ++i)
+                    {
+                        CHECK_EQ(all[i].names()[0], "label");
+                        CHECK_EQ(all[i].names()[1], "index");
+                        CHECK(all[i].get_column("index") == batches[i].get_column("index"));
+                        CHECK(all[i].get_column("label") == batches[i].get_column("label"));
+                    }
+                }
+            }
+        }
+
+        TEST_CASE("deserialize_file applies the read options to the footer and the record batches")
+        {
+            SUBCASE("validation level")
+            {
+                const auto batches = create_numbered_record_batches(2);
+                auto file_data = serialize_to_file_data(batches, std::nullopt);
+
+                // Overwrite the null terminator of a field name of the footer schema: the footer
+                // fails verification, but the name is still read from its length
+                int32_t footer_size = 0;
+                std::memcpy(
+                    &footer_size,
+                    file_data.data() + file_data.size() - arrow_file_magic_size - sizeof(int32_t),
+                    sizeof(int32_t)
+                );
+                const auto footer_begin = file_data.end() - static_cast<std::ptrdiff_t>(arrow_file_magic_size)
+                                          - static_cast<std::ptrdiff_t>(sizeof(int32_t)) - footer_size;
+                const std::string name = "label";
+                const auto name_position = std::search(footer_begin, file_data.end(), name.begin(), name.end());
+                REQUIRE(name_position != file_data.end());
+                *(name_position + static_cast<std::ptrdiff_t>(name.size())) = 'x';
+
+                CHECK_THROWS_AS(std::ignore = deserialize_file(file_data), std::runtime_error);
+                CHECK(deserialize_file(file_data, read_options{.validation = validation_level::none}) == batches);
+            }
+
+            SUBCASE("run-end encoded expansion")
+            {
+                const sp::record_batch batch(
+                    {{"runs",
+                      sp::array(sp::run_end_encoded_array(
+                          sp::array(sp::primitive_array<int32_t>({2, 3})),
+                          sp::array(sp::primitive_array<int64_t>({7, 8}))
+                      ))}}
+                );
+                const auto file_data = serialize_to_file_data({batch}, std::nullopt);
+
+                const auto decoded = deserialize_file(file_data, read_options{});
+                REQUIRE_EQ(decoded.size(), 1);
+                CHECK_EQ(decoded[0].get_column("runs").data_type(), sp::data_type::RUN_ENCODED);
+
+                const auto expanded = deserialize_file(file_data, read_options{.expand_run_end_encoded = true});
+                REQUIRE_EQ(expanded.size(), 1);
+                CHECK(expanded[0].get_column("runs") == sp::array(sp::primitive_array<int64_t>({7, 7, 8})));
+            }
+        }
+
+        TEST_CASE("read_all keeps the decoding flags of the reader")
+        {
+            const sp::record_batch batch(
+                {{"index", sp::array(sp::primitive_array<int32_t>({1, 2, 3}))},
+                 {"runs",
+                  sp::array(sp::run_end_encoded_array(
+                      sp::array(sp::primitive_array<int32_t>({2, 3})),
+                      sp::array(sp::primitive_array<int64_t>({7, 8}))
+                  ))}}
+            );
+            const auto file_data = serialize_to_file_data({batch}, std::nullopt);
+            const auto projection = std::vector<std::string>{"runs"};
+
+            const file_reader expanding_reader(
+                std::span<const uint8_t>(file_data),
+                nullptr,
+                read_options{.expand_run_end_encoded = true}
+            );
+            const file_reader reader{std::span<const uint8_t>(file_data)};
+            for (const auto& options :
+                 {read_options{.expand_run_end_encoded = false},
+                  read_options{.field_names = projection, .expand_run_end_encoded = false}})
+            {
+                const auto expanded = expanding_reader.read_all(options);
+                REQUIRE_EQ(expanded.size(), 1);
+                CHECK(expanded[0].get_column("runs") == sp::array(sp::primitive_array<int64_t>({7, 7, 8})));
+            }
+            for (const auto& options :
+                 {read_options{.expand_run_end_encoded = true},
+                  read_options{.field_names = projection, .expand_run_end_encoded = true}})
+            {
+                const auto decoded = reader.read_all(options);
+                REQUIRE_EQ(decoded.size(), 1);
+                CHECK_EQ(decoded[0].get_column("runs").data_type(), sp::data_type::RUN_ENCODED);
+            }
+        }
+
+        TEST_CASE("memory-mapped file")
+        {
+            const auto batches = create_numbered_record_batches(3);
+            const auto path = write_temporary_file(serialize_to_file_data(batches, std::nullopt), "sparrow_ipc_file_reader.arrow");
+
+            std::optional<sp::record_batch> last;
+            {
+                const file_reader reader(path);
+                REQUIRE_EQ(reader.num_record_batches(), 3);
+                last = reader.read_record_batch(2);
+            }
+            // The record batch keeps the mapping alive
+            CHECK(*last == batches[2]);
+            last.reset();
+            std::filesystem::remove(path);
+        }
+
+        TEST_CASE("memory_mapped_file")
+        {
+            const std::vector<uint8_t> data = {1, 2, 3, 4};
+            const auto path = write_temporary_file(data, "sparrow_ipc_memory_mapped_file.bin");
+            {
+                memory_mapped_file file(path);
+                CHECK_EQ(file.size(), data.size());
+                CHECK(std::ranges::equal(file.data(), data));
+
+                memory_mapped_file moved(std::move(file));
+                CHECK_EQ(moved.size(), data.size());
+                CHECK_EQ(file.size(), 0);
+            }
+            std::filesystem::remove(path);
+            CHECK_THROWS_AS(memory_mapped_file(path), std::runtime_error);
+        }
+
+        TEST_CASE("invalid files throw")
+        {
+            SUBCASE("Too small")
+            {
+                const std::vector<uint8_t> data(10, 0);
+                CHECK_THROWS_AS(file_reader(std::span<const uint8_t>(data)), std::runtime_error);
+            }
+
+            SUBCASE("Block body length overflowing the file")
+            {
+                auto data = serialize_to_file_data(create_numbered_record_batches(1), std::nullopt);
+                int32_t footer_size = 0;
+                std::memcpy(
+                    &footer_size,
+                    data.data() + data.size() - arrow_file_magic_size - sizeof(int32_t),
+                    sizeof(int32_t)
+                );
+                const size_t footer_offset = data.size() - arrow_file_magic_size - sizeof(int32_t)
+                                             - static_cast<size_t>(footer_size);
+                const auto* footer = org::apache::arrow::flatbuf::GetFooter(data.data() + footer_offset);
+                REQUIRE_EQ(footer->recordBatches()->size(), 1);
+                const auto* block = footer->recordBatches()->Get(0);
+                const auto body_length_offset = static_cast<size_t>(
+                    reinterpret_cast<const uint8_t*>(block) - data.data()
+                ) + 16;
+                const int64_t body_length = std::numeric_limits<int64_t>::max() - 4;
+                std::memcpy(data.data() + body_length_offset, &body_length, sizeof(body_length));
+
+                const file_reader reader{std::span<const uint8_t>(data)};
+                CHECK_EQ(reader.num_record_batches(), 1);
+                CHECK_THROWS_AS(std::ignore = reader.read_record_batch(0), std::runtime_error);
+            }
+
+            SUBCASE("Bad magic")
+            {
+                auto data = serialize_to_file_data(create_numbered_record_batches(1), std::nullopt);
+                data[0] = 'X';
+                CHECK_THROWS_AS(file_reader(std::span<const uint8_t>(data)), std::runtime_error);
+            }
+        }
+    }
+}
@@ -509,6 +509,18 @@ namespace sparrow_ipc
                     get_flatbuffer_type(builder, sparrow::data_type_to_format(sparrow::data_type::MAP)).first,
                     org::apache::arrow::flatbuf::Type::Map
                 );  // MAP
+
+                const auto keys_sorted = [&](int64_t flags)
+                {
+                    const auto map_type = get_flatbuffer_type(builder, "+m", flags).second;
+                    return flatbuffers::GetTemporaryPointer(
+                               builder,
+                               flatbuffers::Offset<org::apache::arrow::flatbuf::Map>(map_type.o)
+                    )
+                        ->keysSorted();
+                };
+                CHECK_FALSE(keys_sorted(0));
+                CHECK(keys_sorted(static_cast<int64_t>(sparrow::ArrowFlag::MAP_KEYS_SORTED)));
             }
 
             SUBCASE("Union types")
@@ -521,6 +533,19 @@ namespace sparrow_ipc
                     get_flatbuffer_type(builder, "+us:").first,
                     org::apache::arrow::flatbuf::Type::Union
                 );  // SPARSE_UNION
+
+                const auto union_type = get_flatbuffer_type(builder, "+ud:3,0,7").second;
+                const auto* fb_union = flatbuffers::GetTemporaryPointer(
+                    builder,
+                    flatbuffers::Offset<org::apache::arrow::flatbuf::Union>(union_type.o)
+                );
+                CHECK_EQ(fb_union->mode(), org::apache::arrow::flatbuf::UnionMode::Dense);
+                REQUIRE(fb_union->typeIds() != nullptr);
+                CHECK_EQ(
+                    std::vector<int32_t>(fb_union->typeIds()->begin(), fb_union->typeIds()->end()),
+                    std::vector<int32_t>{3, 0, 7}
+                );
+                CHECK_THROWS(static_cast<void>(get_flatbuffer_type(builder, "+us:0,x")));  // Invalid type id
             }
 
             SUBCASE("Run-End Encoded type")
@@ -0,0 +1,156 @@
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <sparrow/record_batch.hpp>
+
+#include "sparrow_ipc/file_reader.hpp"
+#include "sparrow_ipc/lazy_record_batch.hpp"
+#include "sparrow_ipc/memory_output_stream.hpp"
+#include "sparrow_ipc/serializer.hpp"
+#include "sparrow_ipc/stream_file_serializer.hpp"
+#include "sparrow_ipc/stream_reader.hpp"
+#include "sparrow_ipc_tests_helpers.hpp"
+
+namespace sparrow_ipc
+{
+    namespace sp = sparrow;
+
+    namespace
+    {
+        std::vector<sp::record_batch> create_lazy_test_batches(size_t count)
+        {
+            std::vector<sp::record_batch> batches;
+            for (size_t i = 0; i < count; ++i)
+            {
+                std::vector<int64_t> keys(100, static_cast<int64_t>(i));
+                std::vector<std::string> values(100, "value_" + std::to_string(i));
+                std::vector<double> weights(100, static_cast<double>(i) / 2);
+                batches.push_back(sp::record_batch(
+                    {{"key", sp::array(sp::primitive_array<int64_t>(keys))},
+                     {"value", sp::array(sp::string_array(values))},
+                     {"weight", sp::array(sp::primitive_array<double>(weights))}}
+                ));
+            }
+            return batches;
+        }
+
+        std::vector<uint8_t>
+        serialize_lazy_test_file(const std::vector<sp::record_batch>& batches, std::optional<CompressionType> compression)
+        {
+            std::vector<uint8_t> file_data;
+            memory_output_stream stream(file_data);
+            {
+                stream_file_serializer serializer(stream, compression);
+                serializer << batches << end_file;
+            }
+            return file_data;
+        }
+    }
+
+    TEST_SUITE("lazy_record_batch")
+    {
+        TEST_CASE("columns are decoded on first access")
+        {
+            const auto batches = create_lazy_test_batches(3);
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    const auto file_data = serialize_lazy_test_file(batches, p.type);
+                    const file_reader reader(std::span<const uint8_t>(file_data));
+                    const lazy_record_batch batch = reader.read_lazy_record_batch(1);
+                    CHECK_EQ(batch.nb_columns(), 3);
+                    CHECK_EQ(batch.nb_rows(), 100);
+                    CHECK_EQ(batch.names(), std::vector<std::string>{"key", "value", "weight"});
+                    CHECK_FALSE(batch.is_materialized(0));
+                    CHECK_FALSE(batch.is_materialized(1));
+                    CHECK_FALSE(batch.is_materialized(2));
+
+                    CHECK(batch.get_column("value") == batches[1].get_column("value"));
+                    CHECK(batch.is_materialized(1));
+                    CHECK_FALSE(batch.is_materialized(0));
+                    CHECK_FALSE(batch.is_materialized(2));
+
+                    // Accessing a column again returns the same array
+                    CHECK_EQ(&batch.get_column(1), &batch.get_column("value"));
+
+                    CHECK_THROWS_AS(std::ignore = batch.get_column(3), std::out_of_range);
+                    CHECK_THROWS_AS(std::ignore = batch.get_column("unknown"), std::out_of_range);
+                }
+            }
+        }
+
+        TEST_CASE("concurrent accesses decode each column once")
+        {
+            const auto batches = create_lazy_test_batches(1);
+            const auto file_data = serialize_lazy_test_file(batches, CompressionType::ZSTD);
+            const file_reader reader(std::span<const uint8_t>(file_data));
+            const lazy_record_batch batch = reader.read_lazy_record_batch(0);
+
+            std::vector<const sp::array*> seen(8, nullptr);
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < seen.size(); ++i)
+            {
+                threads.emplace_back(
+                    [&batch, &seen, i]()
+                    {
+                        seen[i] = &batch.get_column(i % 3);
+                    }
+                );
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            for (size_t i = 0; i < seen.size(); ++i)
+            {
+                CHECK_EQ(seen[i], &batch.get_column(i % 3));
+            }
+            CHECK(batch.get_column("weight") == batches[0].get_column("weight"));
+        }
+
+        TEST_CASE("extract a record batch")
+        {
+            const auto batches = create_lazy_test_batches(2);
+            const auto file_data = serialize_lazy_test_file(batches, CompressionType::LZ4_FRAME);
+            std::optional<sp::record_batch> extracted;
+            {
+                const file_reader reader(std::span<const uint8_t>(file_data));
+                lazy_record_batch batch = reader.read_lazy_record_batch(1);
+                std::ignore = batch.get_column(2);
+                extracted = batch.extract_record_batch();
+                CHECK_EQ(batch.nb_columns(), 0);
+            }
+            CHECK(*extracted == batches[1]);
+        }
+
+        TEST_CASE("lazy record batches from a stream_reader")
+        {
+            const auto batches = create_lazy_test_batches(4);
+            std::vector<uint8_t> buffer;
+            memory_output_stream stream(buffer);
+            serializer ser(stream, CompressionType::ZSTD);
+            ser << batches << end_stream;
+
+            std::istringstream iss(std::string(buffer.begin(), buffer.end()));
+            std::vector<lazy_record_batch> lazy_batches;
+            {
+                stream_reader reader(iss);
+                while (auto batch = reader.next_lazy())
+                {
+                    lazy_batches.push_back(std::move(*batch));
+                }
+            }
+            // The lazy batches own their message and outlive the reader
+            REQUIRE_EQ(lazy_batches.size(), batches.size());
+            for (size_t i = 0; i < batches.size(); ++i)
+            {
+                CHECK(lazy_batches[i].get_column("key") == batches[i].get_column("key"));
+            }
+        }
+    }
+}
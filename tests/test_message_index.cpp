@@ -0,0 +1,128 @@
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <sparrow/record_batch.hpp>
+
+#include "sparrow_ipc/encapsulated_message.hpp"
+#include "sparrow_ipc/magic_values.hpp"
+#include "sparrow_ipc/memory_output_stream.hpp"
+#include "sparrow_ipc/message_index.hpp"
+#include "sparrow_ipc/serializer.hpp"
+#include "sparrow_ipc/stream_file_serializer.hpp"
+
+#include "sparrow_ipc_tests_helpers.hpp"
+
+namespace sparrow_ipc
+{
+    namespace
+    {
+        using org::apache::arrow::flatbuf::MessageHeader;
+
+        std::vector<uint8_t>
+        serialize_stream(const std::vector<sp::record_batch>& batches, std::optional<CompressionType> compression)
+        {
+            std::vector<uint8_t> buffer;
+            memory_output_stream stream(buffer);
+            serializer writer(stream, compression);
+            writer << batches << end_stream;
+            return buffer;
+        }
+
+        std::vector<sp::record_batch> make_batches()
+        {
+            std::vector<sp::record_batch> batches;
+            batches.push_back(create_test_record_batch());
+            batches.push_back(create_compressible_test_record_batch());
+            return batches;
+        }
+    }
+
+    TEST_SUITE("message_index")
+    {
+        TEST_CASE("Scanning a stream indexes its messages")
+        {
+            for (const auto& [compression, name] : compression_params)
+            {
+                SUBCASE(name)
+                {
+                    const std::vector<uint8_t> data = serialize_stream(make_batches(), compression);
+                    const message_index index = scan_stream(data);
+
+                    REQUIRE_EQ(index.messages.size(), 3);
+                    CHECK_EQ(index.messages[0].type, MessageHeader::Schema);
+                    CHECK_EQ(index.messages[0].offset, 0);
+                    CHECK_EQ(index.messages[1].type, MessageHeader::RecordBatch);
+                    CHECK_EQ(index.messages[1].num_rows, 5);
+                    CHECK_EQ(index.messages[1].compression, compression);
+                    CHECK_EQ(index.messages[2].type, MessageHeader::RecordBatch);
+                    CHECK_EQ(index.messages[2].num_rows, 1000);
+                    CHECK(index.has_end_of_stream);
+                    CHECK_EQ(index.end_offset + end_of_stream.size(), data.size());
+
+                    // The lengths match the ones of the messages decoded from the offsets
+                    for (const message_info& info : index.messages)
+                    {
+                        const auto [message, rest] = extract_encapsulated_message(
+                            std::span<const uint8_t>(data).subspan(info.offset)
+                        );
+                        CHECK_EQ(
+                            static_cast<size_t>(info.metadata_length),
+                            encapsulated_message_header_size(message.metadata_length())
+                        );
+                        CHECK_EQ(static_cast<size_t>(info.body_length), message.body_length());
+                    }
+                    CHECK_EQ(count_rows(data), 1005);
+                }
+            }
+        }
+
+        TEST_CASE("Scanning an IPC file indexes its stream portion")
+        {
+            std::vector<uint8_t> data;
+            memory_output_stream stream(data);
+            {
+                stream_file_serializer writer(stream);
+                writer << make_batches() << end_file;
+            }
+            const message_index index = scan_stream(data);
+            REQUIRE_EQ(index.messages.size(), 3);
+            CHECK_EQ(index.messages[0].type, MessageHeader::Schema);
+            CHECK_EQ(index.messages[0].offset, arrow_file_header_magic.size());
+            CHECK(index.has_end_of_stream);
+            CHECK_EQ(count_rows(data), 1005);
+        }
+
+        TEST_CASE("Reading the schema only")
+        {
+            const std::vector<uint8_t> data = serialize_stream(make_batches(), std::nullopt);
+            const decoded_schema schema = read_schema(data);
+            CHECK_EQ(schema.field_names, (std::vector<std::string>{"int_col", "string_col"}));
+
+            const decoded_schema projected = read_schema(data, {.field_names = {"string_col"}});
+            CHECK_EQ(projected.field_indices, (std::vector<size_t>{1}));
+        }
+
+        TEST_CASE("A stream without end-of-stream marker is indexed up to its end")
+        {
+            std::vector<uint8_t> data = serialize_stream(make_batches(), std::nullopt);
+            data.resize(data.size() - end_of_stream.size());
+            const message_index index = scan_stream(data);
+            CHECK_EQ(index.messages.size(), 3);
+            CHECK_FALSE(index.has_end_of_stream);
+            CHECK_EQ(index.end_offset, data.size());
+        }
+
+        TEST_CASE("A truncated stream throws")
+        {
+            std::vector<uint8_t> data = serialize_stream(make_batches(), std::nullopt);
+            data.resize(data.size() - end_of_stream.size() - 8);
+            CHECK_THROWS_AS(std::ignore = scan_stream(data), std::runtime_error);
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <sparrow/record_batch.hpp>
+
+#include "sparrow_ipc/magic_values.hpp"
+#include "sparrow_ipc/memory_output_stream.hpp"
+#include "sparrow_ipc/serializer.hpp"
+#include "sparrow_ipc/stream_decoder.hpp"
+#include "sparrow_ipc_tests_helpers.hpp"
+
+namespace sparrow_ipc
+{
+    namespace sp = sparrow;
+
+    namespace
+    {
+        std::vector<uint8_t> serialize_for_decoder(
+            const std::vector<sp::record_batch>& batches,
+            std::optional<CompressionType> compression = std::nullopt
+        )
+        {
+            std::vector<uint8_t> buffer;
+            memory_output_stream stream(buffer);
+            serializer ser(stream, compression);
+            ser << batches << end_stream;
+            return buffer;
+        }
+    }
+
+    TEST_SUITE("stream_decoder")
+    {
+        TEST_CASE("construction with empty callback throws")
+        {
+            CHECK_THROWS_AS(stream_decoder(nullptr), std::invalid_argument);
+        }
+
+        TEST_CASE("decode fragments of any size")
+        {
+            const std::vector<sp::record_batch> batches = {
+                create_test_record_batch(),
+                create_compressible_test_record_batch(),
+                create_test_record_batch()
+            };
+
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    const std::vector<uint8_t> buffer = serialize_for_decoder(batches, p.type);
+
+                    for (const size_t fragment_size : {size_t{1}, size_t{3}, size_t{8}, size_t{100}, buffer.size()})
+                    {
+                        CAPTURE(fragment_size);
+                        std::vector<sp::record_batch> decoded;
+                        stream_decoder decoder(
+                            [&decoded](sp::record_batch&& rb)
+                            {
+                                decoded.push_back(std::move(rb));
+                            }
+                        );
+                        std::span<const uint8_t> data(buffer);
+                        while (!data.empty())
+                        {
+                            const size_t n = std::min(fragment_size, data.size());
+                            // Copy the fragment to a temporary buffer to check that nothing points into it
+                            std::vector<uint8_t> fragment(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(n));
+                            decoder.consume(fragment);
+                            std::ranges::fill(fragment, uint8_t{0});
+                            data = data.subspan(n);
+                        }
+                        CHECK(decoder.ended());
+                        CHECK_EQ(decoder.next_required_size(), 0);
+                        CHECK_EQ(decoder.names(), std::vector<std::string>{"int_col", "string_col"});
+                        REQUIRE_EQ(decoded.size(), batches.size());
+                        for (size_t i = 0; i < batches.size(); ++i)
+                        {
+                            CHECK(decoded[i] == batches[i]);
+                        }
+                    }
+                }
+            }
+        }
+
+        TEST_CASE("batches are emitted as soon as their body is complete")
+        {
+            const std::vector<uint8_t> buffer = serialize_for_decoder({create_test_record_batch()});
+            size_t count = 0;
+            stream_decoder decoder(
+                [&count](sp::record_batch&&)
+                {
+                    ++count;
+                }
+            );
+            CHECK_FALSE(decoder.has_schema());
+            CHECK_THROWS_AS(std::ignore = decoder.names(), std::runtime_error);
+
+            // Everything but the end-of-stream marker
+            decoder.consume(std::span<const uint8_t>(buffer).first(buffer.size() - end_of_stream.size()));
+            CHECK(decoder.has_schema());
+            CHECK_EQ(count, 1);
+            CHECK_FALSE(decoder.ended());
+            CHECK_EQ(decoder.next_required_size(), end_of_stream.size());
+
+            decoder.consume(end_of_stream);
+            CHECK(decoder.ended());
+        }
+
+        TEST_CASE("data after the end of the stream throws")
+        {
+            const std::vector<uint8_t> buffer = serialize_for_decoder({create_test_record_batch()});
+            stream_decoder decoder([](sp::record_batch&&) {});
+            decoder.consume(buffer);
+            CHECK_THROWS_AS(decoder.consume(buffer), std::runtime_error);
+        }
+
+        TEST_CASE("negative body length throws")
+        {
+            const std::vector<uint8_t> buffer = create_record_batch_message(-8);
+            for (const auto level : {validation_level::none, validation_level::metadata})
+            {
+                for (const size_t fragment_size : {size_t{1}, size_t{3}, buffer.size()})
+                {
+                    CAPTURE(static_cast<int>(level));
+                    CAPTURE(fragment_size);
+                    stream_decoder decoder([](sp::record_batch&&) {}, read_options{.validation = level});
+                    const auto consume_all = [&]()
+                    {
+                        std::span<const uint8_t> data(buffer);
+                        while (!data.empty())
+                        {
+                            const size_t n = std::min(fragment_size, data.size());
+                            decoder.consume(data.first(n));
+                            data = data.subspan(n);
+                        }
+                    };
+                    CHECK_THROWS_AS(consume_all(), std::runtime_error);
+                }
+            }
+        }
+
+        TEST_CASE("invalid prefix throws")
+        {
+            const std::vector<uint8_t> buffer(8, 0x01);
+            stream_decoder decoder([](sp::record_batch&&) {});
+            CHECK_THROWS_AS(decoder.consume(buffer), std::runtime_error);
+        }
+    }
+}
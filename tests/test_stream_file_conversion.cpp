@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <sparrow/record_batch.hpp>
+
+#include "sparrow_ipc/any_output_stream.hpp"
+#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/file_reader.hpp"
+#include "sparrow_ipc/magic_values.hpp"
+#include "sparrow_ipc/memory_output_stream.hpp"
+#include "sparrow_ipc/serializer.hpp"
+#include "sparrow_ipc/stream_file_conversion.hpp"
+#include "sparrow_ipc/stream_file_serializer.hpp"
+
+#include "sparrow_ipc_tests_helpers.hpp"
+
+namespace sparrow_ipc
+{
+    namespace
+    {
+        std::vector<sp::record_batch> make_batches()
+        {
+            std::vector<sp::record_batch> batches;
+            batches.push_back(create_test_record_batch());
+            batches.push_back(create_compressible_test_record_batch());
+            return batches;
+        }
+
+        std::vector<uint8_t> convert_stream_to_file(std::span<const uint8_t> stream_data)
+        {
+            std::vector<uint8_t> file_data;
+            memory_output_stream output(file_data);
+            any_output_stream stream(output);
+            stream_to_file(stream_data, stream);
+            return file_data;
+        }
+
+        std::vector<uint8_t> convert_file_to_stream(std::span<const uint8_t> file_data)
+        {
+            std::vector<uint8_t> stream_data;
+            memory_output_stream output(stream_data);
+            any_output_stream stream(output);
+            file_to_stream(file_data, stream);
+            return stream_data;
+        }
+
+        void check_batches(const std::vector<sp::record_batch>& batches)
+        {
+            const std::vector<sp::record_batch> expected = make_batches();
+            REQUIRE_EQ(batches.size(), expected.size());
+            for (size_t i = 0; i < batches.size(); ++i)
+            {
+                CHECK_EQ(batches[i].nb_columns(), expected[i].nb_columns());
+                CHECK_EQ(batches[i].nb_rows(), expected[i].nb_rows());
+            }
+        }
+    }
+
+    TEST_SUITE("stream_file_conversion")
+    {
+        TEST_CASE("Stream to file and back copies the messages")
+        {
+            for (const auto& [compression, name] : compression_params)
+            {
+                SUBCASE(name)
+                {
+                    std::vector<uint8_t> stream_data;
+                    memory_output_stream output(stream_data);
+                    serializer writer(output, compression);
+                    writer << make_batches() << end_stream;
+
+                    const std::vector<uint8_t> file_data = convert_stream_to_file(stream_data);
+                    // The stream is copied as is after the leading magic bytes
+                    REQUIRE_GT(file_data.size(), arrow_file_header_magic.size() + stream_data.size());
+                    CHECK(std::ranges::equal(
+                        std::span<const uint8_t>(file_data).subspan(arrow_file_header_magic.size(), stream_data.size()),
+                        stream_data
+                    ));
+
+                    const file_reader reader{std::span<const uint8_t>(file_data)};
+                    CHECK_EQ(reader.num_record_batches(), 2);
+                    check_batches(reader.read_all());
+
+                    CHECK_EQ(convert_file_to_stream(file_data), stream_data);
+                }
+            }
+        }
+
+        TEST_CASE("File written by the serializer to stream")
+        {
+            std::vector<uint8_t> file_data;
+            memory_output_stream output(file_data);
+            {
+                stream_file_serializer writer(output, CompressionType::ZSTD);
+                writer << make_batches() << end_file;
+            }
+            const std::vector<uint8_t> stream_data = convert_file_to_stream(file_data);
+            check_batches(deserialize_stream(stream_data));
+            // The stream portion of the file is copied as is
+            CHECK(std::ranges::equal(
+                std::span<const uint8_t>(file_data).subspan(arrow_file_header_magic.size(), stream_data.size()),
+                stream_data
+            ));
+        }
+
+        TEST_CASE("Invalid inputs are rejected")
+        {
+            const std::vector<uint8_t> garbage(64, 0x2A);
+            CHECK_THROWS_AS(convert_stream_to_file(garbage), std::runtime_error);
+            CHECK_THROWS_AS(convert_file_to_stream(garbage), std::runtime_error);
+        }
+    }
+}
@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <sparrow/record_batch.hpp>
+
+#include "sparrow_ipc/any_input_stream.hpp"
+#include "sparrow_ipc/deserialize.hpp"
+#include "sparrow_ipc/magic_values.hpp"
+#include "sparrow_ipc/memory_output_stream.hpp"
+#include "sparrow_ipc/serializer.hpp"
+#include "sparrow_ipc/stream_reader.hpp"
+#include "sparrow_ipc_tests_helpers.hpp"
+
+namespace sparrow_ipc
+{
+    namespace sp = sparrow;
+
+    namespace
+    {
+        // Custom POSIX-like stream handing out at most `chunk_size` bytes per read
+        struct chunked_input_stream
+        {
+            std::span<const uint8_t> data;
+            size_t chunk_size;
+
+            std::streamsize read(char* s, std::streamsize count)
+            {
+                const size_t n = std::min({data.size(), chunk_size, static_cast<size_t>(count)});
+                std::copy_n(data.begin(), n, reinterpret_cast<uint8_t*>(s));
+                data = data.subspan(n);
+                return static_cast<std::streamsize>(n);
+            }
+        };
+
+        std::vector<uint8_t>
+        serialize_to_buffer(const std::vector<sp::record_batch>& batches, std::optional<CompressionType> compression)
+        {
+            std::vector<uint8_t> buffer;
+            memory_output_stream stream(buffer);
+            serializer ser(stream, compression);
+            ser << batches << end_stream;
+            return buffer;
+        }
+
+        void check_same_batches(const std::vector<sp::record_batch>& expected, stream_reader& reader)
+        {
+            size_t count = 0;
+            while (auto batch = reader.next())
+            {
+                REQUIRE_LT(count, expected.size());
+                CHECK(*batch == expected[count]);
+                ++count;
+            }
+            CHECK_EQ(count, expected.size());
+            CHECK(reader.ended());
+        }
+    }
+
+    TEST_SUITE("any_input_stream")
+    {
+        TEST_CASE("read from std::istringstream")
+        {
+            std::istringstream iss(std::string("abcdef"));
+            any_input_stream stream(iss);
+            std::array<uint8_t, 4> buffer{};
+            CHECK_EQ(stream.read(buffer), 4);
+            CHECK_EQ(buffer[0], 'a');
+            CHECK_EQ(buffer[3], 'd');
+            CHECK_EQ(stream.read(buffer), 2);
+            CHECK_EQ(buffer[1], 'f');
+            CHECK_EQ(stream.read(buffer), 0);
+            CHECK_EQ(stream.position(), 6);
+        }
+
+        TEST_CASE("read from a stream returning partial reads")
+        {
+            const std::vector<uint8_t> data = {1, 2, 3, 4, 5, 6, 7};
+            chunked_input_stream chunked{data, 3};
+            any_input_stream stream(chunked);
+            std::vector<uint8_t> buffer(7);
+            CHECK_EQ(stream.read(buffer), 7);
+            CHECK_EQ(buffer, data);
+            CHECK_EQ(&stream.get<chunked_input_stream>(), &chunked);
+        }
+    }
+
+    TEST_SUITE("stream_reader")
+    {
+        TEST_CASE("read batches one at a time")
+        {
+            const std::vector<sp::record_batch> batches = {
+                create_test_record_batch(),
+                create_test_record_batch(),
+                create_test_record_batch()
+            };
+
+            for (const auto& p : compression_params)
+            {
+                SUBCASE(p.name)
+                {
+                    const std::vector<uint8_t> buffer = serialize_to_buffer(batches, p.type);
+
+                    SUBCASE("From std::istringstream")
+                    {
+                        std::istringstream iss(std::string(buffer.begin(), buffer.end()));
+                        stream_reader reader(iss);
+                        CHECK_EQ(reader.names(), std::vector<std::string>{"int_col", "string_col"});
+                        check_same_batches(batches, reader);
+                    }
+
+                    SUBCASE("From a fragmented stream")
+                    {
+                        chunked_input_stream chunked{buffer, 5};
+                        stream_reader reader(chunked);
+                        check_same_batches(batches, reader);
+                    }
+
+                    SUBCASE("Same result as deserialize_stream")
+                    {
+                        const auto expected = deserialize_stream(buffer);
+                        chunked_input_stream chunked{buffer, 64};
+                        stream_reader reader(chunked);
+                        check_same_batches(expected, reader);
+                    }
+                }
+            }
+        }
+
+        TEST_CASE("projection")
+        {
+            const std::vector<sp::record_batch> batches = {create_test_record_batch(), create_test_record_batch()};
+            const std::vector<uint8_t> buffer = serialize_to_buffer(batches, std::nullopt);
+
+            SUBCASE("By name")
+            {
+                chunked_input_stream chunked{buffer, buffer.size()};
+                stream_reader reader(chunked, read_options{.field_names = std::vector<std::string>{"string_col"}});
+                CHECK_EQ(reader.names(), std::vector<std::string>{"string_col"});
+                const auto batch = reader.next();
+                REQUIRE(batch.has_value());
+                REQUIRE_EQ(batch->nb_columns(), 1);
+                CHECK(batch->get_column(0) == batches[0].get_column("string_col"));
+            }
+
+            SUBCASE("By index, in a different order")
+            {
+                chunked_input_stream chunked{buffer, buffer.size()};
+                stream_reader reader(chunked, read_options{.field_indices = std::vector<size_t>{1, 0}});
+                CHECK_EQ(reader.names(), std::vector<std::string>{"string_col", "int_col"});
+                const auto batch = reader.next();
+                REQUIRE(batch.has_value());
+                CHECK(batch->get_column("int_col") == batches[0].get_column("int_col"));
+                CHECK(batch->get_column("string_col") == batches[0].get_column("string_col"));
+            }
+
+            SUBCASE("Invalid projections throw")
+            {
+                chunked_input_stream unknown_name{buffer, buffer.size()};
+                stream_reader reader_unknown_name(
+                    unknown_name,
+                    read_options{.field_names = std::vector<std::string>{"missing"}}
+                );
+                CHECK_THROWS_AS(std::ignore = reader_unknown_name.names(), std::invalid_argument);
+
+                chunked_input_stream out_of_range{buffer, buffer.size()};
+                stream_reader reader_out_of_range(
+                    out_of_range,
+                    read_options{.field_indices = std::vector<size_t>{2}}
+                );
+                CHECK_THROWS_AS(std::ignore = reader_out_of_range.next(), std::invalid_argument);
+
+                chunked_input_stream duplicated{buffer, buffer.size()};
+                stream_reader reader_duplicated(duplicated, read_options{.field_indices = std::vector<size_t>{0, 0}});
+                CHECK_THROWS_AS(std::ignore = reader_duplicated.names(), std::invalid_argument);
+            }
+        }
+
+        TEST_CASE("batches outlive the reader and the input")
+        {
+            const auto expected = create_compressible_test_record_batch();
+            std::vector<sp::record_batch> read_batches;
+            {
+                std::vector<uint8_t> buffer = serialize_to_buffer({expected}, std::nullopt);
+                std::istringstream iss(std::string(buffer.begin(), buffer.end()));
+                stream_reader reader(iss);
+                while (auto batch = reader.next())
+                {
+                    read_batches.push_back(std::move(*batch));
+                }
+                std::ranges::fill(buffer, uint8_t{0});
+            }
+            REQUIRE_EQ(read_batches.size(), 1);
+            CHECK(read_batches[0] == expected);
+            // The schema of the arrays is shared with the reader, and outlives it
+            CHECK(read_batches[0].get_column(0).name() == "int_col");
+        }
+
+        TEST_CASE("stream without end-of-stream marker")
+        {
+            std::vector<uint8_t> buffer = serialize_to_buffer({create_test_record_batch()}, std::nullopt);
+            buffer.resize(buffer.size() - end_of_stream.size());
+            chunked_input_stream chunked{buffer, buffer.size()};
+            stream_reader reader(chunked);
+            CHECK(reader.next().has_value());
+            CHECK_FALSE(reader.next().has_value());
+        }
+
+        TEST_CASE("empty stream")
+        {
+            std::istringstream iss;
+            stream_reader reader(iss);
+            CHECK(reader.names().empty());
+            CHECK_FALSE(reader.next().has_value());
+            CHECK(reader.ended());
+        }
+
+        TEST_CASE("truncated stream throws")
+        {
+            std::vector<uint8_t> buffer = serialize_to_buffer({create_test_record_batch()}, std::nullopt);
+            buffer.resize(buffer.size() - end_of_stream.size() - 8);
+            chunked_input_stream chunked{buffer, buffer.size()};
+            stream_reader reader(chunked);
+            CHECK_THROWS_AS(std::ignore = reader.next(), std::runtime_error);
+        }
+
+        TEST_CASE("negative body length throws")
+        {
+            const std::vector<uint8_t> buffer = create_record_batch_message(-8);
+            for (const auto level : {validation_level::none, validation_level::metadata})
+            {
+                CAPTURE(static_cast<int>(level));
+                chunked_input_stream chunked{buffer, 3};
+                stream_reader reader(chunked, read_options{.validation = level});
+                CHECK_THROWS_AS(std::ignore = reader.names(), std::runtime_error);
+            }
+        }
+
+        TEST_CASE("missing continuation throws")
+        {
+            const std::vector<uint8_t> buffer(16, 0x01);
+            chunked_input_stream chunked{buffer, buffer.size()};
+            stream_reader reader(chunked);
+            CHECK_THROWS_AS(std::ignore = reader.names(), std::runtime_error);
+        }
+    }
+}
@@ -0,0 +1,256 @@
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "sparrow_ipc/any_output_stream.hpp"
+#include "sparrow_ipc/encapsulated_message.hpp"
+#include "sparrow_ipc/memory_output_stream.hpp"
+#include "sparrow_ipc/serialize.hpp"
+#include "sparrow_ipc/tensor.hpp"
+
+namespace sparrow_ipc
+{
+    namespace
+    {
+        template <class T>
+        std::span<const uint8_t> as_bytes(const std::vector<T>& values)
+        {
+            return {reinterpret_cast<const uint8_t*>(values.data()), values.size() * sizeof(T)};
+        }
+
+        template <class T>
+        std::vector<T> to_values(std::span<const uint8_t> bytes)
+        {
+            std::vector<T> values(bytes.size() / sizeof(T));
+            std::memcpy(values.data(), bytes.data(), values.size() * sizeof(T));
+            return values;
+        }
+
+        std::vector<uint8_t> serialize(const tensor_view& tensor)
+        {
+            std::vector<uint8_t> buffer;
+            memory_output_stream output(buffer);
+            any_output_stream stream(output);
+            serialize_tensor(tensor, stream);
+            return buffer;
+        }
+
+        std::vector<uint8_t> serialize(const sparse_tensor_view& tensor)
+        {
+            std::vector<uint8_t> buffer;
+            memory_output_stream output(buffer);
+            any_output_stream stream(output);
+            serialize_sparse_tensor(tensor, stream);
+            return buffer;
+        }
+
+        bool points_into(std::span<const uint8_t> buffer, const std::vector<uint8_t>& message)
+        {
+            return buffer.data() >= message.data()
+                   && buffer.data() + buffer.size() <= message.data() + message.size();
+        }
+
+        // 3 x 4 matrix with 4 non-zero values
+        //   [0 1 0 0]
+        //   [2 0 0 3]
+        //   [0 0 4 0]
+        const std::vector<double> non_zero_values = {1., 2., 3., 4.};
+    }
+
+    TEST_SUITE("tensor")
+    {
+        TEST_CASE("Tensor round trip without copy")
+        {
+            const std::vector<float> values = {1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+            const tensor_view tensor{
+                .format = "f",
+                .shape = {{.size = 2, .name = "rows"}, {.size = 3, .name = ""}},
+                .data = as_bytes(values)
+            };
+            const std::vector<uint8_t> message_bytes = serialize(tensor);
+            REQUIRE_EQ(message_bytes.size() % 8, 0);
+
+            const auto [message, rest] = extract_encapsulated_message(message_bytes, true);
+            CHECK(rest.empty());
+            const tensor_view read = read_tensor(message);
+            CHECK_EQ(read.format, "f");
+            REQUIRE_EQ(read.shape.size(), 2);
+            CHECK_EQ(read.shape[0].size, 2);
+            CHECK_EQ(read.shape[0].name, "rows");
+            CHECK_EQ(read.shape[1].size, 3);
+            CHECK(read.shape[1].name.empty());
+            CHECK(read.strides.empty());
+            CHECK(points_into(read.data, message_bytes));
+            CHECK_EQ(to_values<float>(read.data), values);
+        }
+
+        TEST_CASE("Tensor with strides")
+        {
+            // Column-major 2 x 3 matrix of int64
+            const std::vector<int64_t> values = {1, 4, 2, 5, 3, 6};
+            const tensor_view tensor{
+                .format = "l",
+                .shape = {{.size = 2}, {.size = 3}},
+                .strides = {8, 16},
+                .data = as_bytes(values)
+            };
+            const std::vector<uint8_t> message_bytes = serialize(tensor);
+            const tensor_view read = read_tensor(extract_encapsulated_message(message_bytes, true).first);
+            CHECK_EQ(read.format, "l");
+            CHECK_EQ(read.strides, (std::vector<int64_t>{8, 16}));
+            CHECK_EQ(to_values<int64_t>(read.data), values);
+        }
+
+        TEST_CASE("Tensor owner keeps the message alive")
+        {
+            const std::vector<int32_t> values = {7, 8, 9};
+            auto message_bytes = std::make_shared<const std::vector<uint8_t>>(
+                serialize(tensor_view{.format = "i", .shape = {{.size = 3}}, .data = as_bytes(values)})
+            );
+            const encapsulated_message message = extract_encapsulated_message(*message_bytes, true).first;
+            const tensor_view read = read_tensor(message, message_bytes);
+            message_bytes.reset();
+            CHECK_EQ(to_values<int32_t>(read.data), values);
+        }
+
+        TEST_CASE("Invalid tensors are rejected")
+        {
+            const std::vector<float> values = {1.f, 2.f, 3.f};
+            SUBCASE("Data too small for the shape")
+            {
+                const tensor_view tensor{
+                    .format = "f",
+                    .shape = {{.size = 2}, {.size = 2}},
+                    .data = as_bytes(values)
+                };
+                CHECK_THROWS_AS(check_tensor(tensor), std::invalid_argument);
+            }
+            SUBCASE("Strides not matching the shape")
+            {
+                const tensor_view tensor{
+                    .format = "f",
+                    .shape = {{.size = 3}},
+                    .strides = {4, 4},
+                    .data = as_bytes(values)
+                };
+                CHECK_THROWS_AS(check_tensor(tensor), std::invalid_argument);
+            }
+            SUBCASE("Unsupported value type")
+            {
+                const tensor_view tensor{.format = "u", .shape = {{.size = 1}}, .data = as_bytes(values)};
+                CHECK_THROWS_AS(check_tensor(tensor), std::invalid_argument);
+            }
+        }
+
+        TEST_CASE("SparseTensor COO round trip")
+        {
+            const std::vector<int64_t> coordinates = {0, 1, 1, 0, 1, 3, 2, 2};
+            const sparse_tensor_view tensor{
+                .format = "g",
+                .shape = {{.size = 3}, {.size = 4}},
+                .non_zero_length = 4,
+                .index = sparse_tensor_index::coo,
+                .indices = as_bytes(coordinates),
+                .is_canonical = true,
+                .data = as_bytes(non_zero_values)
+            };
+            const std::vector<uint8_t> message_bytes = serialize(tensor);
+            const sparse_tensor_view read = read_sparse_tensor(
+                extract_encapsulated_message(message_bytes, true).first
+            );
+            CHECK_EQ(read.format, "g");
+            CHECK_EQ(read.index, sparse_tensor_index::coo);
+            CHECK_EQ(read.non_zero_length, 4);
+            CHECK_EQ(read.indices_format, "l");
+            CHECK(read.is_canonical);
+            CHECK(read.indptr.empty());
+            CHECK(points_into(read.indices, message_bytes));
+            CHECK(points_into(read.data, message_bytes));
+            CHECK_EQ(to_values<int64_t>(read.indices), coordinates);
+            CHECK_EQ(to_values<double>(read.data), non_zero_values);
+        }
+
+        TEST_CASE("SparseTensor CSR and CSC round trip")
+        {
+            SUBCASE("CSR")
+            {
+                const std::vector<int32_t> indptr = {0, 1, 3, 4};
+                const std::vector<int32_t> indices = {1, 0, 3, 2};
+                const sparse_tensor_view tensor{
+                    .format = "g",
+                    .shape = {{.size = 3}, {.size = 4}},
+                    .non_zero_length = 4,
+                    .index = sparse_tensor_index::csr,
+                    .indices_format = "i",
+                    .indices = as_bytes(indices),
+                    .indptr_format = "i",
+                    .indptr = as_bytes(indptr),
+                    .data = as_bytes(non_zero_values)
+                };
+                const std::vector<uint8_t> message_bytes = serialize(tensor);
+                const sparse_tensor_view read = read_sparse_tensor(
+                    extract_encapsulated_message(message_bytes, true).first
+                );
+                CHECK_EQ(read.index, sparse_tensor_index::csr);
+                CHECK_EQ(read.indptr_format, "i");
+                CHECK_EQ(read.indices_format, "i");
+                CHECK_EQ(to_values<int32_t>(read.indptr), indptr);
+                CHECK_EQ(to_values<int32_t>(read.indices), indices);
+                CHECK_EQ(to_values<double>(read.data), non_zero_values);
+            }
+            SUBCASE("CSC")
+            {
+                const std::vector<int64_t> indptr = {0, 1, 2, 3, 4};
+                const std::vector<int64_t> indices = {1, 0, 2, 1};
+                const std::vector<double> values = {2., 1., 4., 3.};
+                const sparse_tensor_view tensor{
+                    .format = "g",
+                    .shape = {{.size = 3}, {.size = 4}},
+                    .non_zero_length = 4,
+                    .index = sparse_tensor_index::csc,
+                    .indices = as_bytes(indices),
+                    .indptr = as_bytes(indptr),
+                    .data = as_bytes(values)
+                };
+                const std::vector<uint8_t> message_bytes = serialize(tensor);
+                const sparse_tensor_view read = read_sparse_tensor(
+                    extract_encapsulated_message(message_bytes, true).first
+                );
+                CHECK_EQ(read.index, sparse_tensor_index::csc);
+                CHECK_EQ(to_values<int64_t>(read.indptr), indptr);
+                CHECK_EQ(to_values<int64_t>(read.indices), indices);
+                CHECK_EQ(to_values<double>(read.data), values);
+            }
+            SUBCASE("A CSR tensor must be a matrix")
+            {
+                const std::vector<int64_t> indptr = {0, 4};
+                const std::vector<int64_t> indices = {0, 1, 2, 3};
+                const sparse_tensor_view tensor{
+                    .format = "g",
+                    .shape = {{.size = 4}},
+                    .non_zero_length = 4,
+                    .index = sparse_tensor_index::csr,
+                    .indices = as_bytes(indices),
+                    .indptr = as_bytes(indptr),
+                    .data = as_bytes(non_zero_values)
+                };
+                CHECK_THROWS_AS(check_sparse_tensor(tensor), std::invalid_argument);
+            }
+        }
+
+        TEST_CASE("Reading the wrong kind of message throws")
+        {
+            const std::vector<float> values = {1.f};
+            const std::vector<uint8_t> message_bytes = serialize(
+                tensor_view{.format = "f", .shape = {{.size = 1}}, .data = as_bytes(values)}
+            );
+            const encapsulated_message message = extract_encapsulated_message(message_bytes, true).first;
+            CHECK_THROWS_AS(std::ignore = read_sparse_tensor(message), std::runtime_error);
+        }
+    }
+}